@@ -0,0 +1,1723 @@
+extern aym_write_str
+extern aym_write_int
+extern aym_write_flush
+extern scanf
+extern aym_random
+extern aym_srand
+extern aym_sleep
+extern aym_term_clear
+extern aym_term_move
+extern aym_term_color
+extern aym_term_reset
+extern aym_term_cursor
+extern aym_key_poll
+extern aym_time_ms
+extern aym_gfx_open
+extern aym_gfx_is_open
+extern aym_gfx_clear
+extern aym_gfx_set_color
+extern aym_gfx_rect4
+extern aym_gfx_rect
+extern aym_gfx_text3
+extern aym_gfx_text
+extern aym_gfx_present
+extern aym_gfx_close
+extern aym_gfx_key_down
+extern aym_set_args
+extern aym_gc_stats_enable
+extern aym_argc
+extern aym_argv_get
+extern aym_assert
+extern aym_hof_map
+extern aym_hof_filter
+extern aym_hof_reduce
+extern aym_hof_pipeline
+extern aym_hof_map_par
+extern aym_hof_filter_par
+extern aym_hof_reduce_par
+extern aym_fs_read_text
+extern aym_fs_write_text
+extern aym_fs_exists
+extern aym_array_new
+extern aym_array_get
+extern aym_array_set
+extern aym_array_free
+extern aym_array_length
+extern aym_array_push
+extern aym_array_pop
+extern aym_array_remove_at
+extern aym_array_contains_int
+extern aym_array_contains_str
+extern aym_array_find_int
+extern aym_array_find_str
+extern aym_array_sort_int
+extern aym_array_sort_str
+extern aym_array_sort_by
+extern aym_array_unique_int
+extern aym_array_unique_str
+extern aym_set_new
+extern aym_set_from_array
+extern aym_set_add
+extern aym_set_contains
+extern aym_set_remove
+extern aym_set_size
+extern aym_set_items
+extern aym_set_is_string
+extern aym_deque_new
+extern aym_deque_from_array
+extern aym_deque_push_back
+extern aym_deque_push_front
+extern aym_deque_pop_back
+extern aym_deque_pop_front
+extern aym_deque_size
+extern aym_deque_items
+extern aym_deque_is_string
+extern aym_heap_new
+extern aym_heap_from_array
+extern aym_heap_push
+extern aym_heap_pop
+extern aym_heap_peek
+extern aym_heap_size
+extern aym_heap_items
+extern aym_heap_is_string
+extern aym_map_new
+extern aym_map_init_stack
+extern aym_map_set
+extern aym_map_get
+extern aym_map_get_default
+extern aym_map_contains
+extern aym_map_size
+extern aym_map_keys
+extern aym_map_values
+extern aym_map_delete
+extern aym_map_key_at
+extern aym_map_value_at
+extern aym_map_value_is_string
+extern aym_map_value_is_string_key
+extern aym_imap_set
+extern aym_imap_get
+extern aym_imap_get_default
+extern aym_imap_contains
+extern aym_imap_delete
+extern aym_imap_value_is_string_key
+extern aym_object_new
+extern aym_object_get
+extern aym_object_set
+extern aym_object_method
+extern aym_object_to_map
+extern aym_str_concat
+extern aym_str_build
+extern aym_str_eq
+extern aym_str_from_c
+extern aym_str_scratch_mark
+extern aym_str_scratch_release
+extern aym_str_trim
+extern aym_str_split
+extern aym_str_join
+extern aym_str_replace
+extern aym_str_contains
+extern aym_to_string
+extern aym_to_number
+extern aym_sin
+extern aym_cos
+extern aym_tan
+extern aym_asin
+extern aym_acos
+extern aym_atan
+extern aym_sqrt
+extern aym_pow
+extern aym_exp
+extern aym_log
+extern aym_log10
+extern aym_floor
+extern aym_ceil
+extern aym_round
+extern aym_fabs
+extern aym_handler_top
+extern aym_throw
+extern aym_exception_new
+extern aym_exception_type
+extern aym_exception_message
+section .data
+fmt_read_int: db "%ld",0
+fmt_read_str: db "%255s",0
+input_val: dq 0
+input_buf: times 256 db 0
+align 8
+    dq 0x44bd4bd473cd2df9, 1, 1
+print_sep: db 32, 0
+align 8
+    dq 0x44bd31d473cd01cb, 1, 1
+print_term: db 10, 0
+align 8
+    dq 0x44bd80d473cd8808, 1, 1
+list_open: db 91, 0
+align 8
+    dq 0x9afebb00c5c7fa67, 2, 2
+list_sep: db 44, 32, 0
+align 8
+    dq 0x44bd86d473cd923a, 1, 1
+list_close: db 93, 0
+align 8
+    dq 0x44bd49d473cd2a93, 1, 1
+list_quote: db 34, 0
+align 8
+    dq 0x44bda0d473cdbe68, 1, 1
+map_open: db 123, 0
+align 8
+    dq 0x9afebb00c5c7fa67, 2, 2
+map_sep: db 44, 32, 0
+align 8
+    dq 0x44bda6d473cdc89a, 1, 1
+map_close: db 125, 0
+align 8
+    dq 0x9b20b700c5e4da01, 2, 2
+map_colon: db 58, 32, 0
+align 8
+    dq 0xbd0cbb81044f3315, 5, 5
+bool_true: db 99, 104, 105, 113, 97, 0
+align 8
+    dq 0xe31a02b86357a2f1, 5, 5
+bool_false: db 107, 39, 97, 114, 105, 0
+align 8
+    dq 0x44bd9dd473cdb94f, 1, 1
+str0: db 118, 0
+align 8
+    dq 0x44bd8fd473cda185, 1, 1
+str1: db 100, 0
+align 8
+    dq 0xfa583e511b8cf849, 3, 3
+str2: db 102, 49, 57, 0
+align 8
+    dq 0x2e51305138fd0b7b, 3, 3
+str3: db 104, 49, 57, 0
+align 8
+    dq 0x44bd8ad473cd9906, 1, 1
+str4: db 97, 0
+align 8
+    dq 0x591f5b51511723f4, 3, 3
+str5: db 115, 105, 103, 0
+align 8
+    dq 0x44bd9fd473cdbcb5, 1, 1
+str6: db 116, 0
+align 8
+    dq 0x9bb62c00c663c4c4, 2, 2
+str7: db 102, 51, 0
+align 8
+    dq 0x9bb2a600c660ab3b, 2, 2
+str8: db 103, 53, 0
+align 8
+    dq 0x122c8bc6cf63a9ab, 6, 6
+str9: db 69, 110, 111, 114, 109, 101, 0
+align 8
+    dq 0x9bb2a900c660b054, 2, 2
+str10: db 103, 48, 0
+align 8
+    dq 0x9bb2aa00c660b207, 2, 2
+str11: db 103, 49, 0
+align 8
+    dq 0x9bb2ab00c660b3ba, 2, 2
+str12: db 103, 50, 0
+align 8
+    dq 0x9bb2ac00c660b56d, 2, 2
+str13: db 103, 51, 0
+align 8
+    dq 0x9bb2a500c660a988, 2, 2
+str14: db 103, 52, 0
+align 8
+    dq 0x9bb2a700c660acee, 2, 2
+str15: db 103, 54, 0
+align 8
+    dq 0x9bb2a800c660aea1, 2, 2
+str16: db 103, 55, 0
+align 8
+    dq 0x9bb2a100c660a2bc, 2, 2
+str17: db 103, 56, 0
+align 8
+    dq 0x9bb2a200c660a46f, 2, 2
+str18: db 103, 57, 0
+align 8
+    dq 0xf1491651164ed375, 3, 3
+str19: db 103, 49, 48, 0
+align 8
+    dq 0xf1491551164ed1c2, 3, 3
+str20: db 103, 49, 49, 0
+align 8
+    dq 0xf1491451164ed00f, 3, 3
+str21: db 103, 49, 50, 0
+align 8
+    dq 0xf1491351164ece5c, 3, 3
+str22: db 103, 49, 51, 0
+align 8
+    dq 0xf1491251164ecca9, 3, 3
+str23: db 103, 49, 52, 0
+align 8
+    dq 0xf1491151164ecaf6, 3, 3
+str24: db 103, 49, 53, 0
+align 8
+    dq 0xf1491051164ec943, 3, 3
+str25: db 103, 49, 54, 0
+align 8
+    dq 0xf1490f51164ec790, 3, 3
+str26: db 103, 49, 55, 0
+align 8
+    dq 0xf1491e51164ee10d, 3, 3
+str27: db 103, 49, 56, 0
+align 8
+    dq 0xf1491d51164edf5a, 3, 3
+str28: db 103, 49, 57, 0
+align 8
+    dq 0x9bca9300c6751cd3, 2, 2
+str29: db 104, 48, 0
+align 8
+    dq 0x9bca9200c6751b20, 2, 2
+str30: db 104, 49, 0
+align 8
+    dq 0x9bca9500c6752039, 2, 2
+str31: db 104, 50, 0
+align 8
+    dq 0x9bca9400c6751e86, 2, 2
+str32: db 104, 51, 0
+align 8
+    dq 0x9bca9700c675239f, 2, 2
+str33: db 104, 52, 0
+align 8
+    dq 0x9bca9600c67521ec, 2, 2
+str34: db 104, 53, 0
+align 8
+    dq 0x9bca9900c6752705, 2, 2
+str35: db 104, 54, 0
+align 8
+    dq 0x9bca9800c6752552, 2, 2
+str36: db 104, 55, 0
+align 8
+    dq 0x9bca9b00c6752a6b, 2, 2
+str37: db 104, 56, 0
+align 8
+    dq 0x9bca9a00c67528b8, 2, 2
+str38: db 104, 57, 0
+align 8
+    dq 0x2e51275138fcfc30, 3, 3
+str39: db 104, 49, 48, 0
+align 8
+    dq 0x2e51285138fcfde3, 3, 3
+str40: db 104, 49, 49, 0
+align 8
+    dq 0x2e51295138fcff96, 3, 3
+str41: db 104, 49, 50, 0
+align 8
+    dq 0x2e512a5138fd0149, 3, 3
+str42: db 104, 49, 51, 0
+align 8
+    dq 0x2e512b5138fd02fc, 3, 3
+str43: db 104, 49, 52, 0
+align 8
+    dq 0x2e512c5138fd04af, 3, 3
+str44: db 104, 49, 53, 0
+align 8
+    dq 0x2e512d5138fd0662, 3, 3
+str45: db 104, 49, 54, 0
+align 8
+    dq 0x2e512e5138fd0815, 3, 3
+str46: db 104, 49, 55, 0
+align 8
+    dq 0x2e512f5138fd09c8, 3, 3
+str47: db 104, 49, 56, 0
+align 8
+    dq 0x61abb460c2d6fa1a, 6, 6
+str48: db 71, 114, 97, 110, 100, 101, 0
+align 8
+    dq 0x9bb62f00c663c9dd, 2, 2
+str49: db 102, 48, 0
+align 8
+    dq 0x9bb62e00c663c82a, 2, 2
+str50: db 102, 49, 0
+align 8
+    dq 0x9bb62d00c663c677, 2, 2
+str51: db 102, 50, 0
+align 8
+    dq 0x9bb62b00c663c311, 2, 2
+str52: db 102, 52, 0
+align 8
+    dq 0x9bb62a00c663c15e, 2, 2
+str53: db 102, 53, 0
+align 8
+    dq 0x9bb62900c663bfab, 2, 2
+str54: db 102, 54, 0
+align 8
+    dq 0x9bb62800c663bdf8, 2, 2
+str55: db 102, 55, 0
+align 8
+    dq 0x9bb62700c663bc45, 2, 2
+str56: db 102, 56, 0
+align 8
+    dq 0x9bb62600c663ba92, 2, 2
+str57: db 102, 57, 0
+align 8
+    dq 0xfa5845511b8d042e, 3, 3
+str58: db 102, 49, 48, 0
+align 8
+    dq 0xfa5846511b8d05e1, 3, 3
+str59: db 102, 49, 49, 0
+align 8
+    dq 0xfa5843511b8d00c8, 3, 3
+str60: db 102, 49, 50, 0
+align 8
+    dq 0xfa5844511b8d027b, 3, 3
+str61: db 102, 49, 51, 0
+align 8
+    dq 0xfa5849511b8d0afa, 3, 3
+str62: db 102, 49, 52, 0
+align 8
+    dq 0xfa584a511b8d0cad, 3, 3
+str63: db 102, 49, 53, 0
+align 8
+    dq 0xfa5847511b8d0794, 3, 3
+str64: db 102, 49, 54, 0
+align 8
+    dq 0xfa5848511b8d0947, 3, 3
+str65: db 102, 49, 55, 0
+align 8
+    dq 0xfa583d511b8cf696, 3, 3
+str66: db 102, 49, 56, 0
+align 8
+    dq 0x6797a383436c1dbb, 5, 5
+str67: db 77, 101, 100, 105, 111, 0
+align 8
+    dq 0x44bd89d473cd9753, 1, 1
+str68: db 98, 0
+align 8
+    dq 0x44bd88d473cd95a0, 1, 1
+str69: db 99, 0
+align 8
+    dq 0xa68f3d267b026470, 6, 6
+str70: db 67, 104, 105, 113, 117, 105, 0
+n: dq 0
+k: dq 0
+malos: dq 0
+t: dq 0
+ultimo_g: dq 0
+md: dq 0
+basura: dq 0
+m: dq 0
+ultimo_m: dq 0
+ultimo_c: dq 0
+i: dq 0
+e: dq 0
+ultimo_e: dq 0
+c: dq 0
+mb: dq 0
+g: dq 0
+section .rodata
+__Chiqui_class_info_fields: dq str0, str5
+__Chiqui_class_info_types: db 0, 0
+align 8
+__Chiqui_class_info: dq str70, 0, 2, __Chiqui_class_info_fields, __Chiqui_class_info_types, 0, 0, __Chiqui_class_info_vtable
+__Chiqui_class_info_vtable:
+__Enorme_class_info_fields: dq str10, str11, str12, str13, str14, str8, str15, str16, str17, str18, str19, str20, str21, str22, str23, str24, str25, str26, str27, str28, str29, str30, str31, str32, str33, str34, str35, str36, str37, str38, str39, str40, str41, str42, str43, str44, str45, str46, str47, str3, str0, str5
+__Enorme_class_info_types: db 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+align 8
+__Enorme_class_info: dq str9, 0, 42, __Enorme_class_info_fields, __Enorme_class_info_types, 0, 0, __Enorme_class_info_vtable
+__Enorme_class_info_vtable:
+__Grande_class_info_fields: dq str49, str50, str51, str7, str52, str53, str54, str55, str56, str57, str58, str59, str60, str61, str62, str63, str64, str65, str66, str2, str0, str5
+__Grande_class_info_types: db 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+align 8
+__Grande_class_info: dq str48, 0, 22, __Grande_class_info_fields, __Grande_class_info_types, 0, 0, __Grande_class_info_vtable
+__Grande_class_info_vtable:
+__Medio_class_info_fields: dq str4, str68, str69, str1, str0, str5
+__Medio_class_info_types: db 0, 0, 0, 0, 0, 0
+align 8
+__Medio_class_info: dq str67, 0, 6, __Medio_class_info_fields, __Medio_class_info_types, 0, 0, __Medio_class_info_vtable
+__Medio_class_info_vtable:
+section .text
+global main
+__Chiqui_ctor_1:
+    push rbp
+    mov rbp, rsp
+    push rbx
+    push r12
+    push r13
+    push r14
+    push r15
+    sub rsp, 24
+tail1:
+    mov r12, rdi
+    mov r13, rsi
+    mov rax, r12
+    mov rcx, r13
+    mov [rax+16], rcx
+endfunc0:
+    add rsp, 24
+    pop r15
+    pop r14
+    pop r13
+    pop r12
+    pop rbx
+    pop rbp
+    ret
+__Medio_ctor_1:
+    push rbp
+    mov rbp, rsp
+    push rbx
+    push r12
+    push r13
+    push r14
+    push r15
+    sub rsp, 24
+tail3:
+    mov r12, rdi
+    mov r13, rsi
+    mov rax, r12
+    mov rcx, r13
+    mov [rax+48], rcx
+    mov rax, r13
+    add rax, 1
+    sub rsp, 16
+    mov [rsp+0], rax
+    mov rax, r12
+    mov rcx, [rsp+0]
+    add rsp, 16
+    mov [rax+40], rcx
+endfunc2:
+    add rsp, 24
+    pop r15
+    pop r14
+    pop r13
+    pop r12
+    pop rbx
+    pop rbp
+    ret
+__Grande_ctor_1:
+    push rbp
+    mov rbp, rsp
+    push rbx
+    push r12
+    push r13
+    push r14
+    push r15
+    sub rsp, 24
+tail5:
+    mov r12, rdi
+    mov r13, rsi
+    mov rax, r12
+    mov rcx, r13
+    mov [rax+176], rcx
+    mov rax, r13
+    shl rax, 1
+    sub rsp, 16
+    mov [rsp+0], rax
+    mov rax, r12
+    mov rcx, [rsp+0]
+    add rsp, 16
+    mov [rax+168], rcx
+endfunc4:
+    add rsp, 24
+    pop r15
+    pop r14
+    pop r13
+    pop r12
+    pop rbx
+    pop rbp
+    ret
+__Enorme_ctor_1:
+    push rbp
+    mov rbp, rsp
+    push rbx
+    push r12
+    push r13
+    push r14
+    push r15
+    sub rsp, 24
+tail7:
+    mov r12, rdi
+    mov r13, rsi
+    mov rax, r12
+    mov rcx, r13
+    mov [rax+336], rcx
+    mov rax, r13
+    imul rax, 3
+    sub rsp, 16
+    mov [rsp+0], rax
+    mov rax, r12
+    mov rcx, [rsp+0]
+    add rsp, 16
+    mov [rax+328], rcx
+endfunc6:
+    add rsp, 24
+    pop r15
+    pop r14
+    pop r13
+    pop r12
+    pop rbx
+    pop rbp
+    ret
+main:
+    push rbp
+    mov rbp, rsp
+    push rbx
+    push r12
+    push r13
+    push r14
+    push r15
+    sub rsp, 8
+    call aym_set_args
+    call aym_gc_stats_enable
+    sub rsp, 16
+    lea rdi, [rel __Chiqui_class_info]
+    call aym_object_new
+    mov [rsp+0], rax
+    mov rax, 0
+    mov rcx, [rsp+0]
+    mov [rcx+16], rax
+    sub rsp, 16
+    mov rax, -1
+    mov [rsp+0], rax
+    mov rsi, [rsp+0]
+    add rsp, 16
+    mov rdi, [rsp+0]
+    call __Chiqui_ctor_1
+    mov rax, [rsp+0]
+    add rsp, 16
+    mov [rel ultimo_c], rax
+    sub rsp, 16
+    lea rdi, [rel __Medio_class_info]
+    call aym_object_new
+    mov [rsp+0], rax
+    mov rax, 0
+    mov rcx, [rsp+0]
+    mov [rcx+16], rax
+    mov rax, 0
+    mov rcx, [rsp+0]
+    mov [rcx+24], rax
+    mov rax, 0
+    mov rcx, [rsp+0]
+    mov [rcx+32], rax
+    mov rax, 0
+    mov rcx, [rsp+0]
+    mov [rcx+40], rax
+    mov rax, 0
+    mov rcx, [rsp+0]
+    mov [rcx+48], rax
+    sub rsp, 16
+    mov rax, -1
+    mov [rsp+0], rax
+    mov rsi, [rsp+0]
+    add rsp, 16
+    mov rdi, [rsp+0]
+    call __Medio_ctor_1
+    mov rax, [rsp+0]
+    add rsp, 16
+    mov [rel ultimo_m], rax
+    sub rsp, 16
+    lea rdi, [rel __Grande_class_info]
+    call aym_object_new
+    mov [rsp+0], rax
+    mov rax, 0
+    mov rcx, [rsp+0]
+    mov [rcx+16], rax
+    mov rax, 1
+    mov rcx, [rsp+0]
+    mov [rcx+24], rax
+    mov rax, 2
+    mov rcx, [rsp+0]
+    mov [rcx+32], rax
+    mov rax, 3
+    mov rcx, [rsp+0]
+    mov [rcx+40], rax
+    mov rax, 4
+    mov rcx, [rsp+0]
+    mov [rcx+48], rax
+    mov rax, 5
+    mov rcx, [rsp+0]
+    mov [rcx+56], rax
+    mov rax, 6
+    mov rcx, [rsp+0]
+    mov [rcx+64], rax
+    mov rax, 7
+    mov rcx, [rsp+0]
+    mov [rcx+72], rax
+    mov rax, 8
+    mov rcx, [rsp+0]
+    mov [rcx+80], rax
+    mov rax, 9
+    mov rcx, [rsp+0]
+    mov [rcx+88], rax
+    mov rax, 10
+    mov rcx, [rsp+0]
+    mov [rcx+96], rax
+    mov rax, 11
+    mov rcx, [rsp+0]
+    mov [rcx+104], rax
+    mov rax, 12
+    mov rcx, [rsp+0]
+    mov [rcx+112], rax
+    mov rax, 13
+    mov rcx, [rsp+0]
+    mov [rcx+120], rax
+    mov rax, 14
+    mov rcx, [rsp+0]
+    mov [rcx+128], rax
+    mov rax, 15
+    mov rcx, [rsp+0]
+    mov [rcx+136], rax
+    mov rax, 16
+    mov rcx, [rsp+0]
+    mov [rcx+144], rax
+    mov rax, 17
+    mov rcx, [rsp+0]
+    mov [rcx+152], rax
+    mov rax, 18
+    mov rcx, [rsp+0]
+    mov [rcx+160], rax
+    mov rax, 19
+    mov rcx, [rsp+0]
+    mov [rcx+168], rax
+    mov rax, 0
+    mov rcx, [rsp+0]
+    mov [rcx+176], rax
+    sub rsp, 16
+    mov rax, -1
+    mov [rsp+0], rax
+    mov rsi, [rsp+0]
+    add rsp, 16
+    mov rdi, [rsp+0]
+    call __Grande_ctor_1
+    mov rax, [rsp+0]
+    add rsp, 16
+    mov [rel ultimo_g], rax
+    sub rsp, 16
+    lea rdi, [rel __Enorme_class_info]
+    call aym_object_new
+    mov [rsp+0], rax
+    mov rax, 0
+    mov rcx, [rsp+0]
+    mov [rcx+16], rax
+    mov rax, 1
+    mov rcx, [rsp+0]
+    mov [rcx+24], rax
+    mov rax, 2
+    mov rcx, [rsp+0]
+    mov [rcx+32], rax
+    mov rax, 3
+    mov rcx, [rsp+0]
+    mov [rcx+40], rax
+    mov rax, 4
+    mov rcx, [rsp+0]
+    mov [rcx+48], rax
+    mov rax, 5
+    mov rcx, [rsp+0]
+    mov [rcx+56], rax
+    mov rax, 6
+    mov rcx, [rsp+0]
+    mov [rcx+64], rax
+    mov rax, 7
+    mov rcx, [rsp+0]
+    mov [rcx+72], rax
+    mov rax, 8
+    mov rcx, [rsp+0]
+    mov [rcx+80], rax
+    mov rax, 9
+    mov rcx, [rsp+0]
+    mov [rcx+88], rax
+    mov rax, 10
+    mov rcx, [rsp+0]
+    mov [rcx+96], rax
+    mov rax, 11
+    mov rcx, [rsp+0]
+    mov [rcx+104], rax
+    mov rax, 12
+    mov rcx, [rsp+0]
+    mov [rcx+112], rax
+    mov rax, 13
+    mov rcx, [rsp+0]
+    mov [rcx+120], rax
+    mov rax, 14
+    mov rcx, [rsp+0]
+    mov [rcx+128], rax
+    mov rax, 15
+    mov rcx, [rsp+0]
+    mov [rcx+136], rax
+    mov rax, 16
+    mov rcx, [rsp+0]
+    mov [rcx+144], rax
+    mov rax, 17
+    mov rcx, [rsp+0]
+    mov [rcx+152], rax
+    mov rax, 18
+    mov rcx, [rsp+0]
+    mov [rcx+160], rax
+    mov rax, 19
+    mov rcx, [rsp+0]
+    mov [rcx+168], rax
+    mov rax, 0
+    mov rcx, [rsp+0]
+    mov [rcx+176], rax
+    mov rax, 1
+    mov rcx, [rsp+0]
+    mov [rcx+184], rax
+    mov rax, 2
+    mov rcx, [rsp+0]
+    mov [rcx+192], rax
+    mov rax, 3
+    mov rcx, [rsp+0]
+    mov [rcx+200], rax
+    mov rax, 4
+    mov rcx, [rsp+0]
+    mov [rcx+208], rax
+    mov rax, 5
+    mov rcx, [rsp+0]
+    mov [rcx+216], rax
+    mov rax, 6
+    mov rcx, [rsp+0]
+    mov [rcx+224], rax
+    mov rax, 7
+    mov rcx, [rsp+0]
+    mov [rcx+232], rax
+    mov rax, 8
+    mov rcx, [rsp+0]
+    mov [rcx+240], rax
+    mov rax, 9
+    mov rcx, [rsp+0]
+    mov [rcx+248], rax
+    mov rax, 10
+    mov rcx, [rsp+0]
+    mov [rcx+256], rax
+    mov rax, 11
+    mov rcx, [rsp+0]
+    mov [rcx+264], rax
+    mov rax, 12
+    mov rcx, [rsp+0]
+    mov [rcx+272], rax
+    mov rax, 13
+    mov rcx, [rsp+0]
+    mov [rcx+280], rax
+    mov rax, 14
+    mov rcx, [rsp+0]
+    mov [rcx+288], rax
+    mov rax, 15
+    mov rcx, [rsp+0]
+    mov [rcx+296], rax
+    mov rax, 16
+    mov rcx, [rsp+0]
+    mov [rcx+304], rax
+    mov rax, 17
+    mov rcx, [rsp+0]
+    mov [rcx+312], rax
+    mov rax, 18
+    mov rcx, [rsp+0]
+    mov [rcx+320], rax
+    mov rax, 19
+    mov rcx, [rsp+0]
+    mov [rcx+328], rax
+    mov rax, 0
+    mov rcx, [rsp+0]
+    mov [rcx+336], rax
+    sub rsp, 16
+    mov rax, -1
+    mov [rsp+0], rax
+    mov rsi, [rsp+0]
+    add rsp, 16
+    mov rdi, [rsp+0]
+    call __Enorme_ctor_1
+    mov rax, [rsp+0]
+    add rsp, 16
+    mov [rel ultimo_e], rax
+    sub rsp, 16
+    mov rdi, 0
+    call aym_map_new
+    mov [rsp+0], rax
+    mov rax, [rsp+0]
+    add rsp, 16
+    mov [rel m], rax
+    sub rsp, 16
+    mov rdi, 0
+    call aym_map_new
+    mov [rsp+0], rax
+    mov rax, [rsp+0]
+    add rsp, 16
+    mov [rel t], rax
+    mov rax, 0
+    mov [rel i], rax
+forloop9:
+    mov rax, [rel i]
+    cmp rax, 20000
+    setl al
+    movzx rax,al
+    cmp rax,0
+    je forend11
+    sub rsp, 16
+    lea rdi, [rel __Chiqui_class_info]
+    call aym_object_new
+    mov [rsp+0], rax
+    mov rax, 0
+    mov rcx, [rsp+0]
+    mov [rcx+16], rax
+    sub rsp, 16
+    mov rax, [rel i]
+    mov [rsp+0], rax
+    mov rsi, [rsp+0]
+    add rsp, 16
+    mov rdi, [rsp+0]
+    call __Chiqui_ctor_1
+    mov rax, [rsp+0]
+    add rsp, 16
+    mov [rel c], rax
+    sub rsp, 16
+    lea rdi, [rel __Medio_class_info]
+    call aym_object_new
+    mov [rsp+0], rax
+    mov rax, 0
+    mov rcx, [rsp+0]
+    mov [rcx+16], rax
+    mov rax, 0
+    mov rcx, [rsp+0]
+    mov [rcx+24], rax
+    mov rax, 0
+    mov rcx, [rsp+0]
+    mov [rcx+32], rax
+    mov rax, 0
+    mov rcx, [rsp+0]
+    mov [rcx+40], rax
+    mov rax, 0
+    mov rcx, [rsp+0]
+    mov [rcx+48], rax
+    sub rsp, 16
+    mov rax, [rel i]
+    mov [rsp+0], rax
+    mov rsi, [rsp+0]
+    add rsp, 16
+    mov rdi, [rsp+0]
+    call __Medio_ctor_1
+    mov rax, [rsp+0]
+    add rsp, 16
+    mov [rel md], rax
+    sub rsp, 16
+    lea rdi, [rel __Grande_class_info]
+    call aym_object_new
+    mov [rsp+0], rax
+    mov rax, 0
+    mov rcx, [rsp+0]
+    mov [rcx+16], rax
+    mov rax, 1
+    mov rcx, [rsp+0]
+    mov [rcx+24], rax
+    mov rax, 2
+    mov rcx, [rsp+0]
+    mov [rcx+32], rax
+    mov rax, 3
+    mov rcx, [rsp+0]
+    mov [rcx+40], rax
+    mov rax, 4
+    mov rcx, [rsp+0]
+    mov [rcx+48], rax
+    mov rax, 5
+    mov rcx, [rsp+0]
+    mov [rcx+56], rax
+    mov rax, 6
+    mov rcx, [rsp+0]
+    mov [rcx+64], rax
+    mov rax, 7
+    mov rcx, [rsp+0]
+    mov [rcx+72], rax
+    mov rax, 8
+    mov rcx, [rsp+0]
+    mov [rcx+80], rax
+    mov rax, 9
+    mov rcx, [rsp+0]
+    mov [rcx+88], rax
+    mov rax, 10
+    mov rcx, [rsp+0]
+    mov [rcx+96], rax
+    mov rax, 11
+    mov rcx, [rsp+0]
+    mov [rcx+104], rax
+    mov rax, 12
+    mov rcx, [rsp+0]
+    mov [rcx+112], rax
+    mov rax, 13
+    mov rcx, [rsp+0]
+    mov [rcx+120], rax
+    mov rax, 14
+    mov rcx, [rsp+0]
+    mov [rcx+128], rax
+    mov rax, 15
+    mov rcx, [rsp+0]
+    mov [rcx+136], rax
+    mov rax, 16
+    mov rcx, [rsp+0]
+    mov [rcx+144], rax
+    mov rax, 17
+    mov rcx, [rsp+0]
+    mov [rcx+152], rax
+    mov rax, 18
+    mov rcx, [rsp+0]
+    mov [rcx+160], rax
+    mov rax, 19
+    mov rcx, [rsp+0]
+    mov [rcx+168], rax
+    mov rax, 0
+    mov rcx, [rsp+0]
+    mov [rcx+176], rax
+    sub rsp, 16
+    mov rax, [rel i]
+    mov [rsp+0], rax
+    mov rsi, [rsp+0]
+    add rsp, 16
+    mov rdi, [rsp+0]
+    call __Grande_ctor_1
+    mov rax, [rsp+0]
+    add rsp, 16
+    mov [rel g], rax
+    sub rsp, 16
+    lea rdi, [rel __Enorme_class_info]
+    call aym_object_new
+    mov [rsp+0], rax
+    mov rax, 0
+    mov rcx, [rsp+0]
+    mov [rcx+16], rax
+    mov rax, 1
+    mov rcx, [rsp+0]
+    mov [rcx+24], rax
+    mov rax, 2
+    mov rcx, [rsp+0]
+    mov [rcx+32], rax
+    mov rax, 3
+    mov rcx, [rsp+0]
+    mov [rcx+40], rax
+    mov rax, 4
+    mov rcx, [rsp+0]
+    mov [rcx+48], rax
+    mov rax, 5
+    mov rcx, [rsp+0]
+    mov [rcx+56], rax
+    mov rax, 6
+    mov rcx, [rsp+0]
+    mov [rcx+64], rax
+    mov rax, 7
+    mov rcx, [rsp+0]
+    mov [rcx+72], rax
+    mov rax, 8
+    mov rcx, [rsp+0]
+    mov [rcx+80], rax
+    mov rax, 9
+    mov rcx, [rsp+0]
+    mov [rcx+88], rax
+    mov rax, 10
+    mov rcx, [rsp+0]
+    mov [rcx+96], rax
+    mov rax, 11
+    mov rcx, [rsp+0]
+    mov [rcx+104], rax
+    mov rax, 12
+    mov rcx, [rsp+0]
+    mov [rcx+112], rax
+    mov rax, 13
+    mov rcx, [rsp+0]
+    mov [rcx+120], rax
+    mov rax, 14
+    mov rcx, [rsp+0]
+    mov [rcx+128], rax
+    mov rax, 15
+    mov rcx, [rsp+0]
+    mov [rcx+136], rax
+    mov rax, 16
+    mov rcx, [rsp+0]
+    mov [rcx+144], rax
+    mov rax, 17
+    mov rcx, [rsp+0]
+    mov [rcx+152], rax
+    mov rax, 18
+    mov rcx, [rsp+0]
+    mov [rcx+160], rax
+    mov rax, 19
+    mov rcx, [rsp+0]
+    mov [rcx+168], rax
+    mov rax, 0
+    mov rcx, [rsp+0]
+    mov [rcx+176], rax
+    mov rax, 1
+    mov rcx, [rsp+0]
+    mov [rcx+184], rax
+    mov rax, 2
+    mov rcx, [rsp+0]
+    mov [rcx+192], rax
+    mov rax, 3
+    mov rcx, [rsp+0]
+    mov [rcx+200], rax
+    mov rax, 4
+    mov rcx, [rsp+0]
+    mov [rcx+208], rax
+    mov rax, 5
+    mov rcx, [rsp+0]
+    mov [rcx+216], rax
+    mov rax, 6
+    mov rcx, [rsp+0]
+    mov [rcx+224], rax
+    mov rax, 7
+    mov rcx, [rsp+0]
+    mov [rcx+232], rax
+    mov rax, 8
+    mov rcx, [rsp+0]
+    mov [rcx+240], rax
+    mov rax, 9
+    mov rcx, [rsp+0]
+    mov [rcx+248], rax
+    mov rax, 10
+    mov rcx, [rsp+0]
+    mov [rcx+256], rax
+    mov rax, 11
+    mov rcx, [rsp+0]
+    mov [rcx+264], rax
+    mov rax, 12
+    mov rcx, [rsp+0]
+    mov [rcx+272], rax
+    mov rax, 13
+    mov rcx, [rsp+0]
+    mov [rcx+280], rax
+    mov rax, 14
+    mov rcx, [rsp+0]
+    mov [rcx+288], rax
+    mov rax, 15
+    mov rcx, [rsp+0]
+    mov [rcx+296], rax
+    mov rax, 16
+    mov rcx, [rsp+0]
+    mov [rcx+304], rax
+    mov rax, 17
+    mov rcx, [rsp+0]
+    mov [rcx+312], rax
+    mov rax, 18
+    mov rcx, [rsp+0]
+    mov [rcx+320], rax
+    mov rax, 19
+    mov rcx, [rsp+0]
+    mov [rcx+328], rax
+    mov rax, 0
+    mov rcx, [rsp+0]
+    mov [rcx+336], rax
+    sub rsp, 16
+    mov rax, [rel i]
+    mov [rsp+0], rax
+    mov rsi, [rsp+0]
+    add rsp, 16
+    mov rdi, [rsp+0]
+    call __Enorme_ctor_1
+    mov rax, [rsp+0]
+    add rsp, 16
+    mov [rel e], rax
+    sub rsp, 16
+    mov rdi, 3
+    call aym_array_new
+    mov [rsp+0], rax
+    mov rax, [rel i]
+    mov rdx, rax
+    mov rsi, 0
+    mov rdi, [rsp+0]
+    call aym_array_set
+    mov rax, [rel i]
+    add rax, 1
+    mov rdx, rax
+    mov rsi, 1
+    mov rdi, [rsp+0]
+    call aym_array_set
+    mov rax, [rel i]
+    add rax, 2
+    mov rdx, rax
+    mov rsi, 2
+    mov rdi, [rsp+0]
+    call aym_array_set
+    mov rax, [rsp+0]
+    add rsp, 16
+    mov [rel basura], rax
+    sub rsp, 16
+    mov rdi, 1
+    call aym_map_new
+    mov [rsp+0], rax
+    lea rax, [rel str4]
+    mov [rsp+8], rax
+    mov rax, [rel i]
+    mov rcx, 0
+    mov rdx, rax
+    mov rsi, [rsp+8]
+    mov rdi, [rsp+0]
+    call aym_map_set
+    mov rax, [rsp+0]
+    add rsp, 16
+    mov [rel mb], rax
+    mov rax, [rel i]
+    mov rcx, rax
+    mov rax, 2361183241434822607
+    imul rcx
+    sar rdx, 7
+    mov rax, rdx
+    shr rax, 63
+    add rdx, rax
+    mov rax, 1000
+    imul rdx, rax
+    mov rax, rcx
+    sub rax, rdx
+    cmp rax, 0
+    sete al
+    movzx rax,al
+    cmp rax,0
+    je endif13
+    mov rax, [rel c]
+    test rax, rax
+    jnz obj_ok14
+    mov rdi, rax
+    lea rsi, [rel str5]
+    call aym_object_get
+obj_ok14:
+    mov rcx, [rel ultimo_c]
+    mov [rax+24], rcx
+    mov rax, [rel c]
+    mov [rel ultimo_c], rax
+    mov rax, [rel md]
+    test rax, rax
+    jnz obj_ok15
+    mov rdi, rax
+    lea rsi, [rel str5]
+    call aym_object_get
+obj_ok15:
+    mov rcx, [rel ultimo_m]
+    mov [rax+56], rcx
+    mov rax, [rel md]
+    mov [rel ultimo_m], rax
+    mov rax, [rel g]
+    test rax, rax
+    jnz obj_ok16
+    mov rdi, rax
+    lea rsi, [rel str5]
+    call aym_object_get
+obj_ok16:
+    mov rcx, [rel ultimo_g]
+    mov [rax+184], rcx
+    mov rax, [rel g]
+    mov [rel ultimo_g], rax
+    mov rax, [rel e]
+    test rax, rax
+    jnz obj_ok17
+    mov rdi, rax
+    lea rsi, [rel str5]
+    call aym_object_get
+obj_ok17:
+    mov rcx, [rel ultimo_e]
+    mov [rax+344], rcx
+    mov rax, [rel e]
+    mov [rel ultimo_e], rax
+endif13:
+    mov rax, [rel i]
+    mov rdx, rax
+    sar rdx, 63
+    shr rdx, 62
+    lea rcx, [rax+rdx]
+    sar rcx, 2
+    shl rcx, 2
+    sub rax, rcx
+    cmp rax, 0
+    sete al
+    movzx rax,al
+    cmp rax,0
+    je endif19
+    sub rsp, 16
+    mov rax, [rel i]
+    imul rax, 7
+    mov r8, rax
+    mov rax, [rel c]
+    test rax, rax
+    jnz obj_ok20
+    mov rdi, rax
+    lea rsi, [rel str0]
+    call aym_object_get
+obj_ok20:
+    mov rax, [rax+16]
+    mov rbx, rax
+    mov rax, r8
+    add rax, rbx
+    mov r8, rax
+    mov rax, [rel md]
+    test rax, rax
+    jnz obj_ok21
+    mov rdi, rax
+    lea rsi, [rel str1]
+    call aym_object_get
+obj_ok21:
+    mov rax, [rax+40]
+    mov rbx, rax
+    mov rax, r8
+    sub rax, rbx
+    mov r8, rax
+    mov rax, [rel g]
+    test rax, rax
+    jnz obj_ok22
+    mov rdi, rax
+    lea rsi, [rel str2]
+    call aym_object_get
+obj_ok22:
+    mov rax, [rax+168]
+    mov rbx, rax
+    mov rax, r8
+    add rax, rbx
+    mov r8, rax
+    mov rax, [rel e]
+    test rax, rax
+    jnz obj_ok23
+    mov rdi, rax
+    lea rsi, [rel str3]
+    call aym_object_get
+obj_ok23:
+    mov rax, [rax+328]
+    mov rbx, rax
+    mov rax, r8
+    sub rax, rbx
+    push rax
+    sub rsp, 8
+    mov rax, 2
+    mov rsi, rax
+    mov rax, [rel basura]
+    mov rdi, rax
+    test rdi, rdi
+    jz arrget_slow24
+    cmp rsi, [rdi+0]
+    jae arrget_slow24
+    mov rax, [rdi+16]
+    mov rax, [rax+rsi*8]
+    jmp arrget_done25
+arrget_slow24:
+    call aym_array_get
+arrget_done25:
+    add rsp, 8
+    mov rbx, rax
+    pop rax
+    add rax, rbx
+    push rax
+    sub rsp, 8
+    lea rax, [rel str4]
+    mov rsi, rax
+    mov rax, [rel mb]
+    mov rdi, rax
+    call aym_map_get
+    add rsp, 8
+    mov rbx, rax
+    pop rax
+    sub rax, rbx
+    sub rax, 1
+    mov [rsp+0], rax
+    mov rax, [rel i]
+    mov [rsp+8], rax
+    mov rax, [rel m]
+    mov rdi, rax
+    mov rsi, [rsp+8]
+    mov rdx, [rsp+0]
+    add rsp, 16
+    mov rcx, 0
+    call aym_imap_set
+    sub rsp, 16
+    mov rax, [rel i]
+    add rax, 1
+    mov [rsp+0], rax
+    sub rsp, 32
+    lea rax, [rel str6]
+    mov qword [rsp+0], 0
+    mov [rsp+8], rax
+    mov rax, [rel i]
+    mov qword [rsp+16], 1
+    mov [rsp+24], rax
+    lea rdi, [rsp+0]
+    mov rsi, 2
+    call aym_str_build
+    add rsp, 32
+    mov [rsp+8], rax
+    mov rax, [rel t]
+    mov rdi, rax
+    mov rsi, [rsp+8]
+    mov rdx, [rsp+0]
+    add rsp, 16
+    mov rcx, 0
+    call aym_map_set
+endif19:
+forcont10:
+    mov rax, [rel i]
+    add rax, 1
+    mov [rel i], rax
+    jmp forloop9
+forend11:
+    mov rax, 0
+    mov [rel malos], rax
+    mov rax, 0
+    mov [rel i], rax
+forloop26:
+    mov rax, [rel i]
+    cmp rax, 20000
+    setl al
+    movzx rax,al
+    cmp rax,0
+    je forend28
+    mov rax, [rel i]
+    mov rsi, rax
+    mov rax, [rel m]
+    mov rdi, rax
+    call aym_imap_get
+    mov r8, rax
+    mov rax, [rel i]
+    imul rax, 6
+    mov rbx, rax
+    mov rax, r8
+    cmp rax, rbx
+    setne al
+    movzx rax,al
+    cmp rax,0
+    je endif30
+    mov rax, [rel malos]
+    add rax, 1
+    mov [rel malos], rax
+endif30:
+    sub rsp, 32
+    lea rax, [rel str6]
+    mov qword [rsp+0], 0
+    mov [rsp+8], rax
+    mov rax, [rel i]
+    mov qword [rsp+16], 1
+    mov [rsp+24], rax
+    lea rdi, [rsp+0]
+    mov rsi, 2
+    call aym_str_build
+    add rsp, 32
+    mov rsi, rax
+    mov rax, [rel t]
+    mov rdi, rax
+    call aym_map_get
+    mov r8, rax
+    mov rax, [rel i]
+    add rax, 1
+    mov rbx, rax
+    mov rax, r8
+    cmp rax, rbx
+    setne al
+    movzx rax,al
+    cmp rax,0
+    je endif32
+    mov rax, [rel malos]
+    add rax, 1
+    mov [rel malos], rax
+endif32:
+forcont27:
+    mov rax, [rel i]
+    add rax, 4
+    mov [rel i], rax
+    jmp forloop26
+forend28:
+    mov rax, 19
+    mov [rel k], rax
+forloop33:
+    mov rax, [rel k]
+    cmp rax, 0
+    setge al
+    movzx rax,al
+    cmp rax,0
+    je forend35
+    mov rax, [rel k]
+    imul rax, 1000
+    mov [rel n], rax
+    mov rax, [rel ultimo_c]
+    test rax, rax
+    jnz obj_ok44
+    mov rdi, rax
+    lea rsi, [rel str0]
+    call aym_object_get
+obj_ok44:
+    mov rax, [rax+16]
+    cmp rax, [rel n]
+    setne al
+    movzx rax,al
+    cmp rax,0
+    jne or_true42
+    mov rax, [rel ultimo_m]
+    test rax, rax
+    jnz obj_ok45
+    mov rdi, rax
+    lea rsi, [rel str0]
+    call aym_object_get
+obj_ok45:
+    mov rax, [rax+48]
+    cmp rax, [rel n]
+    setne al
+    movzx rax,al
+    cmp rax,0
+    setne al
+    movzx rax,al
+    jmp or_end43
+or_true42:
+    mov rax,1
+or_end43:
+    cmp rax,0
+    jne or_true40
+    mov rax, [rel ultimo_m]
+    test rax, rax
+    jnz obj_ok46
+    mov rdi, rax
+    lea rsi, [rel str1]
+    call aym_object_get
+obj_ok46:
+    mov rax, [rax+40]
+    mov r8, rax
+    mov rax, [rel n]
+    add rax, 1
+    mov rbx, rax
+    mov rax, r8
+    cmp rax, rbx
+    setne al
+    movzx rax,al
+    cmp rax,0
+    setne al
+    movzx rax,al
+    jmp or_end41
+or_true40:
+    mov rax,1
+or_end41:
+    cmp rax,0
+    jne or_true38
+    mov rax, [rel ultimo_m]
+    test rax, rax
+    jnz obj_ok47
+    mov rdi, rax
+    lea rsi, [rel str4]
+    call aym_object_get
+obj_ok47:
+    mov rax, [rax+16]
+    cmp rax, 0
+    setne al
+    movzx rax,al
+    cmp rax,0
+    setne al
+    movzx rax,al
+    jmp or_end39
+or_true38:
+    mov rax,1
+or_end39:
+    cmp rax,0
+    je endif37
+    mov rax, [rel malos]
+    add rax, 1
+    mov [rel malos], rax
+endif37:
+    mov rax, [rel ultimo_g]
+    test rax, rax
+    jnz obj_ok54
+    mov rdi, rax
+    lea rsi, [rel str0]
+    call aym_object_get
+obj_ok54:
+    mov rax, [rax+176]
+    cmp rax, [rel n]
+    setne al
+    movzx rax,al
+    cmp rax,0
+    jne or_true52
+    mov rax, [rel ultimo_g]
+    test rax, rax
+    jnz obj_ok55
+    mov rdi, rax
+    lea rsi, [rel str2]
+    call aym_object_get
+obj_ok55:
+    mov rax, [rax+168]
+    mov r8, rax
+    mov rax, [rel n]
+    shl rax, 1
+    mov rbx, rax
+    mov rax, r8
+    cmp rax, rbx
+    setne al
+    movzx rax,al
+    cmp rax,0
+    setne al
+    movzx rax,al
+    jmp or_end53
+or_true52:
+    mov rax,1
+or_end53:
+    cmp rax,0
+    jne or_true50
+    mov rax, [rel ultimo_g]
+    test rax, rax
+    jnz obj_ok56
+    mov rdi, rax
+    lea rsi, [rel str7]
+    call aym_object_get
+obj_ok56:
+    mov rax, [rax+40]
+    cmp rax, 3
+    setne al
+    movzx rax,al
+    cmp rax,0
+    setne al
+    movzx rax,al
+    jmp or_end51
+or_true50:
+    mov rax,1
+or_end51:
+    cmp rax,0
+    je endif49
+    mov rax, [rel malos]
+    add rax, 1
+    mov [rel malos], rax
+endif49:
+    mov rax, [rel ultimo_e]
+    test rax, rax
+    jnz obj_ok63
+    mov rdi, rax
+    lea rsi, [rel str0]
+    call aym_object_get
+obj_ok63:
+    mov rax, [rax+336]
+    cmp rax, [rel n]
+    setne al
+    movzx rax,al
+    cmp rax,0
+    jne or_true61
+    mov rax, [rel ultimo_e]
+    test rax, rax
+    jnz obj_ok64
+    mov rdi, rax
+    lea rsi, [rel str3]
+    call aym_object_get
+obj_ok64:
+    mov rax, [rax+328]
+    mov r8, rax
+    mov rax, [rel n]
+    imul rax, 3
+    mov rbx, rax
+    mov rax, r8
+    cmp rax, rbx
+    setne al
+    movzx rax,al
+    cmp rax,0
+    setne al
+    movzx rax,al
+    jmp or_end62
+or_true61:
+    mov rax,1
+or_end62:
+    cmp rax,0
+    jne or_true59
+    mov rax, [rel ultimo_e]
+    test rax, rax
+    jnz obj_ok65
+    mov rdi, rax
+    lea rsi, [rel str8]
+    call aym_object_get
+obj_ok65:
+    mov rax, [rax+56]
+    cmp rax, 5
+    setne al
+    movzx rax,al
+    cmp rax,0
+    setne al
+    movzx rax,al
+    jmp or_end60
+or_true59:
+    mov rax,1
+or_end60:
+    cmp rax,0
+    je endif58
+    mov rax, [rel malos]
+    add rax, 1
+    mov [rel malos], rax
+endif58:
+    mov rax, [rel ultimo_c]
+    test rax, rax
+    jnz obj_ok66
+    mov rdi, rax
+    lea rsi, [rel str5]
+    call aym_object_get
+obj_ok66:
+    mov rax, [rax+24]
+    mov [rel ultimo_c], rax
+    mov rax, [rel ultimo_m]
+    test rax, rax
+    jnz obj_ok67
+    mov rdi, rax
+    lea rsi, [rel str5]
+    call aym_object_get
+obj_ok67:
+    mov rax, [rax+56]
+    mov [rel ultimo_m], rax
+    mov rax, [rel ultimo_g]
+    test rax, rax
+    jnz obj_ok68
+    mov rdi, rax
+    lea rsi, [rel str5]
+    call aym_object_get
+obj_ok68:
+    mov rax, [rax+184]
+    mov [rel ultimo_g], rax
+    mov rax, [rel ultimo_e]
+    test rax, rax
+    jnz obj_ok69
+    mov rdi, rax
+    lea rsi, [rel str5]
+    call aym_object_get
+obj_ok69:
+    mov rax, [rax+344]
+    mov [rel ultimo_e], rax
+forcont34:
+    mov rax, [rel k]
+    sub rax, 1
+    mov [rel k], rax
+    jmp forloop33
+forend35:
+    mov rax, [rel m]
+    mov rdi, rax
+    call aym_map_size
+    mov rdi, rax
+    call aym_write_int
+    lea rdi, [rel print_sep]
+    call aym_write_str
+    mov rax, [rel t]
+    mov rdi, rax
+    call aym_map_size
+    mov rdi, rax
+    call aym_write_int
+    lea rdi, [rel print_sep]
+    call aym_write_str
+    mov rax, [rel ultimo_c]
+    test rax, rax
+    jnz obj_ok70
+    mov rdi, rax
+    lea rsi, [rel str0]
+    call aym_object_get
+obj_ok70:
+    mov rax, [rax+16]
+    mov r8, rax
+    mov rax, [rel ultimo_e]
+    test rax, rax
+    jnz obj_ok71
+    mov rdi, rax
+    lea rsi, [rel str0]
+    call aym_object_get
+obj_ok71:
+    mov rax, [rax+336]
+    mov rbx, rax
+    mov rax, r8
+    add rax, rbx
+    mov rdi, rax
+    call aym_write_int
+    lea rdi, [rel print_sep]
+    call aym_write_str
+    mov rax, [rel malos]
+    mov rdi, rax
+    call aym_write_int
+    lea rdi, [rel print_term]
+    call aym_write_str
+endmain8:
+    add rsp, 8
+    pop r15
+    pop r14
+    pop r13
+    pop r12
+    pop rbx
+    pop rbp
+    mov eax,0
+    ret
+section .note.GNU-stack noalloc noexec nowrite progbits
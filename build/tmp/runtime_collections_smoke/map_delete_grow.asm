@@ -0,0 +1,612 @@
+extern aym_write_str
+extern aym_write_int
+extern aym_write_flush
+extern scanf
+extern aym_random
+extern aym_srand
+extern aym_sleep
+extern aym_term_clear
+extern aym_term_move
+extern aym_term_color
+extern aym_term_reset
+extern aym_term_cursor
+extern aym_key_poll
+extern aym_time_ms
+extern aym_gfx_open
+extern aym_gfx_is_open
+extern aym_gfx_clear
+extern aym_gfx_set_color
+extern aym_gfx_rect4
+extern aym_gfx_rect
+extern aym_gfx_text3
+extern aym_gfx_text
+extern aym_gfx_present
+extern aym_gfx_close
+extern aym_gfx_key_down
+extern aym_set_args
+extern aym_gc_stats_enable
+extern aym_argc
+extern aym_argv_get
+extern aym_assert
+extern aym_hof_map
+extern aym_hof_filter
+extern aym_hof_reduce
+extern aym_hof_pipeline
+extern aym_hof_map_par
+extern aym_hof_filter_par
+extern aym_hof_reduce_par
+extern aym_fs_read_text
+extern aym_fs_write_text
+extern aym_fs_exists
+extern aym_array_new
+extern aym_array_get
+extern aym_array_set
+extern aym_array_free
+extern aym_array_length
+extern aym_array_push
+extern aym_array_pop
+extern aym_array_remove_at
+extern aym_array_contains_int
+extern aym_array_contains_str
+extern aym_array_find_int
+extern aym_array_find_str
+extern aym_array_sort_int
+extern aym_array_sort_str
+extern aym_array_sort_by
+extern aym_array_unique_int
+extern aym_array_unique_str
+extern aym_set_new
+extern aym_set_from_array
+extern aym_set_add
+extern aym_set_contains
+extern aym_set_remove
+extern aym_set_size
+extern aym_set_items
+extern aym_set_is_string
+extern aym_deque_new
+extern aym_deque_from_array
+extern aym_deque_push_back
+extern aym_deque_push_front
+extern aym_deque_pop_back
+extern aym_deque_pop_front
+extern aym_deque_size
+extern aym_deque_items
+extern aym_deque_is_string
+extern aym_heap_new
+extern aym_heap_from_array
+extern aym_heap_push
+extern aym_heap_pop
+extern aym_heap_peek
+extern aym_heap_size
+extern aym_heap_items
+extern aym_heap_is_string
+extern aym_map_new
+extern aym_map_init_stack
+extern aym_map_set
+extern aym_map_get
+extern aym_map_get_default
+extern aym_map_contains
+extern aym_map_size
+extern aym_map_keys
+extern aym_map_values
+extern aym_map_delete
+extern aym_map_key_at
+extern aym_map_value_at
+extern aym_map_value_is_string
+extern aym_map_value_is_string_key
+extern aym_imap_set
+extern aym_imap_get
+extern aym_imap_get_default
+extern aym_imap_contains
+extern aym_imap_delete
+extern aym_imap_value_is_string_key
+extern aym_object_new
+extern aym_object_get
+extern aym_object_set
+extern aym_object_method
+extern aym_object_to_map
+extern aym_str_concat
+extern aym_str_build
+extern aym_str_eq
+extern aym_str_from_c
+extern aym_str_scratch_mark
+extern aym_str_scratch_release
+extern aym_str_trim
+extern aym_str_split
+extern aym_str_join
+extern aym_str_replace
+extern aym_str_contains
+extern aym_to_string
+extern aym_to_number
+extern aym_sin
+extern aym_cos
+extern aym_tan
+extern aym_asin
+extern aym_acos
+extern aym_atan
+extern aym_sqrt
+extern aym_pow
+extern aym_exp
+extern aym_log
+extern aym_log10
+extern aym_floor
+extern aym_ceil
+extern aym_round
+extern aym_fabs
+extern aym_handler_top
+extern aym_throw
+extern aym_exception_new
+extern aym_exception_type
+extern aym_exception_message
+section .data
+fmt_read_int: db "%ld",0
+fmt_read_str: db "%255s",0
+input_val: dq 0
+input_buf: times 256 db 0
+align 8
+    dq 0x44bd4bd473cd2df9, 1, 1
+print_sep: db 32, 0
+align 8
+    dq 0x44bd31d473cd01cb, 1, 1
+print_term: db 10, 0
+align 8
+    dq 0x44bd80d473cd8808, 1, 1
+list_open: db 91, 0
+align 8
+    dq 0x9afebb00c5c7fa67, 2, 2
+list_sep: db 44, 32, 0
+align 8
+    dq 0x44bd86d473cd923a, 1, 1
+list_close: db 93, 0
+align 8
+    dq 0x44bd49d473cd2a93, 1, 1
+list_quote: db 34, 0
+align 8
+    dq 0x44bda0d473cdbe68, 1, 1
+map_open: db 123, 0
+align 8
+    dq 0x9afebb00c5c7fa67, 2, 2
+map_sep: db 44, 32, 0
+align 8
+    dq 0x44bda6d473cdc89a, 1, 1
+map_close: db 125, 0
+align 8
+    dq 0x9b20b700c5e4da01, 2, 2
+map_colon: db 58, 32, 0
+align 8
+    dq 0xbd0cbb81044f3315, 5, 5
+bool_true: db 99, 104, 105, 113, 97, 0
+align 8
+    dq 0xe31a02b86357a2f1, 5, 5
+bool_false: db 107, 39, 97, 114, 105, 0
+align 8
+    dq 0x44bd90d473cda338, 1, 1
+str0: db 107, 0
+align 8
+    dq 0x9bc02400c66c0bb1, 2, 2
+str1: db 107, 51, 0
+align 8
+    dq 0x9bc02100c66c0698, 2, 2
+str2: db 107, 48, 0
+align 8
+    dq 0x9bc02200c66c084b, 2, 2
+str3: db 107, 49, 0
+align 8
+    dq 0x44bd95d473cdabb7, 1, 1
+str4: db 110, 0
+align 8
+    dq 0x9bc02700c66c10ca, 2, 2
+str5: db 107, 54, 0
+i: dq 0
+m: dq 0
+ks: dq 0
+suma: dq 0
+primero: dq 0
+borrado: dq 0
+vuelto: dq 0
+ultimo: dq 0
+section .text
+global main
+main:
+    push rbp
+    mov rbp, rsp
+    push rbx
+    push r12
+    push r13
+    push r14
+    push r15
+    sub rsp, 8
+    call aym_set_args
+    sub rsp, 16
+    mov rdi, 0
+    call aym_map_new
+    mov [rsp+0], rax
+    mov rax, [rsp+0]
+    add rsp, 16
+    mov [rel m], rax
+    mov rax, 0
+    mov [rel i], rax
+forloop1:
+    mov rax, [rel i]
+    cmp rax, 200
+    setl al
+    movzx rax,al
+    cmp rax,0
+    je forend3
+    sub rsp, 16
+    mov rax, [rel i]
+    mov [rsp+0], rax
+    sub rsp, 32
+    lea rax, [rel str0]
+    mov qword [rsp+0], 0
+    mov [rsp+8], rax
+    mov rax, [rel i]
+    mov qword [rsp+16], 1
+    mov [rsp+24], rax
+    lea rdi, [rsp+0]
+    mov rsi, 2
+    call aym_str_build
+    add rsp, 32
+    mov [rsp+8], rax
+    mov rax, [rel m]
+    mov rdi, rax
+    mov rsi, [rsp+8]
+    mov rdx, [rsp+0]
+    add rsp, 16
+    mov rcx, 0
+    call aym_map_set
+forcont2:
+    mov rax, [rel i]
+    add rax, 1
+    mov [rel i], rax
+    jmp forloop1
+forend3:
+    mov rax, 0
+    mov [rel i], rax
+forloop4:
+    mov rax, [rel i]
+    cmp rax, 200
+    setl al
+    movzx rax,al
+    cmp rax,0
+    je forend6
+    sub rsp, 16
+    mov rax, [rel m]
+    mov [rsp+0], rax
+    sub rsp, 32
+    lea rax, [rel str0]
+    mov qword [rsp+0], 0
+    mov [rsp+8], rax
+    mov rax, [rel i]
+    mov qword [rsp+16], 1
+    mov [rsp+24], rax
+    lea rdi, [rsp+0]
+    mov rsi, 2
+    call aym_str_build
+    add rsp, 32
+    mov [rsp+8], rax
+    mov rdi, [rsp+0]
+    mov rsi, [rsp+8]
+    add rsp, 16
+    call aym_map_delete
+forcont5:
+    mov rax, [rel i]
+    add rax, 3
+    mov [rel i], rax
+    jmp forloop4
+forend6:
+    sub rsp, 16
+    mov rax, 1003
+    mov [rsp+0], rax
+    lea rax, [rel str1]
+    mov [rsp+8], rax
+    mov rax, [rel m]
+    mov rdi, rax
+    mov rsi, [rsp+8]
+    mov rdx, [rsp+0]
+    add rsp, 16
+    mov rcx, 0
+    call aym_map_set
+    sub rsp, 16
+    mov rax, 1000
+    mov [rsp+0], rax
+    lea rax, [rel str2]
+    mov [rsp+8], rax
+    mov rax, [rel m]
+    mov rdi, rax
+    mov rsi, [rsp+8]
+    mov rdx, [rsp+0]
+    add rsp, 16
+    mov rcx, 0
+    call aym_map_set
+    sub rsp, 16
+    mov rax, 1001
+    mov [rsp+0], rax
+    lea rax, [rel str3]
+    mov [rsp+8], rax
+    mov rax, [rel m]
+    mov rdi, rax
+    mov rsi, [rsp+8]
+    mov rdx, [rsp+0]
+    add rsp, 16
+    mov rcx, 0
+    call aym_map_set
+    mov rax, 0
+    mov [rel i], rax
+forloop7:
+    mov rax, [rel i]
+    cmp rax, 100
+    setl al
+    movzx rax,al
+    cmp rax,0
+    je forend9
+    sub rsp, 16
+    mov rax, 500
+    add rax, [rel i]
+    mov [rsp+0], rax
+    sub rsp, 32
+    lea rax, [rel str4]
+    mov qword [rsp+0], 0
+    mov [rsp+8], rax
+    mov rax, [rel i]
+    mov qword [rsp+16], 1
+    mov [rsp+24], rax
+    lea rdi, [rsp+0]
+    mov rsi, 2
+    call aym_str_build
+    add rsp, 32
+    mov [rsp+8], rax
+    mov rax, [rel m]
+    mov rdi, rax
+    mov rsi, [rsp+8]
+    mov rdx, [rsp+0]
+    add rsp, 16
+    mov rcx, 0
+    call aym_map_set
+forcont8:
+    mov rax, [rel i]
+    add rax, 1
+    mov [rel i], rax
+    jmp forloop7
+forend9:
+    mov rax, [rel m]
+    mov rdi, rax
+    call aym_map_keys
+    mov [rel ks], rax
+    mov rax, 0
+    mov [rel suma], rax
+    mov rax, 0
+    mov [rel i], rax
+forloop10:
+    mov rax, [rel i]
+    mov r8, rax
+    mov rax, [rel ks]
+    test rax, rax
+    jz arrlen_done13
+    mov rax, [rax+0]
+arrlen_done13:
+    mov rbx, rax
+    mov rax, r8
+    cmp rax, rbx
+    setl al
+    movzx rax,al
+    cmp rax,0
+    je forend12
+    mov rax, [rel suma]
+    imul rax, 31
+    push rax
+    sub rsp, 8
+    mov rax, [rel ks]
+    mov rax, [rax+16]
+    mov rcx, [rel i]
+    mov rax, [rax+rcx*8]
+    mov rsi, rax
+    mov rax, [rel m]
+    mov rdi, rax
+    call aym_map_get
+    mov r8, rax
+    mov rax, [rel i]
+    add rax, 1
+    mov rbx, rax
+    mov rax, r8
+    imul rax, rbx
+    add rsp, 8
+    mov rbx, rax
+    pop rax
+    add rax, rbx
+    mov rcx, rax
+    mov rax, -8543223828751151131
+    imul rcx
+    add rdx, rcx
+    sar rdx, 29
+    mov rax, rdx
+    shr rax, 63
+    add rdx, rax
+    mov rax, 1000000007
+    imul rdx, rax
+    mov rax, rcx
+    sub rax, rdx
+    mov [rel suma], rax
+forcont11:
+    mov rax, [rel i]
+    add rax, 1
+    mov [rel i], rax
+    jmp forloop10
+forend12:
+    mov rax, [rel m]
+    mov rdi, rax
+    call aym_map_size
+    mov rdi, rax
+    call aym_write_int
+    lea rdi, [rel print_sep]
+    call aym_write_str
+    mov rax, [rel ks]
+    test rax, rax
+    jz arrlen_done14
+    mov rax, [rax+0]
+arrlen_done14:
+    mov rdi, rax
+    call aym_write_int
+    lea rdi, [rel print_sep]
+    call aym_write_str
+    mov rax, [rel suma]
+    mov rdi, rax
+    call aym_write_int
+    lea rdi, [rel print_term]
+    call aym_write_str
+    mov rax, 0
+    mov rsi, rax
+    mov rax, [rel ks]
+    mov rdi, rax
+    test rdi, rdi
+    jz arrget_slow15
+    cmp rsi, [rdi+0]
+    jae arrget_slow15
+    mov rax, [rdi+16]
+    mov rax, [rax+rsi*8]
+    jmp arrget_done16
+arrget_slow15:
+    call aym_array_get
+arrget_done16:
+    mov [rel primero], rax
+    mov rax, 132
+    mov rsi, rax
+    mov rax, [rel ks]
+    mov rdi, rax
+    test rdi, rdi
+    jz arrget_slow17
+    cmp rsi, [rdi+0]
+    jae arrget_slow17
+    mov rax, [rdi+16]
+    mov rax, [rax+rsi*8]
+    jmp arrget_done18
+arrget_slow17:
+    call aym_array_get
+arrget_done18:
+    mov [rel borrado], rax
+    mov rax, 133
+    mov rsi, rax
+    mov rax, [rel ks]
+    mov rdi, rax
+    test rdi, rdi
+    jz arrget_slow19
+    cmp rsi, [rdi+0]
+    jae arrget_slow19
+    mov rax, [rdi+16]
+    mov rax, [rax+rsi*8]
+    jmp arrget_done20
+arrget_slow19:
+    call aym_array_get
+arrget_done20:
+    mov [rel vuelto], rax
+    mov rax, 234
+    mov rsi, rax
+    mov rax, [rel ks]
+    mov rdi, rax
+    test rdi, rdi
+    jz arrget_slow21
+    cmp rsi, [rdi+0]
+    jae arrget_slow21
+    mov rax, [rdi+16]
+    mov rax, [rax+rsi*8]
+    jmp arrget_done22
+arrget_slow21:
+    call aym_array_get
+arrget_done22:
+    mov [rel ultimo], rax
+    mov rax, [rel primero]
+    mov rdi, rax
+    call aym_write_str
+    lea rdi, [rel print_sep]
+    call aym_write_str
+    mov rax, [rel borrado]
+    mov rdi, rax
+    call aym_write_str
+    lea rdi, [rel print_sep]
+    call aym_write_str
+    mov rax, [rel vuelto]
+    mov rdi, rax
+    call aym_write_str
+    lea rdi, [rel print_sep]
+    call aym_write_str
+    mov rax, [rel ultimo]
+    mov rdi, rax
+    call aym_write_str
+    lea rdi, [rel print_term]
+    call aym_write_str
+    sub rsp, 16
+    mov rax, [rel m]
+    mov [rsp+0], rax
+    lea rax, [rel str5]
+    mov [rsp+8], rax
+    mov rdi, [rsp+0]
+    mov rsi, [rsp+8]
+    add rsp, 16
+    call aym_map_contains
+    cmp rax,0
+    je bool_false23
+    lea rdi, [rel bool_true]
+    call aym_write_str
+    jmp bool_end24
+bool_false23:
+    lea rdi, [rel bool_false]
+    call aym_write_str
+bool_end24:
+    lea rdi, [rel print_sep]
+    call aym_write_str
+    sub rsp, 16
+    mov rax, [rel m]
+    mov [rsp+0], rax
+    lea rax, [rel str1]
+    mov [rsp+8], rax
+    mov rdi, [rsp+0]
+    mov rsi, [rsp+8]
+    add rsp, 16
+    call aym_map_contains
+    cmp rax,0
+    je bool_false25
+    lea rdi, [rel bool_true]
+    call aym_write_str
+    jmp bool_end26
+bool_false25:
+    lea rdi, [rel bool_false]
+    call aym_write_str
+bool_end26:
+    lea rdi, [rel print_sep]
+    call aym_write_str
+    sub rsp, 16
+    lea rax, [rel str3]
+    mov [rsp+0], rax
+    mov rax, [rel m]
+    mov [rsp+8], rax
+    mov rsi, [rsp+0]
+    mov rdi, rax
+    call aym_map_value_is_string_key
+    mov rbx, rax
+    mov rsi, [rsp+0]
+    mov rdi, [rsp+8]
+    call aym_map_get
+    add rsp, 16
+    mov rcx, rax
+    cmp rbx, 0
+    je map_idx_num27
+    mov rdi, rcx
+    call aym_write_str
+    jmp map_idx_done28
+map_idx_num27:
+    mov rdi, rcx
+    call aym_write_int
+map_idx_done28:
+    lea rdi, [rel print_term]
+    call aym_write_str
+endmain0:
+    add rsp, 8
+    pop r15
+    pop r14
+    pop r13
+    pop r12
+    pop rbx
+    pop rbp
+    mov eax,0
+    ret
+section .note.GNU-stack noalloc noexec nowrite progbits
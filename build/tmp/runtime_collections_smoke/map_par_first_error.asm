@@ -0,0 +1,439 @@
+extern aym_write_str
+extern aym_write_int
+extern aym_write_flush
+extern scanf
+extern aym_random
+extern aym_srand
+extern aym_sleep
+extern aym_term_clear
+extern aym_term_move
+extern aym_term_color
+extern aym_term_reset
+extern aym_term_cursor
+extern aym_key_poll
+extern aym_time_ms
+extern aym_gfx_open
+extern aym_gfx_is_open
+extern aym_gfx_clear
+extern aym_gfx_set_color
+extern aym_gfx_rect4
+extern aym_gfx_rect
+extern aym_gfx_text3
+extern aym_gfx_text
+extern aym_gfx_present
+extern aym_gfx_close
+extern aym_gfx_key_down
+extern aym_set_args
+extern aym_gc_stats_enable
+extern aym_argc
+extern aym_argv_get
+extern aym_assert
+extern aym_hof_map
+extern aym_hof_filter
+extern aym_hof_reduce
+extern aym_hof_pipeline
+extern aym_hof_map_par
+extern aym_hof_filter_par
+extern aym_hof_reduce_par
+extern aym_fs_read_text
+extern aym_fs_write_text
+extern aym_fs_exists
+extern aym_array_new
+extern aym_array_get
+extern aym_array_set
+extern aym_array_free
+extern aym_array_length
+extern aym_array_push
+extern aym_array_pop
+extern aym_array_remove_at
+extern aym_array_contains_int
+extern aym_array_contains_str
+extern aym_array_find_int
+extern aym_array_find_str
+extern aym_array_sort_int
+extern aym_array_sort_str
+extern aym_array_sort_by
+extern aym_array_unique_int
+extern aym_array_unique_str
+extern aym_set_new
+extern aym_set_from_array
+extern aym_set_add
+extern aym_set_contains
+extern aym_set_remove
+extern aym_set_size
+extern aym_set_items
+extern aym_set_is_string
+extern aym_deque_new
+extern aym_deque_from_array
+extern aym_deque_push_back
+extern aym_deque_push_front
+extern aym_deque_pop_back
+extern aym_deque_pop_front
+extern aym_deque_size
+extern aym_deque_items
+extern aym_deque_is_string
+extern aym_heap_new
+extern aym_heap_from_array
+extern aym_heap_push
+extern aym_heap_pop
+extern aym_heap_peek
+extern aym_heap_size
+extern aym_heap_items
+extern aym_heap_is_string
+extern aym_map_new
+extern aym_map_init_stack
+extern aym_map_set
+extern aym_map_get
+extern aym_map_get_default
+extern aym_map_contains
+extern aym_map_size
+extern aym_map_keys
+extern aym_map_values
+extern aym_map_delete
+extern aym_map_key_at
+extern aym_map_value_at
+extern aym_map_value_is_string
+extern aym_map_value_is_string_key
+extern aym_imap_set
+extern aym_imap_get
+extern aym_imap_get_default
+extern aym_imap_contains
+extern aym_imap_delete
+extern aym_imap_value_is_string_key
+extern aym_object_new
+extern aym_object_get
+extern aym_object_set
+extern aym_object_method
+extern aym_object_to_map
+extern aym_str_concat
+extern aym_str_build
+extern aym_str_eq
+extern aym_str_from_c
+extern aym_str_scratch_mark
+extern aym_str_scratch_release
+extern aym_str_trim
+extern aym_str_split
+extern aym_str_join
+extern aym_str_replace
+extern aym_str_contains
+extern aym_to_string
+extern aym_to_number
+extern aym_sin
+extern aym_cos
+extern aym_tan
+extern aym_asin
+extern aym_acos
+extern aym_atan
+extern aym_sqrt
+extern aym_pow
+extern aym_exp
+extern aym_log
+extern aym_log10
+extern aym_floor
+extern aym_ceil
+extern aym_round
+extern aym_fabs
+extern aym_handler_top
+extern aym_throw
+extern aym_exception_new
+extern aym_exception_type
+extern aym_exception_message
+section .data
+fmt_read_int: db "%ld",0
+fmt_read_str: db "%255s",0
+input_val: dq 0
+input_buf: times 256 db 0
+align 8
+    dq 0x44bd4bd473cd2df9, 1, 1
+print_sep: db 32, 0
+align 8
+    dq 0x44bd31d473cd01cb, 1, 1
+print_term: db 10, 0
+align 8
+    dq 0x44bd80d473cd8808, 1, 1
+list_open: db 91, 0
+align 8
+    dq 0x9afebb00c5c7fa67, 2, 2
+list_sep: db 44, 32, 0
+align 8
+    dq 0x44bd86d473cd923a, 1, 1
+list_close: db 93, 0
+align 8
+    dq 0x44bd49d473cd2a93, 1, 1
+list_quote: db 34, 0
+align 8
+    dq 0x44bda0d473cdbe68, 1, 1
+map_open: db 123, 0
+align 8
+    dq 0x9afebb00c5c7fa67, 2, 2
+map_sep: db 44, 32, 0
+align 8
+    dq 0x44bda6d473cdc89a, 1, 1
+map_close: db 125, 0
+align 8
+    dq 0x9b20b700c5e4da01, 2, 2
+map_colon: db 58, 32, 0
+align 8
+    dq 0xbd0cbb81044f3315, 5, 5
+bool_true: db 99, 104, 105, 113, 97, 0
+align 8
+    dq 0xe31a02b86357a2f1, 5, 5
+bool_false: db 107, 39, 97, 114, 105, 0
+align 8
+    dq 0x9bc02100c66c0698, 2, 2
+str0: db 107, 48, 0
+align 8
+    dq 0x44bd90d473cda338, 1, 1
+str1: db 107, 0
+align 8
+    dq 0x5769856069bf1735, 13, 13
+str2: db 115, 105, 110, 32, 101, 120, 99, 101, 112, 99, 105, 111, 110, 0
+align 8
+    dq 0xe19f0b510de7f26b, 3, 3
+str3: db 97, 114, 117, 0
+align 8
+    dq 0xf42074204f72374c, 13, 13
+str4: db 110, 111, 32, 101, 120, 105, 115, 116, 101, 58, 32, 107, 53, 0
+align 8
+    dq 0xd84c9f31e88b424a, 5, 5
+str5: db 67, 76, 65, 86, 69, 0
+__try_exception_0: dq 0
+__try_handler_0: times 12 dq 0
+r: dq 0
+e: dq 0
+i: dq 0
+m: dq 0
+xs: dq 0
+ys: dq 0
+bien: dq 0
+section .text
+global main
+busca:
+    push rbp
+    mov rbp, rsp
+    push rbx
+    push r12
+    push r13
+    push r14
+    push r15
+    sub rsp, 24
+tail1:
+    mov r12, rdi
+    mov rax, r12
+    cmp rax, 5
+    sete al
+    movzx rax,al
+    cmp rax,0
+    jne or_true4
+    mov rax, r12
+    cmp rax, 90000
+    sete al
+    movzx rax,al
+    cmp rax,0
+    setne al
+    movzx rax,al
+    jmp or_end5
+or_true4:
+    mov rax,1
+or_end5:
+    cmp rax,0
+    je endif3
+    sub rsp, 32
+    lea rax, [rel str1]
+    mov qword [rsp+0], 0
+    mov [rsp+8], rax
+    mov rax, r12
+    mov qword [rsp+16], 1
+    mov [rsp+24], rax
+    lea rdi, [rsp+0]
+    mov rsi, 2
+    call aym_str_build
+    add rsp, 32
+    mov rsi, rax
+    mov rax, [rel m]
+    mov rdi, rax
+    call aym_map_get
+    jmp endfunc0
+endif3:
+    mov rax, r12
+    jmp endfunc0
+endfunc0:
+    add rsp, 24
+    pop r15
+    pop r14
+    pop r13
+    pop r12
+    pop rbx
+    pop rbp
+    ret
+main:
+    push rbp
+    mov rbp, rsp
+    push rbx
+    push r12
+    push r13
+    push r14
+    push r15
+    sub rsp, 8
+    call aym_set_args
+    sub rsp, 16
+    mov rdi, 1
+    call aym_map_new
+    mov [rsp+0], rax
+    lea rax, [rel str0]
+    mov [rsp+8], rax
+    mov rax, 0
+    mov rcx, 0
+    mov rdx, rax
+    mov rsi, [rsp+8]
+    mov rdi, [rsp+0]
+    call aym_map_set
+    mov rax, [rsp+0]
+    add rsp, 16
+    mov [rel m], rax
+    sub rsp, 16
+    mov rdi, 0
+    call aym_array_new
+    mov [rsp+0], rax
+    mov rax, [rsp+0]
+    add rsp, 16
+    mov [rel xs], rax
+    mov rax, 0
+    mov [rel i], rax
+forloop7:
+    mov rax, [rel i]
+    cmp rax, 100000
+    setl al
+    movzx rax,al
+    cmp rax,0
+    je forend9
+    sub rsp, 16
+    mov rax, [rel xs]
+    mov [rsp+0], rax
+    mov rax, [rel i]
+    mov [rsp+8], rax
+    mov rdi, [rsp+0]
+    mov rsi, [rsp+8]
+    add rsp, 16
+    call aym_array_push
+forcont8:
+    mov rax, [rel i]
+    add rax, 1
+    mov [rel i], rax
+    jmp forloop7
+forend9:
+    mov rax, 0
+    mov [rel bien], rax
+    mov rax, 0
+    mov [rel r], rax
+forloop10:
+    mov rax, [rel r]
+    cmp rax, 50
+    setl al
+    movzx rax,al
+    cmp rax,0
+    je forend12
+    lea rax, [rel __try_handler_0]
+    mov rcx, [rel aym_handler_top]
+    mov [rax], rcx
+    lea rcx, [rel catch13]
+    mov [rax+8], rcx
+    mov [rax+16], rsp
+    mov [rax+24], rbp
+    mov [rax+32], rbx
+    mov [rax+40], r12
+    mov [rax+48], r13
+    mov [rax+56], r14
+    mov [rax+64], r15
+    mov [rel aym_handler_top], rax
+    sub rsp, 16
+    mov rax, [rel xs]
+    mov [rsp+0], rax
+    lea rax, [rel busca]
+    mov [rsp+8], rax
+    mov rdi, [rsp+0]
+    mov rsi, [rsp+8]
+    add rsp, 16
+    call aym_hof_map_par
+    mov [rel ys], rax
+    lea rdi, [rel str2]
+    call aym_write_str
+    lea rdi, [rel print_sep]
+    call aym_write_str
+    mov rax, [rel ys]
+    test rax, rax
+    jz arrlen_done15
+    mov rax, [rax+0]
+arrlen_done15:
+    mov rdi, rax
+    call aym_write_int
+    lea rdi, [rel print_term]
+    call aym_write_str
+    mov rcx, [rel __try_handler_0]
+    mov [rel aym_handler_top], rcx
+    jmp tryend14
+catch13:
+    mov rax, [rel __try_handler_0+72]
+    mov [rel __try_exception_0], rax
+    mov rdi, [rel __try_exception_0]
+    call aym_exception_type
+    mov rsi, rax
+    lea rdi, [rel str5]
+    call aym_str_eq
+    test rax, rax
+    jz catch_next17
+    mov rax, [rel __try_exception_0]
+    mov [rel e], rax
+    mov rax, [rel e]
+    mov rdi, rax
+    call aym_exception_message
+    mov r8, rax
+    lea rax, [rel str4]
+    mov rbx, rax
+    mov rax, r8
+    mov rdi, rax
+    mov rsi, rbx
+    call aym_str_eq
+    cmp rax,0
+    je else18
+    mov rax, [rel bien]
+    add rax, 1
+    mov [rel bien], rax
+    jmp endif19
+else18:
+    mov rax, [rel e]
+    mov rdi, rax
+    call aym_exception_message
+    mov rdi, rax
+    call aym_write_str
+    lea rdi, [rel print_term]
+    call aym_write_str
+endif19:
+    jmp tryend14
+catch_next17:
+catch_nomatch16:
+    mov rdi, [rel __try_exception_0]
+    call aym_throw
+tryend14:
+forcont11:
+    mov rax, [rel r]
+    add rax, 1
+    mov [rel r], rax
+    jmp forloop10
+forend12:
+    mov rax, [rel bien]
+    mov rdi, rax
+    call aym_write_int
+    lea rdi, [rel print_term]
+    call aym_write_str
+endmain6:
+    add rsp, 8
+    pop r15
+    pop r14
+    pop r13
+    pop r12
+    pop rbx
+    pop rbp
+    mov eax,0
+    ret
+section .note.GNU-stack noalloc noexec nowrite progbits
@@ -0,0 +1,439 @@
+extern aym_write_str
+extern aym_write_int
+extern aym_write_flush
+extern scanf
+extern aym_random
+extern aym_srand
+extern aym_sleep
+extern aym_term_clear
+extern aym_term_move
+extern aym_term_color
+extern aym_term_reset
+extern aym_term_cursor
+extern aym_key_poll
+extern aym_time_ms
+extern aym_gfx_open
+extern aym_gfx_is_open
+extern aym_gfx_clear
+extern aym_gfx_set_color
+extern aym_gfx_rect4
+extern aym_gfx_rect
+extern aym_gfx_text3
+extern aym_gfx_text
+extern aym_gfx_present
+extern aym_gfx_close
+extern aym_gfx_key_down
+extern aym_set_args
+extern aym_gc_stats_enable
+extern aym_argc
+extern aym_argv_get
+extern aym_assert
+extern aym_hof_map
+extern aym_hof_filter
+extern aym_hof_reduce
+extern aym_hof_pipeline
+extern aym_hof_map_par
+extern aym_hof_filter_par
+extern aym_hof_reduce_par
+extern aym_fs_read_text
+extern aym_fs_write_text
+extern aym_fs_exists
+extern aym_array_new
+extern aym_array_get
+extern aym_array_set
+extern aym_array_free
+extern aym_array_length
+extern aym_array_push
+extern aym_array_pop
+extern aym_array_remove_at
+extern aym_array_contains_int
+extern aym_array_contains_str
+extern aym_array_find_int
+extern aym_array_find_str
+extern aym_array_sort_int
+extern aym_array_sort_str
+extern aym_array_sort_by
+extern aym_array_unique_int
+extern aym_array_unique_str
+extern aym_set_new
+extern aym_set_from_array
+extern aym_set_add
+extern aym_set_contains
+extern aym_set_remove
+extern aym_set_size
+extern aym_set_items
+extern aym_set_is_string
+extern aym_deque_new
+extern aym_deque_from_array
+extern aym_deque_push_back
+extern aym_deque_push_front
+extern aym_deque_pop_back
+extern aym_deque_pop_front
+extern aym_deque_size
+extern aym_deque_items
+extern aym_deque_is_string
+extern aym_heap_new
+extern aym_heap_from_array
+extern aym_heap_push
+extern aym_heap_pop
+extern aym_heap_peek
+extern aym_heap_size
+extern aym_heap_items
+extern aym_heap_is_string
+extern aym_map_new
+extern aym_map_init_stack
+extern aym_map_set
+extern aym_map_get
+extern aym_map_get_default
+extern aym_map_contains
+extern aym_map_size
+extern aym_map_keys
+extern aym_map_values
+extern aym_map_delete
+extern aym_map_key_at
+extern aym_map_value_at
+extern aym_map_value_is_string
+extern aym_map_value_is_string_key
+extern aym_imap_set
+extern aym_imap_get
+extern aym_imap_get_default
+extern aym_imap_contains
+extern aym_imap_delete
+extern aym_imap_value_is_string_key
+extern aym_object_new
+extern aym_object_get
+extern aym_object_set
+extern aym_object_method
+extern aym_object_to_map
+extern aym_str_concat
+extern aym_str_build
+extern aym_str_eq
+extern aym_str_from_c
+extern aym_str_scratch_mark
+extern aym_str_scratch_release
+extern aym_str_trim
+extern aym_str_split
+extern aym_str_join
+extern aym_str_replace
+extern aym_str_contains
+extern aym_to_string
+extern aym_to_number
+extern aym_sin
+extern aym_cos
+extern aym_tan
+extern aym_asin
+extern aym_acos
+extern aym_atan
+extern aym_sqrt
+extern aym_pow
+extern aym_exp
+extern aym_log
+extern aym_log10
+extern aym_floor
+extern aym_ceil
+extern aym_round
+extern aym_fabs
+extern aym_handler_top
+extern aym_throw
+extern aym_exception_new
+extern aym_exception_type
+extern aym_exception_message
+section .data
+fmt_read_int: db "%ld",0
+fmt_read_str: db "%255s",0
+input_val: dq 0
+input_buf: times 256 db 0
+align 8
+    dq 0x44bd4bd473cd2df9, 1, 1
+print_sep: db 32, 0
+align 8
+    dq 0x44bd31d473cd01cb, 1, 1
+print_term: db 10, 0
+align 8
+    dq 0x44bd80d473cd8808, 1, 1
+list_open: db 91, 0
+align 8
+    dq 0x9afebb00c5c7fa67, 2, 2
+list_sep: db 44, 32, 0
+align 8
+    dq 0x44bd86d473cd923a, 1, 1
+list_close: db 93, 0
+align 8
+    dq 0x44bd49d473cd2a93, 1, 1
+list_quote: db 34, 0
+align 8
+    dq 0x44bda0d473cdbe68, 1, 1
+map_open: db 123, 0
+align 8
+    dq 0x9afebb00c5c7fa67, 2, 2
+map_sep: db 44, 32, 0
+align 8
+    dq 0x44bda6d473cdc89a, 1, 1
+map_close: db 125, 0
+align 8
+    dq 0x9b20b700c5e4da01, 2, 2
+map_colon: db 58, 32, 0
+align 8
+    dq 0xbd0cbb81044f3315, 5, 5
+bool_true: db 99, 104, 105, 113, 97, 0
+align 8
+    dq 0xe31a02b86357a2f1, 5, 5
+bool_false: db 107, 39, 97, 114, 105, 0
+align 8
+    dq 0x9bac4b00c65ba4ec, 2, 2
+str0: db 97, 98, 0
+align 8
+    dq 0x44bd56d473cd40aa, 1, 1
+str1: db 45, 0
+align 8
+    dq 0x14650fb0739d0383, 0, 0
+str2: db 0
+align 8
+    dq 0x44bd9cd473cdb79c, 1, 1
+str3: db 119, 0
+align 8
+    dq 0x44bda1d473cdc01b, 1, 1
+str4: db 122, 0
+w: dq 0
+i: dq 0
+total: dq 0
+j: dq 0
+k: dq 0
+t: dq 0
+ultimo: dq 0
+section .text
+global main
+guarda:
+    push rbp
+    mov rbp, rsp
+    push rbx
+    push r12
+    push r13
+    push r14
+    push r15
+    sub rsp, 40
+tail1:
+    lea rax, [rel str2]
+    mov r12, rax
+    mov r13, 0
+forloop2:
+    mov rax, r13
+    cmp rax, 3
+    setl al
+    movzx rax,al
+    cmp rax,0
+    je forend4
+    sub rsp, 32
+    lea rax, [rel str4]
+    mov qword [rsp+0], 0
+    mov [rsp+8], rax
+    mov rax, r13
+    mov qword [rsp+16], 1
+    mov [rsp+24], rax
+    lea rdi, [rsp+0]
+    mov rsi, 2
+    call aym_str_build
+    add rsp, 32
+    mov r14, rax
+    mov rax, r13
+    cmp rax, 0
+    sete al
+    movzx rax,al
+    cmp rax,0
+    je endif6
+    mov r12, r14
+endif6:
+forcont3:
+    mov rax, r13
+    add rax, 1
+    mov r13, rax
+    jmp forloop2
+forend4:
+    mov rax, r12
+    jmp endfunc0
+endfunc0:
+    add rsp, 40
+    pop r15
+    pop r14
+    pop r13
+    pop r12
+    pop rbx
+    pop rbp
+    ret
+main:
+    push rbp
+    mov rbp, rsp
+    push rbx
+    push r12
+    push r13
+    push r14
+    push r15
+    sub rsp, 8
+    call aym_set_args
+    mov rax, 0
+    mov [rel total], rax
+    mov rax, 0
+    mov [rel i], rax
+    call aym_str_scratch_mark
+    sub rsp, 16
+    mov [rsp+0], rax
+forloop8:
+    mov rax, [rel i]
+    cmp rax, 10000000
+    setl al
+    movzx rax,al
+    cmp rax,0
+    je forend10
+    mov rax, [rel total]
+    push rax
+    sub rsp, 8
+    sub rsp, 32
+    lea rax, [rel str0]
+    mov qword [rsp+0], 0
+    mov [rsp+8], rax
+    mov rax, [rel i]
+    mov qword [rsp+16], 1
+    mov [rsp+24], rax
+    lea rdi, [rsp+0]
+    mov rsi, 2
+    call aym_str_build
+    add rsp, 32
+    test rax, rax
+    jz strlen_done11
+    mov rax, [rax-8]
+strlen_done11:
+    add rsp, 8
+    mov rbx, rax
+    pop rax
+    add rax, rbx
+    mov [rel total], rax
+forcont9:
+    mov rdi, [rsp+0]
+    call aym_str_scratch_release
+    mov rax, [rel i]
+    add rax, 1
+    mov [rel i], rax
+    jmp forloop8
+forend10:
+    mov rdi, [rsp+0]
+    call aym_str_scratch_release
+    add rsp, 16
+    mov rax, [rel total]
+    mov rdi, rax
+    call aym_write_int
+    lea rdi, [rel print_term]
+    call aym_write_str
+    mov rax, 0
+    mov [rel j], rax
+    call aym_str_scratch_mark
+    sub rsp, 16
+    mov [rsp+0], rax
+loop12:
+    mov rax, [rel j]
+    cmp rax, 1000000
+    setl al
+    movzx rax,al
+    cmp rax,0
+    je endloop14
+    sub rsp, 48
+    mov rax, [rel j]
+    mov qword [rsp+0], 1
+    mov [rsp+8], rax
+    lea rax, [rel str1]
+    mov qword [rsp+16], 0
+    mov [rsp+24], rax
+    mov rax, [rel j]
+    mov qword [rsp+32], 1
+    mov [rsp+40], rax
+    lea rdi, [rsp+0]
+    mov rsi, 3
+    call aym_str_build
+    add rsp, 48
+    mov [rel t], rax
+    mov rax, [rel t]
+    test rax, rax
+    jz strlen_done17
+    mov rax, [rax-8]
+strlen_done17:
+    cmp rax, 12
+    setg al
+    movzx rax,al
+    cmp rax,0
+    je endif16
+    jmp endloop14
+endif16:
+    mov rax, [rel j]
+    add rax, 1
+    mov [rel j], rax
+cont13:
+    mov rdi, [rsp+0]
+    call aym_str_scratch_release
+    jmp loop12
+endloop14:
+    mov rdi, [rsp+0]
+    call aym_str_scratch_release
+    add rsp, 16
+    mov rax, [rel j]
+    mov rdi, rax
+    call aym_write_int
+    lea rdi, [rel print_term]
+    call aym_write_str
+    lea rax, [rel str2]
+    mov [rel ultimo], rax
+    mov rax, 0
+    mov [rel k], rax
+forloop18:
+    mov rax, [rel k]
+    cmp rax, 3
+    setl al
+    movzx rax,al
+    cmp rax,0
+    je forend20
+    sub rsp, 32
+    lea rax, [rel str3]
+    mov qword [rsp+0], 0
+    mov [rsp+8], rax
+    mov rax, [rel k]
+    mov qword [rsp+16], 1
+    mov [rsp+24], rax
+    lea rdi, [rsp+0]
+    mov rsi, 2
+    call aym_str_build
+    add rsp, 32
+    mov [rel w], rax
+    mov rax, [rel k]
+    cmp rax, 0
+    sete al
+    movzx rax,al
+    cmp rax,0
+    je endif22
+    mov rax, [rel w]
+    mov [rel ultimo], rax
+endif22:
+forcont19:
+    mov rax, [rel k]
+    add rax, 1
+    mov [rel k], rax
+    jmp forloop18
+forend20:
+    mov rax, [rel ultimo]
+    mov rdi, rax
+    call aym_write_str
+    lea rdi, [rel print_term]
+    call aym_write_str
+    call guarda
+    mov rdi, rax
+    call aym_write_str
+    lea rdi, [rel print_term]
+    call aym_write_str
+endmain7:
+    add rsp, 8
+    pop r15
+    pop r14
+    pop r13
+    pop r12
+    pop rbx
+    pop rbp
+    mov eax,0
+    ret
+section .note.GNU-stack noalloc noexec nowrite progbits
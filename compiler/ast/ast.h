@@ -157,6 +157,8 @@ public:
     char getOp() const { return oper; }
     Expr *getLeft() const { return left.get(); }
     Expr *getRight() const { return right.get(); }
+    void setLeft(std::unique_ptr<Expr> e) { left = std::move(e); }
+    void setRight(std::unique_ptr<Expr> e) { right = std::move(e); }
     void accept(ASTVisitor &v) override { v.visit(*this); }
 private:
     char oper;
@@ -168,6 +170,7 @@ public:
     UnaryExpr(char o, std::unique_ptr<Expr> e) : op(o), expr(std::move(e)) {}
     char getOp() const { return op; }
     Expr *getExpr() const { return expr.get(); }
+    void setExpr(std::unique_ptr<Expr> e) { expr = std::move(e); }
     void accept(ASTVisitor &v) override { v.visit(*this); }
 private:
     char op;
@@ -185,6 +188,11 @@ public:
     Expr *getCondition() const { return condition.get(); }
     Expr *getThen() const { return thenBranch.get(); }
     Expr *getElse() const { return elseBranch.get(); }
+    void setCondition(std::unique_ptr<Expr> e) { condition = std::move(e); }
+    void setThen(std::unique_ptr<Expr> e) { thenBranch = std::move(e); }
+    void setElse(std::unique_ptr<Expr> e) { elseBranch = std::move(e); }
+    std::unique_ptr<Expr> takeThen() { return std::move(thenBranch); }
+    std::unique_ptr<Expr> takeElse() { return std::move(elseBranch); }
     void accept(ASTVisitor &v) override { v.visit(*this); }
 private:
     std::unique_ptr<Expr> condition;
@@ -213,10 +221,15 @@ public:
         : name(std::move(callee)), arguments(std::move(args)) {}
     const std::string &getName() const { return name; }
     const std::vector<std::unique_ptr<Expr>> &getArgs() const { return arguments; }
+    void setArg(size_t i, std::unique_ptr<Expr> e) { arguments[i] = std::move(e); }
+    // Builtins de mapas cuya clave es `jakhüwi` (lo marca el analisis semantico).
+    void setIntKey(bool value) { intKey = value; }
+    bool hasIntKey() const { return intKey; }
     void accept(ASTVisitor &v) override { v.visit(*this); }
 private:
     std::string name;
     std::vector<std::unique_ptr<Expr>> arguments;
+    bool intKey = false;
 };
 
 class MemberCallExpr : public Expr {
@@ -230,6 +243,7 @@ public:
     Expr *getBase() const { return base.get(); }
     const std::string &getMember() const { return member; }
     const std::vector<std::unique_ptr<Expr>> &getArgs() const { return arguments; }
+    void setArg(size_t i, std::unique_ptr<Expr> e) { arguments[i] = std::move(e); }
     void setStaticCallee(const std::string &name) { staticCallee = name; }
     const std::string &getStaticCallee() const { return staticCallee; }
     void setResolvedType(const std::string &type) { resolvedType = type; }
@@ -250,10 +264,15 @@ public:
         : name(std::move(className)), arguments(std::move(args)) {}
     const std::string &getName() const { return name; }
     const std::vector<std::unique_ptr<Expr>> &getArgs() const { return arguments; }
+    void setArg(size_t i, std::unique_ptr<Expr> e) { arguments[i] = std::move(e); }
+    // Builtins de mapas cuya clave es `jakhüwi` (lo marca el analisis semantico).
+    void setIntKey(bool value) { intKey = value; }
+    bool hasIntKey() const { return intKey; }
     void accept(ASTVisitor &v) override { v.visit(*this); }
 private:
     std::string name;
     std::vector<std::unique_ptr<Expr>> arguments;
+    bool intKey = false;
 };
 
 class FunctionRefExpr : public Expr {
@@ -276,6 +295,7 @@ public:
     explicit ListExpr(std::vector<std::unique_ptr<Expr>> values)
         : elements(std::move(values)) {}
     const std::vector<std::unique_ptr<Expr>> &getElements() const { return elements; }
+    void setElement(size_t i, std::unique_ptr<Expr> e) { elements[i] = std::move(e); }
     void accept(ASTVisitor &v) override { v.visit(*this); }
 private:
     std::vector<std::unique_ptr<Expr>> elements;
@@ -288,9 +308,12 @@ public:
     const std::vector<std::pair<std::unique_ptr<Expr>, std::unique_ptr<Expr>>> &getItems() const {
         return items;
     }
+    void setIntKeys(bool value) { intKeys = value; }
+    bool hasIntKeys() const { return intKeys; }
     void accept(ASTVisitor &v) override { v.visit(*this); }
 private:
     std::vector<std::pair<std::unique_ptr<Expr>, std::unique_ptr<Expr>>> items;
+    bool intKeys = false;
 };
 
 class IndexExpr : public Expr {
@@ -301,10 +324,14 @@ public:
     Expr *getIndex() const { return index.get(); }
     std::unique_ptr<Expr> takeBase() { return std::move(base); }
     std::unique_ptr<Expr> takeIndex() { return std::move(index); }
+    void setIndex(std::unique_ptr<Expr> e) { index = std::move(e); }
+    void setIntKey(bool value) { intKey = value; }
+    bool hasIntKey() const { return intKey; }
     void accept(ASTVisitor &v) override { v.visit(*this); }
 private:
     std::unique_ptr<Expr> base;
     std::unique_ptr<Expr> index;
+    bool intKey = false;
 };
 
 class MemberExpr : public Expr {
@@ -320,6 +347,8 @@ public:
     const std::string &getStaticField() const { return staticField; }
     void setResolvedType(const std::string &type) { resolvedType = type; }
     const std::string &getResolvedType() const { return resolvedType; }
+    void setObjectClass(const std::string &name) { objectClass = name; }
+    const std::string &getObjectClass() const { return objectClass; }
     void accept(ASTVisitor &v) override { v.visit(*this); }
 private:
     std::unique_ptr<Expr> base;
@@ -327,6 +356,7 @@ private:
     bool exceptionAccess = false;
     std::string staticField;
     std::string resolvedType;
+    std::string objectClass;
 };
 
 class PrintStmt : public Stmt {
@@ -338,6 +368,7 @@ public:
           separator(std::move(sep)),
           terminator(std::move(term)) {}
     const std::vector<std::unique_ptr<Expr>> &getExprs() const { return expressions; }
+    void setExpr(size_t i, std::unique_ptr<Expr> e) { expressions[i] = std::move(e); }
     Expr *getSeparator() const { return separator.get(); }
     Expr *getTerminator() const { return terminator.get(); }
     void accept(ASTVisitor &v) override { v.visit(*this); }
@@ -352,6 +383,7 @@ public:
     explicit ExprStmt(std::unique_ptr<Expr> e)
         : expression(std::move(e)) {}
     Expr *getExpr() const { return expression.get(); }
+    void setExpr(std::unique_ptr<Expr> e) { expression = std::move(e); }
     void accept(ASTVisitor &v) override { v.visit(*this); }
 private:
     std::unique_ptr<Expr> expression;
@@ -363,6 +395,7 @@ public:
         : name(std::move(n)), value(std::move(v)) {}
     const std::string &getName() const { return name; }
     Expr *getValue() const { return value.get(); }
+    void setValue(std::unique_ptr<Expr> e) { value = std::move(e); }
     void accept(ASTVisitor &v) override { v.visit(*this); }
 private:
     std::string name;
@@ -380,11 +413,19 @@ public:
     Expr *getBase() const { return base.get(); }
     Expr *getIndex() const { return index.get(); }
     Expr *getValue() const { return value.get(); }
+    void setIndex(std::unique_ptr<Expr> e) { index = std::move(e); }
+    void setValue(std::unique_ptr<Expr> e) { value = std::move(e); }
+    void setObjectClass(const std::string &name) { objectClass = name; }
+    const std::string &getObjectClass() const { return objectClass; }
+    void setIntKey(bool value) { intKey = value; }
+    bool hasIntKey() const { return intKey; }
     void accept(ASTVisitor &v) override { v.visit(*this); }
 private:
     std::unique_ptr<Expr> base;
     std::unique_ptr<Expr> index;
     std::unique_ptr<Expr> value;
+    std::string objectClass;
+    bool intKey = false;
 };
 
 class BlockStmt : public Stmt {
@@ -403,6 +444,9 @@ public:
     Expr *getCondition() const { return condition.get(); }
     BlockStmt *getThen() const { return thenBlock.get(); }
     BlockStmt *getElse() const { return elseBlock.get(); }
+    void setCondition(std::unique_ptr<Expr> e) { condition = std::move(e); }
+    std::unique_ptr<BlockStmt> takeThen() { return std::move(thenBlock); }
+    std::unique_ptr<BlockStmt> takeElse() { return std::move(elseBlock); }
     void accept(ASTVisitor &v) override { v.visit(*this); }
 private:
     std::unique_ptr<Expr> condition;
@@ -421,6 +465,7 @@ public:
     Stmt *getInit() const { return initStmt.get(); }
     Expr *getCondition() const { return condition.get(); }
     Stmt *getPost() const { return postStmt.get(); }
+    void setCondition(std::unique_ptr<Expr> e) { condition = std::move(e); }
     BlockStmt *getBody() const { return body.get(); }
     void accept(ASTVisitor &v) override { v.visit(*this); }
 private:
@@ -437,6 +482,7 @@ class ReturnStmt : public Stmt {
 public:
     explicit ReturnStmt(std::unique_ptr<Expr> v) : value(std::move(v)) {}
     Expr *getValue() const { return value.get(); }
+    void setValue(std::unique_ptr<Expr> e) { value = std::move(e); }
     void accept(ASTVisitor &v) override { v.visit(*this); }
 private:
     std::unique_ptr<Expr> value;
@@ -450,6 +496,7 @@ public:
     const std::string &getName() const { return name; }
     void setName(std::string n) { name = std::move(n); }
     Expr *getInit() const { return init.get(); }
+    void setInit(std::unique_ptr<Expr> e) { init = std::move(e); }
     void accept(ASTVisitor &v) override { v.visit(*this); }
 private:
     std::string type;
@@ -533,6 +580,7 @@ public:
         : condition(std::move(cond)), body(std::move(body)) {}
     Expr *getCondition() const { return condition.get(); }
     BlockStmt *getBody() const { return body.get(); }
+    void setCondition(std::unique_ptr<Expr> e) { condition = std::move(e); }
     void accept(ASTVisitor &v) override { v.visit(*this); }
 private:
     std::unique_ptr<Expr> condition;
@@ -546,6 +594,7 @@ public:
         : body(std::move(b)), condition(std::move(cond)) {}
     Expr *getCondition() const { return condition.get(); }
     BlockStmt *getBody() const { return body.get(); }
+    void setCondition(std::unique_ptr<Expr> e) { condition = std::move(e); }
     void accept(ASTVisitor &v) override { v.visit(*this); }
 private:
     std::unique_ptr<BlockStmt> body;
@@ -0,0 +1,463 @@
+#include "ast_fold.h"
+
+#include "ast.h"
+#include <climits>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+namespace aym {
+
+namespace {
+
+// El codigo generado opera en complemento a dos (add/imul/neg de x86-64);
+// plegar con aritmetica sin signo reproduce el desbordamiento sin UB.
+long long wrap(unsigned long long value) {
+    return static_cast<long long>(value);
+}
+
+bool intValue(const Expr *expr, long long &value) {
+    if (auto *n = dynamic_cast<const NumberExpr*>(expr)) {
+        value = n->getValue();
+        return true;
+    }
+    if (auto *b = dynamic_cast<const BoolExpr*>(expr)) {
+        value = b->getValue() ? 1 : 0;
+        return true;
+    }
+    return false;
+}
+
+bool isLiteral(const Expr *expr) {
+    return dynamic_cast<const NumberExpr*>(expr) || dynamic_cast<const BoolExpr*>(expr) ||
+           dynamic_cast<const StringExpr*>(expr);
+}
+
+template <typename T, typename... Args>
+std::unique_ptr<Expr> literalAt(const Node &at, Args &&...args) {
+    auto lit = std::make_unique<T>(std::forward<Args>(args)...);
+    lit->setLocation(at.getLine(), at.getColumn());
+    return lit;
+}
+
+std::unique_ptr<Expr> cloneLiteral(const Expr *lit, const Node &at) {
+    if (auto *n = dynamic_cast<const NumberExpr*>(lit)) return literalAt<NumberExpr>(at, n->getValue());
+    if (auto *b = dynamic_cast<const BoolExpr*>(lit)) return literalAt<BoolExpr>(at, b->getValue());
+    auto *s = static_cast<const StringExpr*>(lit);
+    return literalAt<StringExpr>(at, s->getValue());
+}
+
+// El literal debe corresponder al tipo declarado: una variable `aru`
+// inicializada con un numero no se imprime igual que el numero.
+bool literalMatchesType(const Expr *lit, const std::string &type) {
+    if (dynamic_cast<const NumberExpr*>(lit)) return type == "jakhüwi";
+    if (dynamic_cast<const BoolExpr*>(lit)) return type == "chiqa";
+    if (dynamic_cast<const StringExpr*>(lit)) return type == "aru";
+    return false;
+}
+
+bool foldInt(char op, long long a, long long b, long long &out) {
+    unsigned long long ua = static_cast<unsigned long long>(a);
+    unsigned long long ub = static_cast<unsigned long long>(b);
+    switch (op) {
+        case '+': out = wrap(ua + ub); return true;
+        case '-': out = wrap(ua - ub); return true;
+        case '*': out = wrap(ua * ub); return true;
+        case '/':
+        case '%':
+            // La division por cero y LLONG_MIN / -1 se dejan para que fallen
+            // en tiempo de ejecucion como lo harian sin plegado.
+            if (b == 0 || (a == LLONG_MIN && b == -1)) return false;
+            out = op == '/' ? a / b : a % b;
+            return true;
+        case '^': {
+            // El exponente se toma sin signo, igual que en el codigo generado.
+            unsigned long long result = 1;
+            unsigned long long base = ua;
+            unsigned long long exp = ub;
+            while (exp) {
+                if (exp & 1) result *= base;
+                base *= base;
+                exp >>= 1;
+            }
+            out = wrap(result);
+            return true;
+        }
+        case '<': out = a < b; return true;
+        case 'l': out = a <= b; return true;
+        case '>': out = a > b; return true;
+        case 'g': out = a >= b; return true;
+        case 's': out = a == b; return true;
+        case 'd': out = a != b; return true;
+        case '&': out = a != 0 && b != 0; return true;
+        case '|': out = a != 0 || b != 0; return true;
+        default: return false;
+    }
+}
+
+bool isBoolOp(char op) {
+    return op == '<' || op == 'l' || op == '>' || op == 'g' || op == 's' || op == 'd' ||
+           op == '&' || op == '|';
+}
+
+// Primera pasada: cuenta declaraciones y escrituras por nombre. Solo se
+// propagan variables declaradas una vez, sin asignaciones, ++/-- ni escrituras
+// indexadas, y cuyo nombre no coincide con parametros, campos ni variables de
+// `katjana`.
+class NameScan {
+public:
+    std::unordered_map<std::string,int> decls;
+    std::unordered_set<std::string> pinned;
+
+    void stmt(const Node *node) {
+        if (!node) return;
+        if (auto *v = dynamic_cast<const VarDeclStmt*>(node)) {
+            ++decls[v->getName()];
+            expr(v->getInit());
+        } else if (auto *a = dynamic_cast<const AssignStmt*>(node)) {
+            pinned.insert(a->getName());
+            expr(a->getValue());
+        } else if (auto *a = dynamic_cast<const IndexAssignStmt*>(node)) {
+            if (auto *base = dynamic_cast<const VariableExpr*>(a->getBase())) pinned.insert(base->getName());
+            expr(a->getBase());
+            expr(a->getIndex());
+            expr(a->getValue());
+        } else if (auto *p = dynamic_cast<const PrintStmt*>(node)) {
+            for (const auto &e : p->getExprs()) expr(e.get());
+            expr(p->getSeparator());
+            expr(p->getTerminator());
+        } else if (auto *e = dynamic_cast<const ExprStmt*>(node)) {
+            expr(e->getExpr());
+        } else if (auto *b = dynamic_cast<const BlockStmt*>(node)) {
+            for (const auto &s : b->statements) stmt(s.get());
+        } else if (auto *i = dynamic_cast<const IfStmt*>(node)) {
+            expr(i->getCondition());
+            stmt(i->getThen());
+            stmt(i->getElse());
+        } else if (auto *f = dynamic_cast<const ForStmt*>(node)) {
+            stmt(f->getInit());
+            expr(f->getCondition());
+            stmt(f->getPost());
+            stmt(f->getBody());
+        } else if (auto *w = dynamic_cast<const WhileStmt*>(node)) {
+            expr(w->getCondition());
+            stmt(w->getBody());
+        } else if (auto *d = dynamic_cast<const DoWhileStmt*>(node)) {
+            stmt(d->getBody());
+            expr(d->getCondition());
+        } else if (auto *r = dynamic_cast<const ReturnStmt*>(node)) {
+            expr(r->getValue());
+        } else if (auto *sw = dynamic_cast<const SwitchStmt*>(node)) {
+            expr(sw->getExpr());
+            for (const auto &c : sw->getCases()) {
+                expr(c.first.get());
+                stmt(c.second.get());
+            }
+            stmt(sw->getDefault());
+        } else if (auto *t = dynamic_cast<const ThrowStmt*>(node)) {
+            expr(t->getType());
+            expr(t->getMessage());
+        } else if (auto *t = dynamic_cast<const TryStmt*>(node)) {
+            stmt(t->getTryBlock());
+            for (const auto &c : t->getCatches()) {
+                pinned.insert(c.varName);
+                stmt(c.block.get());
+            }
+            stmt(t->getFinallyBlock());
+        } else if (auto *fn = dynamic_cast<const FunctionStmt*>(node)) {
+            for (const auto &p : fn->getParams()) pinned.insert(p.name);
+            stmt(fn->getBody());
+        } else if (auto *cls = dynamic_cast<const ClassStmt*>(node)) {
+            for (const auto &field : cls->getFields()) {
+                pinned.insert(field.name);
+                expr(field.init.get());
+            }
+            for (const auto &m : cls->getMethods()) {
+                for (const auto &p : m.params) pinned.insert(p.name);
+                stmt(m.body.get());
+            }
+            for (const auto &c : cls->getConstructors()) {
+                for (const auto &p : c.params) pinned.insert(p.name);
+                stmt(c.body.get());
+            }
+        }
+    }
+
+    void expr(const Expr *e) {
+        if (!e) return;
+        if (auto *inc = dynamic_cast<const IncDecExpr*>(e)) {
+            pinned.insert(inc->getName());
+        } else if (auto *b = dynamic_cast<const BinaryExpr*>(e)) {
+            expr(b->getLeft());
+            expr(b->getRight());
+        } else if (auto *u = dynamic_cast<const UnaryExpr*>(e)) {
+            expr(u->getExpr());
+        } else if (auto *t = dynamic_cast<const TernaryExpr*>(e)) {
+            expr(t->getCondition());
+            expr(t->getThen());
+            expr(t->getElse());
+        } else if (auto *c = dynamic_cast<const CallExpr*>(e)) {
+            for (const auto &a : c->getArgs()) expr(a.get());
+        } else if (auto *m = dynamic_cast<const MemberCallExpr*>(e)) {
+            expr(m->getBase());
+            for (const auto &a : m->getArgs()) expr(a.get());
+        } else if (auto *n = dynamic_cast<const NewExpr*>(e)) {
+            for (const auto &a : n->getArgs()) expr(a.get());
+        } else if (auto *l = dynamic_cast<const ListExpr*>(e)) {
+            for (const auto &el : l->getElements()) expr(el.get());
+        } else if (auto *m = dynamic_cast<const MapExpr*>(e)) {
+            for (const auto &item : m->getItems()) {
+                expr(item.first.get());
+                expr(item.second.get());
+            }
+        } else if (auto *i = dynamic_cast<const IndexExpr*>(e)) {
+            expr(i->getBase());
+            expr(i->getIndex());
+        } else if (auto *m = dynamic_cast<const MemberExpr*>(e)) {
+            expr(m->getBase());
+        }
+    }
+
+    bool stable(const std::string &name) const {
+        auto it = decls.find(name);
+        return it != decls.end() && it->second == 1 && !pinned.count(name);
+    }
+};
+
+class ConstantFolder {
+public:
+    ConstantFolder(const NameScan &names, FoldStats &stats) : names(names), stats(stats) {}
+
+    // Cada funcion, metodo o constructor empieza sin constantes conocidas:
+    // puede ejecutarse antes de que el programa principal declare las suyas.
+    void function(BlockStmt *body) {
+        if (!body) return;
+        auto saved = std::move(env);
+        env.clear();
+        stmt(body);
+        env = std::move(saved);
+    }
+
+    template <typename T>
+    void list(std::vector<std::unique_ptr<T>> &items) {
+        for (size_t i = 0; i < items.size();) {
+            stmt(items[i].get());
+            auto *branch = dynamic_cast<IfStmt*>(items[i].get());
+            long long cond = 0;
+            if (!branch || !intValue(branch->getCondition(), cond)) {
+                ++i;
+                continue;
+            }
+            ++stats.deadBranches;
+            std::unique_ptr<BlockStmt> live = cond ? branch->takeThen() : branch->takeElse();
+            if (live) {
+                items[i] = std::move(live);
+                ++i;
+            } else {
+                items.erase(items.begin() + static_cast<long>(i));
+            }
+        }
+    }
+
+    void stmt(Node *node) {
+        if (!node) return;
+        if (auto *v = dynamic_cast<VarDeclStmt*>(node)) {
+            fold(v->getInit(), [&](std::unique_ptr<Expr> e) { v->setInit(std::move(e)); });
+            const Expr *init = v->getInit();
+            if (init && isLiteral(init) && literalMatchesType(init, v->getType()) &&
+                names.stable(v->getName())) {
+                env[v->getName()] = init;
+            }
+        } else if (auto *a = dynamic_cast<AssignStmt*>(node)) {
+            fold(a->getValue(), [&](std::unique_ptr<Expr> e) { a->setValue(std::move(e)); });
+        } else if (auto *a = dynamic_cast<IndexAssignStmt*>(node)) {
+            foldChildren(a->getBase());
+            fold(a->getIndex(), [&](std::unique_ptr<Expr> e) { a->setIndex(std::move(e)); });
+            fold(a->getValue(), [&](std::unique_ptr<Expr> e) { a->setValue(std::move(e)); });
+        } else if (auto *p = dynamic_cast<PrintStmt*>(node)) {
+            for (size_t i = 0; i < p->getExprs().size(); ++i) {
+                fold(p->getExprs()[i].get(), [&](std::unique_ptr<Expr> e) { p->setExpr(i, std::move(e)); });
+            }
+            foldChildren(p->getSeparator());
+            foldChildren(p->getTerminator());
+        } else if (auto *e = dynamic_cast<ExprStmt*>(node)) {
+            fold(e->getExpr(), [&](std::unique_ptr<Expr> r) { e->setExpr(std::move(r)); });
+        } else if (auto *b = dynamic_cast<BlockStmt*>(node)) {
+            auto saved = env;
+            list(b->statements);
+            env = std::move(saved);
+        } else if (auto *i = dynamic_cast<IfStmt*>(node)) {
+            fold(i->getCondition(), [&](std::unique_ptr<Expr> e) { i->setCondition(std::move(e)); });
+            stmt(i->getThen());
+            stmt(i->getElse());
+        } else if (auto *f = dynamic_cast<ForStmt*>(node)) {
+            auto saved = env;
+            stmt(f->getInit());
+            fold(f->getCondition(), [&](std::unique_ptr<Expr> e) { f->setCondition(std::move(e)); });
+            stmt(f->getPost());
+            stmt(f->getBody());
+            env = std::move(saved);
+        } else if (auto *w = dynamic_cast<WhileStmt*>(node)) {
+            fold(w->getCondition(), [&](std::unique_ptr<Expr> e) { w->setCondition(std::move(e)); });
+            stmt(w->getBody());
+        } else if (auto *d = dynamic_cast<DoWhileStmt*>(node)) {
+            stmt(d->getBody());
+            fold(d->getCondition(), [&](std::unique_ptr<Expr> e) { d->setCondition(std::move(e)); });
+        } else if (auto *r = dynamic_cast<ReturnStmt*>(node)) {
+            fold(r->getValue(), [&](std::unique_ptr<Expr> e) { r->setValue(std::move(e)); });
+        } else if (auto *sw = dynamic_cast<SwitchStmt*>(node)) {
+            foldChildren(sw->getExpr());
+            for (const auto &c : sw->getCases()) stmt(c.second.get());
+            stmt(sw->getDefault());
+        } else if (auto *t = dynamic_cast<ThrowStmt*>(node)) {
+            foldChildren(t->getType());
+            foldChildren(t->getMessage());
+        } else if (auto *t = dynamic_cast<TryStmt*>(node)) {
+            stmt(t->getTryBlock());
+            for (const auto &c : t->getCatches()) stmt(c.block.get());
+            stmt(t->getFinallyBlock());
+        } else if (auto *fn = dynamic_cast<FunctionStmt*>(node)) {
+            function(fn->getBody());
+        } else if (auto *cls = dynamic_cast<ClassStmt*>(node)) {
+            for (const auto &m : cls->getMethods()) function(m.body.get());
+            for (const auto &c : cls->getConstructors()) function(c.body.get());
+        }
+    }
+
+private:
+    template <typename Setter>
+    void fold(Expr *e, Setter set) {
+        if (auto replacement = expr(e)) set(std::move(replacement));
+    }
+
+    // Para posiciones sin setter: se pliegan solo las subexpresiones.
+    void foldChildren(Expr *e) {
+        expr(e);
+    }
+
+    // Devuelve el reemplazo de `e`, o nullptr si queda igual.
+    std::unique_ptr<Expr> expr(Expr *e) {
+        if (!e) return nullptr;
+        if (auto *v = dynamic_cast<VariableExpr*>(e)) {
+            auto it = env.find(v->getName());
+            if (it == env.end()) return nullptr;
+            ++stats.propagated;
+            return cloneLiteral(it->second, *v);
+        }
+        if (auto *b = dynamic_cast<BinaryExpr*>(e)) {
+            fold(b->getLeft(), [&](std::unique_ptr<Expr> r) { b->setLeft(std::move(r)); });
+            fold(b->getRight(), [&](std::unique_ptr<Expr> r) { b->setRight(std::move(r)); });
+            return binary(*b);
+        }
+        if (auto *u = dynamic_cast<UnaryExpr*>(e)) {
+            fold(u->getExpr(), [&](std::unique_ptr<Expr> r) { u->setExpr(std::move(r)); });
+            long long value = 0;
+            if (!intValue(u->getExpr(), value)) return nullptr;
+            if (u->getOp() == '!') {
+                ++stats.folded;
+                return literalAt<BoolExpr>(*u, value == 0);
+            }
+            if (u->getOp() == '-' && dynamic_cast<NumberExpr*>(u->getExpr())) {
+                ++stats.folded;
+                return literalAt<NumberExpr>(*u, wrap(0ULL - static_cast<unsigned long long>(value)));
+            }
+            return nullptr;
+        }
+        if (auto *t = dynamic_cast<TernaryExpr*>(e)) {
+            fold(t->getCondition(), [&](std::unique_ptr<Expr> r) { t->setCondition(std::move(r)); });
+            fold(t->getThen(), [&](std::unique_ptr<Expr> r) { t->setThen(std::move(r)); });
+            fold(t->getElse(), [&](std::unique_ptr<Expr> r) { t->setElse(std::move(r)); });
+            long long cond = 0;
+            if (!intValue(t->getCondition(), cond)) return nullptr;
+            ++stats.folded;
+            return cond ? t->takeThen() : t->takeElse();
+        }
+        if (auto *c = dynamic_cast<CallExpr*>(e)) {
+            for (size_t i = 0; i < c->getArgs().size(); ++i) {
+                fold(c->getArgs()[i].get(), [&](std::unique_ptr<Expr> r) { c->setArg(i, std::move(r)); });
+            }
+            return nullptr;
+        }
+        if (auto *m = dynamic_cast<MemberCallExpr*>(e)) {
+            foldChildren(m->getBase());
+            for (size_t i = 0; i < m->getArgs().size(); ++i) {
+                fold(m->getArgs()[i].get(), [&](std::unique_ptr<Expr> r) { m->setArg(i, std::move(r)); });
+            }
+            return nullptr;
+        }
+        if (auto *n = dynamic_cast<NewExpr*>(e)) {
+            for (size_t i = 0; i < n->getArgs().size(); ++i) {
+                fold(n->getArgs()[i].get(), [&](std::unique_ptr<Expr> r) { n->setArg(i, std::move(r)); });
+            }
+            return nullptr;
+        }
+        if (auto *l = dynamic_cast<ListExpr*>(e)) {
+            for (size_t i = 0; i < l->getElements().size(); ++i) {
+                fold(l->getElements()[i].get(), [&](std::unique_ptr<Expr> r) { l->setElement(i, std::move(r)); });
+            }
+            return nullptr;
+        }
+        if (auto *m = dynamic_cast<MapExpr*>(e)) {
+            for (const auto &item : m->getItems()) {
+                foldChildren(item.first.get());
+                foldChildren(item.second.get());
+            }
+            return nullptr;
+        }
+        if (auto *i = dynamic_cast<IndexExpr*>(e)) {
+            foldChildren(i->getBase());
+            fold(i->getIndex(), [&](std::unique_ptr<Expr> r) { i->setIndex(std::move(r)); });
+            return nullptr;
+        }
+        if (auto *m = dynamic_cast<MemberExpr*>(e)) {
+            foldChildren(m->getBase());
+        }
+        return nullptr;
+    }
+
+    std::unique_ptr<Expr> binary(const BinaryExpr &b) {
+        auto *ls = dynamic_cast<const StringExpr*>(b.getLeft());
+        auto *rs = dynamic_cast<const StringExpr*>(b.getRight());
+        if (ls && rs) {
+            switch (b.getOp()) {
+                case '+':
+                    ++stats.folded;
+                    return literalAt<StringExpr>(b, ls->getValue() + rs->getValue());
+                case 's':
+                case 'd': {
+                    bool equal = ls->getValue() == rs->getValue();
+                    ++stats.folded;
+                    return literalAt<BoolExpr>(b, b.getOp() == 's' ? equal : !equal);
+                }
+                default:
+                    return nullptr;
+            }
+        }
+        long long lhs = 0;
+        long long rhs = 0;
+        if (!intValue(b.getLeft(), lhs) || !intValue(b.getRight(), rhs)) return nullptr;
+        long long value = 0;
+        if (!foldInt(b.getOp(), lhs, rhs, value)) return nullptr;
+        ++stats.folded;
+        if (isBoolOp(b.getOp())) return literalAt<BoolExpr>(b, value != 0);
+        return literalAt<NumberExpr>(b, value);
+    }
+
+    const NameScan &names;
+    FoldStats &stats;
+    std::unordered_map<std::string, const Expr*> env;
+};
+
+} // namespace
+
+FoldStats foldConstants(std::vector<std::unique_ptr<Node>> &nodes) {
+    FoldStats stats;
+    NameScan names;
+    for (const auto &node : nodes) names.stmt(node.get());
+    ConstantFolder folder(names, stats);
+    folder.list(nodes);
+    return stats;
+}
+
+} // namespace aym
@@ -0,0 +1,26 @@
+#ifndef AYM_AST_FOLD_H
+#define AYM_AST_FOLD_H
+
+#include <memory>
+#include <vector>
+
+namespace aym {
+
+class Node;
+
+struct FoldStats {
+    int folded = 0;       // expresiones reemplazadas por un literal
+    int propagated = 0;   // lecturas de variables constantes sustituidas
+    int deadBranches = 0; // ramas de `ukaxa` eliminadas
+};
+
+// Pliega constantes sobre el AST ya validado por el analizador semantico:
+// aritmetica y comparaciones entre literales, concatenacion de cadenas
+// literales, ternarios y `ukaxa` con condicion constante. Las variables
+// declaradas una sola vez con un literal y nunca reasignadas se sustituyen
+// por su valor en el resto de su funcion (o del programa principal).
+FoldStats foldConstants(std::vector<std::unique_ptr<Node>> &nodes);
+
+} // namespace aym
+
+#endif // AYM_AST_FOLD_H
@@ -0,0 +1,612 @@
+#include "ast_inline.h"
+
+#include "ast.h"
+#include "../builtins/builtins.h"
+#include <cctype>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+namespace aym {
+
+namespace {
+
+// Tope de nodos para el cuerpo de una candidata y para cada llamada ya
+// expandida con sus argumentos.
+constexpr int kInlineMaxNodes = 40;
+
+// Vueltas maximas al convertir un cuerpo: cada `ukaxa` sin `kuttaya` copia el
+// resto del cuerpo en sus dos ramas.
+constexpr int kInlineMaxSteps = 4 * kInlineMaxNodes;
+
+using TypeMap = std::unordered_map<std::string, std::string>;
+
+// 'i' para `jakhüwi`, 'b' para `chiqa` y 0 para el resto: solo se ponen en
+// linea funciones numericas o booleanas.
+char typeKind(const std::string &type) {
+    if (type == "jakhüwi") return 'i';
+    if (type == "chiqa") return 'b';
+    return 0;
+}
+
+// Tipos visibles en la funcion que llama. Dentro de un metodo no se cae a las
+// globales: un nombre suelto puede ser un campo.
+struct Scope {
+    const TypeMap *locals = nullptr;
+    const TypeMap *globals = nullptr;
+
+    std::string type(const std::string &name) const {
+        if (locals) {
+            auto it = locals->find(name);
+            if (it != locals->end()) {
+                if (globals) {
+                    auto g = globals->find(name);
+                    if (g != globals->end() && g->second != it->second) return "";
+                }
+                return it->second;
+            }
+        }
+        if (globals) {
+            auto it = globals->find(name);
+            if (it != globals->end()) return it->second;
+        }
+        return "";
+    }
+};
+
+// Tipo de una expresion pura siguiendo isBoolExpr/isStringExpr del codegen.
+// Devuelve 0 si la expresion no es pura (llamadas, indices, `++`, listas...)
+// o si mezcla tipos, asi que tambien sirve para aceptar argumentos.
+char kindOf(const Expr *e, const Scope &scope) {
+    if (!e) return 0;
+    if (dynamic_cast<const NumberExpr*>(e)) return 'i';
+    if (dynamic_cast<const BoolExpr*>(e)) return 'b';
+    if (auto *v = dynamic_cast<const VariableExpr*>(e)) return typeKind(scope.type(v->getName()));
+    if (auto *u = dynamic_cast<const UnaryExpr*>(e)) {
+        char k = kindOf(u->getExpr(), scope);
+        if (!k) return 0;
+        if (u->getOp() == '!') return 'b';
+        return k == 'i' ? 'i' : 0;
+    }
+    if (auto *b = dynamic_cast<const BinaryExpr*>(e)) {
+        char l = kindOf(b->getLeft(), scope);
+        char r = kindOf(b->getRight(), scope);
+        if (!l || !r) return 0;
+        switch (b->getOp()) {
+            case '&': case '|': case 's': case 'd':
+            case '<': case 'l': case '>': case 'g':
+                return 'b';
+            default:
+                return l == 'i' && r == 'i' ? 'i' : 0;
+        }
+    }
+    if (auto *t = dynamic_cast<const TernaryExpr*>(e)) {
+        char c = kindOf(t->getCondition(), scope);
+        char a = kindOf(t->getThen(), scope);
+        char b = kindOf(t->getElse(), scope);
+        return c && a == b ? a : 0;
+    }
+    return 0;
+}
+
+int nodeCount(const Expr *e) {
+    if (!e) return 0;
+    if (auto *u = dynamic_cast<const UnaryExpr*>(e)) return 1 + nodeCount(u->getExpr());
+    if (auto *b = dynamic_cast<const BinaryExpr*>(e)) return 1 + nodeCount(b->getLeft()) + nodeCount(b->getRight());
+    if (auto *t = dynamic_cast<const TernaryExpr*>(e)) {
+        return 1 + nodeCount(t->getCondition()) + nodeCount(t->getThen()) + nodeCount(t->getElse());
+    }
+    return 1;
+}
+
+// `/` y `%` terminan en idiv: con divisor cero (o LLONG_MIN / -1) el programa
+// se cae. Una expresion asi no puede evaluarse de mas ni dejar de evaluarse.
+bool mayTrap(const Expr *e) {
+    if (auto *u = dynamic_cast<const UnaryExpr*>(e)) return mayTrap(u->getExpr());
+    if (auto *b = dynamic_cast<const BinaryExpr*>(e)) {
+        if (b->getOp() == '/' || b->getOp() == '%') {
+            auto *n = dynamic_cast<const NumberExpr*>(b->getRight());
+            if (!n || n->getValue() == 0 || n->getValue() == -1) return true;
+        }
+        return mayTrap(b->getLeft()) || mayTrap(b->getRight());
+    }
+    if (auto *t = dynamic_cast<const TernaryExpr*>(e)) {
+        return mayTrap(t->getCondition()) || mayTrap(t->getThen()) || mayTrap(t->getElse());
+    }
+    return false;
+}
+
+bool isTrivial(const Expr *e) {
+    return dynamic_cast<const NumberExpr*>(e) || dynamic_cast<const BoolExpr*>(e) ||
+           dynamic_cast<const VariableExpr*>(e);
+}
+
+template <typename T, typename... Args>
+std::unique_ptr<Expr> nodeAt(const Node &at, Args &&...args) {
+    auto node = std::make_unique<T>(std::forward<Args>(args)...);
+    node->setLocation(at.getLine(), at.getColumn());
+    return node;
+}
+
+// Copia una expresion pura conservando sus posiciones.
+std::unique_ptr<Expr> clonePure(const Expr *e) {
+    if (auto *n = dynamic_cast<const NumberExpr*>(e)) return nodeAt<NumberExpr>(*e, n->getValue());
+    if (auto *b = dynamic_cast<const BoolExpr*>(e)) return nodeAt<BoolExpr>(*e, b->getValue());
+    if (auto *v = dynamic_cast<const VariableExpr*>(e)) return nodeAt<VariableExpr>(*e, v->getName());
+    if (auto *u = dynamic_cast<const UnaryExpr*>(e)) return nodeAt<UnaryExpr>(*e, u->getOp(), clonePure(u->getExpr()));
+    if (auto *b = dynamic_cast<const BinaryExpr*>(e)) {
+        return nodeAt<BinaryExpr>(*e, b->getOp(), clonePure(b->getLeft()), clonePure(b->getRight()));
+    }
+    auto *t = static_cast<const TernaryExpr*>(e);
+    return nodeAt<TernaryExpr>(*e, clonePure(t->getCondition()), clonePure(t->getThen()),
+                               clonePure(t->getElse()));
+}
+
+// Cuerpo de una funcion convertido en una sola expresion: los `ukaxa` con
+// `kuttaya` pasan a ternarios y los `yatiya` quedan como valores con nombre que
+// se sustituyen donde se leen.
+struct Candidate {
+    std::vector<Param> params;
+    TypeMap types; // parametros y locales
+    std::unordered_map<std::string, std::unique_ptr<Expr>> locals;
+    std::unordered_map<std::string, const VarDeclStmt*> declared;
+    std::unique_ptr<Expr> body;
+    int steps = 0;
+};
+
+// Sustituye los argumentos de una llamada en el cuerpo de la candidata. Cuenta
+// cuantas veces se lee cada parametro o local para no duplicar ni perder una
+// division que puede fallar.
+class Expansion {
+public:
+    Expansion(const Candidate &cand, const std::vector<const Expr*> &args) : cand(cand) {
+        for (size_t i = 0; i < args.size(); ++i) bindings[cand.params[i].name] = {args[i], true};
+        for (const auto &local : cand.locals) bindings[local.first] = {local.second.get(), false};
+    }
+
+    std::unique_ptr<Expr> run(const Node &at) {
+        auto result = subst(cand.body.get(), false, at);
+        if (!result) return nullptr;
+        for (const auto &entry : bindings) {
+            const Binding &b = entry.second;
+            if (isTrivial(b.value) || !mayTrap(b.value)) continue;
+            if (b.uses != 1 || b.conditional) return nullptr;
+        }
+        if (nodeCount(result.get()) > kInlineMaxNodes) return nullptr;
+        return result;
+    }
+
+private:
+    struct Binding {
+        const Expr *value = nullptr;
+        bool param = false;
+        int uses = 0;
+        bool conditional = false;
+    };
+
+    std::unique_ptr<Expr> subst(const Expr *e, bool conditional, const Node &at) {
+        if (auto *n = dynamic_cast<const NumberExpr*>(e)) return nodeAt<NumberExpr>(at, n->getValue());
+        if (auto *b = dynamic_cast<const BoolExpr*>(e)) return nodeAt<BoolExpr>(at, b->getValue());
+        if (auto *v = dynamic_cast<const VariableExpr*>(e)) {
+            auto it = bindings.find(v->getName());
+            if (it == bindings.end()) return nullptr;
+            Binding &b = it->second;
+            ++b.uses;
+            b.conditional = b.conditional || conditional;
+            if (b.param) return clonePure(b.value);
+            return subst(b.value, conditional, at);
+        }
+        if (auto *u = dynamic_cast<const UnaryExpr*>(e)) {
+            auto inner = subst(u->getExpr(), conditional, at);
+            if (!inner) return nullptr;
+            return nodeAt<UnaryExpr>(at, u->getOp(), std::move(inner));
+        }
+        if (auto *b = dynamic_cast<const BinaryExpr*>(e)) {
+            // El lado derecho de `&` y `|` puede no evaluarse.
+            bool shortCircuit = b->getOp() == '&' || b->getOp() == '|';
+            auto lhs = subst(b->getLeft(), conditional, at);
+            auto rhs = subst(b->getRight(), conditional || shortCircuit, at);
+            if (!lhs || !rhs) return nullptr;
+            return nodeAt<BinaryExpr>(at, b->getOp(), std::move(lhs), std::move(rhs));
+        }
+        if (auto *t = dynamic_cast<const TernaryExpr*>(e)) {
+            auto cond = subst(t->getCondition(), conditional, at);
+            auto yes = subst(t->getThen(), true, at);
+            auto no = subst(t->getElse(), true, at);
+            if (!cond || !yes || !no) return nullptr;
+            return nodeAt<TernaryExpr>(at, std::move(cond), std::move(yes), std::move(no));
+        }
+        return nullptr;
+    }
+
+    const Candidate &cand;
+    std::unordered_map<std::string, Binding> bindings;
+};
+
+class Inliner {
+public:
+    explicit Inliner(const std::vector<std::unique_ptr<Node>> &nodes) {
+        const auto &builtins = getBuiltinFunctions();
+        for (const auto &node : nodes) {
+            auto *fn = dynamic_cast<const FunctionStmt*>(node.get());
+            if (!fn) continue;
+            std::string lower = fn->getName();
+            for (auto &ch : lower) ch = static_cast<char>(std::tolower(static_cast<unsigned char>(ch)));
+            // Un nombre repetido o que coincide con un builtin se deja tal cual.
+            bool clash = functions.count(fn->getName()) || builtins.count(lower);
+            functions[fn->getName()] = clash ? nullptr : fn;
+        }
+    }
+
+    int candidateCount() {
+        int count = 0;
+        for (const auto &fn : functions) {
+            if (candidate(fn.first)) ++count;
+        }
+        return count;
+    }
+
+    // Devuelve la expresion que reemplaza a la llamada, o nullptr si la
+    // llamada queda como esta.
+    std::unique_ptr<Expr> expand(const CallExpr &call, const Scope &scope) {
+        std::vector<const Expr*> args;
+        for (const auto &arg : call.getArgs()) args.push_back(arg.get());
+        return expandWith(call, args, scope);
+    }
+
+private:
+    const Candidate *candidate(const std::string &name) {
+        auto done = built.find(name);
+        if (done != built.end()) return done->second.get();
+        auto fn = functions.find(name);
+        // Una funcion que ya se esta convirtiendo es recursiva.
+        if (fn == functions.end() || !fn->second || building.count(name)) return nullptr;
+        building.insert(name);
+        auto cand = std::make_unique<Candidate>();
+        bool ok = build(*fn->second, *cand);
+        building.erase(name);
+        auto &slot = built[name];
+        slot = ok ? std::move(cand) : nullptr;
+        return slot.get();
+    }
+
+    std::unique_ptr<Expr> expandWith(const CallExpr &call, const std::vector<const Expr*> &args,
+                                     const Scope &scope) {
+        const Candidate *cand = candidate(call.getName());
+        if (!cand || args.size() != cand->params.size()) return nullptr;
+        for (size_t i = 0; i < args.size(); ++i) {
+            if (kindOf(args[i], scope) != typeKind(cand->params[i].type)) return nullptr;
+        }
+        return Expansion(*cand, args).run(call);
+    }
+
+    bool build(const FunctionStmt &fn, Candidate &cand) {
+        if (!typeKind(fn.getReturnType()) || !fn.getBody()) return false;
+        for (const auto &p : fn.getParams()) {
+            if (!typeKind(p.type) || cand.types.count(p.name)) return false;
+            cand.types[p.name] = p.type;
+        }
+        cand.params = fn.getParams();
+        std::vector<const Stmt*> seq;
+        for (const auto &s : fn.getBody()->statements) seq.push_back(s.get());
+        cand.body = tail(seq, 0, cand);
+        if (!cand.body) return false;
+        Scope scope{&cand.types, nullptr};
+        if (kindOf(cand.body.get(), scope) != typeKind(fn.getReturnType())) return false;
+        int size = nodeCount(cand.body.get());
+        for (const auto &local : cand.locals) size += nodeCount(local.second.get());
+        return size <= kInlineMaxNodes;
+    }
+
+    // Convierte seq[i..] en la expresion que devuelve. Falla con cualquier
+    // sentencia que no sea `yatiya`, `ukaxa` o `kuttaya`, o si algun camino
+    // termina sin `kuttaya`.
+    std::unique_ptr<Expr> tail(const std::vector<const Stmt*> &seq, size_t i, Candidate &cand) {
+        if (++cand.steps > kInlineMaxSteps) return nullptr;
+        for (; i < seq.size(); ++i) {
+            const Stmt *s = seq[i];
+            if (auto *block = dynamic_cast<const BlockStmt*>(s)) {
+                std::vector<const Stmt*> next;
+                for (const auto &inner : block->statements) next.push_back(inner.get());
+                next.insert(next.end(), seq.begin() + static_cast<long>(i) + 1, seq.end());
+                return tail(next, 0, cand);
+            }
+            if (auto *decl = dynamic_cast<const VarDeclStmt*>(s)) {
+                if (!declare(*decl, cand)) return nullptr;
+                continue;
+            }
+            if (auto *ret = dynamic_cast<const ReturnStmt*>(s)) {
+                return ret->getValue() ? templateExpr(ret->getValue(), cand) : nullptr;
+            }
+            if (auto *branch = dynamic_cast<const IfStmt*>(s)) {
+                auto cond = templateExpr(branch->getCondition(), cand);
+                if (!cond) return nullptr;
+                // Una rama sin `kuttaya` sigue con el resto del cuerpo.
+                auto withRest = [&](const BlockStmt *block) {
+                    std::vector<const Stmt*> path;
+                    if (block) {
+                        for (const auto &inner : block->statements) path.push_back(inner.get());
+                    }
+                    path.insert(path.end(), seq.begin() + static_cast<long>(i) + 1, seq.end());
+                    return path;
+                };
+                auto yes = tail(withRest(branch->getThen()), 0, cand);
+                if (!yes) return nullptr;
+                auto no = tail(withRest(branch->getElse()), 0, cand);
+                if (!no) return nullptr;
+                auto result = nodeAt<TernaryExpr>(*branch, std::move(cond), std::move(yes), std::move(no));
+                if (nodeCount(result.get()) > kInlineMaxNodes) return nullptr;
+                return result;
+            }
+            return nullptr;
+        }
+        return nullptr;
+    }
+
+    bool declare(const VarDeclStmt &decl, Candidate &cand) {
+        if (!typeKind(decl.getType()) || !decl.getInit()) return false;
+        auto seen = cand.declared.find(decl.getName());
+        // El mismo `yatiya` puede aparecer en las dos ramas de un `ukaxa`.
+        if (seen != cand.declared.end()) return seen->second == &decl;
+        if (cand.types.count(decl.getName())) return false;
+        auto init = templateExpr(decl.getInit(), cand);
+        if (!init) return false;
+        Scope scope{&cand.types, nullptr};
+        if (kindOf(init.get(), scope) != typeKind(decl.getType())) return false;
+        cand.types[decl.getName()] = decl.getType();
+        cand.declared[decl.getName()] = &decl;
+        cand.locals[decl.getName()] = std::move(init);
+        return true;
+    }
+
+    // Copia una expresion del cuerpo; las llamadas a otras candidatas se
+    // expanden aqui mismo.
+    std::unique_ptr<Expr> templateExpr(const Expr *e, Candidate &cand) {
+        if (auto *v = dynamic_cast<const VariableExpr*>(e)) {
+            if (!cand.types.count(v->getName())) return nullptr;
+            return clonePure(e);
+        }
+        if (dynamic_cast<const NumberExpr*>(e) || dynamic_cast<const BoolExpr*>(e)) return clonePure(e);
+        if (auto *u = dynamic_cast<const UnaryExpr*>(e)) {
+            auto inner = templateExpr(u->getExpr(), cand);
+            if (!inner) return nullptr;
+            return nodeAt<UnaryExpr>(*u, u->getOp(), std::move(inner));
+        }
+        if (auto *b = dynamic_cast<const BinaryExpr*>(e)) {
+            auto lhs = templateExpr(b->getLeft(), cand);
+            auto rhs = templateExpr(b->getRight(), cand);
+            if (!lhs || !rhs) return nullptr;
+            return nodeAt<BinaryExpr>(*b, b->getOp(), std::move(lhs), std::move(rhs));
+        }
+        if (auto *t = dynamic_cast<const TernaryExpr*>(e)) {
+            auto cond = templateExpr(t->getCondition(), cand);
+            auto yes = templateExpr(t->getThen(), cand);
+            auto no = templateExpr(t->getElse(), cand);
+            if (!cond || !yes || !no) return nullptr;
+            return nodeAt<TernaryExpr>(*t, std::move(cond), std::move(yes), std::move(no));
+        }
+        if (auto *c = dynamic_cast<const CallExpr*>(e)) {
+            std::vector<std::unique_ptr<Expr>> args;
+            std::vector<const Expr*> raw;
+            for (const auto &arg : c->getArgs()) {
+                args.push_back(templateExpr(arg.get(), cand));
+                if (!args.back()) return nullptr;
+                raw.push_back(args.back().get());
+            }
+            Scope scope{&cand.types, nullptr};
+            return expandWith(*c, raw, scope);
+        }
+        return nullptr;
+    }
+
+    std::unordered_map<std::string, const FunctionStmt*> functions;
+    std::unordered_map<std::string, std::unique_ptr<Candidate>> built;
+    std::unordered_set<std::string> building;
+};
+
+// Tipos declarados en un cuerpo, aplanados como en collectLocals. Un nombre
+// declarado dos veces con tipos distintos queda sin tipo.
+void collectTypes(const Node *node, TypeMap &types) {
+    if (!node) return;
+    auto add = [&](const std::string &name, const std::string &type) {
+        auto it = types.find(name);
+        if (it == types.end()) {
+            types[name] = type;
+        } else if (it->second != type) {
+            it->second.clear();
+        }
+    };
+    if (auto *v = dynamic_cast<const VarDeclStmt*>(node)) {
+        add(v->getName(), v->getType());
+    } else if (auto *b = dynamic_cast<const BlockStmt*>(node)) {
+        for (const auto &s : b->statements) collectTypes(s.get(), types);
+    } else if (auto *i = dynamic_cast<const IfStmt*>(node)) {
+        collectTypes(i->getThen(), types);
+        collectTypes(i->getElse(), types);
+    } else if (auto *f = dynamic_cast<const ForStmt*>(node)) {
+        collectTypes(f->getInit(), types);
+        collectTypes(f->getPost(), types);
+        collectTypes(f->getBody(), types);
+    } else if (auto *w = dynamic_cast<const WhileStmt*>(node)) {
+        collectTypes(w->getBody(), types);
+    } else if (auto *d = dynamic_cast<const DoWhileStmt*>(node)) {
+        collectTypes(d->getBody(), types);
+    } else if (auto *sw = dynamic_cast<const SwitchStmt*>(node)) {
+        for (const auto &c : sw->getCases()) collectTypes(c.second.get(), types);
+        collectTypes(sw->getDefault(), types);
+    } else if (auto *t = dynamic_cast<const TryStmt*>(node)) {
+        collectTypes(t->getTryBlock(), types);
+        for (const auto &c : t->getCatches()) {
+            add(c.varName, "");
+            collectTypes(c.block.get(), types);
+        }
+        collectTypes(t->getFinallyBlock(), types);
+    }
+}
+
+// Recorre todo el programa y reemplaza las llamadas que se pueden poner en
+// linea. Los argumentos se procesan antes que la llamada, asi `f(g(x))` puede
+// quedar sin llamadas.
+class CallRewriter {
+public:
+    CallRewriter(Inliner &inliner, InlineStats &stats) : inliner(inliner), stats(stats) {}
+
+    void program(std::vector<std::unique_ptr<Node>> &nodes) {
+        for (const auto &node : nodes) {
+            if (!dynamic_cast<const FunctionStmt*>(node.get()) && !dynamic_cast<const ClassStmt*>(node.get())) {
+                collectTypes(node.get(), globals);
+            }
+        }
+        for (auto &node : nodes) {
+            if (auto *fn = dynamic_cast<FunctionStmt*>(node.get())) {
+                function(fn->getName(), fn->getParams(), fn->getBody(), true);
+            } else if (auto *cls = dynamic_cast<ClassStmt*>(node.get())) {
+                for (const auto &m : cls->getMethods()) {
+                    function(cls->getName() + "." + m.name, m.params, m.body.get(), false);
+                }
+                for (const auto &c : cls->getConstructors()) {
+                    function(cls->getName() + ".qallta", c.params, c.body.get(), false);
+                }
+            } else {
+                caller = "programa principal";
+                scope = Scope{&globals, nullptr};
+                stmt(node.get());
+            }
+        }
+    }
+
+private:
+    void function(const std::string &name, const std::vector<Param> &params, BlockStmt *body,
+                  bool useGlobals) {
+        TypeMap locals;
+        for (const auto &p : params) locals[p.name] = p.type;
+        collectTypes(body, locals);
+        caller = name;
+        scope = Scope{&locals, useGlobals ? &globals : nullptr};
+        stmt(body);
+    }
+
+    template <typename Setter>
+    void rewrite(Expr *e, Setter set) {
+        if (auto replacement = expr(e)) set(std::move(replacement));
+    }
+
+    void stmt(Node *node) {
+        if (!node) return;
+        if (auto *v = dynamic_cast<VarDeclStmt*>(node)) {
+            rewrite(v->getInit(), [&](std::unique_ptr<Expr> e) { v->setInit(std::move(e)); });
+        } else if (auto *a = dynamic_cast<AssignStmt*>(node)) {
+            rewrite(a->getValue(), [&](std::unique_ptr<Expr> e) { a->setValue(std::move(e)); });
+        } else if (auto *a = dynamic_cast<IndexAssignStmt*>(node)) {
+            expr(a->getBase());
+            rewrite(a->getIndex(), [&](std::unique_ptr<Expr> e) { a->setIndex(std::move(e)); });
+            rewrite(a->getValue(), [&](std::unique_ptr<Expr> e) { a->setValue(std::move(e)); });
+        } else if (auto *p = dynamic_cast<PrintStmt*>(node)) {
+            for (size_t i = 0; i < p->getExprs().size(); ++i) {
+                rewrite(p->getExprs()[i].get(), [&](std::unique_ptr<Expr> e) { p->setExpr(i, std::move(e)); });
+            }
+            expr(p->getSeparator());
+            expr(p->getTerminator());
+        } else if (auto *e = dynamic_cast<ExprStmt*>(node)) {
+            // Una llamada suelta a una funcion pura no hace nada; se deja para
+            // no cambiar que expresiones se evaluan como sentencia.
+            expr(e->getExpr(), true);
+        } else if (auto *b = dynamic_cast<BlockStmt*>(node)) {
+            for (auto &s : b->statements) stmt(s.get());
+        } else if (auto *i = dynamic_cast<IfStmt*>(node)) {
+            rewrite(i->getCondition(), [&](std::unique_ptr<Expr> e) { i->setCondition(std::move(e)); });
+            stmt(i->getThen());
+            stmt(i->getElse());
+        } else if (auto *f = dynamic_cast<ForStmt*>(node)) {
+            stmt(f->getInit());
+            rewrite(f->getCondition(), [&](std::unique_ptr<Expr> e) { f->setCondition(std::move(e)); });
+            stmt(f->getPost());
+            stmt(f->getBody());
+        } else if (auto *w = dynamic_cast<WhileStmt*>(node)) {
+            rewrite(w->getCondition(), [&](std::unique_ptr<Expr> e) { w->setCondition(std::move(e)); });
+            stmt(w->getBody());
+        } else if (auto *d = dynamic_cast<DoWhileStmt*>(node)) {
+            stmt(d->getBody());
+            rewrite(d->getCondition(), [&](std::unique_ptr<Expr> e) { d->setCondition(std::move(e)); });
+        } else if (auto *r = dynamic_cast<ReturnStmt*>(node)) {
+            rewrite(r->getValue(), [&](std::unique_ptr<Expr> e) { r->setValue(std::move(e)); });
+        } else if (auto *sw = dynamic_cast<SwitchStmt*>(node)) {
+            expr(sw->getExpr());
+            for (const auto &c : sw->getCases()) stmt(c.second.get());
+            stmt(sw->getDefault());
+        } else if (auto *t = dynamic_cast<ThrowStmt*>(node)) {
+            expr(t->getType());
+            expr(t->getMessage());
+        } else if (auto *t = dynamic_cast<TryStmt*>(node)) {
+            stmt(t->getTryBlock());
+            for (const auto &c : t->getCatches()) stmt(c.block.get());
+            stmt(t->getFinallyBlock());
+        }
+    }
+
+    // Devuelve el reemplazo de `e`, o nullptr si queda igual.
+    std::unique_ptr<Expr> expr(Expr *e, bool statement = false) {
+        if (!e) return nullptr;
+        if (auto *b = dynamic_cast<BinaryExpr*>(e)) {
+            rewrite(b->getLeft(), [&](std::unique_ptr<Expr> r) { b->setLeft(std::move(r)); });
+            rewrite(b->getRight(), [&](std::unique_ptr<Expr> r) { b->setRight(std::move(r)); });
+        } else if (auto *u = dynamic_cast<UnaryExpr*>(e)) {
+            rewrite(u->getExpr(), [&](std::unique_ptr<Expr> r) { u->setExpr(std::move(r)); });
+        } else if (auto *t = dynamic_cast<TernaryExpr*>(e)) {
+            rewrite(t->getCondition(), [&](std::unique_ptr<Expr> r) { t->setCondition(std::move(r)); });
+            rewrite(t->getThen(), [&](std::unique_ptr<Expr> r) { t->setThen(std::move(r)); });
+            rewrite(t->getElse(), [&](std::unique_ptr<Expr> r) { t->setElse(std::move(r)); });
+        } else if (auto *c = dynamic_cast<CallExpr*>(e)) {
+            for (size_t i = 0; i < c->getArgs().size(); ++i) {
+                rewrite(c->getArgs()[i].get(), [&](std::unique_ptr<Expr> r) { c->setArg(i, std::move(r)); });
+            }
+            if (statement) return nullptr;
+            auto replacement = inliner.expand(*c, scope);
+            if (replacement) stats.sites.push_back({c->getName(), caller, c->getLine()});
+            return replacement;
+        } else if (auto *m = dynamic_cast<MemberCallExpr*>(e)) {
+            expr(m->getBase());
+            for (size_t i = 0; i < m->getArgs().size(); ++i) {
+                rewrite(m->getArgs()[i].get(), [&](std::unique_ptr<Expr> r) { m->setArg(i, std::move(r)); });
+            }
+        } else if (auto *n = dynamic_cast<NewExpr*>(e)) {
+            for (size_t i = 0; i < n->getArgs().size(); ++i) {
+                rewrite(n->getArgs()[i].get(), [&](std::unique_ptr<Expr> r) { n->setArg(i, std::move(r)); });
+            }
+        } else if (auto *l = dynamic_cast<ListExpr*>(e)) {
+            for (size_t i = 0; i < l->getElements().size(); ++i) {
+                rewrite(l->getElements()[i].get(), [&](std::unique_ptr<Expr> r) { l->setElement(i, std::move(r)); });
+            }
+        } else if (auto *m = dynamic_cast<MapExpr*>(e)) {
+            for (const auto &item : m->getItems()) {
+                expr(item.first.get());
+                expr(item.second.get());
+            }
+        } else if (auto *i = dynamic_cast<IndexExpr*>(e)) {
+            expr(i->getBase());
+            rewrite(i->getIndex(), [&](std::unique_ptr<Expr> r) { i->setIndex(std::move(r)); });
+        } else if (auto *m = dynamic_cast<MemberExpr*>(e)) {
+            expr(m->getBase());
+        }
+        return nullptr;
+    }
+
+    Inliner &inliner;
+    InlineStats &stats;
+    TypeMap globals;
+    Scope scope;
+    std::string caller;
+};
+
+} // namespace
+
+InlineStats inlineFunctions(std::vector<std::unique_ptr<Node>> &nodes) {
+    InlineStats stats;
+    Inliner inliner(nodes);
+    stats.candidates = inliner.candidateCount();
+    CallRewriter rewriter(inliner, stats);
+    rewriter.program(nodes);
+    return stats;
+}
+
+} // namespace aym
@@ -0,0 +1,33 @@
+#ifndef AYM_AST_INLINE_H
+#define AYM_AST_INLINE_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace aym {
+
+class Node;
+
+struct InlineSite {
+    std::string callee; // funcion puesta en linea
+    std::string caller; // funcion, metodo o "programa principal"
+    size_t line = 0;
+};
+
+struct InlineStats {
+    int candidates = 0;             // funciones que se pueden poner en linea
+    std::vector<InlineSite> sites;  // llamadas reemplazadas
+};
+
+// Pone en linea las llamadas a funciones chicas y puras sobre el AST ya
+// validado: cuerpos hechos solo de `yatiya`, `ukaxa` y `kuttaya` con numeros
+// y booleanos, sin recursion ni `yant'aña`, cuyo resultado no pasa de
+// kInlineMaxNodes nodos. La llamada se reemplaza por la expresion del cuerpo
+// con los argumentos sustituidos; los argumentos tambien deben ser puros.
+// Las definiciones quedan en el AST para `&f` y las llamadas no reemplazadas.
+InlineStats inlineFunctions(std::vector<std::unique_ptr<Node>> &nodes);
+
+} // namespace aym
+
+#endif // AYM_AST_INLINE_H
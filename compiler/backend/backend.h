@@ -35,6 +35,8 @@ bool runBackendCompile(BackendKind kind,
                        bool timePipeline,
                        const std::string &timePipelineJsonPath,
                        long long toolTimeoutMs,
+                       const std::string &runtimeOpt,
+                       bool gcStats,
                        std::string &errorMessage);
 
 } // namespace aym
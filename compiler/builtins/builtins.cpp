@@ -75,12 +75,34 @@ static const std::unordered_map<std::string, BuiltinInfo> builtins = {
     {BUILTIN_MAYJTAYA, {2, {}}},
     {BUILTIN_AJLLI, {2, {}}},
     {BUILTIN_THAQTHAPI, {3, {}}},
+    {BUILTIN_MAP_PAR, {2, {}}},
+    {BUILTIN_FILTER_PAR, {2, {}}},
+    {BUILTIN_REDUCE_PAR, {3, {}}},
     {BUILTIN_ULLANA_ARU, {1, {Type::String}}},
     {BUILTIN_QILLQANA_ARU, {2, {Type::String, Type::String}}},
     {BUILTIN_UTJI_ARKATA, {1, {Type::String}}},
     {BUILTIN_WAKICHA, {1, {}}},
+    {BUILTIN_WAKICHA_CLAVE, {2, {}}},
     {BUILTIN_THAQHA, {2, {}}},
-    {BUILTIN_SAPAKI, {1, {}}}
+    {BUILTIN_SAPAKI, {1, {}}},
+    {BUILTIN_TAMA, {1, {}}},
+    {BUILTIN_TAMA_YAPA, {2, {}}},
+    {BUILTIN_TAMA_UTJI, {2, {}}},
+    {BUILTIN_TAMA_APSU, {2, {}}},
+    {BUILTIN_TAMA_SUYU, {1, {}}},
+    {BUILTIN_TAMA_LISTA, {1, {}}},
+    {BUILTIN_SIQI, {1, {}}},
+    {BUILTIN_SIQI_QHIPA, {2, {}}},
+    {BUILTIN_SIQI_NAYRA, {2, {}}},
+    {BUILTIN_SIQI_APSU_QHIPA, {1, {}}},
+    {BUILTIN_SIQI_APSU_NAYRA, {1, {}}},
+    {BUILTIN_SIQI_SUYU, {1, {}}},
+    {BUILTIN_SIQI_LISTA, {1, {}}},
+    {BUILTIN_QULLU, {2, {}}},
+    {BUILTIN_QULLU_YAPA, {2, {}}},
+    {BUILTIN_QULLU_APSU, {1, {}}},
+    {BUILTIN_QULLU_PATA, {1, {}}},
+    {BUILTIN_QULLU_SUYU, {1, {}}}
 };
 
 const std::unordered_map<std::string, BuiltinInfo> &getBuiltinFunctions() {
@@ -91,12 +91,34 @@ constexpr const char BUILTIN_REDUCE[] = "reduce";
 constexpr const char BUILTIN_MAYJTAYA[] = "mayjtaya";
 constexpr const char BUILTIN_AJLLI[] = "ajlli";
 constexpr const char BUILTIN_THAQTHAPI[] = "thaqthapi";
+constexpr const char BUILTIN_MAP_PAR[] = "map_par";
+constexpr const char BUILTIN_FILTER_PAR[] = "filter_par";
+constexpr const char BUILTIN_REDUCE_PAR[] = "reduce_par";
 constexpr const char BUILTIN_ULLANA_ARU[] = "ullana_aru";
 constexpr const char BUILTIN_QILLQANA_ARU[] = "qillqana_aru";
 constexpr const char BUILTIN_UTJI_ARKATA[] = "utji_arkata";
 constexpr const char BUILTIN_WAKICHA[] = "wakicha";
+constexpr const char BUILTIN_WAKICHA_CLAVE[] = "wakicha_clave";
 constexpr const char BUILTIN_THAQHA[] = "thaqha";
 constexpr const char BUILTIN_SAPAKI[] = "sapaki";
+constexpr const char BUILTIN_TAMA[] = "tama";
+constexpr const char BUILTIN_TAMA_YAPA[] = "tama_yapa";
+constexpr const char BUILTIN_TAMA_UTJI[] = "tama_utji";
+constexpr const char BUILTIN_TAMA_APSU[] = "tama_apsu";
+constexpr const char BUILTIN_TAMA_SUYU[] = "tama_suyu";
+constexpr const char BUILTIN_TAMA_LISTA[] = "tama_lista";
+constexpr const char BUILTIN_SIQI[] = "siqi";
+constexpr const char BUILTIN_SIQI_QHIPA[] = "siqi_qhipa";
+constexpr const char BUILTIN_SIQI_NAYRA[] = "siqi_nayra";
+constexpr const char BUILTIN_SIQI_APSU_QHIPA[] = "siqi_apsu_qhipa";
+constexpr const char BUILTIN_SIQI_APSU_NAYRA[] = "siqi_apsu_nayra";
+constexpr const char BUILTIN_SIQI_SUYU[] = "siqi_suyu";
+constexpr const char BUILTIN_SIQI_LISTA[] = "siqi_lista";
+constexpr const char BUILTIN_QULLU[] = "qullu";
+constexpr const char BUILTIN_QULLU_YAPA[] = "qullu_yapa";
+constexpr const char BUILTIN_QULLU_APSU[] = "qullu_apsu";
+constexpr const char BUILTIN_QULLU_PATA[] = "qullu_pata";
+constexpr const char BUILTIN_QULLU_SUYU[] = "qullu_suyu";
 
 const std::unordered_map<std::string, BuiltinInfo> &getBuiltinFunctions();
 std::string typeName(Type t);
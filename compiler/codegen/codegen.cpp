@@ -18,6 +18,10 @@ bool CodeGenerator::generate(const std::vector<std::unique_ptr<Node>> &nodes,
                              long long toolTimeoutMs,
                              std::string *errorMessage) {
     CodeGenImpl impl;
+    impl.useIr = !irDumpPath.empty();
+    impl.irDumpPath = irDumpPath;
+    impl.runtimeOpt = runtimeOpt;
+    impl.gcStats = gcStats;
     return impl.emit(nodes,
                      outputPath,
                      globals,
@@ -34,6 +34,19 @@ public:
                   const std::string &timePipelineJsonPath = "",
                   long long toolTimeoutMs = 0,
                   std::string *errorMessage = nullptr);
+
+    // Activa el backend ir: el AST pasa por el IR SSA, que se vuelca en
+    // `path` y se baja a NASM en lugar de emitirse directamente.
+    void setIrDumpPath(const std::string &path) { irDumpPath = path; }
+    // Nivel de optimizacion con el que gcc compila el runtime C (O0|O2|O3).
+    void setRuntimeOptLevel(const std::string &level) { runtimeOpt = level; }
+    // El ejecutable imprime al salir el resumen del recolector (--gc-stats).
+    void setGcStats(bool enabled) { gcStats = enabled; }
+
+private:
+    std::string irDumpPath;
+    std::string runtimeOpt = "O2";
+    bool gcStats = false;
 };
 
 } // namespace aym
@@ -9,6 +9,7 @@ void CodeGenImpl::registerClass(const ClassStmt *cls) {
     classes[cls->getName()] = cls;
     for (const auto &method : cls->getMethods()) {
         FunctionInfo info;
+        info.className = cls->getName();
         info.name = method.isStatic
             ? classStaticMethodName(cls->getName(), method.name)
             : classMethodName(cls->getName(), method.name);
@@ -27,6 +28,7 @@ void CodeGenImpl::registerClass(const ClassStmt *cls) {
     }
     for (const auto &ctor : cls->getConstructors()) {
         FunctionInfo info;
+        info.className = cls->getName();
         info.name = classCtorName(cls->getName(), ctor.params.size());
         info.params = ctor.params;
         info.params.insert(info.params.begin(), Param{"kasta:" + cls->getName(), "Aka"});
@@ -42,34 +44,39 @@ void CodeGenImpl::registerClass(const ClassStmt *cls) {
 }
 
 void CodeGenImpl::collectClassStrings() {
+    auto addString = [&](const std::string &value) {
+        if (std::find(strings.begin(), strings.end(), value) == strings.end()) {
+            strings.push_back(value);
+        }
+    };
     for (const auto &pair : classes) {
         const ClassStmt *cls = pair.second;
+        addString(cls->getName());
         for (const auto &field : cls->getFields()) {
             collectStrings(field.init.get());
-            if (std::find(strings.begin(), strings.end(), field.name) == strings.end()) {
-                strings.push_back(field.name);
-            }
+            addString(field.name);
         }
         for (const auto &method : cls->getMethods()) {
-            if (std::find(strings.begin(), strings.end(), method.name) == strings.end()) {
-                strings.push_back(method.name);
-            }
-        }
-        if (!cls->getBase().empty()) {
-            auto baseIt = classes.find(cls->getBase());
-            if (baseIt != classes.end()) {
-                const ClassStmt *base = baseIt->second;
-                for (const auto &method : base->getMethods()) {
-                    std::string superKey = classSuperKey(method.name);
-                    if (std::find(strings.begin(), strings.end(), superKey) == strings.end()) {
-                        strings.push_back(superKey);
-                    }
-                }
-            }
+            addString(method.name);
         }
     }
 }
 
+void CodeGenImpl::emitObjectNullCheck(const Expr *base, const std::string &member) {
+    // Aka nunca es nulo dentro de un metodo; para el resto se delega el error
+    // a aym_object_get, que lanza CLAVE igual que el acceso dinamico.
+    if (auto *v = dynamic_cast<const VariableExpr*>(base); v && v->getName() == "Aka") {
+        return;
+    }
+    std::string ok = genLabel("obj_ok");
+    out << "    test rax, rax\n";
+    out << "    jnz " << ok << "\n";
+    out << "    mov " << reg1(this->windows) << ", rax\n";
+    out << "    lea " << reg2(this->windows) << ", [rel str" << findString(member) << "]\n";
+    out << "    call aym_object_get\n";
+    out << ok << ":\n";
+}
+
 bool CodeGenImpl::emitNewExpr(const NewExpr *expr,
                              const std::unordered_map<std::string,int> *locals) {
     auto it = classes.find(expr->getName());
@@ -78,77 +85,34 @@ bool CodeGenImpl::emitNewExpr(const NewExpr *expr,
         return true;
     }
     const ClassStmt *cls = it->second;
-    std::vector<const ClassStmt*> lineage;
-    for (const ClassStmt *c = cls; c; ) {
-        lineage.push_back(c);
-        if (c->getBase().empty()) break;
-        auto baseIt = classes.find(c->getBase());
-        if (baseIt == classes.end()) break;
-        c = baseIt->second;
-    }
-    std::reverse(lineage.begin(), lineage.end());
-    std::vector<const ClassStmt::FieldDecl*> fields;
-    std::unordered_map<std::string, std::string> methods;
-    for (const auto *c : lineage) {
-        for (const auto &field : c->getFields()) {
-            if (!field.isStatic) {
-                fields.push_back(&field);
-            }
-        }
-        for (const auto &method : c->getMethods()) {
-            if (!method.isStatic) {
-                methods[method.name] = classMethodName(c->getName(), method.name);
-            }
-        }
-    }
-    std::unordered_map<std::string, std::string> superMethods;
-    if (!cls->getBase().empty()) {
-        auto baseIt = classes.find(cls->getBase());
-        if (baseIt != classes.end()) {
-            const ClassStmt *base = baseIt->second;
-            for (const auto &method : base->getMethods()) {
-                if (!method.isStatic) {
-                    superMethods[method.name] = classMethodName(base->getName(), method.name);
-                }
-            }
-        }
-    }
-    size_t mapSize = fields.size() + methods.size() + superMethods.size();
-    out << "    mov " << reg1(this->windows) << ", " << mapSize << "\n";
-    out << "    call aym_map_new\n";
-    out << "    mov r12, rax\n";
+    const ObjectLayout &layout = objectLayout(cls->getName());
     std::vector<std::string> regs = paramRegs(this->windows);
-    for (const auto *field : fields) {
-        if (field->init) {
-            emitExpr(field->init.get(), locals);
-        } else {
-            out << "    mov rax, 0\n";
+    // La instancia en construccion vive en la pila mientras se evaluan los
+    // inicializadores y los argumentos del constructor.
+    size_t shadow = this->windows ? 32 : 0;
+    std::string self = "[rsp+" + std::to_string(shadow) + "]";
+    out << "    sub rsp, " << (shadow + 16) << "\n";
+    auto stack = currentStackSlots.find(expr);
+    if (stack != currentStackSlots.end()) {
+        // Instancia que no escapa: vive en el marco (ver assignStackSlots).
+        int base = stack->second;
+        out << "    lea rax, [rbp-" << base << "]\n";
+        out << "    lea rcx, [rel " << classInfoName(cls->getName()) << "]\n";
+        out << "    mov [rax], rcx\n";
+        for (long off = 8; off < kObjectHeaderBytes + 8 * static_cast<long>(layout.fields.size()); off += 8) {
+            out << "    mov qword [rax+" << off << "], 0\n";
         }
-        out << "    mov r14, rax\n";
-        size_t keyIdx = findString(field->name);
-        out << "    lea " << regs[1] << ", [rel str" << keyIdx << "]\n";
-        out << "    mov " << regs[2] << ", r14\n";
-        out << "    mov " << regs[3] << ", "
-            << (field->init && isStringExpr(field->init.get(), locals) ? 1 : 0) << "\n";
-        out << "    mov " << regs[0] << ", r12\n";
-        out << "    call aym_map_set\n";
-    }
-    for (const auto &method : methods) {
-        size_t keyIdx = findString(method.first);
-        out << "    lea " << regs[1] << ", [rel str" << keyIdx << "]\n";
-        out << "    lea " << regs[2] << ", [rel " << method.second << "]\n";
-        out << "    mov " << regs[3] << ", 0\n";
-        out << "    mov " << regs[0] << ", r12\n";
-        out << "    call aym_map_set\n";
-    }
-    for (const auto &method : superMethods) {
-        std::string superKey = classSuperKey(method.first);
-        size_t keyIdx = findString(superKey);
-        out << "    lea " << regs[1] << ", [rel str" << keyIdx << "]\n";
-        out << "    lea " << regs[2] << ", [rel " << method.second << "]\n";
-        out << "    mov " << regs[3] << ", 0\n";
-        out << "    mov " << regs[0] << ", r12\n";
-        out << "    call aym_map_set\n";
+    } else {
+        out << "    lea " << regs[0] << ", [rel " << classInfoName(cls->getName()) << "]\n";
+        out << "    call aym_object_new\n";
+    }
+    out << "    mov " << self << ", rax\n";
+    for (size_t i = 0; i < layout.fieldDecls.size(); ++i) {
+        const auto *field = layout.fieldDecls[i];
+        if (!field->init) continue;
+        emitExpr(field->init.get(), locals);
+        out << "    mov rcx, " << self << "\n";
+        out << "    mov [rcx+" << (kObjectHeaderBytes + 8 * static_cast<long>(i)) << "], rax\n";
     }
     bool hasCtor = false;
     for (const auto &ctor : cls->getConstructors()) {
@@ -159,17 +123,31 @@ bool CodeGenImpl::emitNewExpr(const NewExpr *expr,
     }
     if (hasCtor) {
         std::string ctorName = classCtorName(cls->getName(), expr->getArgs().size());
-        for (size_t i = 0; i < expr->getArgs().size() && i + 1 < regs.size(); ++i) {
-            emitExpr(expr->getArgs()[i].get(), locals);
-            out << "    mov " << regs[i + 1] << ", rax\n";
-        }
-        out << "    mov " << regs[0] << ", r12\n";
+        emitCallArgs(expr->getArgs(), locals, 1);
+        out << "    mov " << regs[0] << ", " << self << "\n";
         out << "    call " << ctorName << "\n";
     }
-    out << "    mov rax, r12\n";
+    out << "    mov rax, " << self << "\n";
+    out << "    add rsp, " << (shadow + 16) << "\n";
     return true;
 }
 
+std::string CodeGenImpl::superMethodImpl(const std::string &method) const {
+    auto it = classes.find(currentClass);
+    std::unordered_set<std::string> seen;
+    while (it != classes.end() && !it->second->getBase().empty()) {
+        if (!seen.insert(it->first).second) break;
+        it = classes.find(it->second->getBase());
+        if (it == classes.end()) break;
+        for (const auto &m : it->second->getMethods()) {
+            if (!m.isStatic && m.name == method) {
+                return classMethodName(it->first, method);
+            }
+        }
+    }
+    return "";
+}
+
 bool CodeGenImpl::emitMemberCallExpr(const MemberCallExpr *expr,
                                     const std::unordered_map<std::string,int> *locals) {
     if (!expr) {
@@ -182,39 +160,92 @@ bool CodeGenImpl::emitMemberCallExpr(const MemberCallExpr *expr,
     }
     std::vector<std::string> regs = paramRegs(this->windows);
     if (dynamic_cast<const SuperExpr*>(expr->getBase())) {
-        if (locals && locals->count("Aka")) {
-            out << "    mov rbx, [rbp-" << locals->at("Aka") << "]\n";
-        } else {
-            out << "    mov rbx, [rel Aka]\n";
+        // jilaaka.metodo() se resuelve en compilacion contra la base de la
+        // clase que contiene la llamada.
+        std::string impl = superMethodImpl(expr->getMember());
+        if (impl.empty()) {
+            out << "    mov rax, 0\n";
+            return true;
         }
-        std::string superKey = classSuperKey(expr->getMember());
-        size_t keyIdx = findString(superKey);
-        out << "    lea " << regs[1] << ", [rel str" << keyIdx << "]\n";
-        out << "    mov " << regs[0] << ", rbx\n";
-        out << "    call aym_map_get\n";
-    } else {
+        emitCallArgs(expr->getArgs(), locals, 1);
+        out << "    mov " << regs[0] << ", " << varOperand("Aka", locals) << "\n";
+        out << "    call " << impl << "\n";
+        return true;
+    }
+    std::string className = objectClassOf(expr->getBase(), locals);
+    long slot = objectMethodSlot(className, expr->getMember());
+    size_t shadow = this->windows ? 32 : 0;
+    if (slot < 0) {
+        // Receptor sin clase estatica conocida: busqueda por nombre.
         emitExpr(expr->getBase(), locals);
-        out << "    mov rbx, rax\n";
-        size_t keyIdx = findString(expr->getMember());
-        out << "    lea " << regs[1] << ", [rel str" << keyIdx << "]\n";
-        out << "    mov " << regs[0] << ", rbx\n";
-        out << "    call aym_map_get\n";
-    }
-    out << "    mov r14, rax\n";
-    out << "    mov r12, rbx\n";
-    emitCallArgs(expr->getArgs(), locals, 1);
-    out << "    mov " << regs[0] << ", r12\n";
-    out << "    call r14\n";
+        out << "    sub rsp, " << (shadow + 16) << "\n";
+        out << "    mov [rsp+" << shadow << "], rax\n";
+        out << "    mov " << regs[0] << ", rax\n";
+        out << "    lea " << regs[1] << ", [rel str" << findString(expr->getMember()) << "]\n";
+        out << "    call aym_object_method\n";
+        out << "    mov [rsp+" << (shadow + 8) << "], rax\n";
+        emitCallArgs(expr->getArgs(), locals, 1);
+        out << "    mov " << regs[0] << ", [rsp+" << shadow << "]\n";
+        out << "    mov rax, [rsp+" << (shadow + 8) << "]\n";
+        out << "    add rsp, " << (shadow + 16) << "\n";
+        out << "    call rax\n";
+        return true;
+    }
+    emitExpr(expr->getBase(), locals);
+    emitObjectNullCheck(expr->getBase(), expr->getMember());
+    if (expr->getArgs().empty()) {
+        out << "    mov " << regs[0] << ", rax\n";
+    } else {
+        out << "    sub rsp, " << (shadow + 16) << "\n";
+        out << "    mov [rsp+" << shadow << "], rax\n";
+        emitCallArgs(expr->getArgs(), locals, 1);
+        out << "    mov " << regs[0] << ", [rsp+" << shadow << "]\n";
+        out << "    add rsp, " << (shadow + 16) << "\n";
+    }
+    // Si ninguna subclase sobrescribe el metodo, la llamada es directa.
+    std::string direct = devirtualizedMethod(className, expr->getMember());
+    if (!direct.empty()) {
+        out << "    call " << direct << "\n";
+        return true;
+    }
+    out << "    mov rax, [" << regs[0] << "]\n";
+    out << "    call [rax+" << (kClassInfoBytes + 8 * slot) << "]\n";
     return true;
 }
 
 bool CodeGenImpl::emitSuperExpr(const SuperExpr *,
                                const std::unordered_map<std::string,int> *locals) {
-    if (locals && locals->count("Aka")) {
-        out << "    mov rax, [rbp-" << locals->at("Aka") << "]\n";
-    } else {
-        out << "    mov rax, [rel Aka]\n";
+    out << "    mov rax, " << varOperand("Aka", locals) << "\n";
+    return true;
+}
+
+bool CodeGenImpl::emitObjectMapCall(const CallExpr *c,
+                                    const std::unordered_map<std::string,int> *locals,
+                                    const std::string &runtimeFn) {
+    const auto &args = c->getArgs();
+    if (args.empty() || objectClassOf(args[0].get(), locals).empty()) {
+        return false;
     }
+    // Los builtins de mapas reciben una vista del objeto como mapa; el resto
+    // de argumentos se prepara igual que en emitCallArgs.
+    std::vector<std::string> regs = paramRegs(this->windows);
+    size_t count = std::min(args.size(), regs.size());
+    size_t shadow = this->windows ? 32 : 0;
+    size_t frame = (shadow + count * 8 + 15) & ~static_cast<size_t>(15);
+    out << "    sub rsp, " << frame << "\n";
+    for (size_t i = 1; i < count; ++i) {
+        emitExpr(args[i].get(), locals);
+        out << "    mov [rsp+" << (shadow + i * 8) << "], rax\n";
+    }
+    emitExpr(args[0].get(), locals);
+    out << "    mov " << regs[0] << ", rax\n";
+    out << "    call aym_object_to_map\n";
+    out << "    mov " << regs[0] << ", rax\n";
+    for (size_t i = 1; i < count; ++i) {
+        out << "    mov " << regs[i] << ", [rsp+" << (shadow + i * 8) << "]\n";
+    }
+    out << "    add rsp, " << frame << "\n";
+    out << "    call " << runtimeFn << "\n";
     return true;
 }
 
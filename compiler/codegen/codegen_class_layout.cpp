@@ -0,0 +1,173 @@
+#include "codegen_impl.h"
+#include "../utils/class_names.h"
+
+#include <algorithm>
+
+namespace aym {
+
+const CodeGenImpl::ObjectLayout &CodeGenImpl::objectLayout(const std::string &className) {
+    auto cached = objectLayouts.find(className);
+    if (cached != objectLayouts.end()) return cached->second;
+
+    ObjectLayout layout;
+    auto it = classes.find(className);
+    if (it != classes.end()) {
+        const ClassStmt *cls = it->second;
+        // La clase base va primero: sus atributos y metodos conservan el mismo
+        // slot en todas las subclases, asi que un acceso resuelto con el tipo
+        // estatico sigue siendo valido para cualquier instancia derivada.
+        if (!cls->getBase().empty() && cls->getBase() != className) {
+            layout = objectLayout(cls->getBase());
+        }
+        for (const auto &field : cls->getFields()) {
+            if (field.isStatic) continue;
+            auto pos = std::find(layout.fields.begin(), layout.fields.end(), field.name);
+            if (pos == layout.fields.end()) {
+                layout.fields.push_back(field.name);
+                layout.fieldDecls.push_back(&field);
+            } else {
+                layout.fieldDecls[static_cast<size_t>(pos - layout.fields.begin())] = &field;
+            }
+        }
+        for (const auto &method : cls->getMethods()) {
+            if (method.isStatic) continue;
+            std::string impl = classMethodName(cls->getName(), method.name);
+            auto pos = std::find(layout.methods.begin(), layout.methods.end(), method.name);
+            if (pos == layout.methods.end()) {
+                layout.methods.push_back(method.name);
+                layout.methodImpls.push_back(impl);
+            } else {
+                layout.methodImpls[static_cast<size_t>(pos - layout.methods.begin())] = impl;
+            }
+        }
+    }
+    return objectLayouts.emplace(className, std::move(layout)).first->second;
+}
+
+long CodeGenImpl::objectFieldOffset(const std::string &className, const std::string &field) {
+    if (className.empty() || !classes.count(className)) return -1;
+    const ObjectLayout &layout = objectLayout(className);
+    auto pos = std::find(layout.fields.begin(), layout.fields.end(), field);
+    if (pos == layout.fields.end()) return -1;
+    return kObjectHeaderBytes + 8 * static_cast<long>(pos - layout.fields.begin());
+}
+
+long CodeGenImpl::objectMethodSlot(const std::string &className, const std::string &method) {
+    if (className.empty() || !classes.count(className)) return -1;
+    const ObjectLayout &layout = objectLayout(className);
+    auto pos = std::find(layout.methods.begin(), layout.methods.end(), method);
+    if (pos == layout.methods.end()) return -1;
+    return static_cast<long>(pos - layout.methods.begin());
+}
+
+bool CodeGenImpl::isSubclassOf(const std::string &derived, const std::string &base) const {
+    std::unordered_set<std::string> seen;
+    auto it = classes.find(derived);
+    while (it != classes.end() && seen.insert(it->first).second) {
+        const std::string &parent = it->second->getBase();
+        if (parent == base) return true;
+        it = classes.find(parent);
+    }
+    return false;
+}
+
+std::string CodeGenImpl::devirtualizedMethod(const std::string &className, const std::string &method) {
+    long slot = objectMethodSlot(className, method);
+    if (slot < 0) return "";
+    std::string impl = objectLayout(className).methodImpls[static_cast<size_t>(slot)];
+    // Basta con que una subclase sobrescriba el metodo para necesitar la vtable.
+    for (const auto &pair : classes) {
+        if (!isSubclassOf(pair.first, className)) continue;
+        if (objectLayout(pair.first).methodImpls[static_cast<size_t>(slot)] != impl) return "";
+    }
+    return impl;
+}
+
+std::string CodeGenImpl::objectClassOf(const Expr *expr,
+                                       const std::unordered_map<std::string,int> *locals) const {
+    (void)locals;
+    // El semantico anota "kasta:X"; collectLocals conserva el tipo declarado.
+    auto classFromType = [&](const std::string &type) -> std::string {
+        std::string name = type.rfind("kasta:", 0) == 0 ? type.substr(6) : type;
+        return classes.count(name) ? name : "";
+    };
+    if (!expr) return "";
+    if (auto *n = dynamic_cast<const NewExpr*>(expr)) {
+        return classes.count(n->getName()) ? n->getName() : "";
+    }
+    if (auto *v = dynamic_cast<const VariableExpr*>(expr)) {
+        if (v->getName() == "Aka") return currentClass;
+        auto pit = currentParamTypes.find(v->getName());
+        if (pit != currentParamTypes.end()) return classFromType(pit->second);
+        auto lit = currentLocalTypes.find(v->getName());
+        if (lit != currentLocalTypes.end()) return classFromType(lit->second);
+        auto git = globalTypes.find(v->getName());
+        if (git != globalTypes.end()) return classFromType(git->second);
+        return "";
+    }
+    if (auto *m = dynamic_cast<const MemberExpr*>(expr)) {
+        return classFromType(m->getResolvedType());
+    }
+    if (auto *m = dynamic_cast<const MemberCallExpr*>(expr)) {
+        return classFromType(m->getResolvedType());
+    }
+    if (auto *c = dynamic_cast<const CallExpr*>(expr)) {
+        auto it = functionReturnTypes.find(c->getName());
+        if (it != functionReturnTypes.end()) return classFromType(it->second);
+    }
+    return "";
+}
+
+void CodeGenImpl::emitClassInfo() {
+    if (classes.empty()) return;
+    std::vector<std::string> names;
+    for (const auto &pair : classes) names.push_back(pair.first);
+    std::sort(names.begin(), names.end());
+    // Descriptores y vtables no cambian en ejecucion.
+    out << (this->windows ? "section .rdata\n" : "section .rodata\n");
+    for (const auto &name : names) {
+        const ClassStmt *cls = classes.at(name);
+        const ObjectLayout &layout = objectLayout(name);
+        std::string info = classInfoName(name);
+        if (!layout.fields.empty()) {
+            out << info << "_fields: dq ";
+            for (size_t i = 0; i < layout.fields.size(); ++i) {
+                out << (i ? ", " : "") << "str" << findString(layout.fields[i]);
+            }
+            out << "\n";
+            out << info << "_types: db ";
+            for (size_t i = 0; i < layout.fieldDecls.size(); ++i) {
+                out << (i ? ", " : "") << (layout.fieldDecls[i]->type == "aru" ? 1 : 0);
+            }
+            out << "\n";
+        }
+        if (!layout.methods.empty()) {
+            out << info << "_methods: dq ";
+            for (size_t i = 0; i < layout.methods.size(); ++i) {
+                out << (i ? ", " : "") << "str" << findString(layout.methods[i]);
+            }
+            out << "\n";
+        }
+        // Mismo orden que AymClass en runtime/runtime_objects.c. La vtable va
+        // inmediatamente despues para despachar con [cls+kClassInfoBytes+8*slot].
+        std::string base = classes.count(cls->getBase()) ? classInfoName(cls->getBase()) : "0";
+        out << "align 8\n";
+        out << info << ": dq str" << findString(name) << ", " << base << ", "
+            << layout.fields.size() << ", " << (layout.fields.empty() ? "0" : info + "_fields") << ", "
+            << (layout.fields.empty() ? "0" : info + "_types") << ", "
+            << layout.methods.size() << ", " << (layout.methods.empty() ? "0" : info + "_methods") << ", "
+            << info << "_vtable\n";
+        out << info << "_vtable:";
+        if (layout.methodImpls.empty()) {
+            out << "\n";
+            continue;
+        }
+        out << " dq ";
+        for (size_t i = 0; i < layout.methodImpls.size(); ++i) {
+            out << (i ? ", " : "") << layout.methodImpls[i];
+        }
+        out << "\n";
+    }
+}
+
+} // namespace aym
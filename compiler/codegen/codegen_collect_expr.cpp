@@ -55,12 +55,6 @@ void CodeGenImpl::collectStrings(const Expr *expr) {
         if (std::find(strings.begin(), strings.end(), m->getMember()) == strings.end()) {
             strings.push_back(m->getMember());
         }
-        if (dynamic_cast<const SuperExpr*>(m->getBase())) {
-            std::string superKey = classSuperKey(m->getMember());
-            if (std::find(strings.begin(), strings.end(), superKey) == strings.end()) {
-                strings.push_back(superKey);
-            }
-        }
         return;
     }
     if (auto *n = dynamic_cast<const NewExpr*>(expr)) {
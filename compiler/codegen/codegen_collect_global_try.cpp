@@ -68,6 +68,7 @@ void CodeGenImpl::collectGlobal(const Stmt *stmt) {
     if (auto *t = dynamic_cast<const TryStmt*>(stmt)) {
         if (!t->getHandlerSlot().empty()) {
             globals.insert(t->getHandlerSlot());
+            handlerGlobals.insert(t->getHandlerSlot());
         }
         if (!t->getExceptionSlot().empty()) {
             globals.insert(t->getExceptionSlot());
@@ -35,9 +35,11 @@ void CodeGenImpl::collectLocals(const Stmt *stmt,
                 }
                 if (auto *call = dynamic_cast<const CallExpr*>(expr)) {
                     std::string callName = lowerName(call->getName());
-                    if ((callName == BUILTIN_WAKICHA || callName == BUILTIN_SAPAKI ||
+                    if ((callName == BUILTIN_WAKICHA || callName == BUILTIN_WAKICHA_CLAVE ||
+                         callName == BUILTIN_SAPAKI ||
                          callName == BUILTIN_MAP || callName == BUILTIN_FILTER ||
-                         callName == BUILTIN_MAYJTAYA || callName == BUILTIN_AJLLI) &&
+                         callName == BUILTIN_MAYJTAYA || callName == BUILTIN_AJLLI ||
+                         callName == BUILTIN_MAP_PAR || callName == BUILTIN_FILTER_PAR) &&
                         !call->getArgs().empty()) {
                         return self(call->getArgs()[0].get(), self);
                     }
@@ -68,6 +70,17 @@ void CodeGenImpl::collectLocals(const Stmt *stmt,
                 declaredType = "mapa:jakhüwi";
             }
         }
+        if (declaredType == "tama") {
+            auto *call = dynamic_cast<const CallExpr*>(v->getInit());
+            if (call && lowerName(call->getName()) == BUILTIN_TAMA && !call->getArgs().empty() &&
+                listElementType(call->getArgs()[0].get(), nullptr) == "aru") {
+                declaredType = "tama:aru";
+            }
+        }
+        if (declaredType == "siqi" || declaredType == "qullu") {
+            std::string queue = queueType(v->getInit(), nullptr);
+            if (!queue.empty()) declaredType = queue;
+        }
         types[v->getName()] = declaredType;
         collectStrings(v->getInit());
         return;
@@ -4,12 +4,14 @@
 namespace aym {
 
 void CodeGenImpl::emitInput(bool asString) {
+    out << "    call aym_write_flush\n";
     if (asString) {
         out << "    lea " << reg1(this->windows) << ", [rel fmt_read_str]\n";
         out << "    lea " << reg2(this->windows) << ", [rel input_buf]\n";
         out << "    xor eax,eax\n";
         out << "    call scanf\n";
-        out << "    lea rax, [rel input_buf]\n";
+        out << "    lea " << reg1(this->windows) << ", [rel input_buf]\n";
+        out << "    call aym_str_from_c\n";
     } else {
         out << "    lea " << reg1(this->windows) << ", [rel fmt_read_int]\n";
         out << "    lea " << reg2(this->windows) << ", [rel input_val]\n";
@@ -51,12 +53,17 @@ bool CodeGenImpl::emit(const std::vector<std::unique_ptr<Node>> &nodes,
     functions.clear();
     mainStmts.clear();
     classes.clear();
+    objectLayouts.clear();
     strings.clear();
     tryTempCounter = 0;
 
     if (pipelineMode != CodegenPipelineMode::LinkOnly) {
         collectProgramItems(nodes);
+        for (auto &f : functions) assignStackSlots(f);
         collectClassStrings();
+        if (useIr && !buildIrModule(errorMessageOut)) {
+            return false;
+        }
 
         std::ofstream fout(path);
         if (!fout.is_open()) {
@@ -13,9 +13,10 @@ namespace aym {
 
 namespace {
 
-std::string runtimeCacheKey(const fs::path &runtimeDir, bool windowsTarget) {
+std::string runtimeCacheKey(const fs::path &runtimeDir, bool windowsTarget, const std::string &optLevel) {
     std::string key = runtimeDir.lexically_normal().string();
     key += windowsTarget ? "|win64" : "|elf64";
+    key += "|" + optLevel;
     return std::to_string(std::hash<std::string>{}(key));
 }
 
@@ -33,22 +34,32 @@ fs::path runtimeCacheDir(const fs::path &fallbackDir) {
     return cache;
 }
 
-bool needsRebuildObject(const fs::path &source, const fs::path &object) {
+// runtime.c incluye runtime_arrays.c, runtime_maps_strings.c, etc., asi que
+// un artefacto queda obsoleto si cualquier fuente .c del runtime es mas nueva.
+bool needsRebuildObject(const fs::path &runtimeDir, const fs::path &object) {
     std::error_code ec;
     if (!fs::exists(object, ec)) {
         return true;
     }
     ec.clear();
-    const auto srcTime = fs::last_write_time(source, ec);
+    const auto objTime = fs::last_write_time(object, ec);
     if (ec) {
         return true;
     }
-    ec.clear();
-    const auto objTime = fs::last_write_time(object, ec);
+    fs::directory_iterator it(runtimeDir, ec);
     if (ec) {
         return true;
     }
-    return objTime < srcTime;
+    for (const auto &entry : it) {
+        if (entry.path().extension() != ".c") {
+            continue;
+        }
+        const auto srcTime = fs::last_write_time(entry.path(), ec);
+        if (ec || objTime < srcTime) {
+            return true;
+        }
+    }
+    return false;
 }
 
 struct PipelineFailureInfo {
@@ -232,6 +243,8 @@ const char *pipelineModeLabel(CodegenPipelineMode mode) {
 
 bool writePipelineMetricsJson(const fs::path &jsonPath,
                               CodegenPipelineMode mode,
+                              const char *backendName,
+                              long long irGenMs,
                               bool windowsTarget,
                               long long toolTimeoutMs,
                               long long asmMs,
@@ -240,6 +253,7 @@ bool writePipelineMetricsJson(const fs::path &jsonPath,
                               long long totalMs,
                               const std::string &runtimeCStatus,
                               const std::string &runtimeMathStatus,
+                              const std::string &runtimeOpt,
                               const fs::path &asmPath,
                               const fs::path &objPath,
                               const fs::path &binPath,
@@ -315,15 +329,20 @@ bool writePipelineMetricsJson(const fs::path &jsonPath,
     out << "{\n";
     out << "  \"schema\": \"aymc.pipeline.v1\",\n";
     out << "  \"mode\": \"" << pipelineModeLabel(mode) << "\",\n";
+    out << "  \"backend\": \"" << backendName << "\",\n";
     out << "  \"windows_target\": " << (windowsTarget ? "true" : "false") << ",\n";
     out << "  \"tool_timeout_ms\": " << toolTimeoutMs << ",\n";
     out << "  \"timing_ms\": {\n";
     out << "    \"assemble\": " << asmMs << ",\n";
     out << "    \"runtime_compile\": " << runtimeMs << ",\n";
     out << "    \"link\": " << linkMs << ",\n";
+    if (irGenMs >= 0) {
+        out << "    \"ir_gen\": " << irGenMs << ",\n";
+    }
     out << "    \"total\": " << totalMs << "\n";
     out << "  },\n";
     out << "  \"runtime\": {\n";
+    out << "    \"opt\": \"" << jsonEscape(runtimeOpt) << "\",\n";
     out << "    \"runtime_c\": \"" << jsonEscape(runtimeCStatus) << "\",\n";
     out << "    \"runtime_math\": \"" << jsonEscape(runtimeMathStatus) << "\"\n";
     out << "  },\n";
@@ -419,10 +438,10 @@ void CodeGenImpl::collectProgramItems(const std::vector<std::unique_ptr<Node>> &
 }
 
 void CodeGenImpl::emitRuntimePrelude() {
-    out << "extern printf\n";
+    out << "extern aym_write_str\n";
+    out << "extern aym_write_int\n";
+    out << "extern aym_write_flush\n";
     out << "extern scanf\n";
-    out << "extern strlen\n";
-    out << "extern strcmp\n";
     out << "extern aym_random\n";
     out << "extern aym_srand\n";
     out << "extern aym_sleep\n";
@@ -445,12 +464,17 @@ void CodeGenImpl::emitRuntimePrelude() {
     out << "extern aym_gfx_close\n";
     out << "extern aym_gfx_key_down\n";
     out << "extern aym_set_args\n";
+    out << "extern aym_gc_stats_enable\n";
     out << "extern aym_argc\n";
     out << "extern aym_argv_get\n";
     out << "extern aym_assert\n";
     out << "extern aym_hof_map\n";
     out << "extern aym_hof_filter\n";
     out << "extern aym_hof_reduce\n";
+    out << "extern aym_hof_pipeline\n";
+    out << "extern aym_hof_map_par\n";
+    out << "extern aym_hof_filter_par\n";
+    out << "extern aym_hof_reduce_par\n";
     out << "extern aym_fs_read_text\n";
     out << "extern aym_fs_write_text\n";
     out << "extern aym_fs_exists\n";
@@ -468,9 +492,36 @@ void CodeGenImpl::emitRuntimePrelude() {
     out << "extern aym_array_find_str\n";
     out << "extern aym_array_sort_int\n";
     out << "extern aym_array_sort_str\n";
+    out << "extern aym_array_sort_by\n";
     out << "extern aym_array_unique_int\n";
     out << "extern aym_array_unique_str\n";
+    out << "extern aym_set_new\n";
+    out << "extern aym_set_from_array\n";
+    out << "extern aym_set_add\n";
+    out << "extern aym_set_contains\n";
+    out << "extern aym_set_remove\n";
+    out << "extern aym_set_size\n";
+    out << "extern aym_set_items\n";
+    out << "extern aym_set_is_string\n";
+    out << "extern aym_deque_new\n";
+    out << "extern aym_deque_from_array\n";
+    out << "extern aym_deque_push_back\n";
+    out << "extern aym_deque_push_front\n";
+    out << "extern aym_deque_pop_back\n";
+    out << "extern aym_deque_pop_front\n";
+    out << "extern aym_deque_size\n";
+    out << "extern aym_deque_items\n";
+    out << "extern aym_deque_is_string\n";
+    out << "extern aym_heap_new\n";
+    out << "extern aym_heap_from_array\n";
+    out << "extern aym_heap_push\n";
+    out << "extern aym_heap_pop\n";
+    out << "extern aym_heap_peek\n";
+    out << "extern aym_heap_size\n";
+    out << "extern aym_heap_items\n";
+    out << "extern aym_heap_is_string\n";
     out << "extern aym_map_new\n";
+    out << "extern aym_map_init_stack\n";
     out << "extern aym_map_set\n";
     out << "extern aym_map_get\n";
     out << "extern aym_map_get_default\n";
@@ -483,7 +534,23 @@ void CodeGenImpl::emitRuntimePrelude() {
     out << "extern aym_map_value_at\n";
     out << "extern aym_map_value_is_string\n";
     out << "extern aym_map_value_is_string_key\n";
+    out << "extern aym_imap_set\n";
+    out << "extern aym_imap_get\n";
+    out << "extern aym_imap_get_default\n";
+    out << "extern aym_imap_contains\n";
+    out << "extern aym_imap_delete\n";
+    out << "extern aym_imap_value_is_string_key\n";
+    out << "extern aym_object_new\n";
+    out << "extern aym_object_get\n";
+    out << "extern aym_object_set\n";
+    out << "extern aym_object_method\n";
+    out << "extern aym_object_to_map\n";
     out << "extern aym_str_concat\n";
+    out << "extern aym_str_build\n";
+    out << "extern aym_str_eq\n";
+    out << "extern aym_str_from_c\n";
+    out << "extern aym_str_scratch_mark\n";
+    out << "extern aym_str_scratch_release\n";
     out << "extern aym_str_trim\n";
     out << "extern aym_str_split\n";
     out << "extern aym_str_join\n";
@@ -506,50 +573,64 @@ void CodeGenImpl::emitRuntimePrelude() {
     out << "extern aym_ceil\n";
     out << "extern aym_round\n";
     out << "extern aym_fabs\n";
-    out << "extern aym_try_push\n";
-    out << "extern aym_try_pop\n";
-    out << "extern aym_try_env\n";
-    out << "extern aym_try_get_exception\n";
+    out << "extern aym_handler_top\n";
     out << "extern aym_throw\n";
     out << "extern aym_exception_new\n";
     out << "extern aym_exception_type\n";
     out << "extern aym_exception_message\n";
-    out << "extern setjmp\n";
     out << "section .data\n";
-    out << "fmt_int: db \"%ld\",10,0\n";
-    out << "fmt_str: db \"%s\",10,0\n";
-    out << "fmt_raw: db \"%s\",0\n";
-    out << "fmt_int_raw: db \"%ld\",0\n";
     out << "fmt_read_int: db \"%ld\",0\n";
     out << "fmt_read_str: db \"%255s\",0\n";
     out << "input_val: dq 0\n";
     out << "input_buf: times 256 db 0\n";
-    out << "print_sep: db \" \",0\n";
-    out << "print_term: db 10,0\n";
-    out << "list_open: db \"[\",0\n";
-    out << "list_sep: db \", \",0\n";
-    out << "list_close: db \"]\",0\n";
-    out << "list_quote: db 34,0\n";
-    out << "map_open: db \"{\",0\n";
-    out << "map_sep: db \", \",0\n";
-    out << "map_close: db \"}\",0\n";
-    out << "map_colon: db \": \",0\n";
-    out << "bool_true: db \"chiqa\",0\n";
-    out << "bool_false: db \"k'ari\",0\n";
+    out << asmStringLiteral("print_sep", " ");
+    out << asmStringLiteral("print_term", "\n");
+    out << asmStringLiteral("list_open", "[");
+    out << asmStringLiteral("list_sep", ", ");
+    out << asmStringLiteral("list_close", "]");
+    out << asmStringLiteral("list_quote", "\"");
+    out << asmStringLiteral("map_open", "{");
+    out << asmStringLiteral("map_sep", ", ");
+    out << asmStringLiteral("map_close", "}");
+    out << asmStringLiteral("map_colon", ": ");
+    out << asmStringLiteral("bool_true", "chiqa");
+    out << asmStringLiteral("bool_false", "k'ari");
 
     for (size_t i = 0; i < strings.size(); ++i) {
-        out << "str" << i << ": db " << toAsmBytes(strings[i]) << "\n";
+        out << asmStringLiteral("str" + std::to_string(i), strings[i]);
     }
     for (const auto &g : globals) {
-        out << g << ": dq 0\n";
+        if (handlerGlobals.count(g)) out << g << ": times " << kHandlerFrameBytes / 8 << " dq 0\n";
+        else out << g << ": dq 0\n";
     }
+    emitClassInfo();
 
     out << "section .text\n";
     out << "global main\n";
 }
 
+void CodeGenImpl::enterMainContext() {
+    currentClass.clear();
+    currentParamStrings.clear();
+    currentLocalStrings.clear();
+    currentParamTypes.clear();
+    currentLocalTypes.clear();
+    std::vector<std::string> mainLocals;
+    for (const auto *s : mainStmts) {
+        collectLocals(s, mainLocals, currentLocalStrings, currentLocalTypes);
+    }
+}
+
 void CodeGenImpl::emitMainEntry() {
-    for (const auto &f : functions) emitFunction(f);
+    for (const auto &f : functions) {
+        const IrFunction *lowered = useIr ? irModule.find(f.name) : nullptr;
+        if (lowered) emitIrFunction(*lowered);
+        else emitFunction(f);
+    }
+    if (const IrFunction *lowered = useIr ? irModule.find("main") : nullptr) {
+        emitIrFunction(*lowered);
+        return;
+    }
 
     out << "main:\n";
     out << "    push rbp\n";
@@ -560,20 +641,13 @@ void CodeGenImpl::emitMainEntry() {
     out << "    push r13\n";
     out << "    push r14\n";
     out << "    push r15\n";
-    currentParamStrings.clear();
-    currentLocalStrings.clear();
-    currentParamTypes.clear();
-    currentLocalTypes.clear();
-    if (!mainStmts.empty()) {
-        std::vector<std::string> mainLocals;
-        for (const auto *s : mainStmts) {
-            collectLocals(s, mainLocals, currentLocalStrings, currentLocalTypes);
-        }
-    }
+    enterMainContext();
+    resetScratchDecls(mainStmts, nullptr);
     int stackReserve = this->windows ? 40 : 8;
     out << "    sub rsp, " << stackReserve << "\n";
     // Capture argc/argv from process entry for builtins arg_cantidad/arg_obtener.
     out << "    call aym_set_args\n";
+    if (gcStats) out << "    call aym_gc_stats_enable\n";
     if (seed >= 0) {
         out << "    mov " << reg1(this->windows) << ", " << seed << "\n";
         out << "    call aym_srand\n";
@@ -616,6 +690,9 @@ bool CodeGenImpl::assembleAndLinkOutput(const std::string &path,
     std::string runtimeMathStatus = "skipped";
     PipelineFailureInfo failure;
     std::vector<PipelineCommandTrace> commandTraces;
+    if (useIr && modeIn != CodegenPipelineMode::LinkOnly) {
+        appendCommandTrace(commandTraces, "ir-gen", "ok", "", 0, false, irGenMs, "");
+    }
 
     if (modeIn != CodegenPipelineMode::LinkOnly && !windows)
         out << "section .note.GNU-stack noalloc noexec nowrite progbits\n";
@@ -644,6 +721,8 @@ bool CodeGenImpl::assembleAndLinkOutput(const std::string &path,
         fs::path jsonPath = fs::path(timePipelineJsonPath);
         if (!writePipelineMetricsJson(jsonPath,
                                       modeIn,
+                                      useIr ? "ir" : "native",
+                                      useIr ? irGenMs : -1,
                                       windows,
                                       toolTimeoutMs,
                                       asmMs,
@@ -652,6 +731,7 @@ bool CodeGenImpl::assembleAndLinkOutput(const std::string &path,
                                       totalMs,
                                       runtimeCStatus,
                                       runtimeMathStatus,
+                                      runtimeOpt,
                                       asmPath,
                                       obj,
                                       modeIn == CodegenPipelineMode::CompileOnly ? fs::path() : bin,
@@ -782,7 +862,7 @@ bool CodeGenImpl::assembleAndLinkOutput(const std::string &path,
     fs::path mathC = runtimeDir / "math.c";
     fs::path linuxGfxC = runtimeDir / "runtime_gfx_linux.c";
     fs::path cacheDir = runtimeCacheDir(outputDir);
-    std::string runtimeTag = runtimeCacheKey(runtimeDir, windows);
+    std::string runtimeTag = runtimeCacheKey(runtimeDir, windows, runtimeOpt);
     fs::path runtimeObj = cacheDir / ("__aym_runtime_" + runtimeTag + (windows ? ".obj" : ".o"));
     fs::path mathObj = cacheDir / ("__aym_math_" + runtimeTag + (windows ? ".obj" : ".o"));
     fs::path linuxGfxObj = cacheDir / ("__aym_runtime_gfx_linux_" + runtimeTag + ".o");
@@ -807,7 +887,7 @@ bool CodeGenImpl::assembleAndLinkOutput(const std::string &path,
                        "fuente runtime faltante");
             return false;
         }
-        if (!needsRebuildObject(source, targetObj)) {
+        if (!needsRebuildObject(runtimeDir, targetObj)) {
             status = "cache-hit";
             appendCommandTrace(commandTraces,
                                label,
@@ -822,7 +902,7 @@ bool CodeGenImpl::assembleAndLinkOutput(const std::string &path,
             }
             return true;
         }
-        const std::vector<std::string> compileCmd = {gccCommand, "-c", source.string(), "-o", targetObj.string()};
+        const std::vector<std::string> compileCmd = {gccCommand, "-" + runtimeOpt, "-c", source.string(), "-o", targetObj.string()};
         long long commandMs = 0;
         ProcessResult process;
         if (!runCommand(compileCmd,
@@ -863,18 +943,39 @@ bool CodeGenImpl::assembleAndLinkOutput(const std::string &path,
         runtimeCompileMs += commandMs;
         return true;
     };
-    if (!compileRuntimeObject(runtimeC, runtimeObj, "runtime-c", runtimeCStatus) ||
-        !compileRuntimeObject(mathC, mathObj, "runtime-math", runtimeMathStatus)) {
-        return finalizeFailure();
-    }
-    std::string runtimeLinuxGfxStatus;
-    if (!windows && !compileRuntimeObject(linuxGfxC, linuxGfxObj, "runtime-linux-gfx", runtimeLinuxGfxStatus)) {
-        return finalizeFailure();
+    // La instalacion puede traer el runtime ya compilado con -O2 para Linux
+    // (libaymrt.a); se usa mientras ninguna fuente del runtime sea mas nueva.
+    fs::path prebuiltRuntime = runtimeDir / "libaymrt.a";
+    if (!windows && runtimeOpt == "O2" && fs::exists(prebuiltRuntime) &&
+        !needsRebuildObject(runtimeDir, prebuiltRuntime)) {
+        runtimeCStatus = "prebuilt";
+        runtimeMathStatus = "prebuilt";
+        appendCommandTrace(commandTraces,
+                           "runtime-lib",
+                           "cache-hit",
+                           "",
+                           0,
+                           false,
+                           0,
+                           "prebuilt");
+        if (timePipeline) {
+            std::cout << "[aymc] etapa runtime-lib: " << prebuiltRuntime.string() << std::endl;
+        }
+        cmd2 = {gccCommand, "-no-pie", obj.string(), prebuiltRuntime.string(), "-o", bin.string(), "-pthread", "-lm", "-lX11", "-lc"};
+    } else {
+        if (!compileRuntimeObject(runtimeC, runtimeObj, "runtime-c", runtimeCStatus) ||
+            !compileRuntimeObject(mathC, mathObj, "runtime-math", runtimeMathStatus)) {
+            return finalizeFailure();
+        }
+        std::string runtimeLinuxGfxStatus;
+        if (!windows && !compileRuntimeObject(linuxGfxC, linuxGfxObj, "runtime-linux-gfx", runtimeLinuxGfxStatus)) {
+            return finalizeFailure();
+        }
+        if (windows)
+            cmd2 = {gccCommand, obj.string(), runtimeObj.string(), mathObj.string(), "-o", bin.string(), "-lm", "-lgdi32", "-luser32"};
+        else
+            cmd2 = {gccCommand, "-no-pie", obj.string(), runtimeObj.string(), mathObj.string(), linuxGfxObj.string(), "-o", bin.string(), "-pthread", "-lm", "-lX11", "-lc"};
     }
-    if (windows)
-        cmd2 = {gccCommand, obj.string(), runtimeObj.string(), mathObj.string(), "-o", bin.string(), "-lm", "-lgdi32", "-luser32"};
-    else
-        cmd2 = {gccCommand, "-no-pie", obj.string(), runtimeObj.string(), mathObj.string(), linuxGfxObj.string(), "-o", bin.string(), "-lm", "-lX11", "-lc"};
     ProcessResult linkProcess;
     if (!runCommand(cmd2,
                     "Error enlazando " + obj.string(),
@@ -0,0 +1,315 @@
+#include "codegen_impl.h"
+#include "../builtins/builtins.h"
+#include "../utils/class_names.h"
+
+namespace aym {
+
+namespace {
+
+// Layouts que se arman en el marco (System V). Deben coincidir con AymArray,
+// AymMap y aym_map_init_stack del runtime.
+constexpr long kStackArrayHeaderBytes = 24;
+constexpr long kStackMapHeaderBytes = 80;
+constexpr long kStackMapEntryBytes = 25;
+constexpr long kStackMapMinSlots = 8;
+// Literales mas grandes siguen en el heap para no inflar el marco.
+constexpr long kStackSlotMaxBytes = 1024;
+
+} // namespace
+
+// Como se usa cada variable local en el cuerpo de una funcion. Cualquier
+// aparicion fuera de los contextos que se anotan aqui (argumento de una
+// funcion, kuttaya, asignacion a otra variable, elemento de otro literal...)
+// cuenta como escape.
+struct CodeGenImpl::VarUses {
+    bool escapes = false;
+    bool index = false;
+    bool indexWrite = false;
+    bool member = false;
+    bool memberWrite = false;
+    bool print = false;
+    std::vector<std::string> builtins;
+    std::vector<std::pair<std::string, size_t>> methods;
+};
+
+namespace {
+
+using VarUses = CodeGenImpl::VarUses;
+
+struct EscapeScan {
+    std::unordered_map<std::string, VarUses> uses;
+    // Literales asignados a una variable, en orden de aparicion.
+    std::vector<std::pair<std::string, const Expr*>> sites;
+    bool super = false;
+    bool unknown = false;
+
+    static const VariableExpr *var(const Expr *e) {
+        return dynamic_cast<const VariableExpr*>(e);
+    }
+
+    static bool literal(const Expr *e) {
+        return dynamic_cast<const ListExpr*>(e) || dynamic_cast<const MapExpr*>(e) ||
+               dynamic_cast<const NewExpr*>(e);
+    }
+
+    void define(const std::string &name, const Expr *value) {
+        if (literal(value)) sites.emplace_back(name, value);
+        expr(value);
+    }
+
+    void expr(const Expr *e) {
+        if (!e) return;
+        if (auto *v = var(e)) {
+            uses[v->getName()].escapes = true;
+        } else if (dynamic_cast<const NumberExpr*>(e) || dynamic_cast<const BoolExpr*>(e) ||
+                   dynamic_cast<const StringExpr*>(e) || dynamic_cast<const FunctionRefExpr*>(e) ||
+                   dynamic_cast<const IncDecExpr*>(e)) {
+            return;
+        } else if (auto *b = dynamic_cast<const BinaryExpr*>(e)) {
+            expr(b->getLeft());
+            expr(b->getRight());
+        } else if (auto *u = dynamic_cast<const UnaryExpr*>(e)) {
+            expr(u->getExpr());
+        } else if (auto *t = dynamic_cast<const TernaryExpr*>(e)) {
+            expr(t->getCondition());
+            expr(t->getThen());
+            expr(t->getElse());
+        } else if (auto *c = dynamic_cast<const CallExpr*>(e)) {
+            const auto &args = c->getArgs();
+            size_t first = 0;
+            if (!args.empty()) {
+                if (auto *v = var(args[0].get())) {
+                    uses[v->getName()].builtins.push_back(lowerName(c->getName()));
+                    first = 1;
+                }
+            }
+            for (size_t i = first; i < args.size(); ++i) expr(args[i].get());
+        } else if (auto *m = dynamic_cast<const MemberCallExpr*>(e)) {
+            if (dynamic_cast<const SuperExpr*>(m->getBase())) {
+                super = true;
+            } else if (auto *v = var(m->getBase()); v && m->getStaticCallee().empty()) {
+                uses[v->getName()].methods.emplace_back(m->getMember(), m->getArgs().size());
+            } else {
+                expr(m->getBase());
+            }
+            for (const auto &a : m->getArgs()) expr(a.get());
+        } else if (auto *n = dynamic_cast<const NewExpr*>(e)) {
+            for (const auto &a : n->getArgs()) expr(a.get());
+        } else if (dynamic_cast<const SuperExpr*>(e)) {
+            super = true;
+        } else if (auto *l = dynamic_cast<const ListExpr*>(e)) {
+            for (const auto &el : l->getElements()) expr(el.get());
+        } else if (auto *mp = dynamic_cast<const MapExpr*>(e)) {
+            for (const auto &item : mp->getItems()) {
+                expr(item.first.get());
+                expr(item.second.get());
+            }
+        } else if (auto *i = dynamic_cast<const IndexExpr*>(e)) {
+            if (auto *v = var(i->getBase())) uses[v->getName()].index = true;
+            else expr(i->getBase());
+            expr(i->getIndex());
+        } else if (auto *me = dynamic_cast<const MemberExpr*>(e)) {
+            if (auto *v = var(me->getBase())) uses[v->getName()].member = true;
+            else expr(me->getBase());
+        } else {
+            unknown = true;
+        }
+    }
+
+    void stmt(const Stmt *s) {
+        if (!s) return;
+        if (auto *p = dynamic_cast<const PrintStmt*>(s)) {
+            for (const auto &e : p->getExprs()) {
+                if (auto *v = var(e.get())) uses[v->getName()].print = true;
+                else expr(e.get());
+            }
+            expr(p->getSeparator());
+            expr(p->getTerminator());
+        } else if (auto *e = dynamic_cast<const ExprStmt*>(s)) {
+            expr(e->getExpr());
+        } else if (auto *a = dynamic_cast<const AssignStmt*>(s)) {
+            define(a->getName(), a->getValue());
+        } else if (auto *v = dynamic_cast<const VarDeclStmt*>(s)) {
+            define(v->getName(), v->getInit());
+        } else if (auto *ia = dynamic_cast<const IndexAssignStmt*>(s)) {
+            if (auto *v = var(ia->getBase())) {
+                auto &u = uses[v->getName()];
+                (ia->getObjectClass().empty() ? u.indexWrite : u.memberWrite) = true;
+            } else {
+                expr(ia->getBase());
+            }
+            expr(ia->getIndex());
+            expr(ia->getValue());
+        } else if (auto *b = dynamic_cast<const BlockStmt*>(s)) {
+            for (const auto &st : b->statements) stmt(st.get());
+        } else if (auto *i = dynamic_cast<const IfStmt*>(s)) {
+            expr(i->getCondition());
+            stmt(i->getThen());
+            stmt(i->getElse());
+        } else if (auto *f = dynamic_cast<const ForStmt*>(s)) {
+            stmt(f->getInit());
+            expr(f->getCondition());
+            stmt(f->getPost());
+            stmt(f->getBody());
+        } else if (auto *w = dynamic_cast<const WhileStmt*>(s)) {
+            expr(w->getCondition());
+            stmt(w->getBody());
+        } else if (auto *dw = dynamic_cast<const DoWhileStmt*>(s)) {
+            stmt(dw->getBody());
+            expr(dw->getCondition());
+        } else if (auto *sw = dynamic_cast<const SwitchStmt*>(s)) {
+            expr(sw->getExpr());
+            for (const auto &c : sw->getCases()) {
+                expr(c.first.get());
+                stmt(c.second.get());
+            }
+            stmt(sw->getDefault());
+        } else if (auto *r = dynamic_cast<const ReturnStmt*>(s)) {
+            expr(r->getValue());
+        } else if (auto *t = dynamic_cast<const ThrowStmt*>(s)) {
+            expr(t->getType());
+            expr(t->getMessage());
+        } else if (auto *t = dynamic_cast<const TryStmt*>(s)) {
+            stmt(t->getTryBlock());
+            for (const auto &c : t->getCatches()) stmt(c.block.get());
+            stmt(t->getFinallyBlock());
+        } else if (!dynamic_cast<const BreakStmt*>(s) && !dynamic_cast<const ContinueStmt*>(s)) {
+            unknown = true;
+        }
+    }
+};
+
+// `name` aparece en alguna parte de `e` (un literal no puede leer la variable
+// que lo recibe: en un bucle seria su propia memoria a medio llenar).
+bool mentions(const Expr *e, const std::string &name) {
+    EscapeScan scan;
+    scan.expr(e);
+    return scan.unknown || scan.uses.count(name);
+}
+
+bool onlyBuiltins(const VarUses &u, std::initializer_list<const char*> allowed) {
+    for (const auto &name : u.builtins) {
+        bool ok = false;
+        for (const char *a : allowed) ok = ok || name == a;
+        if (!ok) return false;
+    }
+    return true;
+}
+
+// Solo lecturas y escrituras por indice (sin crecer), largo y recorridos que
+// devuelven otra lista o un valor.
+bool listStaysLocal(const VarUses &u) {
+    return !u.escapes && !u.member && !u.memberWrite && u.methods.empty() &&
+           onlyBuiltins(u, {BUILTIN_LARGO, BUILTIN_SUYUT, BUILTIN_ARRAY_LENGTH, BUILTIN_ARRAY_GET,
+                            BUILTIN_UTJIT, BUILTIN_THAQHA, BUILTIN_MAP, BUILTIN_FILTER,
+                            BUILTIN_REDUCE, BUILTIN_MAYJTAYA, BUILTIN_AJLLI, BUILTIN_THAQTHAPI,
+                            BUILTIN_MAP_PAR, BUILTIN_FILTER_PAR, BUILTIN_REDUCE_PAR});
+}
+
+// Solo lecturas: una clave nueva haria crecer las entradas y borrar
+// reconstruye la tabla.
+bool mapStaysLocal(const VarUses &u) {
+    return !u.escapes && !u.indexWrite && !u.member && !u.memberWrite && u.methods.empty() &&
+           onlyBuiltins(u, {BUILTIN_UTJI_SUTI, BUILTIN_SUYU_M, BUILTIN_SUTINAKA,
+                            BUILTIN_CHANINAKA, BUILTIN_CHANI_M});
+}
+
+} // namespace
+
+// Posiciones de la tabla hash de un mapa del marco con `cap` claves: la misma
+// cuenta de aym_map_put, para que llenarlo nunca rehaga la tabla.
+long CodeGenImpl::stackMapSlots(long cap) {
+    if (cap <= 0) return 0;
+    long slots = kStackMapMinSlots;
+    while (cap * 4 > slots * 3) slots *= 2;
+    return slots;
+}
+
+// Metodo (o constructor) `impl` de un objeto de clase `cls` que solo usa
+// `Aka` para leer y escribir atributos o llamar a otros metodos que cumplen
+// lo mismo. Los que estan en `visiting` cuentan como seguros para cortar la
+// recursion.
+bool CodeGenImpl::selfStaysLocal(const std::string &cls, const std::string &impl,
+                                 std::unordered_set<std::string> &visiting) {
+    if (visiting.count(impl)) return true;
+    for (const auto &info : functions) {
+        if (info.name != impl || !info.body) continue;
+        EscapeScan scan;
+        scan.stmt(info.body);
+        if (scan.unknown || scan.super) return false;
+        visiting.insert(impl);
+        return objectStaysLocal(cls, scan.uses["Aka"], visiting);
+    }
+    return false;
+}
+
+bool CodeGenImpl::objectStaysLocal(const std::string &cls, const VarUses &u,
+                                   std::unordered_set<std::string> &visiting) {
+    if (u.escapes || u.index || u.indexWrite || u.print || !u.builtins.empty()) return false;
+    for (const auto &m : u.methods) {
+        long slot = objectMethodSlot(cls, m.first);
+        if (slot < 0) return false;
+        const std::string &impl = objectLayout(cls).methodImpls[static_cast<size_t>(slot)];
+        if (!selfStaysLocal(cls, impl, visiting)) return false;
+    }
+    return true;
+}
+
+// Analisis de escape: un `[...]`, `{...}` o `mayacha` asignado a una variable
+// local que no sale de la funcion (no se pasa, no se devuelve, no se guarda en
+// otro lado) se arma en el marco en vez de pedirlo al runtime. Listas y mapas
+// no pueden crecer ahi, asi que solo se aceptan usos que no agregan
+// elementos. Los layouts de lista y mapa son los de System V.
+void CodeGenImpl::assignStackSlots(FunctionInfo &info) {
+    info.stackSlots.clear();
+    if (!info.body) return;
+    EscapeScan scan;
+    scan.stmt(info.body);
+    if (scan.unknown) return;
+
+    std::unordered_set<std::string> params;
+    for (const auto &p : info.params) params.insert(p.name);
+    std::unordered_set<std::string> locals(info.locals.begin(), info.locals.end());
+    std::vector<std::pair<std::string, StackSlot>> candidates;
+    std::unordered_map<std::string, bool> safe;
+    for (const auto &site : scan.sites) {
+        const std::string &name = site.first;
+        const Expr *value = site.second;
+        if (!locals.count(name) || params.count(name)) continue;
+        const VarUses &u = scan.uses[name];
+        long bytes = 0;
+        bool ok = false;
+        if (auto *l = dynamic_cast<const ListExpr*>(value)) {
+            ok = !this->windows && listStaysLocal(u);
+            bytes = kStackArrayHeaderBytes + 8 * static_cast<long>(l->getElements().size());
+        } else if (auto *m = dynamic_cast<const MapExpr*>(value)) {
+            ok = !this->windows && mapStaysLocal(u);
+            long cap = static_cast<long>(m->getItems().size());
+            bytes = kStackMapHeaderBytes + ((kStackMapEntryBytes * cap + 7) & ~7L) +
+                    8 * stackMapSlots(cap);
+        } else if (auto *n = dynamic_cast<const NewExpr*>(value)) {
+            auto cls = classes.find(n->getName());
+            if (cls != classes.end()) {
+                std::unordered_set<std::string> visiting;
+                ok = objectStaysLocal(cls->first, u, visiting);
+                for (const auto &ctor : cls->second->getConstructors()) {
+                    if (ok && ctor.params.size() == n->getArgs().size()) {
+                        ok = selfStaysLocal(cls->first, classCtorName(cls->first, ctor.params.size()),
+                                            visiting);
+                    }
+                }
+                bytes = kObjectHeaderBytes + 8 * static_cast<long>(objectLayout(cls->first).fields.size());
+            }
+        }
+        ok = ok && bytes <= kStackSlotMaxBytes && !mentions(value, name);
+        // Todos los literales que recibe la variable deben poder ir al marco.
+        auto it = safe.find(name);
+        safe[name] = (it == safe.end() || it->second) && ok;
+        candidates.push_back({name, StackSlot{value, bytes}});
+    }
+    for (const auto &c : candidates) {
+        if (safe[c.first]) info.stackSlots.push_back(c.second);
+    }
+}
+
+} // namespace aym
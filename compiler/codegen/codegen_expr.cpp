@@ -20,48 +20,90 @@ void CodeGenImpl::emitExpr(const Expr *expr,
         return;
     }
     if (auto *l = dynamic_cast<const ListExpr *>(expr)) {
+        auto stack = currentStackSlots.find(expr);
+        if (stack != currentStackSlots.end()) {
+            // Lista del marco (ver assignStackSlots): cabecera y elementos
+            // seguidos, sin pasar por el runtime.
+            int base = stack->second;
+            long count = static_cast<long>(l->getElements().size());
+            out << "    mov qword [rbp-" << base << "], " << count << "\n";
+            out << "    mov qword [rbp-" << base - 8 << "], " << count << "\n";
+            out << "    lea rax, [rbp-" << base - 24 << "]\n";
+            out << "    mov [rbp-" << base - 16 << "], rax\n";
+            int slot = base - 24;
+            for (const auto &elem : l->getElements()) {
+                emitExpr(elem.get(), locals);
+                out << "    mov [rbp-" << slot << "], rax\n";
+                slot -= 8;
+            }
+            out << "    lea rax, [rbp-" << base << "]\n";
+            return;
+        }
+        // La lista en construccion se guarda en la pila: los elementos pueden
+        // usar rbx y cualquier registro temporal.
+        std::vector<std::string> regs = paramRegs(this->windows);
+        int shadow = this->windows ? 32 : 0;
+        out << "    sub rsp, " << (shadow + 16) << "\n";
         out << "    mov " << reg1(this->windows) << ", " << l->getElements().size() << "\n";
         out << "    call aym_array_new\n";
-        out << "    mov rbx, rax\n";
+        out << "    mov [rsp+" << shadow << "], rax\n";
         size_t idx = 0;
         for (const auto &elem : l->getElements()) {
             emitExpr(elem.get(), locals);
-            std::vector<std::string> regs = paramRegs(this->windows);
             out << "    mov " << regs[2] << ", rax\n";
             out << "    mov " << regs[1] << ", " << idx << "\n";
-            out << "    mov " << regs[0] << ", rbx\n";
+            out << "    mov " << regs[0] << ", [rsp+" << shadow << "]\n";
             out << "    call aym_array_set\n";
             ++idx;
         }
-        out << "    mov rax, rbx\n";
+        out << "    mov rax, [rsp+" << shadow << "]\n";
+        out << "    add rsp, " << (shadow + 16) << "\n";
         return;
     }
     if (auto *m = dynamic_cast<const MapExpr *>(expr)) {
-        out << "    mov " << reg1(this->windows) << ", " << m->getItems().size() << "\n";
-        out << "    call aym_map_new\n";
-        out << "    mov rbx, rax\n";
         std::vector<std::string> regs = paramRegs(this->windows);
+        int shadow = this->windows ? 32 : 0;
+        out << "    sub rsp, " << (shadow + 16) << "\n";
+        auto stack = currentStackSlots.find(expr);
+        if (stack != currentStackSlots.end()) {
+            long cap = static_cast<long>(m->getItems().size());
+            out << "    lea " << regs[0] << ", [rbp-" << stack->second << "]\n";
+            out << "    mov " << regs[1] << ", " << cap << "\n";
+            out << "    mov " << regs[2] << ", " << stackMapSlots(cap) << "\n";
+            out << "    call aym_map_init_stack\n";
+        } else {
+            out << "    mov " << reg1(this->windows) << ", " << m->getItems().size() << "\n";
+            out << "    call aym_map_new\n";
+        }
+        out << "    mov [rsp+" << shadow << "], rax\n";
         for (const auto &item : m->getItems()) {
             emitExpr(item.first.get(), locals);
-            out << "    mov r14, rax\n";
+            out << "    mov [rsp+" << (shadow + 8) << "], rax\n";
             emitExpr(item.second.get(), locals);
-            out << "    mov r15, rax\n";
             out << "    mov " << regs[3] << ", " << (isStringExpr(item.second.get(), locals) ? 1 : 0) << "\n";
-            out << "    mov " << regs[2] << ", r15\n";
-            out << "    mov " << regs[1] << ", r14\n";
-            out << "    mov " << regs[0] << ", rbx\n";
-            out << "    call aym_map_set\n";
+            out << "    mov " << regs[2] << ", rax\n";
+            out << "    mov " << regs[1] << ", [rsp+" << (shadow + 8) << "]\n";
+            out << "    mov " << regs[0] << ", [rsp+" << shadow << "]\n";
+            out << (m->hasIntKeys() ? "    call aym_imap_set\n" : "    call aym_map_set\n");
         }
-        out << "    mov rax, rbx\n";
+        out << "    mov rax, [rsp+" << shadow << "]\n";
+        out << "    add rsp, " << (shadow + 16) << "\n";
         return;
     }
     if (auto *i = dynamic_cast<const IndexExpr *>(expr)) {
+        if (isBoundedIndex(i->getBase(), i->getIndex()) && isListExpr(i->getBase(), locals)) {
+            std::string element = emitBoundedArrayElement(i->getBase(), i->getIndex(), locals);
+            out << "    mov rax, " << element << "\n";
+            return;
+        }
         emitExpr(i->getIndex(), locals);
         out << "    mov " << reg2(this->windows) << ", rax\n";
         emitExpr(i->getBase(), locals);
         out << "    mov " << reg1(this->windows) << ", rax\n";
         if (isMapExpr(i->getBase(), locals)) {
-            out << "    call aym_map_get\n";
+            out << (i->hasIntKey() ? "    call aym_imap_get\n" : "    call aym_map_get\n");
+        } else if (isListExpr(i->getBase(), locals)) {
+            emitArrayGet();
         } else {
             out << "    call aym_array_get\n";
         }
@@ -73,6 +115,12 @@ void CodeGenImpl::emitExpr(const Expr *expr,
             return;
         }
         emitExpr(m->getBase(), locals);
+        long offset = objectFieldOffset(m->getObjectClass(), m->getMember());
+        if (offset >= 0) {
+            emitObjectNullCheck(m->getBase(), m->getMember());
+            out << "    mov rax, [rax+" << offset << "]\n";
+            return;
+        }
         out << "    mov " << reg1(this->windows) << ", rax\n";
         if (m->isExceptionAccess()) {
             if (m->getMember() == "suti") {
@@ -85,42 +133,26 @@ void CodeGenImpl::emitExpr(const Expr *expr,
         } else {
             size_t keyIdx = findString(m->getMember());
             out << "    lea " << reg2(this->windows) << ", [rel str" << keyIdx << "]\n";
-            out << "    call aym_map_get\n";
+            out << (m->getObjectClass().empty() ? "    call aym_map_get\n" : "    call aym_object_get\n");
         }
         return;
     }
     if (auto *v = dynamic_cast<const VariableExpr *>(expr)) {
-        if (locals && locals->count(v->getName())) {
-            out << "    mov rax, [rbp-" << locals->at(v->getName()) << "]\n";
-        } else {
-            out << "    mov rax, [rel " << v->getName() << "]\n";
-        }
+        out << "    mov rax, " << varOperand(v->getName(), locals) << "\n";
         return;
     }
     if (auto *inc = dynamic_cast<const IncDecExpr *>(expr)) {
-        bool isLocal = locals && locals->count(inc->getName());
-        if (isLocal) {
-            out << "    mov rax, [rbp-" << locals->at(inc->getName()) << "]\n";
-        } else {
-            out << "    mov rax, [rel " << inc->getName() << "]\n";
-        }
+        std::string slot = varOperand(inc->getName(), locals);
+        out << "    mov rax, " << slot << "\n";
         if (inc->prefix()) {
             if (inc->increment()) out << "    add rax, 1\n";
             else out << "    sub rax, 1\n";
-            if (isLocal) {
-                out << "    mov [rbp-" << locals->at(inc->getName()) << "], rax\n";
-            } else {
-                out << "    mov [rel " << inc->getName() << "], rax\n";
-            }
+            out << "    mov " << slot << ", rax\n";
         } else {
             out << "    mov rbx, rax\n";
             if (inc->increment()) out << "    add rax, 1\n";
             else out << "    sub rax, 1\n";
-            if (isLocal) {
-                out << "    mov [rbp-" << locals->at(inc->getName()) << "], rax\n";
-            } else {
-                out << "    mov [rel " << inc->getName() << "], rax\n";
-            }
+            out << "    mov " << slot << ", rax\n";
             out << "    mov rax, rbx\n";
         }
         return;
@@ -0,0 +1,255 @@
+#include "codegen_impl.h"
+#include "../builtins/builtins.h"
+
+namespace aym {
+
+namespace {
+
+// Desplazamientos de AymArray {long len; long cap; intptr_t *data;} en
+// System V. En Win64 `long` mide 4 bytes y el layout cambia, por eso los
+// accesos en linea solo se emiten para Linux.
+constexpr int kArrayLenOffset = 0;
+constexpr int kArrayDataOffset = 16;
+
+bool isLengthBuiltin(const std::string &name) {
+    return name == BUILTIN_LARGO || name == BUILTIN_SUYUT || name == BUILTIN_ARRAY_LENGTH;
+}
+
+// Recorre el cuerpo de un `kuti` para decidir si el indice y la lista quedan
+// fijos: ninguno se reasigna ni se redeclara y no hay llamadas que puedan
+// acortar la lista (funciones del usuario, apsu, apsuuka, array_free...).
+struct BoundedLoopScan {
+    const std::string &index;
+    const std::string &array;
+    bool ok = true;
+
+    bool pinned(const std::string &name) const { return name == index || name == array; }
+
+    static bool pureBuiltin(const std::string &name) {
+        static const char *const kPure[] = {
+            BUILTIN_LARGO, BUILTIN_SUYUT, BUILTIN_ARRAY_LENGTH, BUILTIN_ARRAY_GET,
+            BUILTIN_ARRAY_SET, BUILTIN_PUSH, BUILTIN_LENGTH, BUILTIN_SUYU,
+            BUILTIN_TO_STRING, BUILTIN_TO_NUMBER, BUILTIN_UTJIT, BUILTIN_THAQHA,
+            BUILTIN_SIN, BUILTIN_COS, BUILTIN_TAN, BUILTIN_SQRT, BUILTIN_POW,
+            BUILTIN_FLOOR, BUILTIN_CEIL, BUILTIN_ROUND, BUILTIN_FABS};
+        for (const char *pure : kPure) {
+            if (name == pure) return true;
+        }
+        return false;
+    }
+
+    void expr(const Expr *e) {
+        if (!e || !ok) return;
+        if (dynamic_cast<const NumberExpr*>(e) || dynamic_cast<const BoolExpr*>(e) ||
+            dynamic_cast<const StringExpr*>(e) || dynamic_cast<const VariableExpr*>(e)) {
+            return;
+        }
+        if (auto *b = dynamic_cast<const BinaryExpr*>(e)) {
+            expr(b->getLeft());
+            expr(b->getRight());
+        } else if (auto *u = dynamic_cast<const UnaryExpr*>(e)) {
+            expr(u->getExpr());
+        } else if (auto *t = dynamic_cast<const TernaryExpr*>(e)) {
+            expr(t->getCondition());
+            expr(t->getThen());
+            expr(t->getElse());
+        } else if (auto *inc = dynamic_cast<const IncDecExpr*>(e)) {
+            if (pinned(inc->getName())) ok = false;
+        } else if (auto *c = dynamic_cast<const CallExpr*>(e)) {
+            if (!pureBuiltin(lowerName(c->getName()))) {
+                ok = false;
+                return;
+            }
+            for (const auto &a : c->getArgs()) expr(a.get());
+        } else if (auto *i = dynamic_cast<const IndexExpr*>(e)) {
+            expr(i->getBase());
+            expr(i->getIndex());
+        } else if (auto *l = dynamic_cast<const ListExpr*>(e)) {
+            for (const auto &el : l->getElements()) expr(el.get());
+        } else {
+            ok = false;
+        }
+    }
+
+    void stmt(const Stmt *s) {
+        if (!s || !ok) return;
+        if (auto *p = dynamic_cast<const PrintStmt*>(s)) {
+            for (const auto &e : p->getExprs()) expr(e.get());
+            expr(p->getSeparator());
+            expr(p->getTerminator());
+        } else if (auto *e = dynamic_cast<const ExprStmt*>(s)) {
+            expr(e->getExpr());
+        } else if (auto *a = dynamic_cast<const AssignStmt*>(s)) {
+            if (pinned(a->getName())) ok = false;
+            expr(a->getValue());
+        } else if (auto *ia = dynamic_cast<const IndexAssignStmt*>(s)) {
+            expr(ia->getValue());
+            expr(ia->getIndex());
+            expr(ia->getBase());
+        } else if (auto *v = dynamic_cast<const VarDeclStmt*>(s)) {
+            if (pinned(v->getName())) ok = false;
+            expr(v->getInit());
+        } else if (auto *b = dynamic_cast<const BlockStmt*>(s)) {
+            for (const auto &st : b->statements) stmt(st.get());
+        } else if (auto *i = dynamic_cast<const IfStmt*>(s)) {
+            expr(i->getCondition());
+            stmt(i->getThen());
+            stmt(i->getElse());
+        } else if (auto *f = dynamic_cast<const ForStmt*>(s)) {
+            stmt(f->getInit());
+            expr(f->getCondition());
+            stmt(f->getPost());
+            stmt(f->getBody());
+        } else if (auto *w = dynamic_cast<const WhileStmt*>(s)) {
+            expr(w->getCondition());
+            stmt(w->getBody());
+        } else if (auto *dw = dynamic_cast<const DoWhileStmt*>(s)) {
+            expr(dw->getCondition());
+            stmt(dw->getBody());
+        } else if (auto *r = dynamic_cast<const ReturnStmt*>(s)) {
+            expr(r->getValue());
+        } else if (!dynamic_cast<const BreakStmt*>(s) && !dynamic_cast<const ContinueStmt*>(s)) {
+            ok = false;
+        }
+    }
+};
+
+bool isStepByOne(const Stmt *post, const std::string &index) {
+    if (auto *e = dynamic_cast<const ExprStmt*>(post)) {
+        auto *inc = dynamic_cast<const IncDecExpr*>(e->getExpr());
+        return inc && inc->increment() && inc->getName() == index;
+    }
+    if (auto *a = dynamic_cast<const AssignStmt*>(post)) {
+        auto *b = dynamic_cast<const BinaryExpr*>(a->getValue());
+        if (a->getName() != index || !b || b->getOp() != '+') return false;
+        auto *v = dynamic_cast<const VariableExpr*>(b->getLeft());
+        auto *n = dynamic_cast<const NumberExpr*>(b->getRight());
+        return v && n && v->getName() == index && n->getValue() == 1;
+    }
+    return false;
+}
+
+} // namespace
+
+// `kuti(i = k; i < largo(lista); i = i + 1)` con k >= 0: mientras el cuerpo no
+// toque `i` ni `lista` ni pueda acortarla, todo `lista[i]` del cuerpo esta en
+// rango y no necesita chequeo.
+bool CodeGenImpl::boundedLoopIndex(const ForStmt *loop, std::string &index, std::string &array) const {
+    if (windows || !loop->getCondition()) return false;
+    auto *cond = dynamic_cast<const BinaryExpr*>(loop->getCondition());
+    if (!cond || cond->getOp() != '<') return false;
+    auto *indexVar = dynamic_cast<const VariableExpr*>(cond->getLeft());
+    auto *length = dynamic_cast<const CallExpr*>(cond->getRight());
+    if (!indexVar || !length || length->getArgs().size() != 1 ||
+        !isLengthBuiltin(lowerName(length->getName()))) {
+        return false;
+    }
+    auto *arrayVar = dynamic_cast<const VariableExpr*>(length->getArgs()[0].get());
+    if (!arrayVar || arrayVar->getName() == indexVar->getName()) return false;
+    index = indexVar->getName();
+    array = arrayVar->getName();
+
+    const Expr *start = nullptr;
+    if (auto *decl = dynamic_cast<const VarDeclStmt*>(loop->getInit())) {
+        if (decl->getName() == index) start = decl->getInit();
+    } else if (auto *assign = dynamic_cast<const AssignStmt*>(loop->getInit())) {
+        if (assign->getName() == index) start = assign->getValue();
+    }
+    auto *startNum = dynamic_cast<const NumberExpr*>(start);
+    if (!startNum || startNum->getValue() < 0 || !isStepByOne(loop->getPost(), index)) return false;
+
+    BoundedLoopScan scan{index, array};
+    scan.stmt(loop->getBody());
+    return scan.ok;
+}
+
+bool CodeGenImpl::isBoundedIndex(const Expr *base, const Expr *index) const {
+    auto *b = dynamic_cast<const VariableExpr*>(base);
+    auto *i = dynamic_cast<const VariableExpr*>(index);
+    if (!b || !i) return false;
+    for (const auto &bounded : boundedIndexes) {
+        if (bounded.first == i->getName() && bounded.second == b->getName()) return true;
+    }
+    return false;
+}
+
+// Deja en rax el buffer de la lista y devuelve el operando de memoria del
+// elemento, sin chequeos (el indice ya esta acotado). Puede usar rcx.
+std::string CodeGenImpl::emitBoundedArrayElement(const Expr *base, const Expr *index,
+                                                 const std::unordered_map<std::string,int> *locals) {
+    std::string array = leafOperand(base, locals);
+    std::string idx = leafOperand(index, locals);
+    if (array.front() == '[') {
+        out << "    mov rax, " << array << "\n";
+        array = "rax";
+    }
+    out << "    mov rax, [" << array << "+" << kArrayDataOffset << "]\n";
+    if (idx.front() == '[') {
+        out << "    mov rcx, " << idx << "\n";
+        idx = "rcx";
+    }
+    return "[rax+" + idx + "*8]";
+}
+
+// rax = arr[idx] con la lista en reg1 (y rax) y el indice en reg2. El camino
+// rapido compara el indice sin signo contra len (un negativo queda fuera de
+// rango); nulos, negativos y fuera de rango siguen en aym_array_get.
+void CodeGenImpl::emitArrayGet() {
+    if (windows) {
+        out << "    call aym_array_get\n";
+        return;
+    }
+    std::string array = reg1(windows);
+    std::string idx = reg2(windows);
+    std::string slow = genLabel("arrget_slow");
+    std::string done = genLabel("arrget_done");
+    out << "    test " << array << ", " << array << "\n";
+    out << "    jz " << slow << "\n";
+    out << "    cmp " << idx << ", [" << array << "+" << kArrayLenOffset << "]\n";
+    out << "    jae " << slow << "\n";
+    out << "    mov rax, [" << array << "+" << kArrayDataOffset << "]\n";
+    out << "    mov rax, [rax+" << idx << "*8]\n";
+    out << "    jmp " << done << "\n";
+    out << slow << ":\n";
+    out << "    call aym_array_get\n";
+    out << done << ":\n";
+}
+
+// arr[idx] = valor con lista, indice y valor en los tres primeros registros
+// de argumentos, igual que la llamada a aym_array_set que reemplaza.
+void CodeGenImpl::emitArraySet() {
+    if (windows) {
+        out << "    call aym_array_set\n";
+        return;
+    }
+    std::vector<std::string> regs = paramRegs(windows);
+    std::string slow = genLabel("arrset_slow");
+    std::string done = genLabel("arrset_done");
+    out << "    test " << regs[0] << ", " << regs[0] << "\n";
+    out << "    jz " << slow << "\n";
+    out << "    cmp " << regs[1] << ", [" << regs[0] << "+" << kArrayLenOffset << "]\n";
+    out << "    jae " << slow << "\n";
+    out << "    mov rax, [" << regs[0] << "+" << kArrayDataOffset << "]\n";
+    out << "    mov [rax+" << regs[1] << "*8], " << regs[2] << "\n";
+    out << "    mov rax, " << regs[2] << "\n";
+    out << "    jmp " << done << "\n";
+    out << slow << ":\n";
+    out << "    call aym_array_set\n";
+    out << done << ":\n";
+}
+
+// rax = largo de la lista en rax (0 si es nula).
+void CodeGenImpl::emitArrayLength() {
+    if (windows) {
+        out << "    mov " << reg1(windows) << ", rax\n";
+        out << "    call aym_array_length\n";
+        return;
+    }
+    std::string done = genLabel("arrlen_done");
+    out << "    test rax, rax\n";
+    out << "    jz " << done << "\n";
+    out << "    mov rax, [rax+" << kArrayLenOffset << "]\n";
+    out << done << ":\n";
+}
+
+} // namespace aym
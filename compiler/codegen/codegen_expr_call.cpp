@@ -19,7 +19,40 @@ void CodeGenImpl::emitCallExpr(const CallExpr *c,
 
     // user function call
     emitCallArgs(c->getArgs(), locals, 0);
+    if (c == tailCall) {
+        emitTailJump(c);
+        return;
+    }
     out << "    call " << c->getName() << "\n";
 }
 
+// Un `kuttaya f(...)` puede saltar a f si no queda nada por hacer despues de
+// la llamada: sin `yant'aña` ni `tukuyawi` abiertos y con todos los
+// argumentos en registros. Solo se aplica dentro de funciones y metodos, cuyo
+// marco es siempre el mismo; `main` llama como antes.
+bool CodeGenImpl::tailCallable(const CallExpr *c) const {
+    if (tailFunction.empty() || !tryFrames.empty() || !finallyStack.empty()) return false;
+    if (c->getArgs().size() > paramRegs(this->windows).size()) return false;
+    return paramTypes.count(c->getName()) > 0;
+}
+
+// Los argumentos ya estan en registros. La recursion propia vuelve al inicio
+// del cuerpo reutilizando el marco; otra funcion recibe la direccion de
+// retorno de la actual tras deshacer el marco, que no toca esos registros.
+void CodeGenImpl::emitTailJump(const CallExpr *c) {
+    tailCallEmitted = true;
+    if (c->getName() == tailFunction) {
+        out << "    jmp " << tailLabel << "\n";
+        return;
+    }
+    if (tailFrameBytes) out << "    add rsp, " << tailFrameBytes << "\n";
+    out << "    pop r15\n";
+    out << "    pop r14\n";
+    out << "    pop r13\n";
+    out << "    pop r12\n";
+    out << "    pop rbx\n";
+    out << "    pop rbp\n";
+    out << "    jmp " << c->getName() << "\n";
+}
+
 } // namespace aym
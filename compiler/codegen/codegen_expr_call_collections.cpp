@@ -8,8 +8,7 @@ bool CodeGenImpl::emitBuiltinCollectionCall(const CallExpr *c,
                                             const std::string &nameLower) {
     if (nameLower == BUILTIN_LARGO || nameLower == BUILTIN_SUYUT) {
         emitExpr(c->getArgs()[0].get(), locals);
-        out << "    mov " << reg1(this->windows) << ", rax\n";
-        out << "    call aym_array_length\n";
+        emitArrayLength();
         return true;
     }
 
@@ -53,12 +52,14 @@ bool CodeGenImpl::emitBuiltinCollectionCall(const CallExpr *c,
     }
 
     if (nameLower == BUILTIN_UTJI_SUTI) {
+        if (emitObjectMapCall(c, locals, "aym_map_contains")) return true;
         emitCallArgs(c->getArgs(), locals, 0);
-        out << "    call aym_map_contains\n";
+        out << (c->hasIntKey() ? "    call aym_imap_contains\n" : "    call aym_map_contains\n");
         return true;
     }
 
     if (nameLower == BUILTIN_SUYU_M) {
+        if (emitObjectMapCall(c, locals, "aym_map_size")) return true;
         emitExpr(c->getArgs()[0].get(), locals);
         out << "    mov " << reg1(this->windows) << ", rax\n";
         out << "    call aym_map_size\n";
@@ -66,6 +67,7 @@ bool CodeGenImpl::emitBuiltinCollectionCall(const CallExpr *c,
     }
 
     if (nameLower == BUILTIN_SUTINAKA) {
+        if (emitObjectMapCall(c, locals, "aym_map_keys")) return true;
         emitExpr(c->getArgs()[0].get(), locals);
         out << "    mov " << reg1(this->windows) << ", rax\n";
         out << "    call aym_map_keys\n";
@@ -73,6 +75,7 @@ bool CodeGenImpl::emitBuiltinCollectionCall(const CallExpr *c,
     }
 
     if (nameLower == BUILTIN_CHANINAKA) {
+        if (emitObjectMapCall(c, locals, "aym_map_values")) return true;
         emitExpr(c->getArgs()[0].get(), locals);
         out << "    mov " << reg1(this->windows) << ", rax\n";
         out << "    call aym_map_values\n";
@@ -80,17 +83,23 @@ bool CodeGenImpl::emitBuiltinCollectionCall(const CallExpr *c,
     }
 
     if (nameLower == BUILTIN_APSU_SUTI) {
+        if (emitObjectMapCall(c, locals, "aym_map_delete")) return true;
         emitCallArgs(c->getArgs(), locals, 0);
-        out << "    call aym_map_delete\n";
+        out << (c->hasIntKey() ? "    call aym_imap_delete\n" : "    call aym_map_delete\n");
         return true;
     }
 
     if (nameLower == BUILTIN_CHANI_M) {
+        if (emitObjectMapCall(c, locals, c->getArgs().size() == 3 ? "aym_map_get_default" : "aym_map_get")) {
+            return true;
+        }
         emitCallArgs(c->getArgs(), locals, 0);
+        // Con clave `jakhüwi` el runtime no la convierte a texto (aym_imap_*).
+        std::string prefix = c->hasIntKey() ? "aym_imap_" : "aym_map_";
         if (c->getArgs().size() == 3) {
-            out << "    call aym_map_get_default\n";
+            out << "    call " << prefix << "get_default\n";
         } else {
-            out << "    call aym_map_get\n";
+            out << "    call " << prefix << "get\n";
         }
         return true;
     }
@@ -106,6 +115,20 @@ bool CodeGenImpl::emitBuiltinCollectionCall(const CallExpr *c,
         return true;
     }
 
+    // La clave se calcula una vez por elemento; el runtime necesita saber si
+    // es texto para compararla.
+    if (nameLower == BUILTIN_WAKICHA_CLAVE) {
+        bool stringKey = false;
+        if (auto *key = dynamic_cast<const FunctionRefExpr*>(c->getArgs()[1].get())) {
+            auto it = functionReturnTypes.find(key->getName());
+            stringKey = it != functionReturnTypes.end() && it->second == "aru";
+        }
+        emitCallArgs(c->getArgs(), locals, 0);
+        out << "    mov " << paramRegs(this->windows)[2] << ", " << (stringKey ? 1 : 0) << "\n";
+        out << "    call aym_array_sort_by\n";
+        return true;
+    }
+
     if (nameLower == BUILTIN_SAPAKI) {
         emitExpr(c->getArgs()[0].get(), locals);
         out << "    mov " << reg1(this->windows) << ", rax\n";
@@ -117,6 +140,113 @@ bool CodeGenImpl::emitBuiltinCollectionCall(const CallExpr *c,
         return true;
     }
 
+    if (nameLower == BUILTIN_TAMA) {
+        if (c->getArgs().empty()) {
+            out << "    call aym_set_new\n";
+            return true;
+        }
+        emitExpr(c->getArgs()[0].get(), locals);
+        out << "    mov " << reg1(this->windows) << ", rax\n";
+        out << "    mov " << reg2(this->windows) << ", "
+            << (listElementType(c->getArgs()[0].get(), locals) == "aru" ? 1 : 0) << "\n";
+        out << "    call aym_set_from_array\n";
+        return true;
+    }
+
+    // El hash y la igualdad dependen del tipo del elemento, no del conjunto:
+    // un `tama()` vacio recibe textos o numeros segun lo que se le pase.
+    if (nameLower == BUILTIN_TAMA_YAPA || nameLower == BUILTIN_TAMA_UTJI ||
+        nameLower == BUILTIN_TAMA_APSU) {
+        emitCallArgs(c->getArgs(), locals, 0);
+        out << "    mov " << paramRegs(this->windows)[2] << ", "
+            << (isStringExpr(c->getArgs()[1].get(), locals) ? 1 : 0) << "\n";
+        if (nameLower == BUILTIN_TAMA_YAPA) {
+            out << "    call aym_set_add\n";
+        } else if (nameLower == BUILTIN_TAMA_UTJI) {
+            out << "    call aym_set_contains\n";
+        } else {
+            out << "    call aym_set_remove\n";
+        }
+        return true;
+    }
+
+    if (nameLower == BUILTIN_TAMA_SUYU || nameLower == BUILTIN_TAMA_LISTA) {
+        emitExpr(c->getArgs()[0].get(), locals);
+        out << "    mov " << reg1(this->windows) << ", rax\n";
+        out << (nameLower == BUILTIN_TAMA_SUYU ? "    call aym_set_size\n" : "    call aym_set_items\n");
+        return true;
+    }
+
+    if (nameLower == BUILTIN_SIQI) {
+        bool strings = queueType(c, locals) == "siqi:aru";
+        if (c->getArgs().empty()) {
+            out << "    mov " << reg1(this->windows) << ", " << (strings ? 1 : 0) << "\n";
+            out << "    call aym_deque_new\n";
+            return true;
+        }
+        emitExpr(c->getArgs()[0].get(), locals);
+        out << "    mov " << reg1(this->windows) << ", rax\n";
+        out << "    mov " << reg2(this->windows) << ", " << (strings ? 1 : 0) << "\n";
+        out << "    call aym_deque_from_array\n";
+        return true;
+    }
+
+    if (nameLower == BUILTIN_SIQI_QHIPA || nameLower == BUILTIN_SIQI_NAYRA ||
+        nameLower == BUILTIN_QULLU_YAPA) {
+        emitCallArgs(c->getArgs(), locals, 0);
+        if (nameLower == BUILTIN_SIQI_QHIPA) {
+            out << "    call aym_deque_push_back\n";
+        } else if (nameLower == BUILTIN_SIQI_NAYRA) {
+            out << "    call aym_deque_push_front\n";
+        } else {
+            out << "    call aym_heap_push\n";
+        }
+        return true;
+    }
+
+    if (nameLower == BUILTIN_SIQI_APSU_QHIPA || nameLower == BUILTIN_SIQI_APSU_NAYRA ||
+        nameLower == BUILTIN_SIQI_SUYU || nameLower == BUILTIN_SIQI_LISTA ||
+        nameLower == BUILTIN_QULLU_APSU || nameLower == BUILTIN_QULLU_PATA ||
+        nameLower == BUILTIN_QULLU_SUYU) {
+        static const std::unordered_map<std::string, const char*> kQueueCalls = {
+            {BUILTIN_SIQI_APSU_QHIPA, "aym_deque_pop_back"},
+            {BUILTIN_SIQI_APSU_NAYRA, "aym_deque_pop_front"},
+            {BUILTIN_SIQI_SUYU, "aym_deque_size"},
+            {BUILTIN_SIQI_LISTA, "aym_deque_items"},
+            {BUILTIN_QULLU_APSU, "aym_heap_pop"},
+            {BUILTIN_QULLU_PATA, "aym_heap_peek"},
+            {BUILTIN_QULLU_SUYU, "aym_heap_size"}};
+        emitExpr(c->getArgs()[0].get(), locals);
+        out << "    mov " << reg1(this->windows) << ", rax\n";
+        out << "    call " << kQueueCalls.at(nameLower) << "\n";
+        return true;
+    }
+
+    // qullu([lista][, &comparar]): la comparacion es un puntero a la funcion
+    // (como en aym_hof_map) y 0 deja la de por defecto, el menor primero.
+    if (nameLower == BUILTIN_QULLU) {
+        bool strings = queueType(c, locals) == "qullu:aru";
+        const auto &args = c->getArgs();
+        bool hasList = !args.empty() && !dynamic_cast<const FunctionRefExpr*>(args[0].get());
+        bool hasCmp = !args.empty() && dynamic_cast<const FunctionRefExpr*>(args.back().get());
+        if (hasList) {
+            emitCallArgs(args, locals, 0);
+            if (!hasCmp) out << "    xor " << reg2(this->windows) << ", " << reg2(this->windows) << "\n";
+            out << "    mov " << paramRegs(this->windows)[2] << ", " << (strings ? 1 : 0) << "\n";
+            out << "    call aym_heap_from_array\n";
+            return true;
+        }
+        if (hasCmp) {
+            emitExpr(args.back().get(), locals);
+            out << "    mov " << reg1(this->windows) << ", rax\n";
+        } else {
+            out << "    xor " << reg1(this->windows) << ", " << reg1(this->windows) << "\n";
+        }
+        out << "    mov " << reg2(this->windows) << ", " << (strings ? 1 : 0) << "\n";
+        out << "    call aym_heap_new\n";
+        return true;
+    }
+
     return false;
 }
 
@@ -40,14 +40,19 @@ bool CodeGenImpl::emitBuiltinArrayPrimitiveCall(const CallExpr *c,
     }
 
     if (nameLower == BUILTIN_ARRAY_GET) {
+        if (c->getArgs().size() == 2 && isBoundedIndex(c->getArgs()[0].get(), c->getArgs()[1].get())) {
+            std::string element = emitBoundedArrayElement(c->getArgs()[0].get(), c->getArgs()[1].get(), locals);
+            out << "    mov rax, " << element << "\n";
+            return true;
+        }
         emitCallArgs(c->getArgs(), locals, 0);
-        out << "    call aym_array_get\n";
+        emitArrayGet();
         return true;
     }
 
     if (nameLower == BUILTIN_ARRAY_SET) {
         emitCallArgs(c->getArgs(), locals, 0);
-        out << "    call aym_array_set\n";
+        emitArraySet();
         return true;
     }
 
@@ -60,8 +65,7 @@ bool CodeGenImpl::emitBuiltinArrayPrimitiveCall(const CallExpr *c,
 
     if (nameLower == BUILTIN_ARRAY_LENGTH) {
         emitExpr(c->getArgs()[0].get(), locals);
-        out << "    mov " << reg1(this->windows) << ", rax\n";
-        out << "    call aym_array_length\n";
+        emitArrayLength();
         return true;
     }
 
@@ -8,22 +8,18 @@ bool CodeGenImpl::emitBuiltinIoCall(const CallExpr *c,
                                     const std::string &nameLower) {
     if (nameLower == BUILTIN_PRINT && !c->getArgs().empty()) {
         if (auto *s = dynamic_cast<const StringExpr *>(c->getArgs()[0].get())) {
-            size_t idx = findString(s->getValue());
-            out << "    lea " << reg1(this->windows) << ", [rel fmt_str]\n";
-            out << "    lea " << reg2(this->windows) << ", [rel str" << idx << "]\n";
-            out << "    xor eax,eax\n";
-            out << "    call printf\n";
+            emitPrintDefault("str" + std::to_string(findString(s->getValue())));
         } else {
             emitExpr(c->getArgs()[0].get(), locals);
-            out << "    mov " << reg2(this->windows) << ", rax\n";
-            out << "    lea " << reg1(this->windows) << ", [rel fmt_int]\n";
-            out << "    xor eax,eax\n";
-            out << "    call printf\n";
+            out << "    mov " << reg1(this->windows) << ", rax\n";
+            out << "    call aym_write_int\n";
         }
+        emitPrintDefault("print_term");
         return true;
     }
 
     if (nameLower == BUILTIN_INPUT) {
+        out << "    call aym_write_flush\n";
         out << "    lea " << reg1(this->windows) << ", [rel fmt_read_int]\n";
         out << "    lea " << reg2(this->windows) << ", [rel input_val]\n";
         out << "    xor eax,eax\n";
@@ -33,25 +29,18 @@ bool CodeGenImpl::emitBuiltinIoCall(const CallExpr *c,
     }
 
     if (nameLower == BUILTIN_KATU) {
-        if (!c->getArgs().empty()) {
-            emitExpr(c->getArgs()[0].get(), locals);
-            out << "    mov " << reg2(this->windows) << ", rax\n";
-            out << "    lea " << reg1(this->windows) << ", [rel fmt_raw]\n";
-            out << "    xor eax,eax\n";
-            out << "    call printf\n";
-        }
-        if (c->getArgs().size() > 1) {
-            emitExpr(c->getArgs()[1].get(), locals);
-            out << "    mov " << reg2(this->windows) << ", rax\n";
-            out << "    lea " << reg1(this->windows) << ", [rel fmt_raw]\n";
-            out << "    xor eax,eax\n";
-            out << "    call printf\n";
+        for (size_t i = 0; i < c->getArgs().size() && i < 2; ++i) {
+            emitExpr(c->getArgs()[i].get(), locals);
+            out << "    mov " << reg1(this->windows) << ", rax\n";
+            out << "    call aym_write_str\n";
         }
+        out << "    call aym_write_flush\n";
         out << "    lea " << reg1(this->windows) << ", [rel fmt_read_str]\n";
         out << "    lea " << reg2(this->windows) << ", [rel input_buf]\n";
         out << "    xor eax,eax\n";
         out << "    call scanf\n";
-        out << "    lea rax, [rel input_buf]\n";
+        out << "    lea " << reg1(this->windows) << ", [rel input_buf]\n";
+        out << "    call aym_str_from_c\n";
         return true;
     }
 
@@ -96,10 +85,8 @@ bool CodeGenImpl::emitBuiltinIoCall(const CallExpr *c,
 
     if (nameLower == BUILTIN_WRITE) {
         emitExpr(c->getArgs()[0].get(), locals);
-        out << "    mov " << reg2(this->windows) << ", rax\n";
-        out << "    lea " << reg1(this->windows) << ", [rel fmt_raw]\n";
-        out << "    xor eax,eax\n";
-        out << "    call printf\n";
+        out << "    mov " << reg1(this->windows) << ", rax\n";
+        out << "    call aym_write_str\n";
         return true;
     }
 
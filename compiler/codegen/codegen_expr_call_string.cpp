@@ -6,10 +6,14 @@ namespace aym {
 bool CodeGenImpl::emitBuiltinStringCall(const CallExpr *c,
                                         const std::unordered_map<std::string,int> *locals,
                                         const std::string &nameLower) {
+    // El largo vive en la cabecera del texto, en [s-8]; nulo cuenta como "".
     if (nameLower == BUILTIN_LENGTH || nameLower == BUILTIN_SUYU) {
+        std::string done = genLabel("strlen_done");
         emitExpr(c->getArgs()[0].get(), locals);
-        out << "    mov " << reg1(this->windows) << ", rax\n";
-        out << "    call strlen\n";
+        out << "    test rax, rax\n";
+        out << "    jz " << done << "\n";
+        out << "    mov rax, [rax-8]\n";
+        out << done << ":\n";
         return true;
     }
 
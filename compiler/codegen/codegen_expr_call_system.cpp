@@ -192,6 +192,8 @@ bool CodeGenImpl::emitBuiltinSystemCall(const CallExpr *c,
 bool CodeGenImpl::emitBuiltinFunctionalCall(const CallExpr *c,
                                             const std::unordered_map<std::string,int> *locals,
                                             const std::string &nameLower) {
+    if (emitFusedPipeline(c, locals)) return true;
+
     if (nameLower == BUILTIN_MAP || nameLower == BUILTIN_MAYJTAYA) {
         emitCallArgs(c->getArgs(), locals, 0);
         out << "    call aym_hof_map\n";
@@ -210,6 +212,19 @@ bool CodeGenImpl::emitBuiltinFunctionalCall(const CallExpr *c,
         return true;
     }
 
+    // Las funciones corren en los hilos del pool; una que imprime o cambia
+    // globales se queda en la version de un solo hilo.
+    if (nameLower == BUILTIN_MAP_PAR || nameLower == BUILTIN_FILTER_PAR ||
+        nameLower == BUILTIN_REDUCE_PAR) {
+        bool reduce = nameLower == BUILTIN_REDUCE_PAR;
+        bool parallel = c->getArgs().size() >= 2 && pureStageFunction(c->getArgs()[1].get(), reduce ? 2 : 1);
+        std::string fn = nameLower == BUILTIN_MAP_PAR ? "aym_hof_map"
+                         : nameLower == BUILTIN_FILTER_PAR ? "aym_hof_filter" : "aym_hof_reduce";
+        emitCallArgs(c->getArgs(), locals, 0);
+        out << "    call " << fn << (parallel ? "_par" : "") << "\n";
+        return true;
+    }
+
     return false;
 }
 
@@ -0,0 +1,72 @@
+#include "codegen_impl.h"
+#include "../builtins/builtins.h"
+
+namespace aym {
+
+namespace {
+
+// Debe coincidir con AYM_PART_TEXT/AYM_PART_LONG de runtime_maps_strings.c.
+constexpr int kPartText = 0;
+constexpr int kPartLong = 1;
+
+} // namespace
+
+// Aplana `a + b + ...` entre textos (incluidos los $"..{x}.." que el parser
+// arma como cadena de `+` con `aru(x)`). Un `aru(n)` numerico pasa el numero
+// sin convertir para que el runtime lo formatee en el mismo buffer.
+void CodeGenImpl::collectConcatParts(const Expr *expr,
+                                     const std::unordered_map<std::string,int> *locals,
+                                     std::vector<std::pair<const Expr*, bool>> &parts) {
+    if (auto *b = dynamic_cast<const BinaryExpr*>(expr)) {
+        if (b->getOp() == '+' && isStringExpr(b->getLeft(), locals) && isStringExpr(b->getRight(), locals)) {
+            collectConcatParts(b->getLeft(), locals, parts);
+            collectConcatParts(b->getRight(), locals, parts);
+            return;
+        }
+    }
+    if (auto *s = dynamic_cast<const StringExpr*>(expr)) {
+        if (s->getValue().empty()) return;
+    }
+    if (auto *c = dynamic_cast<const CallExpr*>(expr)) {
+        if (lowerName(c->getName()) == BUILTIN_TO_STRING && c->getArgs().size() == 1) {
+            const Expr *arg = c->getArgs()[0].get();
+            if (!isStringExpr(arg, locals) && !isBoolExpr(arg, locals)) {
+                parts.emplace_back(arg, true);
+                return;
+            }
+        }
+    }
+    parts.emplace_back(expr, false);
+}
+
+// Baja una cadena de concatenaciones a una sola llamada a aym_str_build con
+// un arreglo de partes {tipo, valor} en la pila: una reserva y sin textos
+// intermedios. Dos textos sin numeros siguen usando aym_str_concat.
+bool CodeGenImpl::emitStringBuild(const BinaryExpr *b,
+                                  const std::unordered_map<std::string,int> *locals) {
+    if (b->getOp() != '+' || !isStringExpr(b->getLeft(), locals) || !isStringExpr(b->getRight(), locals)) {
+        return false;
+    }
+    std::vector<std::pair<const Expr*, bool>> parts;
+    collectConcatParts(b, locals, parts);
+    bool hasNumber = false;
+    for (const auto &part : parts) hasNumber = hasNumber || part.second;
+    if (parts.size() < 3 && !hasNumber) return false;
+
+    int shadow = this->windows ? 32 : 0;
+    int bytes = static_cast<int>(parts.size()) * 16;
+    out << "    sub rsp, " << shadow + bytes << "\n";
+    for (size_t i = 0; i < parts.size(); ++i) {
+        int slot = shadow + static_cast<int>(i) * 16;
+        emitExpr(parts[i].first, locals);
+        out << "    mov qword [rsp+" << slot << "], " << (parts[i].second ? kPartLong : kPartText) << "\n";
+        out << "    mov [rsp+" << slot + 8 << "], rax\n";
+    }
+    out << "    lea " << reg1(this->windows) << ", [rsp+" << shadow << "]\n";
+    out << "    mov " << reg2(this->windows) << ", " << parts.size() << "\n";
+    out << "    call aym_str_build\n";
+    out << "    add rsp, " << shadow + bytes << "\n";
+    return true;
+}
+
+} // namespace aym
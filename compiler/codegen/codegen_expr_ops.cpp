@@ -37,75 +37,99 @@ bool CodeGenImpl::emitExprOperator(const Expr *expr,
             out << endLbl << ":\n";
             return true;
         }
-        emitExpr(b->getLeft(), locals);
-        out << "    push rax\n";
-        int spillPad = this->windows ? 40 : 8;
-        out << "    sub rsp, " << spillPad << "\n";
-        emitExpr(b->getRight(), locals);
-        out << "    add rsp, " << spillPad << "\n";
-        out << "    mov rbx, rax\n";
-        out << "    pop rax\n";
+        if (emitStringBuild(b, locals)) return true;
+        // El operando derecho queda en `rhs`: una hoja (inmediato, registro o
+        // slot de variable) se usa directamente; una subexpresion sin llamadas
+        // guarda el izquierdo en un temporal r8-r11; el resto usa la pila.
+        std::string rhs = leafOperand(b->getRight(), locals);
+        const char *temp = exprTempReg();
+        if (!rhs.empty()) {
+            emitExpr(b->getLeft(), locals);
+        } else if (temp && isCallFreeExpr(b->getRight(), locals)) {
+            emitExpr(b->getLeft(), locals);
+            out << "    mov " << temp << ", rax\n";
+            ++exprTempDepth;
+            emitExpr(b->getRight(), locals);
+            --exprTempDepth;
+            out << "    mov rbx, rax\n";
+            out << "    mov rax, " << temp << "\n";
+            rhs = "rbx";
+        } else {
+            emitExpr(b->getLeft(), locals);
+            out << "    push rax\n";
+            int spillPad = this->windows ? 40 : 8;
+            out << "    sub rsp, " << spillPad << "\n";
+            emitExpr(b->getRight(), locals);
+            out << "    add rsp, " << spillPad << "\n";
+            out << "    mov rbx, rax\n";
+            out << "    pop rax\n";
+            rhs = "rbx";
+        }
         bool leftIsString = isStringExpr(b->getLeft(), locals);
         bool rightIsString = isStringExpr(b->getRight(), locals);
+        auto rhsInRbx = [&]() {
+            if (rhs != "rbx") {
+                out << "    mov rbx, " << rhs << "\n";
+                rhs = "rbx";
+            }
+        };
+        // Reduccion de fuerza con divisor, factor o exponente constante.
+        if (auto *num = dynamic_cast<const NumberExpr*>(b->getRight())) {
+            char op = b->getOp();
+            if (op == '*' && emitMulByConst(num->getValue())) return true;
+            if ((op == '/' || op == '%') && emitDivByConst(op, num->getValue())) return true;
+            if (op == '^') {
+                emitPowByConst(num->getValue());
+                return true;
+            }
+        }
         switch (b->getOp()) {
             case '+':
                 if (leftIsString && rightIsString) {
                     out << "    mov " << reg1(this->windows) << ", rax\n";
-                    out << "    mov " << reg2(this->windows) << ", rbx\n";
+                    out << "    mov " << reg2(this->windows) << ", " << rhs << "\n";
                     out << "    call aym_str_concat\n";
                 } else {
-                    out << "    add rax, rbx\n";
+                    out << "    add rax, " << rhs << "\n";
                 }
                 break;
-            case '-': out << "    sub rax, rbx\n"; break;
-            case '*': out << "    imul rax, rbx\n"; break;
-            case '/': out << "    cqo\n    idiv rbx\n"; break;
-            case '%': out << "    cqo\n    idiv rbx\n    mov rax, rdx\n"; break;
-            case '^': {
-                std::string loop = genLabel("pow");
-                std::string end = genLabel("powend");
-                out << "    mov rcx, rbx\n";
-                out << "    mov rbx, rax\n";
-                out << "    mov rax,1\n";
-                out << loop << ":\n";
-                out << "    cmp rcx,0\n";
-                out << "    je " << end << "\n";
-                out << "    imul rax, rbx\n";
-                out << "    dec rcx\n";
-                out << "    jmp " << loop << "\n";
-                out << end << ":\n";
+            case '-': out << "    sub rax, " << rhs << "\n"; break;
+            case '*': out << "    imul rax, " << rhs << "\n"; break;
+            case '/': rhsInRbx(); out << "    cqo\n    idiv rbx\n"; break;
+            case '%': rhsInRbx(); out << "    cqo\n    idiv rbx\n    mov rax, rdx\n"; break;
+            case '^':
+                out << "    mov rcx, " << rhs << "\n";
+                emitPowLoop();
                 break;
-            }
             case '<':
-                out << "    cmp rax, rbx\n    setl al\n    movzx rax,al\n";
+                out << "    cmp rax, " << rhs << "\n    setl al\n    movzx rax,al\n";
                 break;
             case 'l':
-                out << "    cmp rax, rbx\n    setle al\n    movzx rax,al\n";
+                out << "    cmp rax, " << rhs << "\n    setle al\n    movzx rax,al\n";
                 break;
             case '>':
-                out << "    cmp rax, rbx\n    setg al\n    movzx rax,al\n";
+                out << "    cmp rax, " << rhs << "\n    setg al\n    movzx rax,al\n";
                 break;
             case 'g':
-                out << "    cmp rax, rbx\n    setge al\n    movzx rax,al\n";
+                out << "    cmp rax, " << rhs << "\n    setge al\n    movzx rax,al\n";
                 break;
             case 's':
                 if (leftIsString && rightIsString) {
                     out << "    mov " << reg1(this->windows) << ", rax\n";
-                    out << "    mov " << reg2(this->windows) << ", rbx\n";
-                    out << "    call strcmp\n";
-                    out << "    cmp rax,0\n    sete al\n    movzx rax,al\n";
+                    out << "    mov " << reg2(this->windows) << ", " << rhs << "\n";
+                    out << "    call aym_str_eq\n";
                 } else {
-                    out << "    cmp rax, rbx\n    sete al\n    movzx rax,al\n";
+                    out << "    cmp rax, " << rhs << "\n    sete al\n    movzx rax,al\n";
                 }
                 break;
             case 'd':
                 if (leftIsString && rightIsString) {
                     out << "    mov " << reg1(this->windows) << ", rax\n";
-                    out << "    mov " << reg2(this->windows) << ", rbx\n";
-                    out << "    call strcmp\n";
-                    out << "    cmp rax,0\n    setne al\n    movzx rax,al\n";
+                    out << "    mov " << reg2(this->windows) << ", " << rhs << "\n";
+                    out << "    call aym_str_eq\n";
+                    out << "    xor rax, 1\n";
                 } else {
-                    out << "    cmp rax, rbx\n    setne al\n    movzx rax,al\n";
+                    out << "    cmp rax, " << rhs << "\n    setne al\n    movzx rax,al\n";
                 }
                 break;
         }
@@ -0,0 +1,215 @@
+#include "codegen_impl.h"
+#include "../builtins/builtins.h"
+
+#include <functional>
+
+namespace aym {
+
+namespace {
+
+// Debe coincidir con AYM_HOF_MAP/FILTER/REDUCE de runtime_hof.c.
+constexpr int kStageMap = 0;
+constexpr int kStageFilter = 1;
+constexpr int kStageReduce = 2;
+
+int stageKind(const std::string &name) {
+    if (name == BUILTIN_MAP || name == BUILTIN_MAYJTAYA) return kStageMap;
+    if (name == BUILTIN_FILTER || name == BUILTIN_AJLLI) return kStageFilter;
+    if (name == BUILTIN_REDUCE || name == BUILTIN_THAQTHAPI) return kStageReduce;
+    return -1;
+}
+
+// Funciones sin efectos visibles: no imprimen, no asignan globales ni tocan
+// listas, no usan `pantja` y solo llaman builtins puros u otras funciones
+// puras (`calls`). Aun asi pueden lanzar desde el runtime (CLAVE, INDICE,
+// CONVERSION); con `noThrow` tampoco se aceptan indexaciones ni los builtins
+// que lanzan.
+struct PureFunctionScan {
+    const std::unordered_set<std::string> &owned;
+    std::function<bool(const std::string &, size_t)> calls;
+    bool noThrow = false;
+    bool ok = true;
+
+    static bool pureBuiltin(const std::string &name) {
+        static const char *const kPure[] = {
+            BUILTIN_LARGO, BUILTIN_SUYUT, BUILTIN_ARRAY_LENGTH, BUILTIN_ARRAY_GET,
+            BUILTIN_LENGTH, BUILTIN_SUYU, BUILTIN_TO_STRING, BUILTIN_TO_NUMBER,
+            BUILTIN_UTJIT, BUILTIN_THAQHA, BUILTIN_SIN, BUILTIN_COS, BUILTIN_TAN,
+            BUILTIN_SQRT, BUILTIN_POW, BUILTIN_FLOOR, BUILTIN_CEIL, BUILTIN_ROUND,
+            BUILTIN_FABS};
+        for (const char *pure : kPure) {
+            if (name == pure) return true;
+        }
+        return false;
+    }
+
+    static bool throwingBuiltin(const std::string &name) {
+        return name == BUILTIN_ARRAY_GET || name == BUILTIN_TO_NUMBER;
+    }
+
+    void expr(const Expr *e) {
+        if (!e || !ok) return;
+        if (dynamic_cast<const NumberExpr*>(e) || dynamic_cast<const BoolExpr*>(e) ||
+            dynamic_cast<const StringExpr*>(e) || dynamic_cast<const VariableExpr*>(e)) {
+            return;
+        }
+        if (auto *b = dynamic_cast<const BinaryExpr*>(e)) {
+            expr(b->getLeft());
+            expr(b->getRight());
+        } else if (auto *u = dynamic_cast<const UnaryExpr*>(e)) {
+            expr(u->getExpr());
+        } else if (auto *t = dynamic_cast<const TernaryExpr*>(e)) {
+            expr(t->getCondition());
+            expr(t->getThen());
+            expr(t->getElse());
+        } else if (auto *inc = dynamic_cast<const IncDecExpr*>(e)) {
+            if (!owned.count(inc->getName())) ok = false;
+        } else if (auto *c = dynamic_cast<const CallExpr*>(e)) {
+            std::string name = lowerName(c->getName());
+            if (noThrow && throwingBuiltin(name)) {
+                ok = false;
+                return;
+            }
+            if (!pureBuiltin(name) &&
+                !(calls && calls(c->getName(), c->getArgs().size()))) {
+                ok = false;
+                return;
+            }
+            for (const auto &a : c->getArgs()) expr(a.get());
+        } else if (auto *i = dynamic_cast<const IndexExpr*>(e)) {
+            if (noThrow) {
+                ok = false;
+                return;
+            }
+            expr(i->getBase());
+            expr(i->getIndex());
+        } else {
+            ok = false;
+        }
+    }
+
+    void stmt(const Stmt *s) {
+        if (!s || !ok) return;
+        if (auto *e = dynamic_cast<const ExprStmt*>(s)) {
+            expr(e->getExpr());
+        } else if (auto *a = dynamic_cast<const AssignStmt*>(s)) {
+            if (!owned.count(a->getName())) ok = false;
+            expr(a->getValue());
+        } else if (auto *v = dynamic_cast<const VarDeclStmt*>(s)) {
+            expr(v->getInit());
+        } else if (auto *b = dynamic_cast<const BlockStmt*>(s)) {
+            for (const auto &st : b->statements) stmt(st.get());
+        } else if (auto *i = dynamic_cast<const IfStmt*>(s)) {
+            expr(i->getCondition());
+            stmt(i->getThen());
+            stmt(i->getElse());
+        } else if (auto *f = dynamic_cast<const ForStmt*>(s)) {
+            stmt(f->getInit());
+            expr(f->getCondition());
+            stmt(f->getPost());
+            stmt(f->getBody());
+        } else if (auto *w = dynamic_cast<const WhileStmt*>(s)) {
+            expr(w->getCondition());
+            stmt(w->getBody());
+        } else if (auto *dw = dynamic_cast<const DoWhileStmt*>(s)) {
+            expr(dw->getCondition());
+            stmt(dw->getBody());
+        } else if (auto *r = dynamic_cast<const ReturnStmt*>(s)) {
+            expr(r->getValue());
+        } else if (!dynamic_cast<const BreakStmt*>(s) && !dynamic_cast<const ContinueStmt*>(s)) {
+            ok = false;
+        }
+    }
+};
+
+} // namespace
+
+// Funcion libre `name` de `arity` parametros sin efectos visibles (y que no
+// lanza, con `noThrow`). Las que estan en `visiting` cuentan como puras para
+// cortar la recursion.
+bool CodeGenImpl::pureFunction(const std::string &name, size_t arity, bool noThrow,
+                               std::unordered_set<std::string> &visiting) const {
+    if (visiting.count(name)) return true;
+    for (const auto &info : functions) {
+        if (info.name != name || !info.className.empty()) continue;
+        if (info.params.size() != arity || !info.body) return false;
+        std::unordered_set<std::string> owned(info.locals.begin(), info.locals.end());
+        for (const auto &p : info.params) owned.insert(p.name);
+        visiting.insert(name);
+        PureFunctionScan scan{owned, [&](const std::string &callee, size_t argc) {
+            return pureFunction(callee, argc, noThrow, visiting);
+        }, noThrow};
+        scan.stmt(info.body);
+        return scan.ok;
+    }
+    return false;
+}
+
+// `&f` apunta a una funcion libre de `arity` parametros sin efectos visibles.
+bool CodeGenImpl::pureStageFunction(const Expr *ref, size_t arity, bool noThrow) const {
+    auto *f = dynamic_cast<const FunctionRefExpr*>(ref);
+    if (!f) return false;
+    std::unordered_set<std::string> visiting;
+    return pureFunction(f->getName(), arity, noThrow, visiting);
+}
+
+// Fusiona `map`/`filter` anidados (y un `reduce` final) sobre la misma lista
+// en una sola llamada a aym_hof_pipeline con un arreglo de etapas {tipo,
+// funcion} en la pila, como aym_str_build. Hacen falta al menos dos etapas;
+// una sola sigue con su llamada de siempre. Las llamadas se intercalan por
+// elemento en vez de ir etapa por etapa, asi que las etapas tampoco pueden
+// lanzar: si dos lanzaran, la excepcion que sale podria ser otra.
+bool CodeGenImpl::emitFusedPipeline(const CallExpr *c,
+                                    const std::unordered_map<std::string,int> *locals) {
+    std::vector<std::pair<int, const Expr*>> stages;
+    const Expr *init = nullptr;
+    const Expr *source = c;
+    while (auto *call = dynamic_cast<const CallExpr*>(source)) {
+        int kind = stageKind(lowerName(call->getName()));
+        const auto &args = call->getArgs();
+        if (kind < 0 || (kind == kStageReduce && !stages.empty())) break;
+        if (args.size() != (kind == kStageReduce ? 3u : 2u)) break;
+        if (!pureStageFunction(args[1].get(), kind == kStageReduce ? 2 : 1, true)) break;
+        if (kind == kStageReduce) {
+            // El acumulado inicial se evalua antes de las etapas.
+            static const std::unordered_set<std::string> none;
+            PureFunctionScan scan{none, nullptr, true};
+            scan.expr(args[2].get());
+            if (!scan.ok) return false;
+            init = args[2].get();
+        }
+        stages.emplace_back(kind, args[1].get());
+        source = args[0].get();
+    }
+    if (stages.size() < 2) return false;
+
+    int shadow = this->windows ? 32 : 0;
+    int count = static_cast<int>(stages.size());
+    int slotSource = shadow + count * 16;
+    int bytes = count * 16 + 16;
+    out << "    sub rsp, " << shadow + bytes << "\n";
+    emitExpr(source, locals);
+    out << "    mov [rsp+" << slotSource << "], rax\n";
+    if (init) {
+        emitExpr(init, locals);
+        out << "    mov [rsp+" << slotSource + 8 << "], rax\n";
+    }
+    for (int i = 0; i < count; ++i) {
+        const auto &stage = stages[count - 1 - i];
+        int slot = shadow + i * 16;
+        emitExpr(stage.second, locals);
+        out << "    mov qword [rsp+" << slot << "], " << stage.first << "\n";
+        out << "    mov [rsp+" << slot + 8 << "], rax\n";
+    }
+    const auto &regs = paramRegs(this->windows);
+    out << "    mov " << regs[0] << ", [rsp+" << slotSource << "]\n";
+    out << "    lea " << regs[1] << ", [rsp+" << shadow << "]\n";
+    out << "    mov " << regs[2] << ", " << count << "\n";
+    if (init) out << "    mov " << regs[3] << ", [rsp+" << slotSource + 8 << "]\n";
+    else out << "    xor " << regs[3] << ", " << regs[3] << "\n";
+    out << "    call aym_hof_pipeline\n";
+    out << "    add rsp, " << shadow + bytes << "\n";
+    return true;
+}
+
+} // namespace aym
@@ -0,0 +1,160 @@
+#include "codegen_impl.h"
+
+#include <climits>
+
+namespace aym {
+
+namespace {
+
+int powerOfTwoShift(unsigned long long value) {
+    if (value == 0 || (value & (value - 1)) != 0) return -1;
+    int shift = 0;
+    while (value > 1) {
+        value >>= 1;
+        ++shift;
+    }
+    return shift;
+}
+
+// Constante magica para dividir con signo por `d` (|d| >= 2) usando la
+// parte alta de la multiplicacion (Hacker's Delight, cap. 10).
+void signedMagic(long long d, long long &multiplier, int &shift) {
+    const unsigned long long two63 = 1ULL << 63;
+    unsigned long long ad = d < 0 ? 0ULL - static_cast<unsigned long long>(d)
+                                  : static_cast<unsigned long long>(d);
+    unsigned long long t = two63 + (static_cast<unsigned long long>(d) >> 63);
+    unsigned long long anc = t - 1 - t % ad;
+    int p = 63;
+    unsigned long long q1 = two63 / anc;
+    unsigned long long r1 = two63 - q1 * anc;
+    unsigned long long q2 = two63 / ad;
+    unsigned long long r2 = two63 - q2 * ad;
+    unsigned long long delta = 0;
+    do {
+        ++p;
+        q1 *= 2;
+        r1 *= 2;
+        if (r1 >= anc) {
+            ++q1;
+            r1 -= anc;
+        }
+        q2 *= 2;
+        r2 *= 2;
+        if (r2 >= ad) {
+            ++q2;
+            r2 -= ad;
+        }
+        delta = ad - r2;
+    } while (q1 < delta || (q1 == delta && r1 == 0));
+    multiplier = static_cast<long long>(q2 + 1);
+    if (d < 0) multiplier = static_cast<long long>(0ULL - static_cast<unsigned long long>(multiplier));
+    shift = p - 64;
+}
+
+} // namespace
+
+// rax *= factor. Potencias de dos (y sus negativas) pasan a `shl`.
+bool CodeGenImpl::emitMulByConst(long long factor) {
+    if (factor == LLONG_MIN) return false;
+    unsigned long long magnitude = factor < 0 ? 0ULL - static_cast<unsigned long long>(factor)
+                                              : static_cast<unsigned long long>(factor);
+    int shift = powerOfTwoShift(magnitude);
+    if (shift < 0) return false;
+    if (shift > 0) out << "    shl rax, " << shift << "\n";
+    if (factor < 0) out << "    neg rax\n";
+    return true;
+}
+
+// rax = rax / divisor o rax % divisor con la semantica de `idiv` (cociente
+// truncado hacia cero, resto con el signo del dividendo). Usa rcx y rdx.
+// Se dejan a `idiv` el cero y -1, que deben fallar igual que antes con
+// LLONG_MIN / -1.
+bool CodeGenImpl::emitDivByConst(char op, long long divisor) {
+    if (divisor == 0 || divisor == -1 || divisor == LLONG_MIN) return false;
+    bool modulo = op == '%';
+    if (divisor == 1) {
+        if (modulo) out << "    xor eax,eax\n";
+        return true;
+    }
+    unsigned long long magnitude = divisor < 0 ? 0ULL - static_cast<unsigned long long>(divisor)
+                                               : static_cast<unsigned long long>(divisor);
+    int shift = powerOfTwoShift(magnitude);
+    if (shift > 0) {
+        // Se suma 2^k-1 a los dividendos negativos para truncar hacia cero.
+        out << "    mov rdx, rax\n";
+        out << "    sar rdx, 63\n";
+        out << "    shr rdx, " << (64 - shift) << "\n";
+        if (modulo) {
+            out << "    lea rcx, [rax+rdx]\n";
+            out << "    sar rcx, " << shift << "\n";
+            out << "    shl rcx, " << shift << "\n";
+            out << "    sub rax, rcx\n";
+        } else {
+            out << "    add rax, rdx\n";
+            out << "    sar rax, " << shift << "\n";
+            if (divisor < 0) out << "    neg rax\n";
+        }
+        return true;
+    }
+    long long multiplier = 0;
+    int magicShift = 0;
+    signedMagic(divisor, multiplier, magicShift);
+    out << "    mov rcx, rax\n";
+    out << "    mov rax, " << multiplier << "\n";
+    out << "    imul rcx\n";
+    if (divisor > 0 && multiplier < 0) out << "    add rdx, rcx\n";
+    if (divisor < 0 && multiplier > 0) out << "    sub rdx, rcx\n";
+    if (magicShift > 0) out << "    sar rdx, " << magicShift << "\n";
+    out << "    mov rax, rdx\n";
+    out << "    shr rax, 63\n";
+    out << "    add rdx, rax\n";
+    if (modulo) {
+        out << "    mov rax, " << divisor << "\n";
+        out << "    imul rdx, rax\n";
+        out << "    mov rax, rcx\n";
+        out << "    sub rax, rdx\n";
+    } else {
+        out << "    mov rax, rdx\n";
+    }
+    return true;
+}
+
+// rax = rax ^ rcx por cuadrados sucesivos; el exponente se trata como sin
+// signo, igual que el bucle de multiplicaciones al que reemplaza. Usa rdx.
+void CodeGenImpl::emitPowLoop() {
+    std::string loop = genLabel("pow");
+    std::string skip = genLabel("powskip");
+    std::string end = genLabel("powend");
+    out << "    mov rdx, rax\n";
+    out << "    mov rax,1\n";
+    out << loop << ":\n";
+    out << "    test rcx, rcx\n";
+    out << "    jz " << end << "\n";
+    out << "    test cl, 1\n";
+    out << "    jz " << skip << "\n";
+    out << "    imul rax, rdx\n";
+    out << skip << ":\n";
+    out << "    imul rdx, rdx\n";
+    out << "    shr rcx, 1\n";
+    out << "    jmp " << loop << "\n";
+    out << end << ":\n";
+}
+
+// rax = rax ^ exponent con la cadena de cuadrados desenrollada (a lo sumo
+// dos `imul` por bit del exponente). Usa rdx.
+void CodeGenImpl::emitPowByConst(long long exponent) {
+    unsigned long long e = static_cast<unsigned long long>(exponent);
+    if (e == 0) {
+        out << "    mov rax,1\n";
+        return;
+    }
+    int top = 63;
+    while (!((e >> top) & 1)) --top;
+    if (top > 0) out << "    mov rdx, rax\n";
+    for (int bit = top - 1; bit >= 0; --bit) {
+        out << "    imul rax, rax\n";
+        if ((e >> bit) & 1) out << "    imul rax, rdx\n";
+    }
+}
+
+} // namespace aym
@@ -2,15 +2,41 @@
 
 namespace aym {
 
+void CodeGenImpl::enterFunctionContext(const FunctionInfo &info) {
+    currentClass = info.className;
+    currentParamStrings.clear();
+    currentParamTypes.clear();
+    currentLocalStrings = info.stringLocals;
+    currentLocalTypes = info.localTypes;
+    auto pit = paramTypes.find(info.name);
+    if (pit != paramTypes.end()) {
+        size_t idx = 0;
+        for (const auto &p : info.params) {
+            if (idx < pit->second.size()) {
+                currentParamTypes[p.name] = pit->second[idx];
+                if (pit->second[idx] == "aru") currentParamStrings[p.name] = true;
+            }
+            ++idx;
+        }
+    }
+}
+
 void CodeGenImpl::emitFunction(const FunctionInfo &info) {
     std::unordered_map<std::string,int> offsets;
     // We save rbx/r12-r15 in the prologue, so locals start below those slots.
     constexpr int savedRegsBytes = 5 * 8;
     int off = savedRegsBytes;
     for (const auto &n : info.locals) {
-        off += 8;
+        auto type = info.localTypes.find(n);
+        bool handler = type != info.localTypes.end() && type->second == "handler";
+        off += handler ? kHandlerFrameBytes : 8;
         offsets[n] = off;
     }
+    currentStackSlots.clear();
+    for (const auto &slot : info.stackSlots) {
+        off += static_cast<int>(slot.bytes);
+        currentStackSlots[slot.value] = off;
+    }
     int localBytes = off - savedRegsBytes;
     // Reserve Win64 shadow space (32 bytes) so calls are ABI-compliant.
     int shadow = this->windows ? 32 : 0;
@@ -19,21 +45,9 @@ void CodeGenImpl::emitFunction(const FunctionInfo &info) {
     // Keep stackSize == 8 (mod 16) so rsp stays 16-byte aligned at call sites.
     int stackSize = ((needed + 15) & ~15) + 8;
 
-    currentParamStrings.clear();
-    currentParamTypes.clear();
-    currentLocalStrings = info.stringLocals;
-    currentLocalTypes = info.localTypes;
-    auto pit = paramTypes.find(info.name);
-    if (pit != paramTypes.end()) {
-        size_t idx = 0;
-        for (const auto &p : info.params) {
-            if (idx < pit->second.size()) {
-                currentParamTypes[p.name] = pit->second[idx];
-                if (pit->second[idx] == "aru") currentParamStrings[p.name] = true;
-            }
-            ++idx;
-        }
-    }
+    enterFunctionContext(info);
+    allocateLocalRegisters(info);
+    resetScratchDecls({info.body}, &info.params);
 
     std::string endLabel = genLabel("endfunc");
 
@@ -47,18 +61,25 @@ void CodeGenImpl::emitFunction(const FunctionInfo &info) {
     out << "    push r14\n";
     out << "    push r15\n";
     if (stackSize) out << "    sub rsp, " << stackSize << "\n";
+    tailFunction = info.name;
+    tailLabel = genLabel("tail");
+    tailFrameBytes = stackSize;
+    out << tailLabel << ":\n";
 
     // store parameters
     std::vector<std::string> regs = paramRegs(this->windows);
     size_t idx = 0;
     for (const auto &p : info.params) {
         if (idx < regs.size()) {
-            out << "    mov [rbp-" << offsets[p.name] << "], " << regs[idx] << "\n";
+            out << "    mov " << varOperand(p.name, &offsets) << ", " << regs[idx] << "\n";
         }
         ++idx;
     }
 
     emitStmt(info.body, &offsets, endLabel);
+    tailFunction.clear();
+    currentRegLocals.clear();
+    currentStackSlots.clear();
 
     out << endLabel << ":\n";
     if (stackSize) out << "    add rsp, " << stackSize << "\n";
@@ -32,6 +32,29 @@ std::string toAsmBytes(const std::string &value) {
     return oss.str();
 }
 
+namespace {
+// Mismo FNV-1a que aym_str_hash en runtime/runtime.c (0 = sin calcular).
+uint64_t stringHash(const std::string &value) {
+    uint64_t hash = 1469598103934665603ULL;
+    for (unsigned char ch : value) {
+        hash ^= ch;
+        hash *= 1099511628211ULL;
+    }
+    return hash ? hash : 1;
+}
+}
+
+// Literal con la cabecera AymStrHeader {hash, cap, len} delante de la
+// etiqueta, que apunta al primer caracter.
+std::string asmStringLiteral(const std::string &label, const std::string &value) {
+    std::ostringstream oss;
+    oss << "align 8\n";
+    oss << "    dq 0x" << std::hex << stringHash(value) << std::dec << ", "
+        << value.size() << ", " << value.size() << "\n";
+    oss << label << ": db " << toAsmBytes(value) << "\n";
+    return oss.str();
+}
+
 std::vector<std::string> paramRegs(bool windows) {
     if (windows) {
         return {"rcx", "rdx", "r8", "r9"};
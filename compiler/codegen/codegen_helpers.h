@@ -1,6 +1,7 @@
 #ifndef AYM_CODEGEN_HELPERS_H
 #define AYM_CODEGEN_HELPERS_H
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -9,6 +10,7 @@ namespace aym {
 std::string genLabel(const std::string &base);
 std::string lowerName(const std::string &value);
 std::string toAsmBytes(const std::string &value);
+std::string asmStringLiteral(const std::string &label, const std::string &value);
 std::vector<std::string> paramRegs(bool windows);
 std::string reg1(bool windows);
 std::string reg2(bool windows);
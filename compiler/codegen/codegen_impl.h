@@ -10,6 +10,7 @@
 #include "codegen_helpers.h"
 #include "codegen.h"
 #include "../ast/ast.h"
+#include "../ir/ir.h"
 
 namespace aym {
 
@@ -26,13 +27,22 @@ public:
         return strings.size();
     }
 
+    // Literal que el analisis de escape arma en el marco y bytes que ocupa.
+    struct StackSlot {
+        const Expr *value;
+        long bytes;
+    };
+    struct VarUses;
+
     struct FunctionInfo {
         std::string name;
+        std::string className;
         std::vector<Param> params;
         const BlockStmt *body;
         std::vector<std::string> locals;
         std::unordered_map<std::string,bool> stringLocals;
         std::unordered_map<std::string,std::string> localTypes;
+        std::vector<StackSlot> stackSlots;
     };
 
     std::vector<FunctionInfo> functions;
@@ -45,12 +55,53 @@ public:
     std::unordered_map<std::string,std::string> globalTypes;
     std::unordered_map<std::string,std::string> functionReturnTypes;
     std::unordered_map<std::string, const ClassStmt*> classes;
+    // Layout de instancias: atributos y metodos por slot, base primero.
+    struct ObjectLayout {
+        std::vector<std::string> fields;
+        std::vector<const ClassStmt::FieldDecl*> fieldDecls;
+        std::vector<std::string> methods;
+        std::vector<std::string> methodImpls;
+    };
+    // AymObject: descriptor de clase + mapa de atributos dinamicos.
+    static constexpr long kObjectHeaderBytes = 16;
+    // AymClass ocupa 8 palabras y la vtable se emite justo detras.
+    static constexpr long kClassInfoBytes = 64;
+    // Marco de yantana (AymHandler en runtime_exceptions.c): enlace, catch,
+    // rsp, rbp, rbx, r12-r15, excepcion y rdi/rsi de Win64.
+    static constexpr long kHandlerFrameBytes = 96;
+    std::unordered_set<std::string> handlerGlobals;
+    // Marcos de yantana abiertos en la funcion actual y cuantos habia al
+    // entrar a cada destino de pakhina/sarantana (se cierran antes de saltar).
+    std::vector<const TryStmt*> tryFrames;
+    std::vector<size_t> breakTryDepth;
+    std::vector<size_t> continueTryDepth;
+    std::unordered_map<std::string, ObjectLayout> objectLayouts;
     std::string currentClass;
+    // Variables locales de la funcion actual asignadas a registros.
+    std::unordered_map<std::string,std::string> currentRegLocals;
+    // Literales de la funcion actual armados en el marco: desplazamiento
+    // desde rbp de su primer byte.
+    std::unordered_map<const Expr*,int> currentStackSlots;
+    size_t exprTempDepth = 0;
+    // Pares (indice, lista) de los `kuti` activos cuyo indice esta en rango.
+    std::vector<std::pair<std::string,std::string>> boundedIndexes;
+    // Declaraciones por nombre en la funcion actual y, por cada bucle activo,
+    // si libera los textos temporales al final de cada vuelta.
+    std::unordered_map<std::string,int> scratchDeclCounts;
+    std::vector<bool> scratchLoops;
     std::vector<std::string> breakLabels;
     std::vector<std::string> continueLabels;
     std::vector<std::string> finallyStack;
     std::vector<size_t> loopFinallyDepth;
     std::vector<size_t> throwFinallyLimitStack;
+    // Funcion o metodo que se emite (vacio en `main`), bytes de su marco y
+    // etiqueta tras el prologo: un `kuttaya f(...)` en cola salta en vez de
+    // llamar. tailCall es la llamada del `kuttaya` actual que puede saltar.
+    std::string tailFunction;
+    std::string tailLabel;
+    int tailFrameBytes = 0;
+    const CallExpr *tailCall = nullptr;
+    bool tailCallEmitted = false;
     size_t tryTempCounter = 0;
     long seed = -1;
     bool keepAsm = false;
@@ -58,6 +109,14 @@ public:
     bool timePipeline = false;
     std::string timePipelineJsonPath;
     long long toolTimeoutMs = 0;
+    std::string runtimeOpt = "O2";
+    bool gcStats = false;
+    // Backend ir: modulo SSA que se vuelca en irDumpPath y se baja a NASM.
+    bool useIr = false;
+    std::string irDumpPath;
+    IrModule irModule;
+    std::unordered_set<std::string> irUserFunctions;
+    long long irGenMs = -1;
 
     bool emit(const std::vector<std::unique_ptr<Node>> &nodes,
               const std::string &path,
@@ -90,6 +149,10 @@ private:
                     const std::unordered_map<std::string,int> *locals) const;
     bool isMapExpr(const Expr *expr,
                    const std::unordered_map<std::string,int> *locals) const;
+    bool isSetExpr(const Expr *expr,
+                   const std::unordered_map<std::string,int> *locals) const;
+    std::string queueType(const Expr *expr,
+                          const std::unordered_map<std::string,int> *locals) const;
     std::string listElementType(const Expr *expr,
                                 const std::unordered_map<std::string,int> *locals) const;
     std::string mapValueType(const Expr *expr,
@@ -100,6 +163,10 @@ private:
                        const std::unordered_map<std::string,int> *locals);
     void emitPrintMap(const Expr *expr,
                       const std::unordered_map<std::string,int> *locals);
+    void emitPrintRuntimeItems(const Expr *expr,
+                               const std::unordered_map<std::string,int> *locals,
+                               const std::string &runtime, const std::string &open,
+                               const std::string &close);
     void emitPrintDefault(const std::string &label);
 
     void emitStmt(const Stmt *stmt,
@@ -118,6 +185,51 @@ private:
                   const std::unordered_map<std::string,int> *locals);
     bool emitExprOperator(const Expr *expr,
                           const std::unordered_map<std::string,int> *locals);
+    void collectConcatParts(const Expr *expr,
+                            const std::unordered_map<std::string,int> *locals,
+                            std::vector<std::pair<const Expr*, bool>> &parts);
+    bool emitStringBuild(const BinaryExpr *b,
+                         const std::unordered_map<std::string,int> *locals);
+    bool pureFunction(const std::string &name, size_t arity, bool noThrow,
+                      std::unordered_set<std::string> &visiting) const;
+    bool pureStageFunction(const Expr *ref, size_t arity, bool noThrow = false) const;
+    bool emitFusedPipeline(const CallExpr *c,
+                           const std::unordered_map<std::string,int> *locals);
+    bool emitMulByConst(long long factor);
+    bool emitDivByConst(char op, long long divisor);
+    void emitPowLoop();
+    void emitPowByConst(long long exponent);
+    bool boundedLoopIndex(const ForStmt *loop, std::string &index, std::string &array) const;
+    bool isBoundedIndex(const Expr *base, const Expr *index) const;
+    std::string emitBoundedArrayElement(const Expr *base, const Expr *index,
+                                        const std::unordered_map<std::string,int> *locals);
+    void emitArrayGet();
+    void emitArraySet();
+    void emitArrayLength();
+    void resetScratchDecls(const std::vector<const Stmt*> &body, const std::vector<Param> *params);
+    void collectRegionLocals(const Stmt *stmt, std::unordered_set<std::string> &names) const;
+    bool scalarVariable(const std::string &name,
+                        const std::unordered_map<std::string,int> *locals) const;
+    bool scratchExprSafe(const Expr *expr,
+                         const std::unordered_map<std::string,int> *locals,
+                         bool &allocates) const;
+    bool readsRegionText(const Expr *expr,
+                         const std::unordered_map<std::string,int> *locals,
+                         const std::unordered_set<std::string> &regionLocals) const;
+    bool scratchStmtSafe(const Stmt *stmt,
+                         const std::unordered_map<std::string,int> *locals,
+                         const std::unordered_set<std::string> &regionLocals,
+                         bool &allocates) const;
+    bool scratchLoopRegion(const Stmt *body, const Expr *cond, const Stmt *post,
+                           const std::unordered_map<std::string,int> *locals) const;
+    bool scratchStatement(const Stmt *stmt,
+                          const std::unordered_map<std::string,int> *locals) const;
+    void emitScratchMark();
+    void emitScratchRelease();
+    void emitScratchClose();
+    std::string handlerField(const TryStmt *t, const std::unordered_map<std::string,int> *locals,
+                             long offset) const;
+    void emitUnlinkHandlers(size_t depth, const std::unordered_map<std::string,int> *locals);
     void emitCallExpr(const CallExpr *expr,
                       const std::unordered_map<std::string,int> *locals);
     bool emitBuiltinIoCall(const CallExpr *expr,
@@ -147,7 +259,14 @@ private:
     void emitCallArgs(const std::vector<std::unique_ptr<Expr>> &args,
                       const std::unordered_map<std::string,int> *locals,
                       size_t regStart = 0);
+    bool tailCallable(const CallExpr *c) const;
+    void emitTailJump(const CallExpr *c);
     void emitFunction(const FunctionInfo &info);
+    void enterFunctionContext(const FunctionInfo &info);
+    void enterMainContext();
+    class IrFunctionBuilder;
+    bool buildIrModule(std::string *errorMessageOut);
+    void emitIrFunction(const IrFunction &fn);
     void emitInput(bool asString);
     void collectProgramItems(const std::vector<std::unique_ptr<Node>> &nodes);
     void emitRuntimePrelude();
@@ -160,6 +279,34 @@ private:
 
     void registerClass(const ClassStmt *cls);
     void collectClassStrings();
+    const ObjectLayout &objectLayout(const std::string &className);
+    long objectFieldOffset(const std::string &className, const std::string &field);
+    std::string objectClassOf(const Expr *expr,
+                              const std::unordered_map<std::string,int> *locals) const;
+    void allocateLocalRegisters(const FunctionInfo &info);
+    void assignStackSlots(FunctionInfo &info);
+    bool selfStaysLocal(const std::string &cls, const std::string &impl,
+                        std::unordered_set<std::string> &visiting);
+    bool objectStaysLocal(const std::string &cls, const VarUses &uses,
+                          std::unordered_set<std::string> &visiting);
+    static long stackMapSlots(long cap);
+    std::string varOperand(const std::string &name,
+                           const std::unordered_map<std::string,int> *locals) const;
+    std::string leafOperand(const Expr *expr,
+                            const std::unordered_map<std::string,int> *locals) const;
+    bool isCallFreeExpr(const Expr *expr,
+                        const std::unordered_map<std::string,int> *locals);
+    const char *exprTempReg() const;
+    void emitPreserveRegLocals(bool restore);
+    long objectMethodSlot(const std::string &className, const std::string &method);
+    bool isSubclassOf(const std::string &derived, const std::string &base) const;
+    std::string devirtualizedMethod(const std::string &className, const std::string &method);
+    void emitClassInfo();
+    void emitObjectNullCheck(const Expr *base, const std::string &member);
+    std::string superMethodImpl(const std::string &method) const;
+    bool emitObjectMapCall(const CallExpr *expr,
+                           const std::unordered_map<std::string,int> *locals,
+                           const std::string &runtimeFn);
     bool emitNewExpr(const NewExpr *expr,
                      const std::unordered_map<std::string,int> *locals);
     bool emitMemberCallExpr(const MemberCallExpr *expr,
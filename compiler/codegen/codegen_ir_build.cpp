@@ -0,0 +1,659 @@
+#include "codegen_impl.h"
+#include "../builtins/builtins.h"
+#include "../utils/fs.h"
+
+#include <chrono>
+#include <iostream>
+
+namespace aym {
+
+namespace {
+
+IrType irTypeForDecl(const std::string &type) {
+    if (type == "aru") return IrType::Str;
+    if (type == "chiqa") return IrType::Bool;
+    return IrType::I64;
+}
+
+} // namespace
+
+// Construye SSA directamente desde el AST (Braun et al., "Simple and Efficient
+// Construction of SSA Form"): cada variable local guarda su definicion actual
+// por bloque y los phis se crean al leer en bloques con varios predecesores.
+// Los bloques se sellan cuando ya no pueden recibir aristas nuevas.
+class CodeGenImpl::IrFunctionBuilder {
+public:
+    IrFunctionBuilder(CodeGenImpl &cg, IrFunction &fn,
+                      const std::unordered_map<std::string,int> *locals)
+        : cg(cg), fn(fn), locals(locals) {}
+
+    std::string failure;
+
+    bool buildFunction(const FunctionInfo &info) {
+        for (const auto &name : info.locals) {
+            auto type = cg.currentParamTypes.find(name);
+            auto local = cg.currentLocalTypes.find(name);
+            ssaTypes[name] = type != cg.currentParamTypes.end() ? irTypeForDecl(type->second)
+                           : local != cg.currentLocalTypes.end() ? irTypeForDecl(local->second)
+                           : IrType::I64;
+        }
+        auto ret = cg.functionReturnTypes.find(info.name);
+        fn.returnType = ret != cg.functionReturnTypes.end() ? irTypeForDecl(ret->second) : IrType::I64;
+        cur = fn.addBlock();
+        fn.blocks[cur].sealed = true;
+        std::vector<std::string> regs = paramRegs(cg.windows);
+        if (info.params.size() > regs.size()) {
+            return fail("mas parametros que registros");
+        }
+        for (size_t i = 0; i < info.params.size(); ++i) {
+            IrType type = ssaTypes[info.params[i].name];
+            fn.params.push_back(type);
+            IrInstr param{IrOp::Param, type};
+            param.imm = static_cast<long long>(i);
+            writeVar(info.params[i].name, cur, fn.append(cur, param));
+        }
+        if (!stmt(info.body)) return false;
+        if (!fn.terminated(cur)) {
+            fn.append(cur, IrInstr{IrOp::Ret});
+        }
+        return true;
+    }
+
+    bool buildMain(const std::vector<const Stmt*> &stmts) {
+        fn.isMain = true;
+        cur = fn.addBlock();
+        fn.blocks[cur].sealed = true;
+        for (const auto *s : stmts) {
+            if (!stmt(s)) return false;
+        }
+        if (!fn.terminated(cur)) {
+            fn.append(cur, IrInstr{IrOp::Ret});
+        }
+        return true;
+    }
+
+private:
+    CodeGenImpl &cg;
+    IrFunction &fn;
+    const std::unordered_map<std::string,int> *locals;
+    int cur = 0;
+    std::unordered_map<std::string, IrType> ssaTypes;
+    std::unordered_map<std::string, std::unordered_map<int,int>> currentDef;
+    std::unordered_map<int, std::vector<std::pair<std::string,int>>> incompletePhis;
+    struct LoopTargets {
+        int breakBlock;
+        int continueBlock;
+    };
+    std::vector<LoopTargets> loops;
+
+    bool fail(const std::string &why) {
+        if (failure.empty()) failure = why;
+        return false;
+    }
+
+    int emit(IrOp op, IrType type, std::vector<int> args = {}, const std::string &symbol = "") {
+        IrInstr instr{op, type};
+        instr.args = std::move(args);
+        instr.symbol = symbol;
+        return fn.append(cur, std::move(instr));
+    }
+
+    int constant(long long value, IrType type = IrType::I64) {
+        IrInstr instr{IrOp::Const, type};
+        instr.imm = value;
+        return fn.append(cur, instr);
+    }
+
+    int address(const std::string &symbol) {
+        return emit(IrOp::Addr, IrType::Str, {}, symbol);
+    }
+
+    void addEdge(int from, int to) {
+        fn.blocks[to].preds.push_back(from);
+    }
+
+    void jump(int target) {
+        IrInstr br{IrOp::Br};
+        br.targets = {target};
+        fn.append(cur, br);
+        addEdge(cur, target);
+    }
+
+    void branch(int cond, int ifTrue, int ifFalse) {
+        IrInstr br{IrOp::CondBr};
+        br.args = {cond};
+        br.targets = {ifTrue, ifFalse};
+        fn.append(cur, br);
+        addEdge(cur, ifTrue);
+        addEdge(cur, ifFalse);
+    }
+
+    // Bloque sin predecesores para el codigo que sigue a kuttaya/pakhina.
+    void startDeadBlock() {
+        cur = fn.addBlock();
+        fn.blocks[cur].sealed = true;
+    }
+
+    int insertAtBlockStart(int block, IrInstr instr) {
+        instr.block = block;
+        fn.values.push_back(std::move(instr));
+        int id = static_cast<int>(fn.values.size()) - 1;
+        auto &instrs = fn.blocks[block].instrs;
+        auto pos = instrs.begin();
+        while (pos != instrs.end() && fn.values[*pos].op == IrOp::Phi) ++pos;
+        instrs.insert(pos, id);
+        return id;
+    }
+
+    int newPhi(int block, IrType type) {
+        IrInstr phi{IrOp::Phi, type};
+        phi.block = block;
+        fn.values.push_back(phi);
+        int id = static_cast<int>(fn.values.size()) - 1;
+        auto &instrs = fn.blocks[block].instrs;
+        instrs.insert(instrs.begin(), id);
+        return id;
+    }
+
+    void writeVar(const std::string &name, int block, int value) {
+        currentDef[name][block] = value;
+    }
+
+    int readVar(const std::string &name, int block) {
+        auto &defs = currentDef[name];
+        auto it = defs.find(block);
+        if (it != defs.end()) return it->second;
+        int value;
+        IrType type = ssaTypes[name];
+        const IrBlock &b = fn.blocks[block];
+        if (!b.sealed) {
+            value = newPhi(block, type);
+            incompletePhis[block].push_back({name, value});
+        } else if (b.preds.empty()) {
+            // Lectura sin definicion previa en ningun camino: vale 0.
+            IrInstr zero{IrOp::Const, type};
+            value = insertAtBlockStart(block, zero);
+        } else if (b.preds.size() == 1) {
+            value = readVar(name, b.preds[0]);
+        } else {
+            value = newPhi(block, type);
+            writeVar(name, block, value);
+            addPhiOperands(name, value);
+        }
+        writeVar(name, block, value);
+        return value;
+    }
+
+    void addPhiOperands(const std::string &name, int phi) {
+        int block = fn.values[phi].block;
+        std::vector<int> preds = fn.blocks[block].preds;
+        for (int pred : preds) {
+            int value = readVar(name, pred);
+            fn.values[phi].args.push_back(value);
+            fn.values[phi].targets.push_back(pred);
+        }
+    }
+
+    void sealBlock(int block) {
+        auto pending = incompletePhis.find(block);
+        if (pending != incompletePhis.end()) {
+            auto phis = std::move(pending->second);
+            incompletePhis.erase(pending);
+            for (const auto &entry : phis) addPhiOperands(entry.first, entry.second);
+        }
+        fn.blocks[block].sealed = true;
+    }
+
+    IrType globalType(const std::string &name) const {
+        auto it = cg.globalTypes.find(name);
+        return it != cg.globalTypes.end() ? irTypeForDecl(it->second) : IrType::I64;
+    }
+
+    bool isSsaVar(const std::string &name) const {
+        return ssaTypes.count(name) != 0;
+    }
+
+    int loadVar(const std::string &name) {
+        if (isSsaVar(name)) return readVar(name, cur);
+        return emit(IrOp::GlobalLoad, globalType(name), {}, name);
+    }
+
+    void storeVar(const std::string &name, int value) {
+        if (isSsaVar(name)) {
+            writeVar(name, cur, value);
+        } else {
+            emit(IrOp::GlobalStore, IrType::Void, {value}, name);
+        }
+    }
+
+    IrType exprType(const Expr *e) const {
+        if (cg.isStringExpr(e, locals)) return IrType::Str;
+        if (cg.isBoolExpr(e, locals)) return IrType::Bool;
+        return IrType::I64;
+    }
+
+    // Une dos valores que llegan desde bloques distintos.
+    int join(int thenBlock, int thenValue, int elseBlock, int elseValue, IrType type) {
+        int end = fn.addBlock();
+        cur = thenBlock;
+        jump(end);
+        cur = elseBlock;
+        jump(end);
+        cur = end;
+        sealBlock(end);
+        int phi = newPhi(end, type);
+        fn.values[phi].args = {thenValue, elseValue};
+        fn.values[phi].targets = {thenBlock, elseBlock};
+        return phi;
+    }
+
+    bool expr(const Expr *e, int &result) {
+        if (!e) return fail("expresion vacia");
+        if (auto *n = dynamic_cast<const NumberExpr*>(e)) {
+            result = constant(n->getValue());
+            return true;
+        }
+        if (auto *b = dynamic_cast<const BoolExpr*>(e)) {
+            result = constant(b->getValue() ? 1 : 0, IrType::Bool);
+            return true;
+        }
+        if (auto *s = dynamic_cast<const StringExpr*>(e)) {
+            size_t idx = cg.findString(s->getValue());
+            if (idx == cg.strings.size()) return fail("cadena sin registrar");
+            IrInstr str{IrOp::Str, IrType::Str};
+            str.imm = static_cast<long long>(idx);
+            result = fn.append(cur, str);
+            return true;
+        }
+        if (auto *v = dynamic_cast<const VariableExpr*>(e)) {
+            result = loadVar(v->getName());
+            return true;
+        }
+        if (auto *inc = dynamic_cast<const IncDecExpr*>(e)) {
+            int old = loadVar(inc->getName());
+            int updated = emit(inc->increment() ? IrOp::Add : IrOp::Sub, IrType::I64, {old, constant(1)});
+            storeVar(inc->getName(), updated);
+            result = inc->prefix() ? updated : old;
+            return true;
+        }
+        if (auto *u = dynamic_cast<const UnaryExpr*>(e)) {
+            int value;
+            if (!expr(u->getExpr(), value)) return false;
+            if (u->getOp() == '!') result = emit(IrOp::Not, IrType::Bool, {value});
+            else if (u->getOp() == '-') result = emit(IrOp::Neg, IrType::I64, {value});
+            else result = value;
+            return true;
+        }
+        if (auto *t = dynamic_cast<const TernaryExpr*>(e)) {
+            int cond;
+            if (!expr(t->getCondition(), cond)) return false;
+            int thenBlock = fn.addBlock();
+            int elseBlock = fn.addBlock();
+            branch(cond, thenBlock, elseBlock);
+            sealBlock(thenBlock);
+            sealBlock(elseBlock);
+            int thenValue, elseValue;
+            cur = thenBlock;
+            if (!expr(t->getThen(), thenValue)) return false;
+            int thenEnd = cur;
+            cur = elseBlock;
+            if (!expr(t->getElse(), elseValue)) return false;
+            result = join(thenEnd, thenValue, cur, elseValue, exprType(t));
+            return true;
+        }
+        if (auto *b = dynamic_cast<const BinaryExpr*>(e)) {
+            return binary(b, result);
+        }
+        if (auto *c = dynamic_cast<const CallExpr*>(e)) {
+            return call(c, result);
+        }
+        return fail("expresion no soportada");
+    }
+
+    bool binary(const BinaryExpr *b, int &result) {
+        char op = b->getOp();
+        int left;
+        if (!expr(b->getLeft(), left)) return false;
+        if (op == '&' || op == '|') {
+            // Cortocircuito: el derecho solo se evalua en su propio bloque.
+            int rhsBlock = fn.addBlock();
+            int shortBlock = fn.addBlock();
+            if (op == '&') branch(left, rhsBlock, shortBlock);
+            else branch(left, shortBlock, rhsBlock);
+            sealBlock(rhsBlock);
+            sealBlock(shortBlock);
+            cur = rhsBlock;
+            int right;
+            if (!expr(b->getRight(), right)) return false;
+            int normalized = emit(IrOp::CmpNe, IrType::Bool, {right, constant(0)});
+            int rhsEnd = cur;
+            cur = shortBlock;
+            int shortValue = constant(op == '&' ? 0 : 1, IrType::Bool);
+            result = join(rhsEnd, normalized, shortBlock, shortValue, IrType::Bool);
+            return true;
+        }
+        int right;
+        if (!expr(b->getRight(), right)) return false;
+        bool strings = cg.isStringExpr(b->getLeft(), locals) && cg.isStringExpr(b->getRight(), locals);
+        switch (op) {
+            case '+':
+                result = strings ? emit(IrOp::RtCall, IrType::Str, {left, right}, "aym_str_concat")
+                                 : emit(IrOp::Add, IrType::I64, {left, right});
+                return true;
+            case '-': result = emit(IrOp::Sub, IrType::I64, {left, right}); return true;
+            case '*': result = emit(IrOp::Mul, IrType::I64, {left, right}); return true;
+            case '/': result = emit(IrOp::Div, IrType::I64, {left, right}); return true;
+            case '%': result = emit(IrOp::Mod, IrType::I64, {left, right}); return true;
+            case '^': result = emit(IrOp::Pow, IrType::I64, {left, right}); return true;
+            case '<': result = emit(IrOp::CmpLt, IrType::Bool, {left, right}); return true;
+            case 'l': result = emit(IrOp::CmpLe, IrType::Bool, {left, right}); return true;
+            case '>': result = emit(IrOp::CmpGt, IrType::Bool, {left, right}); return true;
+            case 'g': result = emit(IrOp::CmpGe, IrType::Bool, {left, right}); return true;
+            case 's':
+            case 'd': {
+                IrOp cmp = op == 's' ? IrOp::CmpEq : IrOp::CmpNe;
+                if (strings) {
+                    int equal = emit(IrOp::RtCall, IrType::I64, {left, right}, "aym_str_eq");
+                    result = emit(op == 's' ? IrOp::CmpNe : IrOp::CmpEq, IrType::Bool, {equal, constant(0)});
+                } else {
+                    result = emit(cmp, IrType::Bool, {left, right});
+                }
+                return true;
+            }
+        }
+        return fail("operador no soportado");
+    }
+
+    bool call(const CallExpr *c, int &result) {
+        if (!cg.irUserFunctions.count(c->getName()) ||
+            getBuiltinFunctions().count(lowerName(c->getName()))) {
+            return fail("llamada a builtin " + c->getName());
+        }
+        if (c->getArgs().size() > paramRegs(cg.windows).size()) {
+            return fail("mas argumentos que registros");
+        }
+        std::vector<int> args;
+        for (const auto &arg : c->getArgs()) {
+            int value;
+            if (!expr(arg.get(), value)) return false;
+            args.push_back(value);
+        }
+        auto ret = cg.functionReturnTypes.find(c->getName());
+        IrType type = ret != cg.functionReturnTypes.end() ? irTypeForDecl(ret->second) : IrType::I64;
+        result = emit(IrOp::Call, type, std::move(args), c->getName());
+        return true;
+    }
+
+    void printCall(const std::string &symbol, int value) {
+        IrInstr print{IrOp::RtCall, IrType::Void};
+        print.symbol = symbol;
+        print.args = {value};
+        fn.append(cur, print);
+    }
+
+    bool printValue(const Expr *e) {
+        if (dynamic_cast<const IndexExpr*>(e) || cg.isListExpr(e, locals) || cg.isMapExpr(e, locals) ||
+            cg.isSetExpr(e, locals) || !cg.queueType(e, locals).empty() ||
+            !cg.objectClassOf(e, locals).empty()) {
+            return fail("qillqa de coleccion");
+        }
+        int value;
+        if (!expr(e, value)) return false;
+        if (cg.isBoolExpr(e, locals)) {
+            int trueBlock = fn.addBlock();
+            int falseBlock = fn.addBlock();
+            int end = fn.addBlock();
+            branch(value, trueBlock, falseBlock);
+            sealBlock(trueBlock);
+            sealBlock(falseBlock);
+            cur = trueBlock;
+            printCall("aym_write_str", address("bool_true"));
+            jump(end);
+            cur = falseBlock;
+            printCall("aym_write_str", address("bool_false"));
+            jump(end);
+            sealBlock(end);
+            cur = end;
+            return true;
+        }
+        printCall(cg.isStringExpr(e, locals) ? "aym_write_str" : "aym_write_int", value);
+        return true;
+    }
+
+    bool printPiece(const Expr *e, const std::string &fallback) {
+        if (e) return printValue(e);
+        printCall("aym_write_str", address(fallback));
+        return true;
+    }
+
+    bool condBlocks(const Expr *cond, int ifTrue, int ifFalse) {
+        int value;
+        if (!expr(cond, value)) return false;
+        branch(value, ifTrue, ifFalse);
+        return true;
+    }
+
+    bool loopBody(const Stmt *body, int breakBlock, int continueBlock) {
+        loops.push_back({breakBlock, continueBlock});
+        bool ok = stmt(body);
+        loops.pop_back();
+        if (ok && !fn.terminated(cur)) jump(continueBlock);
+        return ok;
+    }
+
+    bool stmt(const Stmt *s) {
+        if (!s) return true;
+        if (auto *block = dynamic_cast<const BlockStmt*>(s)) {
+            for (const auto &child : block->statements) {
+                if (!stmt(child.get())) return false;
+            }
+            return true;
+        }
+        if (auto *p = dynamic_cast<const PrintStmt*>(s)) {
+            const auto &exprs = p->getExprs();
+            for (size_t i = 0; i < exprs.size(); ++i) {
+                if (!printValue(exprs[i].get())) return false;
+                if (i + 1 < exprs.size() && !printPiece(p->getSeparator(), "print_sep")) return false;
+            }
+            return printPiece(p->getTerminator(), "print_term");
+        }
+        if (auto *e = dynamic_cast<const ExprStmt*>(s)) {
+            int ignored;
+            return !e->getExpr() || expr(e->getExpr(), ignored);
+        }
+        if (auto *a = dynamic_cast<const AssignStmt*>(s)) {
+            int value;
+            if (!expr(a->getValue(), value)) return false;
+            storeVar(a->getName(), value);
+            return true;
+        }
+        if (auto *v = dynamic_cast<const VarDeclStmt*>(s)) {
+            if (v->getInit()) {
+                int value;
+                if (!expr(v->getInit(), value)) return false;
+                storeVar(v->getName(), value);
+            } else if (isSsaVar(v->getName())) {
+                writeVar(v->getName(), cur, constant(0, ssaTypes[v->getName()]));
+            }
+            return true;
+        }
+        if (auto *i = dynamic_cast<const IfStmt*>(s)) {
+            int thenBlock = fn.addBlock();
+            int elseBlock = fn.addBlock();
+            int end = i->getElse() ? fn.addBlock() : elseBlock;
+            if (!condBlocks(i->getCondition(), thenBlock, elseBlock)) return false;
+            sealBlock(thenBlock);
+            cur = thenBlock;
+            if (!stmt(i->getThen())) return false;
+            if (!fn.terminated(cur)) jump(end);
+            if (i->getElse()) {
+                sealBlock(elseBlock);
+                cur = elseBlock;
+                if (!stmt(i->getElse())) return false;
+                if (!fn.terminated(cur)) jump(end);
+            }
+            sealBlock(end);
+            cur = end;
+            return true;
+        }
+        if (auto *w = dynamic_cast<const WhileStmt*>(s)) {
+            int header = fn.addBlock();
+            int body = fn.addBlock();
+            int end = fn.addBlock();
+            jump(header);
+            cur = header;
+            if (w->getCondition()) {
+                if (!condBlocks(w->getCondition(), body, end)) return false;
+            } else {
+                jump(body);
+            }
+            sealBlock(body);
+            cur = body;
+            if (!loopBody(w->getBody(), end, header)) return false;
+            sealBlock(header);
+            sealBlock(end);
+            cur = end;
+            return true;
+        }
+        if (auto *f = dynamic_cast<const ForStmt*>(s)) {
+            if (!stmt(f->getInit())) return false;
+            int header = fn.addBlock();
+            int body = fn.addBlock();
+            int step = fn.addBlock();
+            int end = fn.addBlock();
+            jump(header);
+            cur = header;
+            if (f->getCondition()) {
+                if (!condBlocks(f->getCondition(), body, end)) return false;
+            } else {
+                jump(body);
+            }
+            sealBlock(body);
+            cur = body;
+            if (!loopBody(f->getBody(), end, step)) return false;
+            sealBlock(step);
+            cur = step;
+            if (!stmt(f->getPost())) return false;
+            jump(header);
+            sealBlock(header);
+            sealBlock(end);
+            cur = end;
+            return true;
+        }
+        if (auto *dw = dynamic_cast<const DoWhileStmt*>(s)) {
+            int body = fn.addBlock();
+            int cont = fn.addBlock();
+            int end = fn.addBlock();
+            jump(body);
+            cur = body;
+            if (!loopBody(dw->getBody(), end, cont)) return false;
+            sealBlock(cont);
+            cur = cont;
+            if (!condBlocks(dw->getCondition(), body, end)) return false;
+            sealBlock(body);
+            sealBlock(end);
+            cur = end;
+            return true;
+        }
+        if (dynamic_cast<const BreakStmt*>(s) || dynamic_cast<const ContinueStmt*>(s)) {
+            if (loops.empty()) return true;
+            jump(dynamic_cast<const BreakStmt*>(s) ? loops.back().breakBlock : loops.back().continueBlock);
+            startDeadBlock();
+            return true;
+        }
+        if (auto *ret = dynamic_cast<const ReturnStmt*>(s)) {
+            IrInstr instr{IrOp::Ret};
+            if (ret->getValue() && !fn.isMain) {
+                int value;
+                if (!expr(ret->getValue(), value)) return false;
+                instr.args = {value};
+            } else if (ret->getValue()) {
+                int ignored;
+                if (!expr(ret->getValue(), ignored)) return false;
+            }
+            fn.append(cur, instr);
+            startDeadBlock();
+            return true;
+        }
+        if (dynamic_cast<const ImportStmt*>(s)) {
+            return true;
+        }
+        return fail("sentencia no soportada");
+    }
+};
+
+bool CodeGenImpl::buildIrModule(std::string *errorMessageOut) {
+    const auto started = std::chrono::steady_clock::now();
+    irModule = IrModule{};
+    irUserFunctions.clear();
+    for (const auto &info : functions) {
+        if (info.className.empty()) irUserFunctions.insert(info.name);
+    }
+
+    auto build = [&](IrFunction fn, const std::string &name, auto &&body) {
+        std::string failure;
+        if (body(fn, failure)) {
+            simplifyIrFunction(fn);
+            failure = verifyIrFunction(fn);
+            if (failure.empty()) {
+                irModule.functions.push_back(std::move(fn));
+                return;
+            }
+        }
+        irModule.skipped.push_back({name, failure});
+    };
+    for (const auto &info : functions) {
+        IrFunction fn;
+        fn.name = info.name;
+        build(std::move(fn), info.name, [&](IrFunction &target, std::string &failure) {
+            if (!info.className.empty()) {
+                failure = "metodo de kasta";
+                return false;
+            }
+            enterFunctionContext(info);
+            std::unordered_map<std::string,int> locals;
+            for (const auto &name : info.locals) locals[name] = 0;
+            IrFunctionBuilder builder(*this, target, &locals);
+            bool ok = builder.buildFunction(info);
+            failure = builder.failure;
+            return ok;
+        });
+    }
+    IrFunction mainFn;
+    mainFn.name = "main";
+    build(std::move(mainFn), "main", [&](IrFunction &target, std::string &failure) {
+        enterMainContext();
+        IrFunctionBuilder builder(*this, target, nullptr);
+        bool ok = builder.buildMain(mainStmts);
+        failure = builder.failure;
+        return ok;
+    });
+    irModule.strings = strings;
+
+    std::error_code ec;
+    fs::path dumpPath(irDumpPath);
+    if (dumpPath.has_parent_path()) {
+        fs::create_directories(dumpPath.parent_path(), ec);
+    }
+    std::ofstream dump(dumpPath);
+    if (!dump.is_open()) {
+        const std::string message = "No se pudo generar artefacto IR: " + irDumpPath;
+        if (errorMessageOut != nullptr) *errorMessageOut = message;
+        else std::cerr << message << std::endl;
+        return false;
+    }
+    dump << "# AymaraLang IR (SSA)\n";
+    dump << "backend = ir\n";
+    dump << "functions = " << irModule.functions.size() << "\n";
+    dump << "ast_fallback = " << irModule.skipped.size() << "\n";
+    dumpIrModule(irModule, dump);
+
+    const auto finished = std::chrono::steady_clock::now();
+    irGenMs = std::chrono::duration_cast<std::chrono::milliseconds>(finished - started).count();
+    if (timePipeline) {
+        std::cout << "[aymc] etapa ir-gen: " << irGenMs << " ms" << std::endl;
+    }
+    return true;
+}
+
+} // namespace aym
@@ -0,0 +1,246 @@
+#include "codegen_impl.h"
+
+namespace aym {
+
+// Baja una funcion SSA al mismo NASM que el backend nativo: prologo con
+// rbx/r12-r15 guardados, argumentos en paramRegs y llamadas al runtime.
+// Cada valor con resultado vive en un slot [rbp-N]; los phis tienen ademas
+// un slot de entrada que escriben los predecesores antes de saltar, asi las
+// copias de un mismo borde no se pisan entre si.
+void CodeGenImpl::emitIrFunction(const IrFunction &fn) {
+    constexpr int savedRegsBytes = 5 * 8;
+    std::unordered_map<int,int> slots;
+    std::unordered_map<int,int> phiInputs;
+    int off = savedRegsBytes;
+    for (const auto &block : fn.blocks) {
+        for (int id : block.instrs) {
+            const IrInstr &instr = fn.values[id];
+            if (!irHasResult(instr) || instr.op == IrOp::Const || instr.op == IrOp::Str ||
+                instr.op == IrOp::Addr) {
+                continue;
+            }
+            off += 8;
+            slots[id] = off;
+            if (instr.op == IrOp::Phi) {
+                off += 8;
+                phiInputs[id] = off;
+            }
+        }
+    }
+    int shadow = this->windows ? 32 : 0;
+    int stackSize = ((off - savedRegsBytes + shadow + 15) & ~15) + 8;
+    std::vector<std::string> regs = paramRegs(this->windows);
+
+    auto slot = [&](int id) { return "[rbp-" + std::to_string(slots.at(id)) + "]"; };
+    auto load = [&](const std::string &reg, int id) {
+        const IrInstr &v = fn.values[id];
+        if (v.op == IrOp::Const) {
+            out << "    mov " << reg << ", " << v.imm << "\n";
+        } else if (v.op == IrOp::Str) {
+            out << "    lea " << reg << ", [rel str" << v.imm << "]\n";
+        } else if (v.op == IrOp::Addr) {
+            out << "    lea " << reg << ", [rel " << v.symbol << "]\n";
+        } else {
+            out << "    mov " << reg << ", " << slot(id) << "\n";
+        }
+    };
+    auto store = [&](int id) {
+        out << "    mov " << slot(id) << ", rax\n";
+    };
+
+    std::string prefix = genLabel("ir");
+    auto label = [&](int b) { return prefix + "_bb" + std::to_string(b); };
+    std::string endLabel = genLabel(fn.isMain ? "endmain" : "endfunc");
+    std::vector<int> order;
+    for (size_t b = 0; b < fn.blocks.size(); ++b) {
+        if (!fn.blocks[b].instrs.empty()) order.push_back(static_cast<int>(b));
+    }
+
+    auto phiCopies = [&](int from, int to) {
+        for (int id : fn.blocks[to].instrs) {
+            const IrInstr &phi = fn.values[id];
+            if (phi.op != IrOp::Phi) break;
+            for (size_t i = 0; i < phi.targets.size(); ++i) {
+                if (phi.targets[i] != from) continue;
+                load("rax", phi.args[i]);
+                out << "    mov [rbp-" << phiInputs.at(id) << "], rax\n";
+                break;
+            }
+        }
+    };
+
+    out << (fn.isMain ? "main" : fn.name) << ":\n";
+    out << "    push rbp\n";
+    out << "    mov rbp, rsp\n";
+    out << "    push rbx\n";
+    out << "    push r12\n";
+    out << "    push r13\n";
+    out << "    push r14\n";
+    out << "    push r15\n";
+    out << "    sub rsp, " << stackSize << "\n";
+    std::string tailLabel = genLabel("tail");
+    if (!fn.isMain) out << tailLabel << ":\n";
+    if (fn.isMain) {
+        out << "    call aym_set_args\n";
+        if (gcStats) out << "    call aym_gc_stats_enable\n";
+        if (seed >= 0) {
+            out << "    mov " << reg1(this->windows) << ", " << seed << "\n";
+            out << "    call aym_srand\n";
+        }
+    }
+
+    for (size_t pos = 0; pos < order.size(); ++pos) {
+        int b = order[pos];
+        int next = pos + 1 < order.size() ? order[pos + 1] : -1;
+        out << label(b) << ":\n";
+        const std::vector<int> &instrs = fn.blocks[b].instrs;
+        for (size_t k = 0; k < instrs.size(); ++k) {
+            int id = instrs[k];
+            const IrInstr &instr = fn.values[id];
+            switch (instr.op) {
+                case IrOp::Const:
+                case IrOp::Str:
+                case IrOp::Addr:
+                    break;
+                case IrOp::Param:
+                    out << "    mov " << slot(id) << ", " << regs[instr.imm] << "\n";
+                    break;
+                case IrOp::Phi:
+                    out << "    mov rax, [rbp-" << phiInputs.at(id) << "]\n";
+                    store(id);
+                    break;
+                case IrOp::GlobalLoad:
+                    out << "    mov rax, [rel " << instr.symbol << "]\n";
+                    store(id);
+                    break;
+                case IrOp::GlobalStore:
+                    load("rax", instr.args[0]);
+                    out << "    mov [rel " << instr.symbol << "], rax\n";
+                    break;
+                case IrOp::Add:
+                case IrOp::Sub:
+                case IrOp::Mul:
+                    load("rax", instr.args[0]);
+                    if (instr.op == IrOp::Mul && fn.values[instr.args[1]].op == IrOp::Const &&
+                        emitMulByConst(fn.values[instr.args[1]].imm)) {
+                        store(id);
+                        break;
+                    }
+                    load("rcx", instr.args[1]);
+                    out << "    " << (instr.op == IrOp::Add ? "add" : instr.op == IrOp::Sub ? "sub" : "imul")
+                        << " rax, rcx\n";
+                    store(id);
+                    break;
+                case IrOp::Div:
+                case IrOp::Mod: {
+                    char op = instr.op == IrOp::Div ? '/' : '%';
+                    load("rax", instr.args[0]);
+                    const IrInstr &rhs = fn.values[instr.args[1]];
+                    if (rhs.op != IrOp::Const || !emitDivByConst(op, rhs.imm)) {
+                        load("rcx", instr.args[1]);
+                        out << "    cqo\n    idiv rcx\n";
+                        if (instr.op == IrOp::Mod) out << "    mov rax, rdx\n";
+                    }
+                    store(id);
+                    break;
+                }
+                case IrOp::Pow: {
+                    load("rax", instr.args[0]);
+                    const IrInstr &rhs = fn.values[instr.args[1]];
+                    if (rhs.op == IrOp::Const) {
+                        emitPowByConst(rhs.imm);
+                    } else {
+                        load("rcx", instr.args[1]);
+                        emitPowLoop();
+                    }
+                    store(id);
+                    break;
+                }
+                case IrOp::Neg:
+                    load("rax", instr.args[0]);
+                    out << "    neg rax\n";
+                    store(id);
+                    break;
+                case IrOp::Not:
+                    load("rax", instr.args[0]);
+                    out << "    cmp rax,0\n    sete al\n    movzx rax,al\n";
+                    store(id);
+                    break;
+                case IrOp::CmpEq:
+                case IrOp::CmpNe:
+                case IrOp::CmpLt:
+                case IrOp::CmpLe:
+                case IrOp::CmpGt:
+                case IrOp::CmpGe: {
+                    const char *set = instr.op == IrOp::CmpEq ? "sete"
+                                    : instr.op == IrOp::CmpNe ? "setne"
+                                    : instr.op == IrOp::CmpLt ? "setl"
+                                    : instr.op == IrOp::CmpLe ? "setle"
+                                    : instr.op == IrOp::CmpGt ? "setg" : "setge";
+                    load("rax", instr.args[0]);
+                    load("rcx", instr.args[1]);
+                    out << "    cmp rax, rcx\n    " << set << " al\n    movzx rax,al\n";
+                    store(id);
+                    break;
+                }
+                case IrOp::Call:
+                case IrOp::RtCall:
+                    for (size_t i = 0; i < instr.args.size(); ++i) load(regs[i], instr.args[i]);
+                    // `ret` del valor recien llamado: se salta a la funcion
+                    // (o al inicio de esta) y se omite el `ret` siguiente.
+                    if (instr.op == IrOp::Call && !fn.isMain && k + 1 < instrs.size() &&
+                        fn.values[instrs[k + 1]].op == IrOp::Ret &&
+                        fn.values[instrs[k + 1]].args == std::vector<int>{id}) {
+                        if (instr.symbol == fn.name) {
+                            out << "    jmp " << tailLabel << "\n";
+                        } else {
+                            out << "    add rsp, " << stackSize << "\n";
+                            out << "    pop r15\n";
+                            out << "    pop r14\n";
+                            out << "    pop r13\n";
+                            out << "    pop r12\n";
+                            out << "    pop rbx\n";
+                            out << "    pop rbp\n";
+                            out << "    jmp " << instr.symbol << "\n";
+                        }
+                        ++k;
+                        break;
+                    }
+                    if (instr.variadic) out << "    xor eax,eax\n";
+                    out << "    call " << instr.symbol << "\n";
+                    if (irHasResult(instr)) store(id);
+                    break;
+                case IrOp::Br:
+                    phiCopies(b, instr.targets[0]);
+                    if (instr.targets[0] != next) out << "    jmp " << label(instr.targets[0]) << "\n";
+                    break;
+                case IrOp::CondBr:
+                    phiCopies(b, instr.targets[0]);
+                    if (instr.targets[1] != instr.targets[0]) phiCopies(b, instr.targets[1]);
+                    load("rax", instr.args[0]);
+                    out << "    cmp rax,0\n";
+                    out << "    jne " << label(instr.targets[0]) << "\n";
+                    if (instr.targets[1] != next) out << "    jmp " << label(instr.targets[1]) << "\n";
+                    break;
+                case IrOp::Ret:
+                    if (!instr.args.empty()) load("rax", instr.args[0]);
+                    else if (!fn.isMain) out << "    xor eax,eax\n";
+                    out << "    jmp " << endLabel << "\n";
+                    break;
+            }
+        }
+    }
+
+    out << endLabel << ":\n";
+    out << "    add rsp, " << stackSize << "\n";
+    out << "    pop r15\n";
+    out << "    pop r14\n";
+    out << "    pop r13\n";
+    out << "    pop r12\n";
+    out << "    pop rbx\n";
+    out << "    pop rbp\n";
+    if (fn.isMain) out << "    mov eax,0\n";
+    out << "    ret\n";
+}
+
+} // namespace aym
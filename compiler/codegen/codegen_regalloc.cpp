@@ -0,0 +1,314 @@
+#include "codegen_impl.h"
+#include "../builtins/builtins.h"
+
+#include <algorithm>
+#include <climits>
+
+namespace aym {
+
+namespace {
+
+// Registros callee-saved reservados para variables locales. Ninguna secuencia
+// del generador los usa como temporales mientras evalua subexpresiones.
+const char *const kLocalRegs[] = {"r12", "r13", "r14", "r15"};
+// Temporales para subexpresiones sin llamadas (caller-saved, libres mientras
+// no haya call de por medio).
+const char *const kExprTempRegs[] = {"r8", "r9", "r10", "r11"};
+
+// Numera en orden de evaluacion cada referencia a una variable. Un intervalo
+// [primera, ultima] referencia, extendido a todo bucle que lo toque, cubre la
+// vida de la variable en el codigo lineal que emite el generador.
+struct LiveRangeScan {
+    std::unordered_map<std::string, std::pair<int,int>> ranges;
+    std::unordered_map<std::string, long> weights;
+    std::vector<std::pair<int,int>> loops;
+    int pos = 0;
+    int loopDepth = 0;
+    bool unsupported = false;
+
+    void touch(const std::string &name) {
+        ++pos;
+        auto it = ranges.find(name);
+        if (it == ranges.end()) {
+            ranges[name] = {pos, pos};
+        } else {
+            it->second.second = pos;
+        }
+        long weight = 1;
+        for (int i = 0; i < loopDepth && i < 4; ++i) weight *= 8;
+        weights[name] += weight;
+    }
+
+    template <typename F>
+    void loop(F body) {
+        int start = ++pos;
+        ++loopDepth;
+        body();
+        --loopDepth;
+        loops.push_back({start, ++pos});
+    }
+
+    void expr(const Expr *e) {
+        if (!e) return;
+        if (auto *v = dynamic_cast<const VariableExpr*>(e)) {
+            touch(v->getName());
+        } else if (auto *b = dynamic_cast<const BinaryExpr*>(e)) {
+            expr(b->getLeft());
+            expr(b->getRight());
+        } else if (auto *u = dynamic_cast<const UnaryExpr*>(e)) {
+            expr(u->getExpr());
+        } else if (auto *t = dynamic_cast<const TernaryExpr*>(e)) {
+            expr(t->getCondition());
+            expr(t->getThen());
+            expr(t->getElse());
+        } else if (auto *inc = dynamic_cast<const IncDecExpr*>(e)) {
+            touch(inc->getName());
+        } else if (auto *c = dynamic_cast<const CallExpr*>(e)) {
+            for (const auto &a : c->getArgs()) expr(a.get());
+        } else if (auto *m = dynamic_cast<const MemberCallExpr*>(e)) {
+            expr(m->getBase());
+            for (const auto &a : m->getArgs()) expr(a.get());
+        } else if (auto *n = dynamic_cast<const NewExpr*>(e)) {
+            for (const auto &a : n->getArgs()) expr(a.get());
+        } else if (dynamic_cast<const SuperExpr*>(e)) {
+            touch("Aka");
+        } else if (auto *l = dynamic_cast<const ListExpr*>(e)) {
+            for (const auto &el : l->getElements()) expr(el.get());
+        } else if (auto *mp = dynamic_cast<const MapExpr*>(e)) {
+            for (const auto &item : mp->getItems()) {
+                expr(item.first.get());
+                expr(item.second.get());
+            }
+        } else if (auto *i = dynamic_cast<const IndexExpr*>(e)) {
+            expr(i->getBase());
+            expr(i->getIndex());
+        } else if (auto *me = dynamic_cast<const MemberExpr*>(e)) {
+            expr(me->getBase());
+        } else if (!dynamic_cast<const NumberExpr*>(e) && !dynamic_cast<const BoolExpr*>(e) &&
+                   !dynamic_cast<const StringExpr*>(e) && !dynamic_cast<const FunctionRefExpr*>(e)) {
+            unsupported = true;
+        }
+    }
+
+    void stmt(const Stmt *s) {
+        if (!s) return;
+        if (auto *p = dynamic_cast<const PrintStmt*>(s)) {
+            for (const auto &e : p->getExprs()) expr(e.get());
+            expr(p->getSeparator());
+            expr(p->getTerminator());
+        } else if (auto *e = dynamic_cast<const ExprStmt*>(s)) {
+            expr(e->getExpr());
+        } else if (auto *a = dynamic_cast<const AssignStmt*>(s)) {
+            expr(a->getValue());
+            touch(a->getName());
+        } else if (auto *ia = dynamic_cast<const IndexAssignStmt*>(s)) {
+            expr(ia->getValue());
+            expr(ia->getIndex());
+            expr(ia->getBase());
+        } else if (auto *b = dynamic_cast<const BlockStmt*>(s)) {
+            for (const auto &st : b->statements) stmt(st.get());
+        } else if (auto *i = dynamic_cast<const IfStmt*>(s)) {
+            expr(i->getCondition());
+            stmt(i->getThen());
+            stmt(i->getElse());
+        } else if (auto *f = dynamic_cast<const ForStmt*>(s)) {
+            stmt(f->getInit());
+            loop([&] {
+                expr(f->getCondition());
+                stmt(f->getBody());
+                stmt(f->getPost());
+            });
+        } else if (auto *w = dynamic_cast<const WhileStmt*>(s)) {
+            loop([&] {
+                expr(w->getCondition());
+                stmt(w->getBody());
+            });
+        } else if (auto *dw = dynamic_cast<const DoWhileStmt*>(s)) {
+            loop([&] {
+                stmt(dw->getBody());
+                expr(dw->getCondition());
+            });
+        } else if (auto *sw = dynamic_cast<const SwitchStmt*>(s)) {
+            expr(sw->getExpr());
+            for (const auto &c : sw->getCases()) {
+                expr(c.first.get());
+                stmt(c.second.get());
+            }
+            stmt(sw->getDefault());
+        } else if (auto *r = dynamic_cast<const ReturnStmt*>(s)) {
+            expr(r->getValue());
+        } else if (auto *v = dynamic_cast<const VarDeclStmt*>(s)) {
+            expr(v->getInit());
+            touch(v->getName());
+        } else if (auto *t = dynamic_cast<const ThrowStmt*>(s)) {
+            expr(t->getType());
+            expr(t->getMessage());
+        } else if (!dynamic_cast<const BreakStmt*>(s) && !dynamic_cast<const ContinueStmt*>(s)) {
+            // yant'aña: el marco guarda r12-r15 al entrar y aym_throw los
+            // restaura, asi que un local en registro cambiado dentro del
+            // bloque volveria en el katjaña al valor que tenia al entrar.
+            unsupported = true;
+        }
+    }
+};
+
+} // namespace
+
+void CodeGenImpl::allocateLocalRegisters(const FunctionInfo &info) {
+    currentRegLocals.clear();
+    if (!info.body) return;
+    LiveRangeScan scan;
+    std::vector<std::string> regs = paramRegs(this->windows);
+    for (size_t i = 0; i < info.params.size() && i < regs.size(); ++i) {
+        scan.ranges[info.params[i].name] = {0, 0};
+    }
+    scan.stmt(info.body);
+    if (scan.unsupported) return;
+
+    struct Interval {
+        std::string name;
+        int start;
+        int end;
+        long weight;
+    };
+    std::vector<Interval> intervals;
+    for (const auto &name : info.locals) {
+        auto it = scan.ranges.find(name);
+        if (it == scan.ranges.end() || scan.weights[name] == 0) continue;
+        if (std::any_of(intervals.begin(), intervals.end(),
+                        [&](const Interval &iv) { return iv.name == name; })) {
+            continue;
+        }
+        Interval iv{name, it->second.first, it->second.second, scan.weights[name]};
+        for (const auto &l : scan.loops) {
+            if (iv.start <= l.second && iv.end >= l.first) {
+                iv.start = std::min(iv.start, l.first);
+                iv.end = std::max(iv.end, l.second);
+            }
+        }
+        intervals.push_back(iv);
+    }
+    std::sort(intervals.begin(), intervals.end(), [](const Interval &a, const Interval &b) {
+        return a.start != b.start ? a.start < b.start : a.weight > b.weight;
+    });
+
+    // Linear scan: al quedarse sin registros se derrama el intervalo activo de
+    // menor peso (referencias ponderadas por profundidad de bucle).
+    std::vector<const Interval*> active;
+    std::vector<std::string> freeRegs(std::begin(kLocalRegs), std::end(kLocalRegs));
+    std::reverse(freeRegs.begin(), freeRegs.end());
+    for (const auto &iv : intervals) {
+        for (auto it = active.begin(); it != active.end();) {
+            if ((*it)->end < iv.start) {
+                freeRegs.push_back(currentRegLocals[(*it)->name]);
+                it = active.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        if (!freeRegs.empty()) {
+            currentRegLocals[iv.name] = freeRegs.back();
+            freeRegs.pop_back();
+            active.push_back(&iv);
+            continue;
+        }
+        auto victim = std::min_element(active.begin(), active.end(),
+                                       [](const Interval *a, const Interval *b) { return a->weight < b->weight; });
+        if (victim != active.end() && (*victim)->weight < iv.weight) {
+            currentRegLocals[iv.name] = currentRegLocals[(*victim)->name];
+            currentRegLocals.erase((*victim)->name);
+            *victim = &iv;
+        }
+    }
+}
+
+std::string CodeGenImpl::varOperand(const std::string &name,
+                                    const std::unordered_map<std::string,int> *locals) const {
+    if (locals && locals->count(name)) {
+        auto reg = currentRegLocals.find(name);
+        if (reg != currentRegLocals.end()) return reg->second;
+        return "[rbp-" + std::to_string(locals->at(name)) + "]";
+    }
+    return "[rel " + name + "]";
+}
+
+std::string CodeGenImpl::leafOperand(const Expr *expr,
+                                     const std::unordered_map<std::string,int> *locals) const {
+    if (auto *n = dynamic_cast<const NumberExpr*>(expr)) {
+        if (n->getValue() >= INT_MIN && n->getValue() <= INT_MAX) return std::to_string(n->getValue());
+        return "";
+    }
+    if (auto *b = dynamic_cast<const BoolExpr*>(expr)) {
+        return b->getValue() ? "1" : "0";
+    }
+    if (auto *v = dynamic_cast<const VariableExpr*>(expr)) {
+        return varOperand(v->getName(), locals);
+    }
+    return "";
+}
+
+bool CodeGenImpl::isCallFreeExpr(const Expr *expr,
+                                 const std::unordered_map<std::string,int> *locals) {
+    if (!expr) return true;
+    if (dynamic_cast<const NumberExpr*>(expr) || dynamic_cast<const BoolExpr*>(expr) ||
+        dynamic_cast<const StringExpr*>(expr) || dynamic_cast<const VariableExpr*>(expr) ||
+        dynamic_cast<const IncDecExpr*>(expr) || dynamic_cast<const FunctionRefExpr*>(expr)) {
+        return true;
+    }
+    if (auto *u = dynamic_cast<const UnaryExpr*>(expr)) {
+        return isCallFreeExpr(u->getExpr(), locals);
+    }
+    if (auto *t = dynamic_cast<const TernaryExpr*>(expr)) {
+        return isCallFreeExpr(t->getCondition(), locals) && isCallFreeExpr(t->getThen(), locals) &&
+               isCallFreeExpr(t->getElse(), locals);
+    }
+    if (auto *b = dynamic_cast<const BinaryExpr*>(expr)) {
+        char op = b->getOp();
+        if ((op == '+' || op == 's' || op == 'd') &&
+            isStringExpr(b->getLeft(), locals) && isStringExpr(b->getRight(), locals)) {
+            return false;
+        }
+        return isCallFreeExpr(b->getLeft(), locals) && isCallFreeExpr(b->getRight(), locals);
+    }
+    if (auto *c = dynamic_cast<const CallExpr*>(expr)) {
+        // El largo de una lista se lee en linea (ver emitArrayLength).
+        std::string name = lowerName(c->getName());
+        bool length = name == BUILTIN_LARGO || name == BUILTIN_SUYUT || name == BUILTIN_ARRAY_LENGTH;
+        return length && !this->windows && c->getArgs().size() == 1 &&
+               isCallFreeExpr(c->getArgs()[0].get(), locals);
+    }
+    if (auto *i = dynamic_cast<const IndexExpr*>(expr)) {
+        // Dentro de un `kuti` acotado, lista[i] se lee sin llamar al runtime.
+        return isBoundedIndex(i->getBase(), i->getIndex()) && isListExpr(i->getBase(), locals);
+    }
+    if (auto *m = dynamic_cast<const MemberExpr*>(expr)) {
+        if (!m->getStaticField().empty()) return true;
+        // El chequeo de nulo solo llama al runtime para lanzar CLAVE.
+        return objectFieldOffset(m->getObjectClass(), m->getMember()) >= 0 &&
+               isCallFreeExpr(m->getBase(), locals);
+    }
+    return false;
+}
+
+const char *CodeGenImpl::exprTempReg() const {
+    if (exprTempDepth >= sizeof(kExprTempRegs) / sizeof(kExprTempRegs[0])) return nullptr;
+    return kExprTempRegs[exprTempDepth];
+}
+
+void CodeGenImpl::emitPreserveRegLocals(bool restore) {
+    if (currentRegLocals.empty()) return;
+    int shadow = this->windows ? 32 : 0;
+    size_t count = sizeof(kLocalRegs) / sizeof(kLocalRegs[0]);
+    if (!restore) out << "    sub rsp, " << (shadow + 8 * count) << "\n";
+    for (size_t i = 0; i < count; ++i) {
+        std::string slot = "[rsp+" + std::to_string(shadow + 8 * i) + "]";
+        if (restore) {
+            out << "    mov " << kLocalRegs[i] << ", " << slot << "\n";
+        } else {
+            out << "    mov " << slot << ", " << kLocalRegs[i] << "\n";
+        }
+    }
+    if (restore) out << "    add rsp, " << (shadow + 8 * count) << "\n";
+}
+
+} // namespace aym
@@ -0,0 +1,291 @@
+#include "codegen_impl.h"
+#include "../builtins/builtins.h"
+
+namespace aym {
+
+namespace {
+
+// Builtins que solo leen sus argumentos: no guardan punteros a textos en
+// ninguna estructura viva, asi que lo que produzcan puede morir al cerrar la
+// region temporal.
+bool scratchPureBuiltin(const std::string &name) {
+    static const char *const kPure[] = {
+        BUILTIN_LARGO, BUILTIN_SUYUT, BUILTIN_ARRAY_LENGTH, BUILTIN_ARRAY_GET,
+        BUILTIN_LENGTH, BUILTIN_SUYU, BUILTIN_TO_STRING, BUILTIN_TO_NUMBER,
+        BUILTIN_CHUSA, BUILTIN_SIKTA, BUILTIN_MAYACHTA, BUILTIN_UTJI,
+        BUILTIN_UTJIT, BUILTIN_THAQHA, BUILTIN_WRITE, BUILTIN_SIN, BUILTIN_COS,
+        BUILTIN_TAN, BUILTIN_SQRT, BUILTIN_POW, BUILTIN_FLOOR, BUILTIN_CEIL,
+        BUILTIN_ROUND, BUILTIN_FABS, BUILTIN_TAMA_UTJI, BUILTIN_TAMA_SUYU,
+        BUILTIN_SIQI_SUYU, BUILTIN_QULLU_SUYU};
+    for (const char *pure : kPure) {
+        if (name == pure) return true;
+    }
+    return false;
+}
+
+bool allocatingBuiltin(const std::string &name) {
+    return name == BUILTIN_TO_STRING || name == BUILTIN_CHUSA ||
+           name == BUILTIN_SIKTA || name == BUILTIN_MAYACHTA;
+}
+
+void countDecls(const Stmt *s, std::unordered_map<std::string,int> &counts) {
+    if (!s) return;
+    if (auto *v = dynamic_cast<const VarDeclStmt*>(s)) {
+        counts[v->getName()]++;
+    } else if (auto *b = dynamic_cast<const BlockStmt*>(s)) {
+        for (const auto &st : b->statements) countDecls(st.get(), counts);
+    } else if (auto *i = dynamic_cast<const IfStmt*>(s)) {
+        countDecls(i->getThen(), counts);
+        countDecls(i->getElse(), counts);
+    } else if (auto *f = dynamic_cast<const ForStmt*>(s)) {
+        countDecls(f->getInit(), counts);
+        countDecls(f->getBody(), counts);
+    } else if (auto *w = dynamic_cast<const WhileStmt*>(s)) {
+        countDecls(w->getBody(), counts);
+    } else if (auto *dw = dynamic_cast<const DoWhileStmt*>(s)) {
+        countDecls(dw->getBody(), counts);
+    } else if (auto *sw = dynamic_cast<const SwitchStmt*>(s)) {
+        for (const auto &c : sw->getCases()) countDecls(c.second.get(), counts);
+        countDecls(sw->getDefault(), counts);
+    } else if (auto *t = dynamic_cast<const TryStmt*>(s)) {
+        countDecls(t->getTryBlock(), counts);
+        for (const auto &c : t->getCatches()) {
+            counts[c.varName]++;
+            countDecls(c.block.get(), counts);
+        }
+        countDecls(t->getFinallyBlock(), counts);
+    }
+}
+
+} // namespace
+
+void CodeGenImpl::resetScratchDecls(const std::vector<const Stmt*> &body,
+                                    const std::vector<Param> *params) {
+    scratchDeclCounts.clear();
+    for (const auto *s : body) countDecls(s, scratchDeclCounts);
+    if (params) {
+        for (const auto &p : *params) scratchDeclCounts[p.name]++;
+    }
+}
+
+// Variables declaradas (con valor inicial) una sola vez y dentro de `s`: por
+// el alcance de bloque nadie fuera de la region puede leerlas.
+void CodeGenImpl::collectRegionLocals(const Stmt *s, std::unordered_set<std::string> &names) const {
+    if (!s) return;
+    if (auto *v = dynamic_cast<const VarDeclStmt*>(s)) {
+        auto it = scratchDeclCounts.find(v->getName());
+        if (v->getInit() && it != scratchDeclCounts.end() && it->second == 1) names.insert(v->getName());
+    } else if (auto *b = dynamic_cast<const BlockStmt*>(s)) {
+        for (const auto &st : b->statements) collectRegionLocals(st.get(), names);
+    } else if (auto *i = dynamic_cast<const IfStmt*>(s)) {
+        collectRegionLocals(i->getThen(), names);
+        collectRegionLocals(i->getElse(), names);
+    } else if (auto *f = dynamic_cast<const ForStmt*>(s)) {
+        collectRegionLocals(f->getInit(), names);
+        collectRegionLocals(f->getBody(), names);
+    } else if (auto *w = dynamic_cast<const WhileStmt*>(s)) {
+        collectRegionLocals(w->getBody(), names);
+    } else if (auto *dw = dynamic_cast<const DoWhileStmt*>(s)) {
+        collectRegionLocals(dw->getBody(), names);
+    }
+}
+
+bool CodeGenImpl::scalarVariable(const std::string &name,
+                                 const std::unordered_map<std::string,int> *locals) const {
+    const std::string *type = nullptr;
+    if (locals && currentLocalTypes.count(name)) type = &currentLocalTypes.at(name);
+    else if (locals && currentParamTypes.count(name)) type = &currentParamTypes.at(name);
+    else if (globalTypes.count(name)) type = &globalTypes.at(name);
+    return type && (*type == "jakhüwi" || *type == "chiqa");
+}
+
+// Una expresion es apta si solo usa hojas, operadores y builtins de lectura;
+// `allocates` indica si crea algun texto nuevo.
+bool CodeGenImpl::scratchExprSafe(const Expr *e,
+                                  const std::unordered_map<std::string,int> *locals,
+                                  bool &allocates) const {
+    if (!e) return true;
+    if (dynamic_cast<const NumberExpr*>(e) || dynamic_cast<const BoolExpr*>(e) ||
+        dynamic_cast<const StringExpr*>(e) || dynamic_cast<const VariableExpr*>(e) ||
+        dynamic_cast<const IncDecExpr*>(e)) {
+        return true;
+    }
+    if (auto *b = dynamic_cast<const BinaryExpr*>(e)) {
+        if (b->getOp() == '+' && isStringExpr(b->getLeft(), locals) && isStringExpr(b->getRight(), locals)) {
+            allocates = true;
+        }
+        return scratchExprSafe(b->getLeft(), locals, allocates) &&
+               scratchExprSafe(b->getRight(), locals, allocates);
+    }
+    if (auto *u = dynamic_cast<const UnaryExpr*>(e)) {
+        return scratchExprSafe(u->getExpr(), locals, allocates);
+    }
+    if (auto *t = dynamic_cast<const TernaryExpr*>(e)) {
+        return scratchExprSafe(t->getCondition(), locals, allocates) &&
+               scratchExprSafe(t->getThen(), locals, allocates) &&
+               scratchExprSafe(t->getElse(), locals, allocates);
+    }
+    if (auto *c = dynamic_cast<const CallExpr*>(e)) {
+        std::string name = lowerName(c->getName());
+        if (!scratchPureBuiltin(name)) return false;
+        if (allocatingBuiltin(name)) allocates = true;
+        for (const auto &a : c->getArgs()) {
+            if (!scratchExprSafe(a.get(), locals, allocates)) return false;
+        }
+        return true;
+    }
+    if (auto *i = dynamic_cast<const IndexExpr*>(e)) {
+        return isListExpr(i->getBase(), locals) &&
+               scratchExprSafe(i->getBase(), locals, allocates) &&
+               scratchExprSafe(i->getIndex(), locals, allocates);
+    }
+    return false;
+}
+
+// Indica si la expresion lee una variable no numerica declarada dentro de la
+// region: su texto vive en la arena de la vuelta aunque la expresion no cree
+// ninguno nuevo.
+bool CodeGenImpl::readsRegionText(const Expr *e,
+                                  const std::unordered_map<std::string,int> *locals,
+                                  const std::unordered_set<std::string> &regionLocals) const {
+    if (!e) return false;
+    if (auto *v = dynamic_cast<const VariableExpr*>(e)) {
+        return regionLocals.count(v->getName()) && !scalarVariable(v->getName(), locals);
+    }
+    if (auto *b = dynamic_cast<const BinaryExpr*>(e)) {
+        return readsRegionText(b->getLeft(), locals, regionLocals) ||
+               readsRegionText(b->getRight(), locals, regionLocals);
+    }
+    if (auto *u = dynamic_cast<const UnaryExpr*>(e)) {
+        return readsRegionText(u->getExpr(), locals, regionLocals);
+    }
+    if (auto *t = dynamic_cast<const TernaryExpr*>(e)) {
+        return readsRegionText(t->getCondition(), locals, regionLocals) ||
+               readsRegionText(t->getThen(), locals, regionLocals) ||
+               readsRegionText(t->getElse(), locals, regionLocals);
+    }
+    if (auto *c = dynamic_cast<const CallExpr*>(e)) {
+        for (const auto &a : c->getArgs()) {
+            if (readsRegionText(a.get(), locals, regionLocals)) return true;
+        }
+        return false;
+    }
+    if (auto *i = dynamic_cast<const IndexExpr*>(e)) {
+        return readsRegionText(i->getBase(), locals, regionLocals) ||
+               readsRegionText(i->getIndex(), locals, regionLocals);
+    }
+    return false;
+}
+
+// Un texto creado dentro de la region solo puede escapar guardandose en una
+// variable que viva fuera de ella, ya sea recien creado o leido de una
+// variable de la region; listas, mapas, objetos, retornos y llamadas del
+// usuario quedan descartados de entrada.
+bool CodeGenImpl::scratchStmtSafe(const Stmt *s,
+                                  const std::unordered_map<std::string,int> *locals,
+                                  const std::unordered_set<std::string> &regionLocals,
+                                  bool &allocates) const {
+    if (!s) return true;
+    auto stores = [&](const std::string &name, const Expr *value) {
+        bool valueAllocates = false;
+        if (!scratchExprSafe(value, locals, valueAllocates)) return false;
+        allocates = allocates || valueAllocates;
+        bool regionValue = valueAllocates || readsRegionText(value, locals, regionLocals);
+        return !regionValue || regionLocals.count(name) || scalarVariable(name, locals);
+    };
+    if (auto *p = dynamic_cast<const PrintStmt*>(s)) {
+        for (const auto &e : p->getExprs()) {
+            if (!scratchExprSafe(e.get(), locals, allocates)) return false;
+        }
+        return scratchExprSafe(p->getSeparator(), locals, allocates) &&
+               scratchExprSafe(p->getTerminator(), locals, allocates);
+    }
+    if (auto *e = dynamic_cast<const ExprStmt*>(s)) {
+        return scratchExprSafe(e->getExpr(), locals, allocates);
+    }
+    if (auto *a = dynamic_cast<const AssignStmt*>(s)) {
+        return stores(a->getName(), a->getValue());
+    }
+    if (auto *v = dynamic_cast<const VarDeclStmt*>(s)) {
+        bool valueAllocates = false;
+        if (!scratchExprSafe(v->getInit(), locals, valueAllocates)) return false;
+        allocates = allocates || valueAllocates;
+        bool regionValue = valueAllocates || readsRegionText(v->getInit(), locals, regionLocals);
+        return !regionValue || regionLocals.count(v->getName()) ||
+               v->getType() == "jakhüwi" || v->getType() == "chiqa";
+    }
+    if (auto *b = dynamic_cast<const BlockStmt*>(s)) {
+        for (const auto &st : b->statements) {
+            if (!scratchStmtSafe(st.get(), locals, regionLocals, allocates)) return false;
+        }
+        return true;
+    }
+    if (auto *i = dynamic_cast<const IfStmt*>(s)) {
+        return scratchExprSafe(i->getCondition(), locals, allocates) &&
+               scratchStmtSafe(i->getThen(), locals, regionLocals, allocates) &&
+               scratchStmtSafe(i->getElse(), locals, regionLocals, allocates);
+    }
+    if (auto *f = dynamic_cast<const ForStmt*>(s)) {
+        return scratchStmtSafe(f->getInit(), locals, regionLocals, allocates) &&
+               scratchExprSafe(f->getCondition(), locals, allocates) &&
+               scratchStmtSafe(f->getPost(), locals, regionLocals, allocates) &&
+               scratchStmtSafe(f->getBody(), locals, regionLocals, allocates);
+    }
+    if (auto *w = dynamic_cast<const WhileStmt*>(s)) {
+        return scratchExprSafe(w->getCondition(), locals, allocates) &&
+               scratchStmtSafe(w->getBody(), locals, regionLocals, allocates);
+    }
+    if (auto *dw = dynamic_cast<const DoWhileStmt*>(s)) {
+        return scratchExprSafe(dw->getCondition(), locals, allocates) &&
+               scratchStmtSafe(dw->getBody(), locals, regionLocals, allocates);
+    }
+    return dynamic_cast<const BreakStmt*>(s) || dynamic_cast<const ContinueStmt*>(s);
+}
+
+// Cada vuelta de un bucle libera los textos que creo si ninguno puede
+// sobrevivir a la vuelta. La condicion y el paso cuentan como parte de ella.
+bool CodeGenImpl::scratchLoopRegion(const Stmt *body, const Expr *cond, const Stmt *post,
+                                    const std::unordered_map<std::string,int> *locals) const {
+    std::unordered_set<std::string> regionLocals;
+    collectRegionLocals(body, regionLocals);
+    bool allocates = false;
+    return scratchStmtSafe(body, locals, regionLocals, allocates) &&
+           scratchExprSafe(cond, locals, allocates) &&
+           scratchStmtSafe(post, locals, regionLocals, allocates) && allocates;
+}
+
+// Dentro de un bucle que no pudo liberar por vuelta, cada sentencia simple que
+// solo crea textos de paso abre su propia region.
+bool CodeGenImpl::scratchStatement(const Stmt *s,
+                                   const std::unordered_map<std::string,int> *locals) const {
+    if (scratchLoops.empty() || scratchLoops.back()) return false;
+    if (!dynamic_cast<const PrintStmt*>(s) && !dynamic_cast<const ExprStmt*>(s) &&
+        !dynamic_cast<const AssignStmt*>(s) && !dynamic_cast<const VarDeclStmt*>(s)) {
+        return false;
+    }
+    bool allocates = false;
+    return scratchStmtSafe(s, locals, {}, allocates) && allocates;
+}
+
+// La marca se guarda en la pila y no en el runtime: un `pantja` que salta
+// fuera de la region no deja nada pendiente.
+void CodeGenImpl::emitScratchMark() {
+    int shadow = this->windows ? 32 : 0;
+    out << "    call aym_str_scratch_mark\n";
+    out << "    sub rsp, " << (shadow + 16) << "\n";
+    out << "    mov [rsp+" << shadow << "], rax\n";
+}
+
+void CodeGenImpl::emitScratchRelease() {
+    int shadow = this->windows ? 32 : 0;
+    out << "    mov " << reg1(this->windows) << ", [rsp+" << shadow << "]\n";
+    out << "    call aym_str_scratch_release\n";
+}
+
+void CodeGenImpl::emitScratchClose() {
+    int shadow = this->windows ? 32 : 0;
+    emitScratchRelease();
+    out << "    add rsp, " << (shadow + 16) << "\n";
+}
+
+} // namespace aym
@@ -6,9 +6,12 @@ void CodeGenImpl::emitStmt(const Stmt *stmt,
                            const std::unordered_map<std::string,int> *locals,
                            const std::string &endLabel) {
     if (!stmt) return;
-    if (emitStmtBasic(stmt, locals, endLabel)) return;
-    if (emitStmtControl(stmt, locals, endLabel)) return;
-    if (emitStmtException(stmt, locals, endLabel)) return;
+    bool scratch = scratchStatement(stmt, locals);
+    if (scratch) emitScratchMark();
+    if (!emitStmtBasic(stmt, locals, endLabel) && !emitStmtControl(stmt, locals, endLabel)) {
+        emitStmtException(stmt, locals, endLabel);
+    }
+    if (scratch) emitScratchClose();
 }
 
 } // namespace aym
@@ -31,6 +31,12 @@ bool CodeGenImpl::emitStmtBasic(const Stmt *stmt,
         if (locals && currentLocalStrings.count(a->getName())) str = currentLocalStrings[a->getName()];
         else if (!locals && globalTypes.count(a->getName()) && globalTypes[a->getName()] == "aru") str = true;
 
+        std::string slot = varOperand(a->getName(), locals);
+        std::string leaf = leafOperand(a->getValue(), locals);
+        if (!leaf.empty() && slot.front() != '[') {
+            out << "    mov " << slot << ", " << leaf << "\n";
+            return true;
+        }
         if (auto *call = dynamic_cast<const CallExpr*>(a->getValue()); call && call->getName()==BUILTIN_INPUT) {
             if (str)
                 emitInput(true);
@@ -39,11 +45,7 @@ bool CodeGenImpl::emitStmtBasic(const Stmt *stmt,
         } else {
             emitExpr(a->getValue(), locals);
         }
-        if (locals && locals->count(a->getName())) {
-            out << "    mov [rbp-" << locals->at(a->getName()) << "], rax\n";
-        } else {
-            out << "    mov [rel " << a->getName() << "], rax\n";
-        }
+        out << "    mov " << slot << ", rax\n";
         return true;
     }
     if (auto *a = dynamic_cast<const IndexAssignStmt *>(stmt)) {
@@ -59,27 +61,82 @@ bool CodeGenImpl::emitStmtBasic(const Stmt *stmt,
                 }
             }
         }
-        emitExpr(a->getValue(), locals);
-        out << "    mov r14, rax\n";
-        emitExpr(a->getIndex(), locals);
-        out << "    mov r15, rax\n";
+        int shadow = this->windows ? 32 : 0;
+        if (!a->getObjectClass().empty()) {
+            auto *indexLit = dynamic_cast<const StringExpr*>(a->getIndex());
+            long offset = indexLit ? objectFieldOffset(a->getObjectClass(), indexLit->getValue()) : -1;
+            if (offset >= 0) {
+                std::string value = leafOperand(a->getValue(), locals);
+                if (value.empty()) {
+                    emitExpr(a->getValue(), locals);
+                    out << "    sub rsp, " << (shadow + 16) << "\n";
+                    out << "    mov [rsp+" << shadow << "], rax\n";
+                    emitExpr(a->getBase(), locals);
+                    emitObjectNullCheck(a->getBase(), indexLit->getValue());
+                    out << "    mov rcx, [rsp+" << shadow << "]\n";
+                    out << "    add rsp, " << (shadow + 16) << "\n";
+                } else {
+                    emitExpr(a->getBase(), locals);
+                    emitObjectNullCheck(a->getBase(), indexLit->getValue());
+                    out << "    mov rcx, " << value << "\n";
+                }
+                out << "    mov [rax+" << offset << "], rcx\n";
+                return true;
+            }
+        }
+        if (a->getObjectClass().empty() && isBoundedIndex(a->getBase(), a->getIndex()) &&
+            isListExpr(a->getBase(), locals)) {
+            std::string value = leafOperand(a->getValue(), locals);
+            if (value.empty()) {
+                emitExpr(a->getValue(), locals);
+                value = "rax";
+            }
+            out << "    mov rdx, " << value << "\n";
+            std::string element = emitBoundedArrayElement(a->getBase(), a->getIndex(), locals);
+            out << "    mov " << element << ", rdx\n";
+            return true;
+        }
+        // Valor e indice se evaluan antes que la base (mismo orden de siempre);
+        // si no son hojas se guardan en la pila, no en registros.
+        std::string value = leafOperand(a->getValue(), locals);
+        std::string index = leafOperand(a->getIndex(), locals);
+        bool staged = value.empty() || index.empty();
+        if (staged) {
+            out << "    sub rsp, " << (shadow + 16) << "\n";
+            emitExpr(a->getValue(), locals);
+            out << "    mov [rsp+" << shadow << "], rax\n";
+            emitExpr(a->getIndex(), locals);
+            out << "    mov [rsp+" << (shadow + 8) << "], rax\n";
+            value = "[rsp+" + std::to_string(shadow) + "]";
+            index = "[rsp+" + std::to_string(shadow + 8) + "]";
+        }
         emitExpr(a->getBase(), locals);
-        out << "    mov rbx, rax\n";
-        if (isMapExpr(a->getBase(), locals)) {
+        out << "    mov " << regs[0] << ", rax\n";
+        out << "    mov " << regs[1] << ", " << index << "\n";
+        out << "    mov " << regs[2] << ", " << value << "\n";
+        if (staged) {
+            out << "    add rsp, " << (shadow + 16) << "\n";
+        }
+        if (!a->getObjectClass().empty()) {
             out << "    mov " << regs[3] << ", " << (isStringExpr(a->getValue(), locals) ? 1 : 0) << "\n";
-            out << "    mov " << regs[2] << ", r14\n";
-            out << "    mov " << regs[1] << ", r15\n";
-            out << "    mov " << regs[0] << ", rbx\n";
-            out << "    call aym_map_set\n";
+            out << "    call aym_object_set\n";
+        } else if (isMapExpr(a->getBase(), locals)) {
+            out << "    mov " << regs[3] << ", " << (isStringExpr(a->getValue(), locals) ? 1 : 0) << "\n";
+            out << (a->hasIntKey() ? "    call aym_imap_set\n" : "    call aym_map_set\n");
+        } else if (isListExpr(a->getBase(), locals)) {
+            emitArraySet();
         } else {
-            out << "    mov " << regs[2] << ", r14\n";
-            out << "    mov " << regs[1] << ", r15\n";
-            out << "    mov " << regs[0] << ", rbx\n";
             out << "    call aym_array_set\n";
         }
         return true;
     }
     if (auto *v = dynamic_cast<const VarDeclStmt *>(stmt)) {
+        std::string slot = varOperand(v->getName(), locals);
+        std::string leaf = leafOperand(v->getInit(), locals);
+        if (!leaf.empty() && slot.front() != '[') {
+            out << "    mov " << slot << ", " << leaf << "\n";
+            return true;
+        }
         if (v->getInit()) {
             bool str = (v->getType() == "aru");
             if (auto *call = dynamic_cast<const CallExpr*>(v->getInit()); call && call->getName()==BUILTIN_INPUT) {
@@ -87,11 +144,10 @@ bool CodeGenImpl::emitStmtBasic(const Stmt *stmt,
             } else {
                 emitExpr(v->getInit(), locals);
             }
-            if (locals && locals->count(v->getName())) {
-                out << "    mov [rbp-" << locals->at(v->getName()) << "], rax\n";
-            } else {
-                out << "    mov [rel " << v->getName() << "], rax\n";
-            }
+            out << "    mov " << slot << ", rax\n";
+        } else if (slot.front() != '[') {
+            // Un registro puede traer el valor de otra variable o de otra llamada.
+            out << "    xor " << slot << ", " << slot << "\n";
         }
         return true;
     }
@@ -29,7 +29,12 @@ bool CodeGenImpl::emitStmtControl(const Stmt *stmt,
         std::string end = genLabel("endloop");
         breakLabels.push_back(end);
         continueLabels.push_back(cont);
+        breakTryDepth.push_back(tryFrames.size());
+        continueTryDepth.push_back(tryFrames.size());
         loopFinallyDepth.push_back(finallyStack.size());
+        bool scratch = scratchLoopRegion(w->getBody(), w->getCondition(), nullptr, locals);
+        scratchLoops.push_back(scratch);
+        if (scratch) emitScratchMark();
         out << loop << ":\n";
         if (w->getCondition()) {
             emitExpr(w->getCondition(), locals);
@@ -38,10 +43,15 @@ bool CodeGenImpl::emitStmtControl(const Stmt *stmt,
         }
         emitStmt(w->getBody(), locals, endLabel);
         out << cont << ":\n";
+        if (scratch) emitScratchRelease();
         out << "    jmp " << loop << "\n";
         out << end << ":\n";
+        if (scratch) emitScratchClose();
+        scratchLoops.pop_back();
         breakLabels.pop_back();
         continueLabels.pop_back();
+        breakTryDepth.pop_back();
+        continueTryDepth.pop_back();
         loopFinallyDepth.pop_back();
         return true;
     }
@@ -52,20 +62,35 @@ bool CodeGenImpl::emitStmtControl(const Stmt *stmt,
         emitStmt(f->getInit(), locals, endLabel);
         breakLabels.push_back(end);
         continueLabels.push_back(cont);
+        breakTryDepth.push_back(tryFrames.size());
+        continueTryDepth.push_back(tryFrames.size());
         loopFinallyDepth.push_back(finallyStack.size());
+        bool scratch = scratchLoopRegion(f->getBody(), f->getCondition(), f->getPost(), locals);
+        scratchLoops.push_back(scratch);
+        if (scratch) emitScratchMark();
         out << loop << ":\n";
         if (f->getCondition()) {
             emitExpr(f->getCondition(), locals);
             out << "    cmp rax,0\n";
             out << "    je " << end << "\n";
         }
+        std::string boundedIndex;
+        std::string boundedArray;
+        bool bounded = boundedLoopIndex(f, boundedIndex, boundedArray);
+        if (bounded) boundedIndexes.push_back({boundedIndex, boundedArray});
         emitStmt(f->getBody(), locals, endLabel);
+        if (bounded) boundedIndexes.pop_back();
         out << cont << ":\n";
+        if (scratch) emitScratchRelease();
         emitStmt(f->getPost(), locals, endLabel);
         out << "    jmp " << loop << "\n";
         out << end << ":\n";
+        if (scratch) emitScratchClose();
+        scratchLoops.pop_back();
         breakLabels.pop_back();
         continueLabels.pop_back();
+        breakTryDepth.pop_back();
+        continueTryDepth.pop_back();
         loopFinallyDepth.pop_back();
         return true;
     }
@@ -75,16 +100,26 @@ bool CodeGenImpl::emitStmtControl(const Stmt *stmt,
         std::string end = genLabel("doend");
         breakLabels.push_back(end);
         continueLabels.push_back(cont);
+        breakTryDepth.push_back(tryFrames.size());
+        continueTryDepth.push_back(tryFrames.size());
         loopFinallyDepth.push_back(finallyStack.size());
+        bool scratch = scratchLoopRegion(dw->getBody(), dw->getCondition(), nullptr, locals);
+        scratchLoops.push_back(scratch);
+        if (scratch) emitScratchMark();
         out << loop << ":\n";
         emitStmt(dw->getBody(), locals, endLabel);
         out << cont << ":\n";
+        if (scratch) emitScratchRelease();
         emitExpr(dw->getCondition(), locals);
         out << "    cmp rax,0\n";
         out << "    jne " << loop << "\n";
         out << end << ":\n";
+        if (scratch) emitScratchClose();
+        scratchLoops.pop_back();
         breakLabels.pop_back();
         continueLabels.pop_back();
+        breakTryDepth.pop_back();
+        continueTryDepth.pop_back();
         loopFinallyDepth.pop_back();
         return true;
     }
@@ -114,9 +149,9 @@ bool CodeGenImpl::emitStmtControl(const Stmt *stmt,
                 if (switchIsString) {
                     out << "    mov " << reg1(this->windows) << ", rbx\n";
                     out << "    mov " << reg2(this->windows) << ", rax\n";
-                    out << "    call strcmp\n";
-                    out << "    cmp rax,0\n";
-                    out << "    je " << label << "\n";
+                    out << "    call aym_str_eq\n";
+                    out << "    test rax, rax\n";
+                    out << "    jnz " << label << "\n";
                 } else {
                     out << "    cmp rbx, rax\n";
                     out << "    je " << label << "\n";
@@ -132,6 +167,7 @@ bool CodeGenImpl::emitStmtControl(const Stmt *stmt,
         };
         std::string end = genLabel("switchend");
         breakLabels.push_back(end);
+        breakTryDepth.push_back(tryFrames.size());
         std::vector<std::string> labels;
         for (size_t i = 0; i < sw->getCases().size(); ++i)
             labels.push_back(genLabel("case"));
@@ -157,9 +193,11 @@ bool CodeGenImpl::emitStmtControl(const Stmt *stmt,
         }
         out << end << ":\n";
         breakLabels.pop_back();
+        breakTryDepth.pop_back();
         return true;
     }
     if (dynamic_cast<const BreakStmt *>(stmt)) {
+        if (!breakTryDepth.empty()) emitUnlinkHandlers(breakTryDepth.back(), locals);
         size_t limit = loopFinallyDepth.empty() ? 0 : loopFinallyDepth.back();
         for (size_t i = finallyStack.size(); i > limit; --i) {
             out << "    call " << finallyStack[i - 1] << "\n";
@@ -169,6 +207,7 @@ bool CodeGenImpl::emitStmtControl(const Stmt *stmt,
         return true;
     }
     if (dynamic_cast<const ContinueStmt *>(stmt)) {
+        if (!continueTryDepth.empty()) emitUnlinkHandlers(continueTryDepth.back(), locals);
         size_t limit = loopFinallyDepth.empty() ? 0 : loopFinallyDepth.back();
         for (size_t i = finallyStack.size(); i > limit; --i) {
             out << "    call " << finallyStack[i - 1] << "\n";
@@ -178,7 +217,18 @@ bool CodeGenImpl::emitStmtControl(const Stmt *stmt,
         return true;
     }
     if (auto *ret = dynamic_cast<const ReturnStmt *>(stmt)) {
+        auto *call = dynamic_cast<const CallExpr *>(ret->getValue());
+        if (call && tailCallable(call)) {
+            tailCall = call;
+            tailCallEmitted = false;
+            emitExpr(call, locals);
+            tailCall = nullptr;
+            if (tailCallEmitted) return true;
+            out << "    jmp " << endLabel << "\n";
+            return true;
+        }
         if (ret->getValue()) emitExpr(ret->getValue(), locals);
+        emitUnlinkHandlers(0, locals);
         if (!finallyStack.empty()) {
             if (ret->getValue()) {
                 int spillPad = this->windows ? 40 : 8;
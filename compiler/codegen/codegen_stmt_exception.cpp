@@ -45,50 +45,44 @@ bool CodeGenImpl::emitStmtException(const Stmt *stmt,
         std::string finallyLabel;
         if (t->getFinallyBlock()) finallyLabel = genLabel("finally");
 
-        out << "    call aym_try_push\n";
-        if (locals && locals->count(t->getHandlerSlot())) {
-            out << "    mov [rbp-" << locals->at(t->getHandlerSlot()) << "], rax\n";
-        } else {
-            out << "    mov [rel " << t->getHandlerSlot() << "], rax\n";
+        // Entrar al bloque solo llena el marco y lo enlaza en aym_handler_top;
+        // aym_throw lo desenlaza y vuelve a catchLabel con rsp/rbp restaurados.
+        out << "    lea rax, " << handlerField(t, locals, 0) << "\n";
+        out << "    mov rcx, [rel aym_handler_top]\n";
+        out << "    mov [rax], rcx\n";
+        out << "    lea rcx, [rel " << catchLabel << "]\n";
+        out << "    mov [rax+8], rcx\n";
+        out << "    mov [rax+16], rsp\n";
+        out << "    mov [rax+24], rbp\n";
+        out << "    mov [rax+32], rbx\n";
+        out << "    mov [rax+40], r12\n";
+        out << "    mov [rax+48], r13\n";
+        out << "    mov [rax+56], r14\n";
+        out << "    mov [rax+64], r15\n";
+        if (this->windows) {
+            out << "    mov [rax+80], rdi\n";
+            out << "    mov [rax+88], rsi\n";
         }
-        out << "    mov " << reg1(this->windows) << ", rax\n";
-        out << "    call aym_try_env\n";
-        out << "    mov " << reg1(this->windows) << ", rax\n";
-        out << "    call setjmp\n";
-        out << "    cmp rax,0\n";
-        out << "    jne " << catchLabel << "\n";
+        out << "    mov [rel aym_handler_top], rax\n";
 
         if (t->getFinallyBlock()) finallyStack.push_back(finallyLabel);
+        tryFrames.push_back(t);
         emitStmt(t->getTryBlock(), locals, endLabel);
+        tryFrames.pop_back();
         if (t->getFinallyBlock()) finallyStack.pop_back();
 
-        if (locals && locals->count(t->getHandlerSlot())) {
-            out << "    mov " << reg1(this->windows) << ", [rbp-" << locals->at(t->getHandlerSlot()) << "]\n";
-        } else {
-            out << "    mov " << reg1(this->windows) << ", [rel " << t->getHandlerSlot() << "]\n";
-        }
-        out << "    call aym_try_pop\n";
+        out << "    mov rcx, " << handlerField(t, locals, 0) << "\n";
+        out << "    mov [rel aym_handler_top], rcx\n";
         if (t->getFinallyBlock()) out << "    call " << finallyLabel << "\n";
         out << "    jmp " << end << "\n";
 
         out << catchLabel << ":\n";
-        if (locals && locals->count(t->getHandlerSlot())) {
-            out << "    mov " << reg1(this->windows) << ", [rbp-" << locals->at(t->getHandlerSlot()) << "]\n";
-        } else {
-            out << "    mov " << reg1(this->windows) << ", [rel " << t->getHandlerSlot() << "]\n";
-        }
-        out << "    call aym_try_get_exception\n";
+        out << "    mov rax, " << handlerField(t, locals, 72) << "\n";
         if (locals && locals->count(t->getExceptionSlot())) {
             out << "    mov [rbp-" << locals->at(t->getExceptionSlot()) << "], rax\n";
         } else {
             out << "    mov [rel " << t->getExceptionSlot() << "], rax\n";
         }
-        if (locals && locals->count(t->getHandlerSlot())) {
-            out << "    mov " << reg1(this->windows) << ", [rbp-" << locals->at(t->getHandlerSlot()) << "]\n";
-        } else {
-            out << "    mov " << reg1(this->windows) << ", [rel " << t->getHandlerSlot() << "]\n";
-        }
-        out << "    call aym_try_pop\n";
 
         if (t->getCatches().empty()) {
             if (t->getFinallyBlock()) out << "    call " << finallyLabel << "\n";
@@ -113,9 +107,9 @@ bool CodeGenImpl::emitStmtException(const Stmt *stmt,
                     out << "    mov " << reg2(this->windows) << ", rax\n";
                     size_t typeIdx = findString(c.typeName);
                     out << "    lea " << reg1(this->windows) << ", [rel str" << typeIdx << "]\n";
-                    out << "    call strcmp\n";
-                    out << "    cmp rax,0\n";
-                    out << "    jne " << nextLabel << "\n";
+                    out << "    call aym_str_eq\n";
+                    out << "    test rax, rax\n";
+                    out << "    jz " << nextLabel << "\n";
                 }
                 if (locals && locals->count(c.varName)) {
                     if (locals && locals->count(t->getExceptionSlot())) {
@@ -170,5 +164,21 @@ bool CodeGenImpl::emitStmtException(const Stmt *stmt,
     return false;
 }
 
+std::string CodeGenImpl::handlerField(const TryStmt *t, const std::unordered_map<std::string,int> *locals,
+                                      long offset) const {
+    if (locals && locals->count(t->getHandlerSlot())) {
+        return "[rbp-" + std::to_string(locals->at(t->getHandlerSlot()) - offset) + "]";
+    }
+    return "[rel " + t->getHandlerSlot() + (offset ? "+" + std::to_string(offset) : "") + "]";
+}
+
+// Saca de la cadena los marcos abiertos por encima de `depth` antes de saltar
+// fuera de sus bloques. No toca rax (puede llevar el valor de kuttaya).
+void CodeGenImpl::emitUnlinkHandlers(size_t depth, const std::unordered_map<std::string,int> *locals) {
+    if (tryFrames.size() <= depth) return;
+    out << "    mov rcx, " << handlerField(tryFrames[depth], locals, 0) << "\n";
+    out << "    mov [rel aym_handler_top], rcx\n";
+}
+
 } // namespace aym
 
@@ -28,6 +28,12 @@ bool CodeGenImpl::isStringExpr(const Expr *expr,
             listElementType(c->getArgs()[0].get(), locals) == "aru") {
             return true;
         }
+        if ((nameLower == BUILTIN_SIQI_APSU_QHIPA || nameLower == BUILTIN_SIQI_APSU_NAYRA ||
+             nameLower == BUILTIN_QULLU_APSU || nameLower == BUILTIN_QULLU_PATA) &&
+            !c->getArgs().empty()) {
+            std::string queue = queueType(c->getArgs()[0].get(), locals);
+            return queue.size() > 4 && queue.compare(queue.size() - 4, 4, ":aru") == 0;
+        }
         auto it = functionReturnTypes.find(c->getName());
         if (it == functionReturnTypes.end()) it = functionReturnTypes.find(nameLower);
         if (it != functionReturnTypes.end() && it->second == "aru") return true;
@@ -85,7 +91,8 @@ bool CodeGenImpl::isListExpr(const Expr *expr,
         std::string name = lowerName(c->getName());
         if (name == BUILTIN_PUSH || name == BUILTIN_CHULLU || name == BUILTIN_JALJTA ||
             name == BUILTIN_SUTINAKA || name == BUILTIN_CHANINAKA ||
-            name == BUILTIN_WAKICHA || name == BUILTIN_SAPAKI) return true;
+            name == BUILTIN_WAKICHA || name == BUILTIN_WAKICHA_CLAVE || name == BUILTIN_SAPAKI ||
+            name == BUILTIN_TAMA_LISTA || name == BUILTIN_SIQI_LISTA) return true;
         auto it = functionReturnTypes.find(c->getName());
         if (it == functionReturnTypes.end()) it = functionReturnTypes.find(name);
         if (it != functionReturnTypes.end() && it->second.rfind("t'aqa", 0) == 0) return true;
@@ -101,22 +108,12 @@ bool CodeGenImpl::isMapExpr(const Expr *expr,
     if (auto *v = dynamic_cast<const VariableExpr*>(expr)) {
         auto it = globalTypes.find(v->getName());
         if (it != globalTypes.end() && it->second.rfind("mapa", 0) == 0) return true;
-        if (it != globalTypes.end() && it->second.rfind("kasta:", 0) == 0) return true;
         if (currentParamTypes.count(v->getName()) &&
             currentParamTypes.at(v->getName()).rfind("mapa", 0) == 0)
             return true;
-        if (currentParamTypes.count(v->getName()) &&
-            currentParamTypes.at(v->getName()).rfind("kasta:", 0) == 0)
-            return true;
         if (currentLocalTypes.count(v->getName()) &&
             currentLocalTypes.at(v->getName()).rfind("mapa", 0) == 0)
             return true;
-        if (currentLocalTypes.count(v->getName()) &&
-            currentLocalTypes.at(v->getName()).rfind("kasta:", 0) == 0)
-            return true;
-    }
-    if (dynamic_cast<const NewExpr*>(expr)) {
-        return true;
     }
     if (auto *c = dynamic_cast<const CallExpr*>(expr)) {
         std::string name = lowerName(c->getName());
@@ -127,6 +124,71 @@ bool CodeGenImpl::isMapExpr(const Expr *expr,
     return false;
 }
 
+bool CodeGenImpl::isSetExpr(const Expr *expr,
+                            const std::unordered_map<std::string,int> *locals) const {
+    (void)locals;
+    if (!expr) return false;
+    auto isSetType = [](const std::string &t) { return t == "tama" || t.rfind("tama:", 0) == 0; };
+    if (auto *v = dynamic_cast<const VariableExpr*>(expr)) {
+        auto it = globalTypes.find(v->getName());
+        if (it != globalTypes.end() && isSetType(it->second)) return true;
+        if (currentParamTypes.count(v->getName()) && isSetType(currentParamTypes.at(v->getName())))
+            return true;
+        if (currentLocalTypes.count(v->getName()) && isSetType(currentLocalTypes.at(v->getName())))
+            return true;
+    }
+    if (auto *c = dynamic_cast<const CallExpr*>(expr)) {
+        std::string name = lowerName(c->getName());
+        if (name == BUILTIN_TAMA) return true;
+        auto it = functionReturnTypes.find(c->getName());
+        if (it == functionReturnTypes.end()) it = functionReturnTypes.find(name);
+        if (it != functionReturnTypes.end() && isSetType(it->second)) return true;
+    }
+    return false;
+}
+
+// `siqi:X` o `qullu:X` si la expresion es una cola; solo "siqi"/"qullu" cuando
+// el tipo del elemento no se conoce (un parametro) y "" si no es una cola.
+std::string CodeGenImpl::queueType(const Expr *expr,
+                                   const std::unordered_map<std::string,int> *locals) const {
+    if (!expr) return "";
+    auto isQueueType = [](const std::string &t) {
+        return t == "siqi" || t == "qullu" || t.rfind("siqi:", 0) == 0 || t.rfind("qullu:", 0) == 0;
+    };
+    if (auto *v = dynamic_cast<const VariableExpr*>(expr)) {
+        for (const auto *types : {&currentParamTypes, &currentLocalTypes, &globalTypes}) {
+            auto it = types->find(v->getName());
+            if (it != types->end() && isQueueType(it->second)) return it->second;
+        }
+    }
+    if (auto *c = dynamic_cast<const CallExpr*>(expr)) {
+        std::string name = lowerName(c->getName());
+        if (name == BUILTIN_SIQI) {
+            bool strings = !c->getArgs().empty() && listElementType(c->getArgs()[0].get(), locals) == "aru";
+            return strings ? "siqi:aru" : "siqi:jakhüwi";
+        }
+        if (name == BUILTIN_QULLU) {
+            // Sin lista, el tipo sale del primer parametro de la comparacion.
+            bool strings = false;
+            for (const auto &arg : c->getArgs()) {
+                if (auto *f = dynamic_cast<const FunctionRefExpr*>(arg.get())) {
+                    auto pit = paramTypes.find(f->getName());
+                    if (pit != paramTypes.end() && !pit->second.empty() && pit->second[0] == "aru") {
+                        strings = true;
+                    }
+                } else if (listElementType(arg.get(), locals) == "aru") {
+                    strings = true;
+                }
+            }
+            return strings ? "qullu:aru" : "qullu:jakhüwi";
+        }
+        auto it = functionReturnTypes.find(c->getName());
+        if (it == functionReturnTypes.end()) it = functionReturnTypes.find(name);
+        if (it != functionReturnTypes.end() && isQueueType(it->second)) return it->second;
+    }
+    return "";
+}
+
 std::string CodeGenImpl::listElementType(const Expr *expr,
                                          const std::unordered_map<std::string,int> *locals) const {
     if (!expr) return "";
@@ -182,9 +244,29 @@ std::string CodeGenImpl::listElementType(const Expr *expr,
         if ((name == BUILTIN_PUSH || name == BUILTIN_CHULLU) && !c->getArgs().empty()) {
             return listElementType(c->getArgs()[0].get(), locals);
         }
-        if ((name == BUILTIN_WAKICHA || name == BUILTIN_SAPAKI) && !c->getArgs().empty()) {
+        if ((name == BUILTIN_WAKICHA || name == BUILTIN_WAKICHA_CLAVE || name == BUILTIN_SAPAKI) &&
+            !c->getArgs().empty()) {
             return listElementType(c->getArgs()[0].get(), locals);
         }
+        if (name == BUILTIN_SIQI_LISTA && !c->getArgs().empty()) {
+            std::string queue = queueType(c->getArgs()[0].get(), locals);
+            auto colon = queue.find(':');
+            return colon == std::string::npos ? "" : queue.substr(colon + 1);
+        }
+        if (name == BUILTIN_TAMA_LISTA && !c->getArgs().empty()) {
+            const Expr *set = c->getArgs()[0].get();
+            if (auto *ctor = dynamic_cast<const CallExpr*>(set)) {
+                if (lowerName(ctor->getName()) == BUILTIN_TAMA && !ctor->getArgs().empty()) {
+                    return listElementType(ctor->getArgs()[0].get(), locals);
+                }
+            }
+            if (auto *sv = dynamic_cast<const VariableExpr*>(set)) {
+                for (const auto *types : {&currentParamTypes, &currentLocalTypes, &globalTypes}) {
+                    auto it = types->find(sv->getName());
+                    if (it != types->end() && it->second.rfind("tama:", 0) == 0) return it->second.substr(5);
+                }
+            }
+        }
     }
     return "";
 }
@@ -248,7 +330,8 @@ bool CodeGenImpl::isBoolExpr(const Expr *expr,
     if (auto *c = dynamic_cast<const CallExpr*>(expr)) {
         std::string nameLower = lowerName(c->getName());
         if (nameLower == BUILTIN_UTJI || nameLower == BUILTIN_UTJIT ||
-            nameLower == BUILTIN_UTJI_SUTI) return true;
+            nameLower == BUILTIN_UTJI_SUTI || nameLower == BUILTIN_TAMA_YAPA ||
+            nameLower == BUILTIN_TAMA_UTJI || nameLower == BUILTIN_TAMA_APSU) return true;
         auto it = functionReturnTypes.find(c->getName());
         if (it == functionReturnTypes.end()) it = functionReturnTypes.find(nameLower);
         if (it != functionReturnTypes.end() && it->second == "chiqa") return true;
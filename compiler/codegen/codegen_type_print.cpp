@@ -2,11 +2,11 @@
 
 namespace aym {
 
+// qillqa escribe al buffer de salida del runtime (runtime_output.c) con
+// aym_write_str/aym_write_int: sin printf ni formato por valor.
 void CodeGenImpl::emitPrintDefault(const std::string &label) {
-    out << "    lea " << reg1(this->windows) << ", [rel fmt_raw]\n";
-    out << "    lea " << reg2(this->windows) << ", [rel " << label << "]\n";
-    out << "    xor eax,eax\n";
-    out << "    call printf\n";
+    out << "    lea " << reg1(this->windows) << ", [rel " << label << "]\n";
+    out << "    call aym_write_str\n";
 }
 
 void CodeGenImpl::emitPrintValue(const Expr *expr,
@@ -16,30 +16,33 @@ void CodeGenImpl::emitPrintValue(const Expr *expr,
         if (isMapExpr(i->getBase(), locals)) {
             std::string valueIsNumber = genLabel("map_idx_num");
             std::string valueDone = genLabel("map_idx_done");
+            // Clave y mapa en la pila: r12-r15 pueden tener variables locales.
+            int shadow = this->windows ? 32 : 0;
+            std::string key = "[rsp+" + std::to_string(shadow) + "]";
+            std::string map = "[rsp+" + std::to_string(shadow + 8) + "]";
+            out << "    sub rsp, " << (shadow + 16) << "\n";
             emitExpr(i->getIndex(), locals);
-            out << "    mov r14, rax\n";
+            out << "    mov " << key << ", rax\n";
             emitExpr(i->getBase(), locals);
+            out << "    mov " << map << ", rax\n";
+            out << "    mov " << reg2(this->windows) << ", " << key << "\n";
+            out << "    mov " << reg1(this->windows) << ", rax\n";
+            out << (i->hasIntKey() ? "    call aym_imap_value_is_string_key\n"
+                                   : "    call aym_map_value_is_string_key\n");
             out << "    mov rbx, rax\n";
-            out << "    mov " << reg2(this->windows) << ", r14\n";
-            out << "    mov " << reg1(this->windows) << ", rbx\n";
-            out << "    call aym_map_value_is_string_key\n";
-            out << "    mov r15, rax\n";
-            out << "    mov " << reg2(this->windows) << ", r14\n";
-            out << "    mov " << reg1(this->windows) << ", rbx\n";
-            out << "    call aym_map_get\n";
-            out << "    mov r14, rax\n";
-            out << "    cmp r15, 0\n";
+            out << "    mov " << reg2(this->windows) << ", " << key << "\n";
+            out << "    mov " << reg1(this->windows) << ", " << map << "\n";
+            out << (i->hasIntKey() ? "    call aym_imap_get\n" : "    call aym_map_get\n");
+            out << "    add rsp, " << (shadow + 16) << "\n";
+            out << "    mov rcx, rax\n";
+            out << "    cmp rbx, 0\n";
             out << "    je " << valueIsNumber << "\n";
-            out << "    mov " << reg2(this->windows) << ", r14\n";
-            out << "    lea " << reg1(this->windows) << ", [rel fmt_raw]\n";
-            out << "    xor eax,eax\n";
-            out << "    call printf\n";
+            out << "    mov " << reg1(this->windows) << ", rcx\n";
+            out << "    call aym_write_str\n";
             out << "    jmp " << valueDone << "\n";
             out << valueIsNumber << ":\n";
-            out << "    mov " << reg2(this->windows) << ", r14\n";
-            out << "    lea " << reg1(this->windows) << ", [rel fmt_int_raw]\n";
-            out << "    xor eax,eax\n";
-            out << "    call printf\n";
+            out << "    mov " << reg1(this->windows) << ", rcx\n";
+            out << "    call aym_write_int\n";
             out << valueDone << ":\n";
             return;
         }
@@ -48,7 +51,17 @@ void CodeGenImpl::emitPrintValue(const Expr *expr,
         emitPrintList(expr, locals);
         return;
     }
-    if (isMapExpr(expr, locals)) {
+    if (isSetExpr(expr, locals)) {
+        emitPrintRuntimeItems(expr, locals, "aym_set", "map_open", "map_close");
+        return;
+    }
+    std::string queue = queueType(expr, locals);
+    if (!queue.empty()) {
+        emitPrintRuntimeItems(expr, locals, queue.rfind("siqi", 0) == 0 ? "aym_deque" : "aym_heap",
+                              "list_open", "list_close");
+        return;
+    }
+    if (isMapExpr(expr, locals) || !objectClassOf(expr, locals).empty()) {
         emitPrintMap(expr, locals);
         return;
     }
@@ -65,16 +78,13 @@ void CodeGenImpl::emitPrintValue(const Expr *expr,
         out << endLbl << ":\n";
         return;
     }
-    emitExpr(expr, locals);
-    if (isStringExpr(expr, locals)) {
-        out << "    mov " << reg2(this->windows) << ", rax\n";
-        out << "    lea " << reg1(this->windows) << ", [rel fmt_raw]\n";
-    } else {
-        out << "    mov " << reg2(this->windows) << ", rax\n";
-        out << "    lea " << reg1(this->windows) << ", [rel fmt_int_raw]\n";
+    if (auto *s = dynamic_cast<const StringExpr*>(expr)) {
+        emitPrintDefault("str" + std::to_string(findString(s->getValue())));
+        return;
     }
-    out << "    xor eax,eax\n";
-    out << "    call printf\n";
+    emitExpr(expr, locals);
+    out << "    mov " << reg1(this->windows) << ", rax\n";
+    out << (isStringExpr(expr, locals) ? "    call aym_write_str\n" : "    call aym_write_int\n");
 }
 
 void CodeGenImpl::emitPrintList(const Expr *expr,
@@ -83,6 +93,7 @@ void CodeGenImpl::emitPrintList(const Expr *expr,
     std::string end = genLabel("list_end");
     std::string elemType = listElementType(expr, locals);
     emitExpr(expr, locals);
+    emitPreserveRegLocals(false);
     out << "    mov rbx, rax\n";
     emitPrintDefault("list_open");
     out << "    mov " << reg1(this->windows) << ", rbx\n";
@@ -98,16 +109,12 @@ void CodeGenImpl::emitPrintList(const Expr *expr,
     if (elemType == "aru") {
         out << "    mov r14, rax\n";
         emitPrintDefault("list_quote");
-        out << "    mov " << reg2(this->windows) << ", r14\n";
-        out << "    lea " << reg1(this->windows) << ", [rel fmt_raw]\n";
-    } else {
-        out << "    mov " << reg2(this->windows) << ", rax\n";
-        out << "    lea " << reg1(this->windows) << ", [rel fmt_int_raw]\n";
-    }
-    out << "    xor eax,eax\n";
-    out << "    call printf\n";
-    if (elemType == "aru") {
+        out << "    mov " << reg1(this->windows) << ", r14\n";
+        out << "    call aym_write_str\n";
         emitPrintDefault("list_quote");
+    } else {
+        out << "    mov " << reg1(this->windows) << ", rax\n";
+        out << "    call aym_write_int\n";
     }
     out << "    inc r13\n";
     out << "    cmp r13, r12\n";
@@ -116,6 +123,7 @@ void CodeGenImpl::emitPrintList(const Expr *expr,
     out << "    jmp " << loop << "\n";
     out << end << ":\n";
     emitPrintDefault("list_close");
+    emitPreserveRegLocals(true);
 }
 
 void CodeGenImpl::emitPrintMap(const Expr *expr,
@@ -123,6 +131,11 @@ void CodeGenImpl::emitPrintMap(const Expr *expr,
     std::string loop = genLabel("map_loop");
     std::string end = genLabel("map_end");
     emitExpr(expr, locals);
+    if (!objectClassOf(expr, locals).empty()) {
+        out << "    mov " << reg1(this->windows) << ", rax\n";
+        out << "    call aym_object_to_map\n";
+    }
+    emitPreserveRegLocals(false);
     out << "    mov rbx, rax\n";
     emitPrintDefault("map_open");
     out << "    mov " << reg1(this->windows) << ", rbx\n";
@@ -135,11 +148,8 @@ void CodeGenImpl::emitPrintMap(const Expr *expr,
     out << "    mov " << reg2(this->windows) << ", r13\n";
     out << "    mov " << reg1(this->windows) << ", rbx\n";
     out << "    call aym_map_key_at\n";
-    out << "    mov r14, rax\n";
-    out << "    mov " << reg2(this->windows) << ", r14\n";
-    out << "    lea " << reg1(this->windows) << ", [rel fmt_raw]\n";
-    out << "    xor eax,eax\n";
-    out << "    call printf\n";
+    out << "    mov " << reg1(this->windows) << ", rax\n";
+    out << "    call aym_write_str\n";
     emitPrintDefault("map_colon");
     out << "    mov " << reg2(this->windows) << ", r13\n";
     out << "    mov " << reg1(this->windows) << ", rbx\n";
@@ -154,17 +164,13 @@ void CodeGenImpl::emitPrintMap(const Expr *expr,
     std::string valueDone = genLabel("map_value_done");
     out << "    je " << valueIsNumber << "\n";
     emitPrintDefault("list_quote");
-    out << "    mov " << reg2(this->windows) << ", r14\n";
-    out << "    lea " << reg1(this->windows) << ", [rel fmt_raw]\n";
-    out << "    xor eax,eax\n";
-    out << "    call printf\n";
+    out << "    mov " << reg1(this->windows) << ", r14\n";
+    out << "    call aym_write_str\n";
     emitPrintDefault("list_quote");
     out << "    jmp " << valueDone << "\n";
     out << valueIsNumber << ":\n";
-    out << "    mov " << reg2(this->windows) << ", r14\n";
-    out << "    lea " << reg1(this->windows) << ", [rel fmt_int_raw]\n";
-    out << "    xor eax,eax\n";
-    out << "    call printf\n";
+    out << "    mov " << reg1(this->windows) << ", r14\n";
+    out << "    call aym_write_int\n";
     out << valueDone << ":\n";
     out << "    inc r13\n";
     out << "    cmp r13, r12\n";
@@ -173,6 +179,61 @@ void CodeGenImpl::emitPrintMap(const Expr *expr,
     out << "    jmp " << loop << "\n";
     out << end << ":\n";
     emitPrintDefault("map_close");
+    emitPreserveRegLocals(true);
+}
+
+// `{1, 2}` o `{"a", "b"}` para un tama, `[1, 2]` para siqi y qullu. Se
+// recorre la lista de `<runtime>_items` y el tipo de los elementos lo guarda la
+// coleccion (`<runtime>_is_string`): un `tama()` sin lista inicial no lo tiene
+// en compilacion.
+void CodeGenImpl::emitPrintRuntimeItems(const Expr *expr,
+                                        const std::unordered_map<std::string,int> *locals,
+                                        const std::string &runtime, const std::string &open,
+                                        const std::string &close) {
+    std::string loop = genLabel("set_loop");
+    std::string end = genLabel("set_end");
+    std::string itemIsNumber = genLabel("set_item_num");
+    std::string itemDone = genLabel("set_item_done");
+    emitExpr(expr, locals);
+    emitPreserveRegLocals(false);
+    out << "    mov " << reg1(this->windows) << ", rax\n";
+    out << "    mov rbx, rax\n";
+    out << "    call " << runtime << "_is_string\n";
+    out << "    mov r15, rax\n";
+    out << "    mov " << reg1(this->windows) << ", rbx\n";
+    out << "    call " << runtime << "_items\n";
+    out << "    mov rbx, rax\n";
+    emitPrintDefault(open);
+    out << "    mov " << reg1(this->windows) << ", rbx\n";
+    out << "    call aym_array_length\n";
+    out << "    mov r12, rax\n";
+    out << "    xor r13, r13\n";
+    out << loop << ":\n";
+    out << "    cmp r13, r12\n";
+    out << "    je " << end << "\n";
+    out << "    mov " << reg2(this->windows) << ", r13\n";
+    out << "    mov " << reg1(this->windows) << ", rbx\n";
+    out << "    call aym_array_get\n";
+    out << "    mov r14, rax\n";
+    out << "    cmp r15, 0\n";
+    out << "    je " << itemIsNumber << "\n";
+    emitPrintDefault("list_quote");
+    out << "    mov " << reg1(this->windows) << ", r14\n";
+    out << "    call aym_write_str\n";
+    emitPrintDefault("list_quote");
+    out << "    jmp " << itemDone << "\n";
+    out << itemIsNumber << ":\n";
+    out << "    mov " << reg1(this->windows) << ", r14\n";
+    out << "    call aym_write_int\n";
+    out << itemDone << ":\n";
+    out << "    inc r13\n";
+    out << "    cmp r13, r12\n";
+    out << "    je " << end << "\n";
+    emitPrintDefault("map_sep");
+    out << "    jmp " << loop << "\n";
+    out << end << ":\n";
+    emitPrintDefault(close);
+    emitPreserveRegLocals(true);
 }
 
 } // namespace aym
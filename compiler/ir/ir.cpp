@@ -0,0 +1,315 @@
+#include "ir.h"
+
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace aym {
+
+int IrFunction::addBlock() {
+    blocks.emplace_back();
+    return static_cast<int>(blocks.size()) - 1;
+}
+
+int IrFunction::append(int block, IrInstr instr) {
+    instr.block = block;
+    values.push_back(std::move(instr));
+    int id = static_cast<int>(values.size()) - 1;
+    blocks[block].instrs.push_back(id);
+    return id;
+}
+
+bool IrFunction::terminated(int block) const {
+    const auto &instrs = blocks[block].instrs;
+    return !instrs.empty() && irIsTerminator(values[instrs.back()].op);
+}
+
+std::vector<int> IrFunction::successors(int block) const {
+    if (!terminated(block)) return {};
+    const IrInstr &term = values[blocks[block].instrs.back()];
+    if (term.op == IrOp::Ret) return {};
+    return term.targets;
+}
+
+const IrFunction *IrModule::find(const std::string &name) const {
+    for (const auto &fn : functions) {
+        if (fn.name == name) return &fn;
+    }
+    return nullptr;
+}
+
+const char *irTypeName(IrType type) {
+    switch (type) {
+        case IrType::Void: return "void";
+        case IrType::I64: return "i64";
+        case IrType::Bool: return "bool";
+        case IrType::Str: return "str";
+    }
+    return "?";
+}
+
+const char *irOpName(IrOp op) {
+    switch (op) {
+        case IrOp::Const: return "const";
+        case IrOp::Str: return "cstr";
+        case IrOp::Addr: return "addr";
+        case IrOp::Param: return "param";
+        case IrOp::GlobalLoad: return "gload";
+        case IrOp::GlobalStore: return "gstore";
+        case IrOp::Add: return "add";
+        case IrOp::Sub: return "sub";
+        case IrOp::Mul: return "mul";
+        case IrOp::Div: return "div";
+        case IrOp::Mod: return "mod";
+        case IrOp::Pow: return "pow";
+        case IrOp::Neg: return "neg";
+        case IrOp::Not: return "not";
+        case IrOp::CmpEq: return "eq";
+        case IrOp::CmpNe: return "ne";
+        case IrOp::CmpLt: return "lt";
+        case IrOp::CmpLe: return "le";
+        case IrOp::CmpGt: return "gt";
+        case IrOp::CmpGe: return "ge";
+        case IrOp::Call: return "call";
+        case IrOp::RtCall: return "rtcall";
+        case IrOp::Phi: return "phi";
+        case IrOp::Br: return "br";
+        case IrOp::CondBr: return "cbr";
+        case IrOp::Ret: return "ret";
+    }
+    return "?";
+}
+
+bool irIsTerminator(IrOp op) {
+    return op == IrOp::Br || op == IrOp::CondBr || op == IrOp::Ret;
+}
+
+bool irHasResult(const IrInstr &instr) {
+    return instr.type != IrType::Void;
+}
+
+namespace {
+
+void removeUnreachableBlocks(IrFunction &fn) {
+    std::vector<bool> reachable(fn.blocks.size(), false);
+    std::vector<int> work{0};
+    reachable[0] = true;
+    while (!work.empty()) {
+        int b = work.back();
+        work.pop_back();
+        for (int s : fn.successors(b)) {
+            if (!reachable[s]) {
+                reachable[s] = true;
+                work.push_back(s);
+            }
+        }
+    }
+    for (size_t b = 0; b < fn.blocks.size(); ++b) {
+        IrBlock &block = fn.blocks[b];
+        if (!reachable[b]) {
+            block.instrs.clear();
+            block.preds.clear();
+            continue;
+        }
+        // Los phis pierden las entradas de predecesores eliminados.
+        std::vector<int> preds;
+        for (int p : block.preds) {
+            if (reachable[p]) preds.push_back(p);
+        }
+        for (int id : block.instrs) {
+            IrInstr &instr = fn.values[id];
+            if (instr.op != IrOp::Phi) continue;
+            std::vector<int> args;
+            std::vector<int> from;
+            for (size_t i = 0; i < instr.targets.size(); ++i) {
+                if (reachable[instr.targets[i]]) {
+                    args.push_back(instr.args[i]);
+                    from.push_back(instr.targets[i]);
+                }
+            }
+            instr.args = std::move(args);
+            instr.targets = std::move(from);
+        }
+        block.preds = std::move(preds);
+    }
+}
+
+} // namespace
+
+void simplifyIrFunction(IrFunction &fn) {
+    if (fn.blocks.empty()) return;
+    removeUnreachableBlocks(fn);
+
+    std::unordered_map<int,int> replaced;
+    auto resolve = [&](int v) {
+        auto it = replaced.find(v);
+        while (it != replaced.end()) {
+            v = it->second;
+            it = replaced.find(v);
+        }
+        return v;
+    };
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (auto &block : fn.blocks) {
+            for (auto it = block.instrs.begin(); it != block.instrs.end();) {
+                IrInstr &phi = fn.values[*it];
+                if (phi.op != IrOp::Phi) {
+                    ++it;
+                    continue;
+                }
+                int same = -1;
+                bool trivial = true;
+                for (int &arg : phi.args) {
+                    arg = resolve(arg);
+                    if (arg == *it || arg == same) continue;
+                    if (same != -1) {
+                        trivial = false;
+                        break;
+                    }
+                    same = arg;
+                }
+                if (!trivial || same == -1) {
+                    ++it;
+                    continue;
+                }
+                replaced[*it] = same;
+                it = block.instrs.erase(it);
+                changed = true;
+            }
+        }
+    }
+    if (replaced.empty()) return;
+    for (auto &block : fn.blocks) {
+        for (int id : block.instrs) {
+            for (int &arg : fn.values[id].args) arg = resolve(arg);
+        }
+    }
+}
+
+std::string verifyIrFunction(const IrFunction &fn) {
+    std::unordered_set<int> defined;
+    for (const auto &block : fn.blocks) {
+        for (int id : block.instrs) defined.insert(id);
+    }
+    for (size_t b = 0; b < fn.blocks.size(); ++b) {
+        const IrBlock &block = fn.blocks[b];
+        if (block.instrs.empty()) continue;
+        std::string where = "@" + fn.name + " bb" + std::to_string(b);
+        if (!fn.terminated(static_cast<int>(b))) {
+            return where + ": bloque sin terminador";
+        }
+        bool seenNonPhi = false;
+        for (size_t i = 0; i < block.instrs.size(); ++i) {
+            const IrInstr &instr = fn.values[block.instrs[i]];
+            if (irIsTerminator(instr.op) && i + 1 != block.instrs.size()) {
+                return where + ": terminador en medio del bloque";
+            }
+            if (instr.op == IrOp::Phi) {
+                if (seenNonPhi) return where + ": phi despues de otras instrucciones";
+                if (instr.targets.size() != block.preds.size()) {
+                    return where + ": phi %" + std::to_string(block.instrs[i]) +
+                           " no coincide con los predecesores";
+                }
+            } else {
+                seenNonPhi = true;
+            }
+            for (int arg : instr.args) {
+                if (!defined.count(arg)) {
+                    return where + ": operando %" + std::to_string(arg) + " sin definir";
+                }
+            }
+        }
+        for (int s : fn.successors(static_cast<int>(b))) {
+            const auto &preds = fn.blocks[s].preds;
+            if (std::find(preds.begin(), preds.end(), static_cast<int>(b)) == preds.end()) {
+                return where + ": sucesor bb" + std::to_string(s) + " sin arista de vuelta";
+            }
+        }
+    }
+    return "";
+}
+
+void dumpIrFunction(const IrFunction &fn, std::ostream &out) {
+    out << "func @" << fn.name << "(";
+    for (size_t i = 0; i < fn.params.size(); ++i) {
+        if (i) out << ", ";
+        out << irTypeName(fn.params[i]);
+    }
+    out << ") -> " << irTypeName(fn.returnType) << " {\n";
+    for (size_t b = 0; b < fn.blocks.size(); ++b) {
+        const IrBlock &block = fn.blocks[b];
+        if (block.instrs.empty()) continue;
+        out << "bb" << b << ":";
+        if (!block.preds.empty()) {
+            out << "  ; preds:";
+            for (size_t i = 0; i < block.preds.size(); ++i) {
+                out << (i ? ", bb" : " bb") << block.preds[i];
+            }
+        }
+        out << "\n";
+        for (int id : block.instrs) {
+            const IrInstr &instr = fn.values[id];
+            out << "  ";
+            if (irHasResult(instr)) out << "%" << id << " = ";
+            out << irOpName(instr.op);
+            if (irHasResult(instr)) out << " " << irTypeName(instr.type);
+            switch (instr.op) {
+                case IrOp::Const:
+                case IrOp::Param:
+                    out << " " << instr.imm;
+                    break;
+                case IrOp::Str:
+                    out << " $" << instr.imm;
+                    break;
+                case IrOp::Phi:
+                    for (size_t i = 0; i < instr.args.size(); ++i) {
+                        out << (i ? ", [%" : " [%") << instr.args[i] << ", bb" << instr.targets[i] << "]";
+                    }
+                    break;
+                case IrOp::Br:
+                    out << " bb" << instr.targets[0];
+                    break;
+                case IrOp::CondBr:
+                    out << " %" << instr.args[0] << ", bb" << instr.targets[0] << ", bb" << instr.targets[1];
+                    break;
+                default: {
+                    if (!instr.symbol.empty()) out << " @" << instr.symbol;
+                    bool call = instr.op == IrOp::Call || instr.op == IrOp::RtCall;
+                    if (call) out << "(";
+                    for (size_t i = 0; i < instr.args.size(); ++i) {
+                        if (i || (!call && !instr.symbol.empty())) out << ",";
+                        if (i || !call) out << " ";
+                        out << "%" << instr.args[i];
+                    }
+                    if (call) out << ")";
+                    break;
+                }
+            }
+            out << "\n";
+        }
+    }
+    out << "}\n";
+}
+
+void dumpIrModule(const IrModule &module, std::ostream &out) {
+    for (size_t i = 0; i < module.strings.size(); ++i) {
+        out << "$" << i << " = \"";
+        for (char ch : module.strings[i]) {
+            if (ch == '\n') out << "\\n";
+            else if (ch == '"' || ch == '\\') out << '\\' << ch;
+            else out << ch;
+        }
+        out << "\"\n";
+    }
+    for (const auto &fn : module.functions) {
+        out << "\n";
+        dumpIrFunction(fn, out);
+    }
+    for (const auto &skip : module.skipped) {
+        out << "\n; @" << skip.first << ": sin IR, se emite desde el AST (" << skip.second << ")\n";
+    }
+}
+
+} // namespace aym
@@ -0,0 +1,110 @@
+#ifndef AYM_IR_H
+#define AYM_IR_H
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace aym {
+
+// IR de tres direcciones en forma SSA. Cada instruccion con resultado define
+// un valor %N (N es su indice en IrFunction::values); los bloques guardan el
+// orden de sus instrucciones y la ultima siempre es un terminador.
+
+enum class IrType {
+    Void,
+    I64,
+    Bool,
+    Str
+};
+
+enum class IrOp {
+    Const,       // imm
+    Str,         // imm = indice en la tabla de cadenas del modulo
+    Addr,        // symbol: etiqueta de datos del runtime (fmt_raw, bool_true...)
+    Param,       // imm = posicion del parametro
+    GlobalLoad,  // symbol
+    GlobalStore, // symbol, args[0]
+    Add,
+    Sub,
+    Mul,
+    Div,
+    Mod,
+    Pow,
+    Neg,
+    Not,
+    CmpEq,
+    CmpNe,
+    CmpLt,
+    CmpLe,
+    CmpGt,
+    CmpGe,
+    Call,        // symbol: funcion del programa
+    RtCall,      // symbol: funcion del runtime o de libc
+    Phi,         // args[i] llega desde el bloque targets[i]
+    Br,          // targets[0]
+    CondBr,      // args[0] != 0 ? targets[0] : targets[1]
+    Ret          // args vacio o args[0]
+};
+
+struct IrInstr {
+    IrInstr() = default;
+    explicit IrInstr(IrOp opIn, IrType typeIn = IrType::Void) : op(opIn), type(typeIn) {}
+
+    IrOp op = IrOp::Const;
+    IrType type = IrType::Void;
+    long long imm = 0;
+    std::string symbol;
+    std::vector<int> args;
+    std::vector<int> targets;
+    int block = -1;
+    // Llamadas variadicas (printf/scanf) necesitan al=0 en System V.
+    bool variadic = false;
+};
+
+struct IrBlock {
+    std::vector<int> instrs;
+    std::vector<int> preds;
+    bool sealed = false;
+};
+
+struct IrFunction {
+    std::string name;
+    std::vector<IrType> params;
+    IrType returnType = IrType::Void;
+    bool isMain = false;
+    std::vector<IrInstr> values;
+    std::vector<IrBlock> blocks;
+
+    int addBlock();
+    int append(int block, IrInstr instr);
+    bool terminated(int block) const;
+    std::vector<int> successors(int block) const;
+};
+
+struct IrModule {
+    std::vector<std::string> strings;
+    std::vector<IrFunction> functions;
+    // Funciones que se emiten desde el AST y motivo.
+    std::vector<std::pair<std::string, std::string>> skipped;
+
+    const IrFunction *find(const std::string &name) const;
+};
+
+const char *irTypeName(IrType type);
+const char *irOpName(IrOp op);
+bool irIsTerminator(IrOp op);
+bool irHasResult(const IrInstr &instr);
+
+// Elimina bloques inalcanzables y phis triviales (todas las entradas iguales),
+// reescribiendo los usos hasta llegar a un punto fijo.
+void simplifyIrFunction(IrFunction &fn);
+// Comprueba invariantes basicos: terminador final, phis alineados con los
+// predecesores y operandos definidos. Devuelve vacio si todo es correcto.
+std::string verifyIrFunction(const IrFunction &fn);
+void dumpIrFunction(const IrFunction &fn, std::ostream &out);
+void dumpIrModule(const IrModule &module, std::ostream &out);
+
+} // namespace aym
+
+#endif // AYM_IR_H
@@ -74,6 +74,9 @@ enum class TokenType {
     KeywordTypeBool,
     KeywordTypeList,
     KeywordTypeMap,
+    KeywordTypeSet,
+    KeywordTypeDeque,
+    KeywordTypeHeap,
     KeywordTrue,
     KeywordFalse,
     EndOfFile
@@ -171,6 +171,12 @@ void Lexer::lexIdentifierOrKeyword(std::vector<Token> &tokens,
         tokens.push_back({TokenType::KeywordTypeList, word, startLine, startColumn});
     } else if (normalized == "mapa") {
         tokens.push_back({TokenType::KeywordTypeMap, word, startLine, startColumn});
+    } else if (normalized == "tama") {
+        tokens.push_back({TokenType::KeywordTypeSet, word, startLine, startColumn});
+    } else if (normalized == "siqi") {
+        tokens.push_back({TokenType::KeywordTypeDeque, word, startLine, startColumn});
+    } else if (normalized == "qullu") {
+        tokens.push_back({TokenType::KeywordTypeHeap, word, startLine, startColumn});
     } else if (normalized == "chiqa") {
         tokens.push_back({TokenType::KeywordTrue, word, startLine, startColumn});
     } else if (normalized == "kari") {
@@ -1,5 +1,7 @@
 #include "lexer/lexer.h"
 #include "parser/parser.h"
+#include "ast/ast_fold.h"
+#include "ast/ast_inline.h"
 #include "ast/ast_json.h"
 #include "backend/backend.h"
 #include "codegen/codegen.h"
@@ -191,6 +193,8 @@ int main(int argc, char** argv) {
                                              options.timePipeline,
                                              pipelineMetricsJsonPath,
                                              options.toolTimeoutMs,
+                                             options.runtimeOpt,
+                                             options.gcStats,
                                              backendError);
             if (!ok) {
                 if (!backendError.empty()) {
@@ -287,9 +291,21 @@ int main(int argc, char** argv) {
             return 0;
         }
 
+        if (!options.noInline) {
+            aym::InlineStats inlineStats = aym::inlineFunctions(nodes);
+            if (options.inlineReport) {
+                for (const auto &site : inlineStats.sites) {
+                    std::cout << "[aymc] En linea: " << site.callee << " en " << site.caller
+                              << " (linea " << site.line << ")" << std::endl;
+                }
+                std::cout << "[aymc] Llamadas en linea: " << inlineStats.sites.size()
+                          << " (funciones candidatas: " << inlineStats.candidates << ")" << std::endl;
+            }
+        }
+        aym::foldConstants(nodes);
+
         std::string runtimeDirString;
-        if (backendKind == aym::BackendKind::Native &&
-            pipelineMode != aym::CodegenPipelineMode::CompileOnly) {
+        if (pipelineMode != aym::CodegenPipelineMode::CompileOnly) {
             fs::path runtimeDir = aym::findRuntimeDirectory();
             if (!fs::exists(runtimeDir)) {
                 aym::error("No se encontro el runtime. Busca runtime/runtime.c junto al compilador o instala el paquete completo.");
@@ -314,6 +330,8 @@ int main(int argc, char** argv) {
                                          options.timePipeline,
                                          pipelineMetricsJsonPath,
                                          options.toolTimeoutMs,
+                                         options.runtimeOpt,
+                                         options.gcStats,
                                          backendError);
         if (!ok) {
             if (!backendError.empty()) {
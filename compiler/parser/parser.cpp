@@ -19,6 +19,12 @@ std::string canonicalTypeName(const Token &tok) {
             return "t'aqa";
         case TokenType::KeywordTypeMap:
             return "mapa";
+        case TokenType::KeywordTypeSet:
+            return "tama";
+        case TokenType::KeywordTypeDeque:
+            return "siqi";
+        case TokenType::KeywordTypeHeap:
+            return "qullu";
         default:
             return tok.text;
     }
@@ -31,7 +37,9 @@ Parser::Parser(const std::vector<Token>& t, DiagnosticEngine *diag)
 std::string Parser::parseTypeName() {
     if (match(TokenType::KeywordTypeNumber) || match(TokenType::KeywordTypeString) ||
         match(TokenType::KeywordTypeBool) || match(TokenType::KeywordTypeList) ||
-        match(TokenType::KeywordTypeMap) || match(TokenType::KeywordTrue)) {
+        match(TokenType::KeywordTypeMap) || match(TokenType::KeywordTypeSet) ||
+        match(TokenType::KeywordTypeDeque) || match(TokenType::KeywordTypeHeap) ||
+        match(TokenType::KeywordTrue)) {
         return canonicalTypeName(tokens[pos-1]);
     }
     if (match(TokenType::Identifier)) {
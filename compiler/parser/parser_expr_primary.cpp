@@ -92,7 +92,9 @@ std::unique_ptr<Expr> Parser::parsePrimary() {
         Token tok = tokens[pos-1];
         return parseMapLiteral(tok);
     }
-    if (match(TokenType::KeywordTypeString) || match(TokenType::KeywordTypeNumber)) {
+    if (match(TokenType::KeywordTypeString) || match(TokenType::KeywordTypeNumber) ||
+        match(TokenType::KeywordTypeSet) || match(TokenType::KeywordTypeDeque) ||
+        match(TokenType::KeywordTypeHeap)) {
         Token idTok = tokens[pos-1];
         std::string name = idTok.text;
         if (match(TokenType::LParen)) {
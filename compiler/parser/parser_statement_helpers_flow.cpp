@@ -101,7 +101,9 @@ std::unique_ptr<Stmt> Parser::parseForStatement(const Token &forTok) {
             std::string type;
             if (match(TokenType::KeywordTypeNumber) || match(TokenType::KeywordTypeString) ||
                 match(TokenType::KeywordTypeBool) || match(TokenType::KeywordTypeList) ||
-                match(TokenType::KeywordTypeMap) || match(TokenType::KeywordTrue)) {
+                match(TokenType::KeywordTypeMap) || match(TokenType::KeywordTypeSet) ||
+                match(TokenType::KeywordTypeDeque) || match(TokenType::KeywordTypeHeap) ||
+                match(TokenType::KeywordTrue)) {
                 type = normalizeTypeNameLocal(tokens[pos-1]);
             } else {
                 parseError("se esperaba un tipo en el encabezado de 'kuti'");
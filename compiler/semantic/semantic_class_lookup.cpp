@@ -76,6 +76,8 @@ bool SemanticAnalyzer::isTypeAssignable(const std::string &actualType,
                                         const std::string &expectedType) const {
     if (expectedType.empty() || actualType.empty()) return false;
     if (actualType == expectedType) return true;
+    if ((expectedType == "tama" || expectedType == "siqi" || expectedType == "qullu") &&
+        actualType.rfind(expectedType + ":", 0) == 0) return true;
     if (actualType.rfind("kasta:", 0) == 0 && expectedType.rfind("kasta:", 0) == 0) {
         return isSubclassOf(actualType.substr(6), expectedType.substr(6));
     }
@@ -31,12 +31,17 @@ void SemanticAnalyzer::visit(ListExpr &l) {
 void SemanticAnalyzer::visit(MapExpr &m) {
     markNode(m);
     std::string valueType;
+    std::string firstKeyType;
     bool sawValue = false;
     for (const auto &item : m.getItems()) {
         item.first->accept(*this);
         std::string keyType = currentType;
-        if (keyType != "aru") {
-            reportError("clave de mapa debe ser texto");
+        if (keyType != "aru" && keyType != "jakhüwi") {
+            reportError("clave de mapa debe ser texto o numero");
+        } else if (firstKeyType.empty()) {
+            firstKeyType = keyType;
+        } else if (keyType != firstKeyType) {
+            reportError("claves de mapa de tipos distintos");
         }
         item.second->accept(*this);
         std::string t = currentType;
@@ -47,6 +52,7 @@ void SemanticAnalyzer::visit(MapExpr &m) {
             valueType.clear();
         }
     }
+    m.setIntKeys(firstKeyType == "jakhüwi");
     if (!sawValue) {
         currentType = "mapa:jakhüwi";
     } else if (!valueType.empty()) {
@@ -65,6 +71,7 @@ void SemanticAnalyzer::visit(IndexExpr &i) {
     if (baseType.rfind("t'aqa:", 0) == 0) {
         currentType = baseType.substr(6);
     } else if (baseType.rfind("mapa", 0) == 0) {
+        i.setIntKey(currentType == "jakhüwi");
         if (baseType.rfind("mapa:", 0) == 0) {
             currentType = baseType.substr(5);
         } else {
@@ -95,6 +102,7 @@ void SemanticAnalyzer::visit(MemberExpr &m) {
             reportError("atributo privado '" + m.getMember() + "' no accesible");
             currentType = "";
         } else {
+            m.setObjectClass(className);
             currentType = field->type;
             m.setResolvedType(field->type);
         }
@@ -23,6 +23,14 @@ void SemanticAnalyzer::visit(CallExpr &c) {
         if (c.getArgs().size() < 2 || c.getArgs().size() > 3) {
             reportError("numero incorrecto de argumentos en llamada a '" + c.getName() + "'", "AYM3005");
         }
+    } else if (nameLower == BUILTIN_TAMA || nameLower == BUILTIN_SIQI) {
+        if (c.getArgs().size() > 1) {
+            reportError("numero incorrecto de argumentos en llamada a '" + c.getName() + "'", "AYM3005");
+        }
+    } else if (nameLower == BUILTIN_QULLU) {
+        if (c.getArgs().size() > 2) {
+            reportError("numero incorrecto de argumentos en llamada a '" + c.getName() + "'", "AYM3005");
+        }
     } else if (c.getArgs().size() != it->second) {
         reportError("numero incorrecto de argumentos en llamada a '" + c.getName() + "'", "AYM3005");
     }
@@ -31,9 +39,11 @@ void SemanticAnalyzer::visit(CallExpr &c) {
     if (pit == paramTypes.end()) {
         pit = paramTypes.find(nameLower);
     }
+    std::vector<std::string> argTypes;
     for (const auto &arg : c.getArgs()) {
         arg->accept(*this);
         std::string t = currentType;
+        argTypes.push_back(t);
         if (pit != paramTypes.end() && idx < pit->second.size()) {
             const std::string &expectedType = pit->second[idx];
             if (!expectedType.empty() && !t.empty() && !isTypeAssignable(t, expectedType)) {
@@ -44,6 +54,11 @@ void SemanticAnalyzer::visit(CallExpr &c) {
         }
         ++idx;
     }
+    if ((nameLower == BUILTIN_CHANI_M || nameLower == BUILTIN_UTJI_SUTI ||
+         nameLower == BUILTIN_APSU_SUTI) && argTypes.size() > 1 &&
+        argTypes[0].rfind("mapa", 0) == 0 && argTypes[1] == "jakhüwi") {
+        c.setIntKey(true);
+    }
     if (nameLower == BUILTIN_TO_STRING || nameLower == BUILTIN_CHUSA ||
         nameLower == BUILTIN_MAYACHTA || nameLower == BUILTIN_SIKTA ||
         nameLower == BUILTIN_ULLANA_ARU) {
@@ -70,8 +85,31 @@ void SemanticAnalyzer::visit(CallExpr &c) {
         currentType = "jakhüwi";
     } else if (nameLower == BUILTIN_UTJI || nameLower == BUILTIN_UTJIT || nameLower == BUILTIN_UTJI_SUTI) {
         currentType = "chiqa";
+    } else if (nameLower == BUILTIN_WAKICHA_CLAVE) {
+        // wakicha_clave(lista, &clave): la clave de cada elemento es numero o texto.
+        const FunctionRefExpr *key = c.getArgs().size() > 1
+                                         ? dynamic_cast<const FunctionRefExpr*>(c.getArgs()[1].get())
+                                         : nullptr;
+        if (!key) {
+            reportError("se esperaba una funcion para wakicha_clave");
+        } else {
+            auto fit = functions.find(key->getName());
+            auto rit = functionReturnTypes.find(key->getName());
+            if (fit == functions.end() || fit->second != 1) {
+                reportError("la funcion de clave de wakicha_clave debe recibir un parametro");
+            } else if (rit != functionReturnTypes.end() && rit->second != "jakhüwi" &&
+                       rit->second != "aru") {
+                reportError("la clave de wakicha_clave debe ser numero o texto");
+            }
+        }
+        if (!argTypes.empty() && argTypes[0].rfind("t'aqa:", 0) == 0) {
+            currentType = argTypes[0];
+        } else {
+            currentType = "t'aqa:jakhüwi";
+        }
     } else if (nameLower == BUILTIN_MAP || nameLower == BUILTIN_FILTER ||
                nameLower == BUILTIN_MAYJTAYA || nameLower == BUILTIN_AJLLI ||
+               nameLower == BUILTIN_MAP_PAR || nameLower == BUILTIN_FILTER_PAR ||
                nameLower == BUILTIN_WAKICHA || nameLower == BUILTIN_SAPAKI) {
         if (!c.getArgs().empty()) {
             c.getArgs()[0]->accept(*this);
@@ -84,7 +122,8 @@ void SemanticAnalyzer::visit(CallExpr &c) {
         } else {
             currentType = "t'aqa:jakhüwi";
         }
-    } else if (nameLower == BUILTIN_REDUCE || nameLower == BUILTIN_THAQTHAPI) {
+    } else if (nameLower == BUILTIN_REDUCE || nameLower == BUILTIN_THAQTHAPI ||
+               nameLower == BUILTIN_REDUCE_PAR) {
         if (c.getArgs().size() >= 3) {
             c.getArgs()[2]->accept(*this);
             // keep currentType from initial accumulator
@@ -144,6 +183,115 @@ void SemanticAnalyzer::visit(CallExpr &c) {
         } else {
             currentType = "t'aqa:jakhüwi";
         }
+    } else if (nameLower == BUILTIN_TAMA) {
+        currentType = "tama";
+        if (!c.getArgs().empty()) {
+            c.getArgs()[0]->accept(*this);
+            if (currentType.rfind("t'aqa:", 0) == 0) {
+                currentType = "tama:" + currentType.substr(6);
+            } else {
+                reportError("se esperaba una lista para tama");
+                currentType = "tama";
+            }
+        }
+    } else if (nameLower == BUILTIN_TAMA_YAPA || nameLower == BUILTIN_TAMA_UTJI ||
+               nameLower == BUILTIN_TAMA_APSU || nameLower == BUILTIN_TAMA_SUYU ||
+               nameLower == BUILTIN_TAMA_LISTA) {
+        std::string baseType;
+        if (!c.getArgs().empty()) {
+            c.getArgs()[0]->accept(*this);
+            baseType = currentType;
+            if (baseType != "tama" && baseType.rfind("tama:", 0) != 0) {
+                reportError("se esperaba un tama para " + c.getName());
+            }
+        }
+        // Un `tama` sin tipo de elemento (tama()) acepta textos o numeros.
+        std::string elementType = baseType.rfind("tama:", 0) == 0 ? baseType.substr(5) : "";
+        if (c.getArgs().size() > 1) {
+            c.getArgs()[1]->accept(*this);
+            if (!elementType.empty() && currentType != elementType) {
+                reportError("tipo incompatible en " + c.getName());
+            }
+        }
+        if (nameLower == BUILTIN_TAMA_SUYU) {
+            currentType = "jakhüwi";
+        } else if (nameLower == BUILTIN_TAMA_LISTA) {
+            currentType = "t'aqa:" + (elementType.empty() ? std::string("jakhüwi") : elementType);
+        } else {
+            currentType = "chiqa";
+        }
+    } else if (nameLower == BUILTIN_SIQI) {
+        // Como `[]`, una siqi() vacia guarda numeros.
+        currentType = "siqi:jakhüwi";
+        if (!argTypes.empty()) {
+            if (argTypes[0].rfind("t'aqa:", 0) == 0) {
+                currentType = "siqi:" + argTypes[0].substr(6);
+            } else {
+                reportError("se esperaba una lista para siqi");
+            }
+        }
+    } else if (nameLower == BUILTIN_QULLU) {
+        // qullu([lista][, &comparar]): el tipo del elemento sale de la lista o,
+        // si no hay, del primer parametro de la funcion de comparacion.
+        std::string elementType;
+        const FunctionRefExpr *cmp = nullptr;
+        for (size_t i = 0; i < c.getArgs().size(); ++i) {
+            if (auto *f = dynamic_cast<const FunctionRefExpr*>(c.getArgs()[i].get())) {
+                if (i + 1 != c.getArgs().size()) {
+                    reportError("la funcion de comparacion de qullu va al final");
+                }
+                cmp = f;
+            } else if (i == 0 && argTypes[0].rfind("t'aqa:", 0) == 0) {
+                elementType = argTypes[0].substr(6);
+            } else {
+                reportError("se esperaba una lista o una funcion para qullu");
+            }
+        }
+        if (cmp) {
+            auto fit = functions.find(cmp->getName());
+            if (fit == functions.end() || fit->second != 2) {
+                reportError("la funcion de comparacion de qullu debe recibir dos parametros");
+            } else {
+                auto rit = functionReturnTypes.find(cmp->getName());
+                if (rit != functionReturnTypes.end() && rit->second != "chiqa") {
+                    reportError("la funcion de comparacion de qullu debe devolver chiqa");
+                }
+                auto cpit = paramTypes.find(cmp->getName());
+                if (cpit != paramTypes.end() && !cpit->second.empty() && !cpit->second[0].empty()) {
+                    if (elementType.empty()) {
+                        elementType = cpit->second[0];
+                    } else if (cpit->second[0] != elementType) {
+                        reportError("tipo incompatible en la funcion de comparacion de qullu");
+                    }
+                }
+            }
+        }
+        currentType = "qullu:" + (elementType.empty() ? std::string("jakhüwi") : elementType);
+    } else if (nameLower == BUILTIN_SIQI_QHIPA || nameLower == BUILTIN_SIQI_NAYRA ||
+               nameLower == BUILTIN_SIQI_APSU_QHIPA || nameLower == BUILTIN_SIQI_APSU_NAYRA ||
+               nameLower == BUILTIN_SIQI_SUYU || nameLower == BUILTIN_SIQI_LISTA ||
+               nameLower == BUILTIN_QULLU_YAPA || nameLower == BUILTIN_QULLU_APSU ||
+               nameLower == BUILTIN_QULLU_PATA || nameLower == BUILTIN_QULLU_SUYU) {
+        const std::string prefix = nameLower.rfind("siqi", 0) == 0 ? "siqi:" : "qullu:";
+        std::string elementType = "jakhüwi";
+        if (!argTypes.empty()) {
+            if (argTypes[0].rfind(prefix, 0) == 0) {
+                elementType = argTypes[0].substr(prefix.size());
+            } else if (argTypes[0] + ":" != prefix) {
+                reportError("se esperaba un " + prefix.substr(0, prefix.size() - 1) + " para " + c.getName());
+            }
+        }
+        if (argTypes.size() > 1 && argTypes[1] != elementType) {
+            reportError("tipo incompatible en " + c.getName());
+        }
+        if (nameLower == BUILTIN_SIQI_LISTA) {
+            currentType = "t'aqa:" + elementType;
+        } else if (nameLower == BUILTIN_SIQI_APSU_QHIPA || nameLower == BUILTIN_SIQI_APSU_NAYRA ||
+                   nameLower == BUILTIN_QULLU_APSU || nameLower == BUILTIN_QULLU_PATA) {
+            currentType = elementType;
+        } else {
+            currentType = "jakhüwi";
+        }
     } else if (nameLower == BUILTIN_APSU || nameLower == BUILTIN_APSU_UKA) {
         if (!c.getArgs().empty()) {
             c.getArgs()[0]->accept(*this);
@@ -33,6 +33,9 @@ void SemanticAnalyzer::visit(IndexAssignStmt &a) {
     a.getBase()->accept(*this);
     std::string baseType = currentType;
     a.getIndex()->accept(*this);
+    if (baseType.rfind("mapa", 0) == 0) {
+        a.setIntKey(currentType == "jakhüwi");
+    }
     a.getValue()->accept(*this);
     std::string valueType = currentType;
     if (baseType.rfind("kasta-ref:", 0) == 0) {
@@ -63,6 +66,7 @@ void SemanticAnalyzer::visit(IndexAssignStmt &a) {
             if (field && !isTypeAssignable(valueType, field->type)) {
                 reportError("tipo incompatible en asignacion de atributo");
             }
+            a.setObjectClass(className);
         }
         currentType = valueType;
     } else if (baseType.rfind("t'aqa:", 0) == 0) {
@@ -103,6 +107,10 @@ void SemanticAnalyzer::visit(VarDeclStmt &v) {
             declaredType = "t'aqa:jakhüwi";
         }
     }
+    if ((declaredType == "tama" || declaredType == "siqi" || declaredType == "qullu") &&
+        t.rfind(declaredType + ":", 0) == 0) {
+        declaredType = t;
+    }
     if (declaredType == "mapa") {
         if (t.rfind("mapa:", 0) == 0) {
             declaredType = t;
@@ -21,8 +21,8 @@ inline std::string classStaticFieldName(const std::string &className, const std:
     return "__" + className + "_static_" + field;
 }
 
-inline std::string classSuperKey(const std::string &method) {
-    return "super::" + method;
+inline std::string classInfoName(const std::string &className) {
+    return "__" + className + "_class_info";
 }
 
 } // namespace aym
@@ -58,6 +58,7 @@ CliParseResult parseCompileOptions(int argc, char **argv, CompileOptions &option
         const std::string timePipelineJsonPrefix = "--time-pipeline-json=";
         const std::string toolTimeoutPrefix = "--tool-timeout-ms=";
         const std::string backendPrefix = "--backend=";
+        const std::string runtimeOptPrefix = "--runtime-opt=";
         const std::string checkManifestPrefix = "--check-manifest=";
         const std::string emitLockPrefix = "--emit-lock=";
         const std::string checkLockPrefix = "--check-lock=";
@@ -95,6 +96,30 @@ CliParseResult parseCompileOptions(int argc, char **argv, CompileOptions &option
             }
             continue;
         }
+        if (arg == "--runtime-opt") {
+            if (i + 1 >= argc) {
+                errorMsg = "La opcion --runtime-opt requiere un valor (O0|O2|O3).";
+                return CliParseResult::Error;
+            }
+            options.runtimeOpt = argv[++i];
+            continue;
+        }
+        if (arg.rfind(runtimeOptPrefix, 0) == 0) {
+            options.runtimeOpt = arg.substr(runtimeOptPrefix.size());
+            continue;
+        }
+        if (arg == "--gc-stats") {
+            options.gcStats = true;
+            continue;
+        }
+        if (arg == "--no-inline") {
+            options.noInline = true;
+            continue;
+        }
+        if (arg == "--inline-report") {
+            options.inlineReport = true;
+            continue;
+        }
         if (arg == "--debug") {
             options.debug = true;
             continue;
@@ -298,6 +323,11 @@ CliParseResult parseCompileOptions(int argc, char **argv, CompileOptions &option
         return CliParseResult::Error;
     }
 
+    if (options.runtimeOpt != "O0" && options.runtimeOpt != "O2" && options.runtimeOpt != "O3") {
+        errorMsg = "Perfil de runtime no soportado: " + options.runtimeOpt + ". Usa --runtime-opt O0, O2 u O3.";
+        return CliParseResult::Error;
+    }
+
     if (options.compileOnly && options.linkOnly) {
         errorMsg = "No se puede usar --compile-only y --link-only al mismo tiempo.";
         return CliParseResult::Error;
@@ -337,6 +367,10 @@ const char *compileHelpText() {
            "  -h, --help                   Muestra esta ayuda\n"
            "  -o <ruta>                    Define nombre/ruta del ejecutable\n"
            "  --backend <nombre>           Selecciona backend (native|ir)\n"
+           "  --runtime-opt <nivel>        Optimizacion del runtime C (O0|O2|O3, por defecto O2)\n"
+           "  --gc-stats                   El programa reporta recolecciones de basura al salir\n"
+           "  --no-inline                  No pone en linea llamadas a funciones chicas\n"
+           "  --inline-report              Lista las llamadas puestas en linea\n"
            "  --debug                      Imprime tokens en consola\n"
            "  --dump-ast                   Imprime total de nodos AST\n"
            "  --check                      Solo valida sintaxis/semantica (sin generar binario)\n"
@@ -367,6 +401,7 @@ const char *compileHelpText() {
            "  aymc --time-pipeline -o build/app programa.aym\n"
            "  aymc --time-pipeline-json -o build/app programa.aym\n"
            "  aymc --tool-timeout-ms 30000 -o build/app programa.aym\n"
+           "  aymc --runtime-opt O0 -o build/app programa.aym\n"
            "  aymc --check-manifest --emit-lock\n"
            "  aymc --check-manifest --check-lock\n";
 }
@@ -13,6 +13,10 @@ struct CompileOptions {
     std::vector<std::string> inputs;
     std::string output;
     std::string backend = "native";
+    std::string runtimeOpt = "O2";
+    bool gcStats = false;
+    bool noInline = false;
+    bool inlineReport = false;
     bool outputProvided = false;
     bool debug = false;
     bool dumpAst = false;
@@ -3,17 +3,18 @@
 #include <stdlib.h>
 #include <time.h>
 #include <stdint.h>
-#include <setjmp.h>
 #include <ctype.h>
 #include <sys/stat.h>
 #ifdef _WIN32
 #include <windows.h>
+#include <io.h>
 #else
 #include <unistd.h>
 #include <sys/time.h>
 #include <sys/select.h>
 #include <termios.h>
 #include <fcntl.h>
+#include <pthread.h>
 #endif
 
 intptr_t aym_exception_new(const char *type, const char *message);
@@ -22,6 +23,10 @@ intptr_t aym_array_new(long size);
 intptr_t aym_array_get(intptr_t arr, long idx);
 long aym_array_length(intptr_t arr);
 intptr_t aym_array_push(intptr_t arr, intptr_t val);
+intptr_t aym_set_new(void);
+long aym_set_add(intptr_t set, intptr_t value, long is_string);
+void aym_set_free(intptr_t set);
+char *aym_to_string(long value);
 long aym_gfx_set_color(long r, long g, long b);
 long aym_gfx_rect4(long x, long y, long w, long h);
 long aym_gfx_text3(const char *text, long x, long y);
@@ -36,29 +41,126 @@ long aym_linux_gfx_present(void);
 long aym_linux_gfx_close(void);
 long aym_linux_gfx_key_down(long key);
 #endif
+void aym_write_flush(void);
+
+#include "runtime_pool.c"
+
+#include "runtime_gc.c"
 
 static void aym_throw_typed(const char *type, const char *message) {
     intptr_t exc = aym_exception_new(type, message);
     aym_throw(exc);
 }
 
+/* Cabecera de los textos. Vive justo antes del primer caracter, asi que un
+ * texto sigue siendo un `char *` terminado en NUL (printf, fopen...). `len`
+ * queda en [s-8] porque el codigo generado lo lee en linea; `hash` es el de
+ * aym_str_hash o 0 si aun no se calculo; `cap` son los bytes reservados para
+ * caracteres sin contar el NUL. Todo texto que ve un programa tiene cabecera:
+ * literales del compilador, la arena, copias en el heap y AYM_STR_LITERAL. */
+typedef struct {
+    uint64_t hash;
+    size_t cap;
+    size_t len;
+} AymStrHeader;
+
+#define AYM_STR_HEADER(s) ((AymStrHeader *)(s) - 1)
+
+#define AYM_STR_LITERAL(name, text) \
+    static struct { AymStrHeader header; char data[sizeof(text)]; } name = \
+        {{0, sizeof(text) - 1, sizeof(text) - 1}, text}
+
+AYM_STR_LITERAL(aym_str_empty, "");
+
+static inline size_t aym_str_len(const char *s) {
+    return s ? AYM_STR_HEADER(s)->len : 0;
+}
+
+/* FNV-1a sobre los `len` bytes; el 0 queda reservado para "sin calcular".
+ * codegen_helpers.cpp calcula el mismo valor para los literales. */
+uint64_t aym_str_hash(const char *s) {
+    if (!s) s = aym_str_empty.data;
+    AymStrHeader *h = AYM_STR_HEADER(s);
+    if (h->hash) return h->hash;
+    uint64_t hash = 1469598103934665603ULL;
+    for (size_t i = 0; i < h->len; i++) {
+        hash ^= (unsigned char)s[i];
+        hash *= 1099511628211ULL;
+    }
+    if (!hash) hash = 1;
+    h->hash = hash;
+    return hash;
+}
+
+/* Mezcla final de MurmurHash3 (fmix64) para claves enteras: los enteros
+ * consecutivos quedan repartidos por toda la tabla. Tampoco devuelve 0. */
+static inline uint64_t aym_int_hash(intptr_t value) {
+    uint64_t x = (uint64_t)value;
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ULL;
+    x ^= x >> 33;
+    return x ? x : 1;
+}
+
+/* Igualdad sin recorrer: descarta por largo y por hash ya calculado antes de
+ * comparar bytes. Un texto nulo equivale a "". */
+long aym_str_eq(const char *left, const char *right) {
+    if (left == right) return 1;
+    size_t len = aym_str_len(left);
+    if (len != aym_str_len(right)) return 0;
+    if (!len) return 1;
+    uint64_t lh = AYM_STR_HEADER(left)->hash;
+    uint64_t rh = AYM_STR_HEADER(right)->hash;
+    if (lh && rh && lh != rh) return 0;
+    return memcmp(left, right, len) == 0;
+}
+
 char *aym_str_concat(const char *left, const char *right);
+char *aym_str_alloc(size_t len);
 
 static char *aym_str_copy(const char *src, size_t len) {
-    char *out = (char *)malloc(len + 1);
+    char *out = aym_str_alloc(len);
     if (!out) return NULL;
     if (len && src) {
         memcpy(out, src, len);
     }
+    return out;
+}
+
+/* Texto con cabecera fuera de la arena para lo que debe sobrevivir a las
+ * regiones temporales (argumentos, excepciones, archivos leidos). Lo libera
+ * el recolector. */
+static char *aym_str_heap(size_t len) {
+    AymStrHeader *h = (AymStrHeader *)aym_gc_alloc(sizeof(AymStrHeader) + len + 1, AYM_GC_TEXT);
+    if (!h) return NULL;
+    h->hash = 0;
+    h->cap = len;
+    h->len = len;
+    char *out = (char *)(h + 1);
     out[len] = '\0';
     return out;
 }
 
+static char *aym_str_heap_copy(const char *src) {
+    size_t len = src ? strlen(src) : 0;
+    char *out = aym_str_heap(len);
+    if (out && len) memcpy(out, src, len);
+    return out;
+}
+
+/* Copia a la arena un texto C sin cabecera (p. ej. el buffer de katu). */
+char *aym_str_from_c(const char *text) {
+    return aym_str_copy(text, text ? strlen(text) : 0);
+}
+
 static int aym_is_word_char(char ch) {
     return isalnum((unsigned char)ch) || ch == '_';
 }
 
 void leer_linea(char *buf, int size) {
+    aym_write_flush();
     if (fgets(buf, size, stdin)) {
         size_t len = strlen(buf);
         if (len && buf[len-1] == '\n') buf[len-1] = '\0';
@@ -83,6 +185,7 @@ int aym_random(int max) {
 }
 
 void aym_sleep(int ms) {
+    aym_write_flush();
     if (ms <= 0) return;
 #ifdef _WIN32
     Sleep(ms);
@@ -95,8 +198,14 @@ static long aym_cli_argc = 0;
 static const char **aym_cli_argv = NULL;
 
 void aym_set_args(long argc, const char **argv) {
+    aym_cli_argc = 0;
+    size_t count = argc > 0 ? (size_t)argc : 1;
+    aym_cli_argv = (const char **)aym_gc_alloc(count * sizeof(char *), AYM_GC_RAW);
+    if (!aym_cli_argv) return;
+    for (long i = 0; i < argc; i++) {
+        aym_cli_argv[i] = argv[i] ? aym_str_heap_copy(argv[i]) : NULL;
+    }
     aym_cli_argc = argc;
-    aym_cli_argv = argv;
 }
 
 long aym_argc(void) {
@@ -104,9 +213,9 @@ long aym_argc(void) {
 }
 
 const char *aym_argv_get(long idx) {
-    if (!aym_cli_argv) return "";
-    if (idx < 0 || idx >= aym_cli_argc) return "";
-    if (!aym_cli_argv[idx]) return "";
+    if (!aym_cli_argv) return aym_str_empty.data;
+    if (idx < 0 || idx >= aym_cli_argc) return aym_str_empty.data;
+    if (!aym_cli_argv[idx]) return aym_str_empty.data;
     return aym_cli_argv[idx];
 }
 
@@ -125,45 +234,6 @@ long aym_assert(long cond, const char *message) {
 typedef intptr_t (*AymUnaryFn)(intptr_t);
 typedef intptr_t (*AymBinaryFn)(intptr_t, intptr_t);
 
-intptr_t aym_hof_map(intptr_t arr, intptr_t fn_ptr) {
-    if (!arr || !fn_ptr) return aym_array_new(0);
-    long len = aym_array_length(arr);
-    intptr_t out = aym_array_new(0);
-    AymUnaryFn fn = (AymUnaryFn)fn_ptr;
-    for (long i = 0; i < len; i++) {
-        intptr_t v = aym_array_get(arr, i);
-        intptr_t mapped = fn(v);
-        aym_array_push(out, mapped);
-    }
-    return out;
-}
-
-intptr_t aym_hof_filter(intptr_t arr, intptr_t fn_ptr) {
-    if (!arr || !fn_ptr) return aym_array_new(0);
-    long len = aym_array_length(arr);
-    intptr_t out = aym_array_new(0);
-    AymUnaryFn fn = (AymUnaryFn)fn_ptr;
-    for (long i = 0; i < len; i++) {
-        intptr_t v = aym_array_get(arr, i);
-        if (fn(v)) {
-            aym_array_push(out, v);
-        }
-    }
-    return out;
-}
-
-intptr_t aym_hof_reduce(intptr_t arr, intptr_t fn_ptr, intptr_t init) {
-    if (!arr || !fn_ptr) return init;
-    long len = aym_array_length(arr);
-    intptr_t acc = init;
-    AymBinaryFn fn = (AymBinaryFn)fn_ptr;
-    for (long i = 0; i < len; i++) {
-        intptr_t v = aym_array_get(arr, i);
-        acc = fn(acc, v);
-    }
-    return acc;
-}
-
 char *aym_fs_read_text(const char *path) {
     if (!path || !path[0]) return aym_str_copy("", 0);
     FILE *f = fopen(path, "rb");
@@ -178,7 +248,7 @@ char *aym_fs_read_text(const char *path) {
         return aym_str_copy("", 0);
     }
     rewind(f);
-    char *buf = (char *)malloc((size_t)size + 1);
+    char *buf = aym_str_heap((size_t)size);
     if (!buf) {
         fclose(f);
         return aym_str_copy("", 0);
@@ -186,6 +256,7 @@ char *aym_fs_read_text(const char *path) {
     size_t n = fread(buf, 1, (size_t)size, f);
     fclose(f);
     buf[n] = '\0';
+    AYM_STR_HEADER(buf)->len = n;
     return buf;
 }
 
@@ -193,9 +264,8 @@ long aym_fs_write_text(const char *path, const char *text) {
     if (!path || !path[0]) return 0;
     FILE *f = fopen(path, "wb");
     if (!f) return 0;
-    if (!text) text = "";
-    size_t len = strlen(text);
-    size_t written = fwrite(text, 1, len, f);
+    size_t len = aym_str_len(text);
+    size_t written = len ? fwrite(text, 1, len, f) : 0;
     fclose(f);
     return (written == len) ? 1 : 0;
 }
@@ -255,6 +325,7 @@ static void aym_term_restore(void) {
 
 void aym_term_clear(void) {
     aym_term_init();
+    aym_write_flush();
     printf("\x1b[2J\x1b[H");
     fflush(stdout);
 }
@@ -263,6 +334,7 @@ void aym_term_move(long x, long y) {
     aym_term_init();
     if (x < 1) x = 1;
     if (y < 1) y = 1;
+    aym_write_flush();
     printf("\x1b[%ld;%ldH", y, x);
     fflush(stdout);
 }
@@ -275,18 +347,21 @@ void aym_term_color(long fg, long bg) {
     if (bg > 15) bg = 15;
     long fgCode = (fg < 8) ? (30 + fg) : (90 + (fg - 8));
     long bgCode = (bg < 8) ? (40 + bg) : (100 + (bg - 8));
+    aym_write_flush();
     printf("\x1b[%ld;%ldm", fgCode, bgCode);
     fflush(stdout);
 }
 
 void aym_term_reset(void) {
     aym_term_init();
+    aym_write_flush();
     printf("\x1b[0m");
     fflush(stdout);
 }
 
 void aym_term_cursor(long visible) {
     aym_term_init();
+    aym_write_flush();
     printf(visible ? "\x1b[?25h" : "\x1b[?25l");
     fflush(stdout);
 }
@@ -314,6 +389,7 @@ static long aym_key_ascii(void) {
 
 long aym_key_poll(void) {
     aym_term_init();
+    aym_write_flush();
 #ifdef _WIN32
     if (aym_key_down(VK_LEFT)) return 1003;
     if (aym_key_down(VK_RIGHT)) return 1004;
@@ -352,13 +428,13 @@ long aym_time_ms(void) {
 #endif
 }
 
+#ifdef _WIN32
 static long aym_color_clip(long value) {
     if (value < 0) return 0;
     if (value > 255) return 255;
     return value;
 }
 
-#ifdef _WIN32
 static HWND aym_gfx_hwnd = NULL;
 static HDC aym_gfx_window_dc = NULL;
 static HDC aym_gfx_mem_dc = NULL;
@@ -826,25 +902,18 @@ char *aym_file_read_text(const char *path) {
         buf[len++] = (char)ch;
     }
     fclose(f);
-    if (len + 1 >= cap) {
-        char *next = (char *)realloc(buf, len + 1);
-        if (!next) {
-            free(buf);
-            return aym_str_copy("", 0);
-        }
-        buf = next;
-    }
-    buf[len] = '\0';
-    return buf;
+    char *out = aym_str_heap(len);
+    if (out) memcpy(out, buf, len);
+    free(buf);
+    return out;
 }
 
 long aym_file_write_text(const char *path, const char *text) {
     if (!path || path[0] == '\0') return 0;
     FILE *f = fopen(path, "wb");
     if (!f) return 0;
-    if (!text) text = "";
-    size_t len = strlen(text);
-    size_t written = fwrite(text, 1, len, f);
+    size_t len = aym_str_len(text);
+    size_t written = len ? fwrite(text, 1, len, f) : 0;
     fclose(f);
     return (written == len) ? 1 : 0;
 }
@@ -868,6 +937,18 @@ long aym_record_save(long value) {
 
 #include "runtime_arrays.c"
 
+#include "runtime_sort.c"
+
+#include "runtime_hof.c"
+
 #include "runtime_maps_strings.c"
 
+#include "runtime_sets.c"
+
+#include "runtime_queues.c"
+
+#include "runtime_output.c"
+
+#include "runtime_objects.c"
+
 #include "runtime_exceptions.c"
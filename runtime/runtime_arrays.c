@@ -6,7 +6,7 @@ typedef struct {
 
 intptr_t aym_array_new(long size) {
     if (size < 0) return 0;
-    AymArray *arr = calloc(1, sizeof(AymArray));
+    AymArray *arr = aym_gc_alloc(sizeof(AymArray), AYM_GC_ARRAY);
     if (!arr) {
         fprintf(stderr, "aym_array_new: allocation failed\n");
         return 0;
@@ -17,9 +17,10 @@ intptr_t aym_array_new(long size) {
         arr->data = calloc((size_t)size, sizeof(intptr_t));
         if (!arr->data) {
             fprintf(stderr, "aym_array_new: allocation failed\n");
-            free(arr);
+            aym_gc_release(arr);
             return 0;
         }
+        aym_gc_note(sizeof(intptr_t) * (size_t)size);
     }
     return (intptr_t)arr;
 }
@@ -51,7 +52,18 @@ void aym_array_free(intptr_t arr) {
     if (!arr) return;
     AymArray *a = (AymArray*)arr;
     free(a->data);
-    free(a);
+    aym_gc_release(a);
+}
+
+static void aym_array_gc_visit(void *body, AymGcVisitFn visit, void *ctx) {
+    AymArray *a = (AymArray*)body;
+    visit(ctx, a->data, sizeof(intptr_t) * (size_t)a->cap);
+}
+
+static size_t aym_array_gc_free(void *body) {
+    AymArray *a = (AymArray*)body;
+    free(a->data);
+    return sizeof(intptr_t) * (size_t)a->cap;
 }
 
 long aym_array_length(intptr_t arr) {
@@ -70,6 +82,7 @@ intptr_t aym_array_push(intptr_t arr, intptr_t val) {
             fprintf(stderr, "aym_array_push: allocation failed\n");
             return arr;
         }
+        aym_gc_note(sizeof(intptr_t) * (size_t)(newCap - a->cap));
         a->data = next;
         a->cap = newCap;
     }
@@ -126,7 +139,7 @@ long aym_array_contains_str(intptr_t arr, const char *value) {
         const char *item = (const char *)a->data[i];
         if (!item && !value) return 1;
         if (!item || !value) continue;
-        if (strcmp(item, value) == 0) return 1;
+        if (aym_str_eq(item, value)) return 1;
     }
     return 0;
 }
@@ -147,85 +160,33 @@ long aym_array_find_str(intptr_t arr, const char *value) {
         const char *item = (const char *)a->data[i];
         if (!item && !value) return i;
         if (!item || !value) continue;
-        if (strcmp(item, value) == 0) return i;
+        if (aym_str_eq(item, value)) return i;
     }
     return -1;
 }
 
-static int aym_cmp_intptr(const void *left, const void *right) {
-    intptr_t a = *(const intptr_t *)left;
-    intptr_t b = *(const intptr_t *)right;
-    if (a < b) return -1;
-    if (a > b) return 1;
-    return 0;
-}
-
-static int aym_cmp_cstr_ptr(const void *left, const void *right) {
-    const char *a = (const char *)(*(const intptr_t *)left);
-    const char *b = (const char *)(*(const intptr_t *)right);
-    if (!a && !b) return 0;
-    if (!a) return -1;
-    if (!b) return 1;
-    return strcmp(a, b);
-}
-
-intptr_t aym_array_sort_int(intptr_t arr) {
-    if (!arr) return aym_array_new(0);
-    AymArray *a = (AymArray*)arr;
-    intptr_t out = aym_array_new(a->len);
-    if (!out) return 0;
-    AymArray *dst = (AymArray*)out;
-    for (long i = 0; i < a->len; i++) {
-        dst->data[i] = a->data[i];
-    }
-    if (dst->len > 1) {
-        qsort(dst->data, (size_t)dst->len, sizeof(intptr_t), aym_cmp_intptr);
-    }
-    return out;
-}
-
-intptr_t aym_array_sort_str(intptr_t arr) {
+/* Un conjunto auxiliar recuerda lo ya visto: O(n) esperado en vez de volver
+ * a recorrer la salida por cada elemento. Se conserva la primera aparicion. */
+static intptr_t aym_array_unique(intptr_t arr, long is_string) {
     if (!arr) return aym_array_new(0);
     AymArray *a = (AymArray*)arr;
-    intptr_t out = aym_array_new(a->len);
+    intptr_t out = aym_array_new(0);
     if (!out) return 0;
-    AymArray *dst = (AymArray*)out;
+    intptr_t seen = aym_set_new();
+    if (!seen) return out;
     for (long i = 0; i < a->len; i++) {
-        dst->data[i] = a->data[i];
-    }
-    if (dst->len > 1) {
-        qsort(dst->data, (size_t)dst->len, sizeof(intptr_t), aym_cmp_cstr_ptr);
+        if (aym_set_add(seen, a->data[i], is_string)) {
+            if (!aym_array_push(out, a->data[i])) break;
+        }
     }
+    aym_set_free(seen);
     return out;
 }
 
 intptr_t aym_array_unique_int(intptr_t arr) {
-    if (!arr) return aym_array_new(0);
-    AymArray *a = (AymArray*)arr;
-    intptr_t out = aym_array_new(0);
-    if (!out) return 0;
-    for (long i = 0; i < a->len; i++) {
-        if (!aym_array_contains_int(out, a->data[i])) {
-            if (!aym_array_push(out, a->data[i])) {
-                return out;
-            }
-        }
-    }
-    return out;
+    return aym_array_unique(arr, 0);
 }
 
 intptr_t aym_array_unique_str(intptr_t arr) {
-    if (!arr) return aym_array_new(0);
-    AymArray *a = (AymArray*)arr;
-    intptr_t out = aym_array_new(0);
-    if (!out) return 0;
-    for (long i = 0; i < a->len; i++) {
-        const char *value = (const char *)a->data[i];
-        if (!aym_array_contains_str(out, value)) {
-            if (!aym_array_push(out, (intptr_t)value)) {
-                return out;
-            }
-        }
-    }
-    return out;
+    return aym_array_unique(arr, 1);
 }
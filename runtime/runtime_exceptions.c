@@ -3,72 +3,85 @@ typedef struct {
     const char *message;
 } AymException;
 
+/* Marco de un bloque yantana. Lo reserva el codigo generado en la pila de la
+ * funcion (o en .bss para el programa principal) y lo llena al entrar al
+ * bloque con unos pocos mov: enlace al marco anterior, direccion del catch y
+ * los registros que el compilador necesita intactos al volver. Entrar y
+ * salir del bloque no llama al runtime; solo aym_throw lee el marco. Los
+ * desplazamientos deben coincidir con los de codegen_stmt_exception.cpp. */
 typedef struct AymHandler {
-    jmp_buf env;
-    struct AymHandler *prev;
-    AymException *exception;
+    struct AymHandler *prev;   /* 0 */
+    void *resume;              /* 8 */
+    intptr_t rsp;              /* 16 */
+    intptr_t rbp;              /* 24 */
+    intptr_t rbx;              /* 32 */
+    intptr_t r12;              /* 40 */
+    intptr_t r13;              /* 48 */
+    intptr_t r14;              /* 56 */
+    intptr_t r15;              /* 64 */
+    AymException *exception;   /* 72 */
+    intptr_t rdi;              /* 80, solo Win64 */
+    intptr_t rsi;              /* 88, solo Win64 */
 } AymHandler;
 
-static AymHandler *current_handler = NULL;
+AymHandler *aym_handler_top = NULL;
 
+/* Tipo y mensaje se copian al heap con cabecera: el runtime lanza con
+ * literales de C y un texto de la arena podria liberarse antes del catch. */
 intptr_t aym_exception_new(const char *type, const char *message) {
-    AymException *exc = (AymException*)calloc(1, sizeof(AymException));
+    AymException *exc = (AymException*)aym_gc_alloc(sizeof(AymException), AYM_GC_RAW);
     if (!exc) return 0;
-    exc->type = type ? type : "Error";
-    exc->message = message ? message : "";
+    exc->type = aym_str_heap_copy(type ? type : "Error");
+    exc->message = aym_str_heap_copy(message);
     return (intptr_t)exc;
 }
 
 const char *aym_exception_type(intptr_t exc) {
-    if (!exc) return "";
+    if (!exc) return aym_str_empty.data;
     return ((AymException*)exc)->type;
 }
 
 const char *aym_exception_message(intptr_t exc) {
-    if (!exc) return "";
+    if (!exc) return aym_str_empty.data;
     return ((AymException*)exc)->message;
 }
 
-intptr_t aym_try_push(void) {
-    AymHandler *handler = (AymHandler*)calloc(1, sizeof(AymHandler));
-    if (!handler) return 0;
-    handler->prev = current_handler;
-    current_handler = handler;
-    return (intptr_t)handler;
-}
+/* Vuelve al catch del marco: restaura los registros guardados, la pila y
+ * salta a `resume`. Los marcos C intermedios se descartan como con longjmp. */
+#ifdef _WIN32
+#define AYM_RESUME_WIN64_REGS "mov 80(%%rax), %%rdi\n\t" "mov 88(%%rax), %%rsi\n\t"
+#else
+#define AYM_RESUME_WIN64_REGS ""
+#endif
 
-void aym_try_pop(intptr_t handler) {
-    if (!handler) return;
-    AymHandler *h = (AymHandler*)handler;
-    if (current_handler == h) {
-        current_handler = h->prev;
-    }
-    free(h);
-}
-
-int aym_try_enter(intptr_t handler) {
-    if (!handler) return 0;
-    AymHandler *h = (AymHandler*)handler;
-    return setjmp(h->env);
-}
-
-intptr_t aym_try_get_exception(intptr_t handler) {
-    if (!handler) return 0;
-    AymHandler *h = (AymHandler*)handler;
-    return (intptr_t)h->exception;
-}
-
-intptr_t aym_try_env(intptr_t handler) {
-    if (!handler) return 0;
-    AymHandler *h = (AymHandler*)handler;
-    return (intptr_t)h->env;
+__attribute__((noreturn)) static void aym_handler_resume(AymHandler *h) {
+    __asm__ volatile(
+        AYM_RESUME_WIN64_REGS
+        "mov 32(%%rax), %%rbx\n\t"
+        "mov 40(%%rax), %%r12\n\t"
+        "mov 48(%%rax), %%r13\n\t"
+        "mov 56(%%rax), %%r14\n\t"
+        "mov 64(%%rax), %%r15\n\t"
+        "mov 24(%%rax), %%rbp\n\t"
+        "mov 16(%%rax), %%rsp\n\t"
+        "jmp *8(%%rax)\n\t"
+        : : "a"(h) : "memory");
+    __builtin_unreachable();
 }
 
 void aym_throw(intptr_t exception) {
-    if (!current_handler) {
+    /* Dentro de un trozo del pool los marcos de yantana son de otra pila: el
+     * pool guarda la excepcion y la relanza el hilo que llamo. */
+    if (aym_pool_catch) {
+        aym_pool_thrown = exception;
+        __builtin_longjmp(aym_pool_catch, 1);
+    }
+    AymHandler *h = aym_handler_top;
+    if (!h) {
         fprintf(stderr, "Excepcion no manejada\n");
         exit(1);
     }
-    current_handler->exception = (AymException*)exception;
-    longjmp(current_handler->env, 1);
+    h->exception = (AymException*)exception;
+    aym_handler_top = h->prev;
+    aym_handler_resume(h);
 }
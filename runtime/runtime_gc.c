@@ -0,0 +1,465 @@
+/* Recolector de basura del runtime: marcar y barrer, conservador.
+ *
+ * Listas, mapas, conjuntos, colas, objetos, excepciones y textos del heap se
+ * reservan con aym_gc_alloc, que les antepone un AymGcBlock enlazado en una
+ * lista. El codigo generado no deja mapas de punteros, asi que las raices se
+ * buscan palabra por palabra: la pila del hilo principal (con los registros
+ * que guarda el propio recolector) y las secciones .data/.bss del programa,
+ * donde estan las globales, los marcos yantana de main y aym_handler_top.
+ * Desde cada bloque alcanzado se recorren su cuerpo y los buffers que posee
+ * (datos de la lista, claves y valores del mapa...). Una palabra que cae
+ * dentro de cualquiera de esos rangos mantiene vivo el bloque aunque apunte
+ * al medio.
+ *
+ * Los bloques de la arena de textos anteriores al que esta en uso tambien se
+ * liberan cuando nada apunta dentro de ellos. Las arenas de los hilos del
+ * pool no se tocan.
+ *
+ * Los bloques chicos salen de losas por clase de tamano (ver
+ * aym_gc_slab_take) en vez de un calloc cada uno.
+ *
+ * aym_gc_alloc recolecta cuando lo reservado desde la vez anterior pasa el
+ * umbral (AYM_GC_MIN_BYTES o lo que quedo vivo, lo que sea mayor), nunca
+ * durante un trabajo del pool. AYM_GC=0 apaga la recoleccion y
+ * AYM_GC_UMBRAL=<bytes> cambia ese minimo (las pruebas lo bajan para
+ * recolectar seguido). Con
+ * `aymc --gc-stats` el programa imprime al salir cuantas hubo, las pausas y
+ * los bytes liberados. */
+
+#define AYM_GC_MIN_BYTES (8u * 1024u * 1024u)
+
+/* Tipos de bloque. El cuerpo de AYM_GC_RAW se recorre entero buscando
+ * punteros; el de AYM_GC_TEXT no tiene ninguno. Los demas ademas poseen
+ * buffers que libera su modulo. */
+#define AYM_GC_RAW 0
+#define AYM_GC_TEXT 1
+#define AYM_GC_ARRAY 2
+#define AYM_GC_MAP 3
+#define AYM_GC_SET 4
+#define AYM_GC_DEQUE 5
+#define AYM_GC_HEAP 6
+
+/* Losas: un malloc de AYM_GC_SLAB_BYTES partido en ranuras iguales de una
+ * clase (multiplos de AYM_GC_CLASS_STEP hasta AYM_GC_SLAB_MAX, cabecera
+ * incluida). */
+#define AYM_GC_SLAB_BYTES (64 * 1024)
+#define AYM_GC_CLASS_STEP 16
+#define AYM_GC_SLAB_MAX 256
+#define AYM_GC_CLASSES (AYM_GC_SLAB_MAX / AYM_GC_CLASS_STEP)
+
+typedef struct AymGcBlock {
+    struct AymGcBlock *prev;
+    struct AymGcBlock *next;
+    size_t size;
+    unsigned char kind;
+    unsigned char mark;
+    unsigned char slab; /* clase + 1, o 0 si es un calloc propio */
+} AymGcBlock;
+
+typedef void (*AymGcVisitFn)(void *ctx, const void *start, size_t bytes);
+
+/* Cada modulo entrega los buffers con punteros de su tipo y libera los que
+ * posee; la arena de textos expone sus bloques llenos. */
+static void aym_array_gc_visit(void *body, AymGcVisitFn visit, void *ctx);
+static size_t aym_array_gc_free(void *body);
+static void aym_map_gc_visit(void *body, AymGcVisitFn visit, void *ctx);
+static size_t aym_map_gc_free(void *body);
+static void aym_set_gc_visit(void *body, AymGcVisitFn visit, void *ctx);
+static size_t aym_set_gc_free(void *body);
+static void aym_deque_gc_visit(void *body, AymGcVisitFn visit, void *ctx);
+static size_t aym_deque_gc_free(void *body);
+static void aym_heap_gc_visit(void *body, AymGcVisitFn visit, void *ctx);
+static size_t aym_heap_gc_free(void *body);
+typedef void (*AymGcChunkFn)(void *ctx, void *chunk, const char *data, size_t cap);
+static void aym_str_gc_chunks(AymGcChunkFn fn, void *ctx);
+static size_t aym_str_gc_drop(void *chunk);
+
+/* Rango de memoria de un bloque o de un bloque de la arena (`chunk`). */
+typedef struct {
+    uintptr_t lo;
+    uintptr_t hi;
+    AymGcBlock *block;
+    void *chunk;
+    unsigned char marked;
+} AymGcRange;
+
+static struct {
+    AymGcBlock *blocks;
+    size_t pending;
+    size_t threshold;
+    size_t min_bytes;
+    size_t live;
+    int state; /* 0 sin leer AYM_GC, 1 activo, -1 apagado */
+    int collecting;
+    int overflow;
+    AymGcRange *ranges;
+    size_t range_count;
+    size_t range_cap;
+    AymGcBlock **stack;
+    size_t stack_len;
+    size_t stack_cap;
+    uintptr_t min;
+    uintptr_t max;
+    long collections;
+    uint64_t pause_total_us;
+    uint64_t pause_max_us;
+    uint64_t freed_bytes;
+    uint64_t freed_blocks;
+    void *slab_free[AYM_GC_CLASSES];
+} aym_gc = {.threshold = AYM_GC_MIN_BYTES, .min_bytes = AYM_GC_MIN_BYTES};
+
+#ifdef _WIN32
+extern char __data_start__[], __data_end__[], __bss_start__[], __bss_end__[];
+#else
+extern char __data_start[], _end[];
+extern void *__libc_stack_end;
+#endif
+
+static uint64_t aym_gc_now_us(void) {
+#ifdef _WIN32
+    LARGE_INTEGER freq, now;
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&now);
+    return (uint64_t)(now.QuadPart * 1000000 / freq.QuadPart);
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000u + (uint64_t)ts.tv_nsec / 1000u;
+#endif
+}
+
+void aym_gc_collect(void);
+
+/* Ranura en cero para un bloque de `total` bytes. Las libres de cada clase
+ * forman una lista enlazada por su primera palabra; una losa nueva se parte
+ * entera al entrar. Las losas no se devuelven al sistema. */
+static AymGcBlock *aym_gc_slab_take(size_t total) {
+    size_t cls = (total + AYM_GC_CLASS_STEP - 1) / AYM_GC_CLASS_STEP - 1;
+    size_t slot = (cls + 1) * AYM_GC_CLASS_STEP;
+    char *p = (char *)aym_gc.slab_free[cls];
+    if (!p) {
+        char *slab = (char *)malloc(AYM_GC_SLAB_BYTES);
+        if (!slab) return NULL;
+        for (size_t i = AYM_GC_SLAB_BYTES / slot; i-- > 0;) {
+            *(char **)(slab + i * slot) = p;
+            p = slab + i * slot;
+        }
+    }
+    aym_gc.slab_free[cls] = *(char **)p;
+    memset(p, 0, total);
+    AymGcBlock *b = (AymGcBlock *)p;
+    b->slab = (unsigned char)(cls + 1);
+    return b;
+}
+
+static void aym_gc_block_free(AymGcBlock *b) {
+    if (!b->slab) {
+        free(b);
+        return;
+    }
+    size_t cls = (size_t)b->slab - 1;
+    *(void **)b = aym_gc.slab_free[cls];
+    aym_gc.slab_free[cls] = b;
+}
+
+/* Lee AYM_GC y AYM_GC_UMBRAL la primera vez que se reserva o recolecta. */
+static void aym_gc_config(void) {
+    const char *env = getenv("AYM_GC");
+    aym_gc.state = env && strcmp(env, "0") == 0 ? -1 : 1;
+    const char *min = getenv("AYM_GC_UMBRAL");
+    if (min && *min) {
+        unsigned long long bytes = strtoull(min, NULL, 10);
+        if (bytes > 0) aym_gc.min_bytes = (size_t)bytes;
+    }
+    aym_gc.threshold = aym_gc.min_bytes;
+}
+
+/* Los hilos del pool solo reservan bloques al lanzar; la lista y las losas
+ * se protegen con el candado del pool mientras hay un trabajo en curso. */
+static void *aym_gc_alloc(size_t size, int kind) {
+    if (aym_gc.state == 0 && !aym_pool_inside) aym_gc_config();
+    if (aym_gc.pending >= aym_gc.threshold && !aym_pool_inside) aym_gc_collect();
+    size_t total = sizeof(AymGcBlock) + size;
+    int locked = aym_pool_inside;
+    if (locked) aym_lock(&aym_pool.lock);
+    AymGcBlock *b = total <= AYM_GC_SLAB_MAX ? aym_gc_slab_take(total)
+                                             : (AymGcBlock *)calloc(1, total);
+    if (b) {
+        b->size = size;
+        b->kind = (unsigned char)kind;
+        b->next = aym_gc.blocks;
+        if (aym_gc.blocks) aym_gc.blocks->prev = b;
+        aym_gc.blocks = b;
+        aym_gc.pending += size;
+    }
+    if (locked) aym_unlock(&aym_pool.lock);
+    return b ? b + 1 : NULL;
+}
+
+/* Suelta un bloque que su modulo ya vacio (aym_array_free y compania). */
+static void aym_gc_release(void *body) {
+    if (!body) return;
+    AymGcBlock *b = (AymGcBlock *)body - 1;
+    int locked = aym_pool_inside;
+    if (locked) aym_lock(&aym_pool.lock);
+    if (b->prev) b->prev->next = b->next;
+    else aym_gc.blocks = b->next;
+    if (b->next) b->next->prev = b->prev;
+    aym_gc_block_free(b);
+    if (locked) aym_unlock(&aym_pool.lock);
+}
+
+/* Memoria que crecio fuera de aym_gc_alloc (buffers, arena) y cuenta para
+ * el umbral. Lo que reservan los hilos del pool no se cuenta. */
+static void aym_gc_note(size_t bytes) {
+    if (!aym_pool_inside) aym_gc.pending += bytes;
+}
+
+static void aym_gc_add_range(uintptr_t lo, uintptr_t hi, AymGcBlock *block, void *chunk) {
+    if (lo >= hi) return;
+    if (aym_gc.range_count == aym_gc.range_cap) {
+        size_t cap = aym_gc.range_cap ? aym_gc.range_cap * 2 : 1024;
+        AymGcRange *ranges = (AymGcRange *)realloc(aym_gc.ranges, sizeof(AymGcRange) * cap);
+        if (!ranges) {
+            aym_gc.overflow = 1;
+            return;
+        }
+        aym_gc.ranges = ranges;
+        aym_gc.range_cap = cap;
+    }
+    AymGcRange *r = &aym_gc.ranges[aym_gc.range_count++];
+    r->lo = lo;
+    r->hi = hi;
+    r->block = block;
+    r->chunk = chunk;
+    r->marked = 0;
+}
+
+static void aym_gc_add_block_range(void *ctx, const void *start, size_t bytes) {
+    if (!start) return;
+    uintptr_t lo = (uintptr_t)start;
+    aym_gc_add_range(lo, lo + bytes, (AymGcBlock *)ctx, NULL);
+}
+
+static void aym_gc_count_range(void *ctx, const void *start, size_t bytes) {
+    (void)ctx;
+    if (start) aym_gc.live += bytes;
+}
+
+/* Un puntero justo al final de un bloque de la arena es una marca de
+ * aym_str_scratch_mark y tambien lo mantiene. */
+static void aym_gc_add_chunk_range(void *ctx, void *chunk, const char *data, size_t cap) {
+    (void)ctx;
+    aym_gc_add_range((uintptr_t)data, (uintptr_t)data + cap + 1, NULL, chunk);
+}
+
+/* Buffers que posee el bloque, ademas de su cuerpo. */
+static void aym_gc_visit_owned(AymGcBlock *b, AymGcVisitFn visit, void *ctx) {
+    void *body = b + 1;
+    switch (b->kind) {
+    case AYM_GC_ARRAY: aym_array_gc_visit(body, visit, ctx); break;
+    case AYM_GC_MAP: aym_map_gc_visit(body, visit, ctx); break;
+    case AYM_GC_SET: aym_set_gc_visit(body, visit, ctx); break;
+    case AYM_GC_DEQUE: aym_deque_gc_visit(body, visit, ctx); break;
+    case AYM_GC_HEAP: aym_heap_gc_visit(body, visit, ctx); break;
+    default: break;
+    }
+}
+
+static size_t aym_gc_free_block(AymGcBlock *b) {
+    void *body = b + 1;
+    size_t bytes = b->size;
+    switch (b->kind) {
+    case AYM_GC_ARRAY: bytes += aym_array_gc_free(body); break;
+    case AYM_GC_MAP: bytes += aym_map_gc_free(body); break;
+    case AYM_GC_SET: bytes += aym_set_gc_free(body); break;
+    case AYM_GC_DEQUE: bytes += aym_deque_gc_free(body); break;
+    case AYM_GC_HEAP: bytes += aym_heap_gc_free(body); break;
+    default: break;
+    }
+    aym_gc_block_free(b);
+    return bytes;
+}
+
+static int aym_gc_range_cmp(const void *a, const void *b) {
+    uintptr_t x = ((const AymGcRange *)a)->lo;
+    uintptr_t y = ((const AymGcRange *)b)->lo;
+    return x < y ? -1 : x > y;
+}
+
+static AymGcRange *aym_gc_find(uintptr_t p) {
+    if (p < aym_gc.min || p >= aym_gc.max) return NULL;
+    size_t lo = 0, hi = aym_gc.range_count;
+    while (hi - lo > 1) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (aym_gc.ranges[mid].lo <= p) lo = mid;
+        else hi = mid;
+    }
+    AymGcRange *r = &aym_gc.ranges[lo];
+    return p >= r->lo && p < r->hi ? r : NULL;
+}
+
+static void aym_gc_push(AymGcBlock *b) {
+    if (aym_gc.stack_len == aym_gc.stack_cap) {
+        size_t cap = aym_gc.stack_cap ? aym_gc.stack_cap * 2 : 256;
+        AymGcBlock **stack = (AymGcBlock **)realloc(aym_gc.stack, sizeof(AymGcBlock *) * cap);
+        if (!stack) {
+            /* Sin memoria para rangos o para la pila de marcado no se sabe
+             * que queda vivo, asi que esa vez no se barre. */
+            aym_gc.overflow = 1;
+            return;
+        }
+        aym_gc.stack = stack;
+        aym_gc.stack_cap = cap;
+    }
+    aym_gc.stack[aym_gc.stack_len++] = b;
+}
+
+static void aym_gc_scan_range(void *ctx, const void *start, size_t bytes);
+
+static void aym_gc_mark_word(uintptr_t w) {
+    AymGcRange *r = aym_gc_find(w);
+    if (!r) return;
+    if (r->chunk) {
+        r->marked = 1;
+    } else if (!r->block->mark) {
+        r->block->mark = 1;
+        aym_gc_push(r->block);
+    }
+}
+
+static void aym_gc_scan_range(void *ctx, const void *start, size_t bytes) {
+    (void)ctx;
+    uintptr_t p = ((uintptr_t)start + sizeof(uintptr_t) - 1) & ~(uintptr_t)(sizeof(uintptr_t) - 1);
+    uintptr_t end = (uintptr_t)start + bytes;
+    for (; p + sizeof(uintptr_t) <= end; p += sizeof(uintptr_t)) {
+        aym_gc_mark_word(*(const uintptr_t *)p);
+    }
+}
+
+/* .data/.bss se recorren byte a byte: el compilador deja las globales una
+ * tras otra despues de los textos, sin alinear. El estado del recolector se
+ * salta porque `min` es el inicio de un rango y lo mantendria vivo. */
+static void aym_gc_scan_bytes(const char *lo, const char *hi) {
+    for (const char *p = lo; p + sizeof(uintptr_t) <= hi; p++) {
+        uintptr_t w;
+        memcpy(&w, p, sizeof(w));
+        aym_gc_mark_word(w);
+    }
+}
+
+static void aym_gc_scan_data(const char *lo, const char *hi) {
+    const char *self = (const char *)&aym_gc;
+    if (self >= lo && self < hi) {
+        aym_gc_scan_bytes(lo, self);
+        lo = self + sizeof(aym_gc);
+    }
+    aym_gc_scan_bytes(lo, hi);
+}
+
+static void aym_gc_scan_roots(void) {
+    volatile uintptr_t here = 0;
+    uintptr_t sp = (uintptr_t)&here;
+#ifdef _WIN32
+    uintptr_t base = (uintptr_t)((NT_TIB *)NtCurrentTeb())->StackBase;
+    aym_gc_scan_range(NULL, (const void *)sp, base - sp);
+    aym_gc_scan_data(__data_start__, __data_end__);
+    aym_gc_scan_data(__bss_start__, __bss_end__);
+#else
+    uintptr_t base = (uintptr_t)__libc_stack_end;
+    aym_gc_scan_range(NULL, (const void *)sp, base - sp);
+    aym_gc_scan_data(__data_start, _end);
+#endif
+}
+
+static __attribute__((noinline)) void aym_gc_run(void) {
+    aym_gc.range_count = 0;
+    aym_gc.live = 0;
+    aym_gc.overflow = 0;
+    for (AymGcBlock *b = aym_gc.blocks; b; b = b->next) {
+        aym_gc_add_block_range(b, b + 1, b->size);
+        aym_gc_visit_owned(b, aym_gc_add_block_range, b);
+    }
+    aym_str_gc_chunks(aym_gc_add_chunk_range, NULL);
+    if (aym_gc.range_count == 0) return;
+    qsort(aym_gc.ranges, aym_gc.range_count, sizeof(AymGcRange), aym_gc_range_cmp);
+    aym_gc.min = aym_gc.ranges[0].lo;
+    aym_gc.max = 0;
+    for (size_t i = 0; i < aym_gc.range_count; i++) {
+        if (aym_gc.ranges[i].hi > aym_gc.max) aym_gc.max = aym_gc.ranges[i].hi;
+    }
+
+    aym_gc_scan_roots();
+    while (aym_gc.stack_len > 0) {
+        AymGcBlock *b = aym_gc.stack[--aym_gc.stack_len];
+        if (b->kind != AYM_GC_TEXT) aym_gc_scan_range(NULL, b + 1, b->size);
+        aym_gc_visit_owned(b, aym_gc_scan_range, NULL);
+    }
+    if (aym_gc.overflow) {
+        for (AymGcBlock *b = aym_gc.blocks; b; b = b->next) b->mark = 0;
+        return;
+    }
+
+    for (size_t i = 0; i < aym_gc.range_count; i++) {
+        AymGcRange *r = &aym_gc.ranges[i];
+        if (!r->chunk) continue;
+        if (r->marked) aym_gc.live += r->hi - r->lo - 1;
+        else aym_gc.freed_bytes += aym_str_gc_drop(r->chunk);
+    }
+    AymGcBlock *b = aym_gc.blocks;
+    while (b) {
+        AymGcBlock *next = b->next;
+        if (b->mark) {
+            b->mark = 0;
+            aym_gc.live += b->size;
+            aym_gc_visit_owned(b, aym_gc_count_range, NULL);
+        } else {
+            if (b->prev) b->prev->next = next;
+            else aym_gc.blocks = next;
+            if (next) next->prev = b->prev;
+            size_t bytes = aym_gc_free_block(b);
+            aym_gc.freed_bytes += bytes;
+            aym_gc.freed_blocks++;
+        }
+        b = next;
+    }
+}
+
+/* Recolecta ya. Solo desde el hilo principal y fuera de los trabajos del
+ * pool; __builtin_unwind_init deja en esta pila los registros que guarda
+ * el llamado para que la busqueda de raices los vea. */
+void aym_gc_collect(void) {
+    if (aym_gc.state == 0) aym_gc_config();
+    if (aym_gc.state < 0 || aym_gc.collecting || aym_pool_inside) {
+        aym_gc.pending = 0;
+        return;
+    }
+    __builtin_unwind_init();
+    aym_gc.collecting = 1;
+    uint64_t start = aym_gc_now_us();
+    aym_gc_run();
+    uint64_t pause = aym_gc_now_us() - start;
+    aym_gc.collecting = 0;
+    aym_gc.collections++;
+    aym_gc.pause_total_us += pause;
+    if (pause > aym_gc.pause_max_us) aym_gc.pause_max_us = pause;
+    aym_gc.pending = 0;
+    aym_gc.threshold = aym_gc.live > aym_gc.min_bytes ? aym_gc.live : aym_gc.min_bytes;
+}
+
+static void aym_gc_stats_print(void) {
+    fprintf(stderr,
+            "[gc] recolecciones: %ld, pausa total: %.3f ms, pausa maxima: %.3f ms, "
+            "liberado: %llu bytes en %llu bloques, vivo: %llu bytes\n",
+            aym_gc.collections,
+            (double)aym_gc.pause_total_us / 1000.0,
+            (double)aym_gc.pause_max_us / 1000.0,
+            (unsigned long long)aym_gc.freed_bytes,
+            (unsigned long long)aym_gc.freed_blocks,
+            (unsigned long long)aym_gc.live);
+}
+
+/* `aymc --gc-stats`: main la llama al empezar. */
+void aym_gc_stats_enable(void) {
+    atexit(aym_gc_stats_print);
+}
@@ -0,0 +1,244 @@
+/* Funciones de orden superior (`map`, `filter`, `reduce`). `fn_ptr` es una
+ * funcion del programa (`&f`). Las listas de salida se reservan desde el
+ * largo de la entrada: `map` la llena sin crecer y `filter` nunca pasa de esa
+ * capacidad. */
+
+#define AYM_HOF_MAP 0
+#define AYM_HOF_FILTER 1
+#define AYM_HOF_REDUCE 2
+
+/* Lista vacia con espacio para `cap` elementos. */
+static intptr_t aym_hof_out(long cap) {
+    intptr_t out = aym_array_new(cap);
+    if (out) ((AymArray*)out)->len = 0;
+    return out;
+}
+
+/* Devuelve la memoria sobrante cuando el filtro dejo menos de la mitad. */
+static void aym_hof_shrink(intptr_t out) {
+    AymArray *a = (AymArray*)out;
+    if (!a || a->len >= a->cap / 2) return;
+    if (a->len == 0) {
+        free(a->data);
+        a->data = NULL;
+        a->cap = 0;
+        return;
+    }
+    intptr_t *data = realloc(a->data, sizeof(intptr_t) * (size_t)a->len);
+    if (!data) return;
+    a->data = data;
+    a->cap = a->len;
+}
+
+intptr_t aym_hof_map(intptr_t arr, intptr_t fn_ptr) {
+    if (!arr || !fn_ptr) return aym_array_new(0);
+    AymArray *src = (AymArray*)arr;
+    long len = src->len;
+    intptr_t out = aym_array_new(len);
+    if (!out) return 0;
+    AymArray *dst = (AymArray*)out;
+    AymUnaryFn fn = (AymUnaryFn)fn_ptr;
+    for (long i = 0; i < len && i < src->len; i++) {
+        dst->data[i] = fn(src->data[i]);
+    }
+    return out;
+}
+
+intptr_t aym_hof_filter(intptr_t arr, intptr_t fn_ptr) {
+    if (!arr || !fn_ptr) return aym_array_new(0);
+    AymArray *src = (AymArray*)arr;
+    long len = src->len;
+    intptr_t out = aym_hof_out(len);
+    if (!out) return 0;
+    AymArray *dst = (AymArray*)out;
+    AymUnaryFn fn = (AymUnaryFn)fn_ptr;
+    for (long i = 0; i < len && i < src->len; i++) {
+        intptr_t v = src->data[i];
+        if (fn(v)) dst->data[dst->len++] = v;
+    }
+    aym_hof_shrink(out);
+    return out;
+}
+
+intptr_t aym_hof_reduce(intptr_t arr, intptr_t fn_ptr, intptr_t init) {
+    if (!arr || !fn_ptr) return init;
+    AymArray *src = (AymArray*)arr;
+    intptr_t acc = init;
+    AymBinaryFn fn = (AymBinaryFn)fn_ptr;
+    for (long i = 0; i < src->len; i++) {
+        acc = fn(acc, src->data[i]);
+    }
+    return acc;
+}
+
+/* Cadena `map`/`filter`/`reduce` fusionada por el compilador: `stages` trae
+ * `count` pares {tipo, funcion} en orden de aplicacion y solo el ultimo puede
+ * ser AYM_HOF_REDUCE. Cada elemento pasa por todas las etapas en una sola
+ * vuelta, sin listas intermedias. Devuelve la lista final o, si termina en
+ * `reduce`, el acumulado que empieza en `init`. */
+intptr_t aym_hof_pipeline(intptr_t arr, const intptr_t *stages, long count, intptr_t init) {
+    int reduces = count > 0 && stages[2 * (count - 1)] == AYM_HOF_REDUCE;
+    if (!arr) return reduces ? init : aym_array_new(0);
+    AymArray *src = (AymArray*)arr;
+    long len = src->len;
+    long steps = reduces ? count - 1 : count;
+    int filters = 0;
+    for (long s = 0; s < steps; s++) filters |= stages[2 * s] == AYM_HOF_FILTER;
+
+    intptr_t out = 0;
+    AymArray *dst = NULL;
+    if (!reduces) {
+        out = aym_hof_out(len);
+        if (!out) return 0;
+        dst = (AymArray*)out;
+    }
+    intptr_t acc = init;
+    for (long i = 0; i < len && i < src->len; i++) {
+        intptr_t v = src->data[i];
+        long s = 0;
+        for (; s < steps; s++) {
+            intptr_t fn = stages[2 * s + 1];
+            if (stages[2 * s] == AYM_HOF_MAP) {
+                v = ((AymUnaryFn)fn)(v);
+            } else if (!((AymUnaryFn)fn)(v)) {
+                break;
+            }
+        }
+        if (s < steps) continue;
+        if (reduces) acc = ((AymBinaryFn)stages[2 * steps + 1])(acc, v);
+        else dst->data[dst->len++] = v;
+    }
+    if (reduces) return acc;
+    if (filters) aym_hof_shrink(out);
+    return out;
+}
+
+/* Versiones en paralelo (`map_par`, `filter_par`, `reduce_par`): la lista se
+ * parte en rangos de al menos AYM_HOF_PAR_GRAIN elementos, unos cuantos por
+ * hilo para que el robo de trabajo reparta bien, y los resultados se juntan en
+ * el orden de la lista. Listas cortas o sin pool van por la version comun. El
+ * compilador solo las usa con funciones puras. */
+#define AYM_HOF_PAR_GRAIN 4096
+#define AYM_HOF_PAR_CHUNKS_PER_THREAD 8
+#define AYM_HOF_PAR_MAX_CHUNKS (AYM_POOL_MAX_THREADS * AYM_HOF_PAR_CHUNKS_PER_THREAD)
+
+typedef struct {
+    const intptr_t *src;
+    intptr_t *out;
+    long counts[AYM_HOF_PAR_MAX_CHUNKS];
+    intptr_t fn;
+    long n;
+    long chunks;
+} AymHofPar;
+
+static long aym_hof_par_chunks(long n) {
+    long threads = aym_pool_threads();
+    if (threads < 2 || n < 2 * AYM_HOF_PAR_GRAIN) return 1;
+    long chunks = n / AYM_HOF_PAR_GRAIN;
+    long most = threads * AYM_HOF_PAR_CHUNKS_PER_THREAD;
+    return chunks < most ? chunks : most;
+}
+
+static void aym_hof_par_range(const AymHofPar *job, long chunk, long *lo, long *hi) {
+    *lo = job->n * chunk / job->chunks;
+    *hi = job->n * (chunk + 1) / job->chunks;
+}
+
+static void aym_hof_map_chunk(void *ctx, long chunk) {
+    AymHofPar *job = (AymHofPar*)ctx;
+    AymUnaryFn fn = (AymUnaryFn)job->fn;
+    long lo, hi;
+    aym_hof_par_range(job, chunk, &lo, &hi);
+    for (long i = lo; i < hi; i++) job->out[i] = fn(job->src[i]);
+}
+
+/* Cada trozo deja sus elementos al inicio de su propio rango de la salida. */
+static void aym_hof_filter_chunk(void *ctx, long chunk) {
+    AymHofPar *job = (AymHofPar*)ctx;
+    AymUnaryFn fn = (AymUnaryFn)job->fn;
+    long lo, hi;
+    aym_hof_par_range(job, chunk, &lo, &hi);
+    long kept = lo;
+    for (long i = lo; i < hi; i++) {
+        intptr_t v = job->src[i];
+        if (fn(v)) job->out[kept++] = v;
+    }
+    job->counts[chunk] = kept - lo;
+}
+
+/* Cada trozo se reduce desde su primer elemento; no hace falta neutro. */
+static void aym_hof_reduce_chunk(void *ctx, long chunk) {
+    AymHofPar *job = (AymHofPar*)ctx;
+    AymBinaryFn fn = (AymBinaryFn)job->fn;
+    long lo, hi;
+    aym_hof_par_range(job, chunk, &lo, &hi);
+    intptr_t acc = job->src[lo];
+    for (long i = lo + 1; i < hi; i++) acc = fn(acc, job->src[i]);
+    job->out[chunk] = acc;
+}
+
+intptr_t aym_hof_map_par(intptr_t arr, intptr_t fn_ptr) {
+    if (!arr || !fn_ptr) return aym_array_new(0);
+    AymArray *src = (AymArray*)arr;
+    long chunks = aym_hof_par_chunks(src->len);
+    if (chunks < 2) return aym_hof_map(arr, fn_ptr);
+    intptr_t out = aym_array_new(src->len);
+    if (!out) return 0;
+    AymHofPar job;
+    job.src = src->data;
+    job.out = ((AymArray*)out)->data;
+    job.fn = fn_ptr;
+    job.n = src->len;
+    job.chunks = chunks;
+    aym_pool_for(chunks, aym_hof_map_chunk, &job);
+    return out;
+}
+
+intptr_t aym_hof_filter_par(intptr_t arr, intptr_t fn_ptr) {
+    if (!arr || !fn_ptr) return aym_array_new(0);
+    AymArray *src = (AymArray*)arr;
+    long chunks = aym_hof_par_chunks(src->len);
+    if (chunks < 2) return aym_hof_filter(arr, fn_ptr);
+    intptr_t out = aym_array_new(src->len);
+    if (!out) return 0;
+    AymArray *dst = (AymArray*)out;
+    AymHofPar job;
+    job.src = src->data;
+    job.out = dst->data;
+    job.fn = fn_ptr;
+    job.n = src->len;
+    job.chunks = chunks;
+    aym_pool_for(chunks, aym_hof_filter_chunk, &job);
+    long len = 0;
+    for (long c = 0; c < chunks; c++) {
+        long lo = job.n * c / chunks;
+        if (len != lo && job.counts[c] > 0) {
+            memmove(dst->data + len, dst->data + lo, sizeof(intptr_t) * (size_t)job.counts[c]);
+        }
+        len += job.counts[c];
+    }
+    dst->len = len;
+    aym_hof_shrink(out);
+    return out;
+}
+
+/* `fn` tiene que ser asociativa: los trozos se reducen por separado y sus
+ * resultados se combinan en orden a partir de `init`. */
+intptr_t aym_hof_reduce_par(intptr_t arr, intptr_t fn_ptr, intptr_t init) {
+    if (!arr || !fn_ptr) return init;
+    AymArray *src = (AymArray*)arr;
+    long chunks = aym_hof_par_chunks(src->len);
+    if (chunks < 2) return aym_hof_reduce(arr, fn_ptr, init);
+    intptr_t partials[AYM_HOF_PAR_MAX_CHUNKS];
+    AymHofPar job;
+    job.src = src->data;
+    job.out = partials;
+    job.fn = fn_ptr;
+    job.n = src->len;
+    job.chunks = chunks;
+    aym_pool_for(chunks, aym_hof_reduce_chunk, &job);
+    AymBinaryFn fn = (AymBinaryFn)fn_ptr;
+    intptr_t acc = init;
+    for (long c = 0; c < chunks; c++) acc = fn(acc, partials[c]);
+    return acc;
+}
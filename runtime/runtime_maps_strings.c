@@ -1,22 +1,140 @@
+/* Mapa con direccionamiento abierto. Las entradas viven en arreglos densos en
+ * orden de insercion (keys/values/types/hashes); `slots` es la tabla hash
+ * (potencia de dos, sondeo lineal) con el indice de la entrada o uno de los
+ * marcadores AYM_MAP_EMPTY/AYM_MAP_TOMBSTONE. Borrar deja una lapida en la
+ * tabla y un hueco (hash == 0, ningun hash vale 0) en las entradas; ambos se
+ * eliminan al compactar o rehacer la tabla.
+ *
+ * Los cuatro arreglos comparten un bloque (aym_map_place).
+ *
+ * Las claves son textos o enteros segun `int_keys`. Un mapa vacio adopta el
+ * tipo de la primera clave que recibe; el compilador llama a aym_imap_* cuando
+ * el analisis semantico ve claves `jakhüwi`, y esas claves se guardan tal cual
+ * (hash fmix64, comparacion directa) sin pasar por aym_to_string. Una clave
+ * de texto numerica se trata como su entero en esos mapas (ver
+ * aym_map_text_int_key). */
+#define AYM_MAP_EMPTY (-1L)
+#define AYM_MAP_TOMBSTONE (-2L)
+#define AYM_MAP_MIN_SLOTS 8
+/* keys + values + types + hashes por entrada. */
+#define AYM_MAP_ENTRY_BYTES (2 * sizeof(intptr_t) + sizeof(unsigned char) + sizeof(uint64_t))
+/* Capacidad de entradas con que arranca un mapa al recibir la primera. */
+#define AYM_MAP_MIN_CAP 8
+
 typedef struct {
     long len;
     long cap;
-    char **keys;
+    intptr_t *keys;
     intptr_t *values;
     unsigned char *types;
+    uint64_t *hashes;
+    long used;
+    long *slots;
+    long slot_count;
+    long int_keys;
 } AymMap;
 
+/* El hash de una clave de texto queda en su cabecera: los literales lo traen
+ * calculado del compilador y los demas textos lo calculan una sola vez. */
+static uint64_t aym_map_hash(const char *key) {
+    return aym_str_hash(key);
+}
+
+static long aym_map_find_hashed(AymMap *map, intptr_t key, uint64_t hash, size_t *slot) {
+    if (!map->slots) return -1;
+    size_t mask = (size_t)map->slot_count - 1;
+    size_t pos = (size_t)hash & mask;
+    while (1) {
+        long entry = map->slots[pos];
+        if (entry == AYM_MAP_EMPTY) return -1;
+        if (entry >= 0 && map->hashes[entry] == hash &&
+            (map->int_keys ? map->keys[entry] == key
+                           : aym_str_eq((const char *)map->keys[entry], (const char *)key))) {
+            if (slot) *slot = pos;
+            return entry;
+        }
+        pos = (pos + 1) & mask;
+    }
+}
+
+static long aym_imap_find(AymMap *map, intptr_t key) {
+    if (!map || !map->int_keys) return -1;
+    return aym_map_find_hashed(map, key, aym_int_hash(key), NULL);
+}
+
+/* Un texto que aym_to_string produciria para un entero ("5", "-12"; no "05",
+ * "+5" ni "-0"). En un mapa de claves enteras se busca como ese numero, asi
+ * `m[sutinaka(m)[i]]` encuentra la entrada. Fuera del rango de intptr_t no es
+ * un entero. */
+static int aym_map_text_int_key(const char *key, intptr_t *out) {
+    int negative = key[0] == '-';
+    const char *p = negative ? key + 1 : key;
+    if (p[0] < '0' || p[0] > '9' || (p[0] == '0' && (p[1] || negative))) return 0;
+    unsigned long long limit = (unsigned long long)INTPTR_MAX + (negative ? 1u : 0u);
+    unsigned long long value = 0;
+    for (; *p; p++) {
+        if (*p < '0' || *p > '9') return 0;
+        unsigned digit = (unsigned)(*p - '0');
+        if (value > (limit - digit) / 10) return 0;
+        value = value * 10 + digit;
+    }
+    *out = negative ? -(intptr_t)(value - 1) - 1 : (intptr_t)value;
+    return 1;
+}
+
 static long aym_map_find(AymMap *map, const char *key) {
     if (!map || !key) return -1;
-    for (long i = 0; i < map->len; i++) {
-        if (map->keys[i] && strcmp(map->keys[i], key) == 0) return i;
+    if (map->int_keys) {
+        intptr_t ikey = 0;
+        return aym_map_text_int_key(key, &ikey) ? aym_imap_find(map, ikey) : -1;
+    }
+    return aym_map_find_hashed(map, (intptr_t)key, aym_map_hash(key), NULL);
+}
+
+/* Elimina los huecos dejados por aym_map_delete conservando el orden y
+ * reconstruye la tabla hash con `slot_count` posiciones. */
+static int aym_map_rehash(AymMap *map, long slot_count) {
+    long *slots = malloc(sizeof(long) * (size_t)slot_count);
+    if (!slots) {
+        fprintf(stderr, "aym_map_set: allocation failed\n");
+        return 0;
     }
-    return -1;
+    for (long i = 0; i < slot_count; i++) slots[i] = AYM_MAP_EMPTY;
+    long live = 0;
+    for (long i = 0; i < map->used; i++) {
+        if (!map->hashes[i]) continue;
+        map->keys[live] = map->keys[i];
+        map->values[live] = map->values[i];
+        map->types[live] = map->types[i];
+        map->hashes[live] = map->hashes[i];
+        size_t pos = (size_t)map->hashes[live] & (size_t)(slot_count - 1);
+        while (slots[pos] != AYM_MAP_EMPTY) pos = (pos + 1) & (size_t)(slot_count - 1);
+        slots[pos] = live;
+        live++;
+    }
+    free(map->slots);
+    map->slots = slots;
+    map->slot_count = slot_count;
+    map->used = live;
+    return 1;
+}
+
+static void aym_map_compact(AymMap *map) {
+    if (map->used != map->len) aym_map_rehash(map, map->slot_count);
+}
+
+/* Las entradas viven en un solo bloque: keys, values y hashes (8 bytes cada
+ * una, asi quedan alineadas) y al final types. */
+static void aym_map_place(AymMap *map, char *entries, long cap) {
+    map->keys = (intptr_t *)entries;
+    map->values = map->keys + cap;
+    map->hashes = (uint64_t *)(map->values + cap);
+    map->types = (unsigned char *)(map->hashes + cap);
 }
 
 intptr_t aym_map_new(long size) {
     if (size < 0) return 0;
-    AymMap *map = calloc(1, sizeof(AymMap));
+    AymMap *map = aym_gc_alloc(sizeof(AymMap), AYM_GC_MAP);
     if (!map) {
         fprintf(stderr, "aym_map_new: allocation failed\n");
         return 0;
@@ -24,36 +142,70 @@ intptr_t aym_map_new(long size) {
     map->len = 0;
     map->cap = size;
     if (size > 0) {
-        map->keys = calloc((size_t)size, sizeof(char *));
-        map->values = calloc((size_t)size, sizeof(intptr_t));
-        map->types = calloc((size_t)size, sizeof(unsigned char));
-        if (!map->keys || !map->values || !map->types) {
+        char *entries = calloc((size_t)size, AYM_MAP_ENTRY_BYTES);
+        if (!entries) {
             fprintf(stderr, "aym_map_new: allocation failed\n");
-            free(map->keys);
-            free(map->values);
-            free(map->types);
-            free(map);
+            aym_gc_release(map);
             return 0;
         }
+        aym_map_place(map, entries, size);
+        aym_gc_note(AYM_MAP_ENTRY_BYTES * (size_t)size);
+    }
+    return (intptr_t)map;
+}
+
+/* Mapa que el compilador arma en el marco de una funcion cuando no escapa
+ * (analisis de escape): `mem` trae la cabecera, `cap` entradas y `slot_count`
+ * posiciones de tabla. No se reserva ni se libera nada; el compilador solo lo
+ * usa para leer, asi que nunca pasa de las claves del literal. */
+intptr_t aym_map_init_stack(void *mem, long cap, long slot_count) {
+    AymMap *map = (AymMap*)mem;
+    memset(map, 0, sizeof(AymMap));
+    map->cap = cap;
+    if (cap > 0) {
+        char *entries = (char *)(map + 1);
+        aym_map_place(map, entries, cap);
+        map->slots = (long *)(entries + ((AYM_MAP_ENTRY_BYTES * (size_t)cap + 7) & ~(size_t)7));
+        map->slot_count = slot_count;
+        for (long i = 0; i < slot_count; i++) map->slots[i] = AYM_MAP_EMPTY;
     }
     return (intptr_t)map;
 }
 
+/* keys y values quedan seguidos: un solo rango con todos los punteros. */
+static void aym_map_gc_visit(void *body, AymGcVisitFn visit, void *ctx) {
+    AymMap *map = (AymMap*)body;
+    visit(ctx, map->keys, 2 * sizeof(intptr_t) * (size_t)map->cap);
+}
+
+static size_t aym_map_gc_free(void *body) {
+    AymMap *map = (AymMap*)body;
+    free(map->keys);
+    free(map->slots);
+    return AYM_MAP_ENTRY_BYTES * (size_t)map->cap + sizeof(long) * (size_t)map->slot_count;
+}
+
+/* Pasa las `used` entradas a un bloque nuevo del doble: un malloc y cuatro
+ * memcpy en vez de un realloc por arreglo. */
 static int aym_map_grow(AymMap *map) {
-    long newCap = map->cap > 0 ? map->cap * 2 : 1;
-    char **newKeys = realloc(map->keys, sizeof(char *) * (size_t)newCap);
-    intptr_t *newValues = realloc(map->values, sizeof(intptr_t) * (size_t)newCap);
-    unsigned char *newTypes = realloc(map->types, sizeof(unsigned char) * (size_t)newCap);
-    if (!newKeys || !newValues || !newTypes) {
+    long newCap = map->cap > 0 ? map->cap * 2 : AYM_MAP_MIN_CAP;
+    char *entries = malloc(AYM_MAP_ENTRY_BYTES * (size_t)newCap);
+    if (!entries) {
         fprintf(stderr, "aym_map_set: allocation failed\n");
-        free(newKeys);
-        free(newValues);
-        free(newTypes);
         return 0;
     }
-    map->keys = newKeys;
-    map->values = newValues;
-    map->types = newTypes;
+    AymMap next = *map;
+    aym_map_place(&next, entries, newCap);
+    size_t used = (size_t)map->used;
+    if (used) {
+        memcpy(next.keys, map->keys, sizeof(intptr_t) * used);
+        memcpy(next.values, map->values, sizeof(intptr_t) * used);
+        memcpy(next.hashes, map->hashes, sizeof(uint64_t) * used);
+        memcpy(next.types, map->types, sizeof(unsigned char) * used);
+    }
+    free(map->keys);
+    aym_gc_note(AYM_MAP_ENTRY_BYTES * (size_t)(newCap - map->cap));
+    aym_map_place(map, entries, newCap);
     map->cap = newCap;
     return 1;
 }
@@ -63,36 +215,98 @@ long aym_map_size(intptr_t map) {
     return ((AymMap*)map)->len;
 }
 
-long aym_map_contains(intptr_t map, const char *key) {
-    if (!map || !key) return 0;
-    return aym_map_find((AymMap*)map, key) >= 0;
+/* Un mapa sin entradas vivas (ni huecos) toma el tipo de clave pedido. */
+static void aym_map_adopt_keys(AymMap *m, long int_keys) {
+    if (m->used == 0) m->int_keys = int_keys;
 }
 
-intptr_t aym_map_set(intptr_t map, const char *key, intptr_t value, int is_string) {
-    if (!map || !key) return 0;
-    AymMap *m = (AymMap*)map;
-    long idx = aym_map_find(m, key);
+/* Inserta o reemplaza una clave cuyo tipo ya coincide con `int_keys`. */
+static intptr_t aym_map_put(AymMap *m, intptr_t key, uint64_t hash, intptr_t value, int is_string) {
+    long idx = aym_map_find_hashed(m, key, hash, NULL);
     if (idx >= 0) {
         m->values[idx] = (intptr_t)value;
         m->types[idx] = (unsigned char)(is_string ? 1 : 0);
         return value;
     }
-    if (m->len >= m->cap) {
-        if (!aym_map_grow(m)) return 0;
+    if (m->used >= m->cap) {
+        if (m->used - m->len > m->used / 2) {
+            aym_map_compact(m);
+        }
+        if (m->used >= m->cap && !aym_map_grow(m)) return 0;
+    }
+    /* Factor de carga maximo 3/4 contando lapidas (used >= ocupadas). */
+    if ((m->used + 1) * 4 > m->slot_count * 3) {
+        long slots = m->slot_count > 0 ? m->slot_count : AYM_MAP_MIN_SLOTS;
+        while ((m->len + 1) * 4 > slots * 3 / 2) slots *= 2;
+        if (!aym_map_rehash(m, slots)) return 0;
     }
-    m->keys[m->len] = (char *)key;
-    m->values[m->len] = (intptr_t)value;
-    m->types[m->len] = (unsigned char)(is_string ? 1 : 0);
+    long entry = m->used++;
+    m->keys[entry] = key;
+    m->values[entry] = (intptr_t)value;
+    m->types[entry] = (unsigned char)(is_string ? 1 : 0);
+    m->hashes[entry] = hash;
+    size_t mask = (size_t)m->slot_count - 1;
+    size_t pos = (size_t)hash & mask;
+    while (m->slots[pos] >= 0) pos = (pos + 1) & mask;
+    m->slots[pos] = entry;
     m->len++;
     return value;
 }
 
+/* Quita la entrada `idx`, que esta en la posicion `pos` de la tabla. */
+static intptr_t aym_map_erase(AymMap *m, long idx, size_t pos) {
+    intptr_t value = m->values[idx];
+    m->slots[pos] = AYM_MAP_TOMBSTONE;
+    m->hashes[idx] = 0;
+    m->len--;
+    if (m->len == 0) {
+        for (long i = 0; i < m->slot_count; i++) m->slots[i] = AYM_MAP_EMPTY;
+        m->used = 0;
+    }
+    return value;
+}
+
+AYM_STR_LITERAL(aym_map_missing_prefix, "no existe: ");
+
 static void aym_map_missing_key(const char *key) {
-    const char *suffix = key ? key : "";
-    char *message = aym_str_concat("no existe: ", suffix);
+    char *message = aym_str_concat(aym_map_missing_prefix.data, key);
     aym_throw_typed("CLAVE", message ? message : "no existe");
 }
 
+static void aym_imap_missing_key(intptr_t key) {
+    aym_map_missing_key(aym_to_string((long)key));
+}
+
+long aym_map_contains(intptr_t map, const char *key) {
+    if (!map || !key) return 0;
+    return aym_map_find((AymMap*)map, key) >= 0;
+}
+
+/* Un mapa de claves enteras que recibe una clave de texto no numerica pasa
+ * a claves de texto, cada una como la escribiria `aru(k)`. */
+static void aym_map_to_text_keys(AymMap *m) {
+    for (long i = 0; i < m->used; i++) {
+        if (!m->hashes[i]) continue;
+        const char *text = aym_to_string((long)m->keys[i]);
+        m->keys[i] = (intptr_t)text;
+        m->hashes[i] = aym_map_hash(text);
+    }
+    m->int_keys = 0;
+    aym_map_rehash(m, m->slot_count);
+}
+
+intptr_t aym_map_set(intptr_t map, const char *key, intptr_t value, int is_string) {
+    if (!map || !key) return 0;
+    AymMap *m = (AymMap*)map;
+    aym_map_adopt_keys(m, 0);
+    if (m->int_keys) {
+        intptr_t ikey = 0;
+        if (aym_map_text_int_key(key, &ikey)) return aym_map_put(m, ikey, aym_int_hash(ikey), value, is_string);
+        aym_map_to_text_keys(m);
+    }
+    return aym_map_put(m, (intptr_t)key, aym_map_hash(key), value, is_string);
+}
+
 intptr_t aym_map_get(intptr_t map, const char *key) {
     if (!map) {
         aym_map_missing_key(key);
@@ -116,32 +330,94 @@ intptr_t aym_map_get_default(intptr_t map, const char *key, intptr_t default_val
 }
 
 intptr_t aym_map_delete(intptr_t map, const char *key) {
-    if (!map) {
+    if (!map || !key) {
         aym_map_missing_key(key);
         return 0;
     }
     AymMap *m = (AymMap*)map;
-    long idx = aym_map_find(m, key);
+    size_t pos = 0;
+    intptr_t ikey = 0;
+    long idx = -1;
+    if (!m->int_keys) {
+        idx = aym_map_find_hashed(m, (intptr_t)key, aym_map_hash(key), &pos);
+    } else if (aym_map_text_int_key(key, &ikey)) {
+        idx = aym_map_find_hashed(m, ikey, aym_int_hash(ikey), &pos);
+    }
     if (idx < 0) {
         aym_map_missing_key(key);
         return 0;
     }
-    intptr_t value = m->values[idx];
-    for (long i = idx + 1; i < m->len; i++) {
-        m->keys[i - 1] = m->keys[i];
-        m->values[i - 1] = m->values[i];
-        m->types[i - 1] = m->types[i];
+    return aym_map_erase(m, idx, pos);
+}
+
+/* Variantes de clave entera. Si el mapa ya tiene claves de texto la clave se
+ * convierte con aym_to_string, igual que el `aru(k)` que se escribia antes. */
+long aym_imap_contains(intptr_t map, intptr_t key) {
+    if (!map) return 0;
+    AymMap *m = (AymMap*)map;
+    if (!m->int_keys) return m->used ? aym_map_contains(map, aym_to_string((long)key)) : 0;
+    return aym_imap_find(m, key) >= 0;
+}
+
+intptr_t aym_imap_set(intptr_t map, intptr_t key, intptr_t value, int is_string) {
+    if (!map) return 0;
+    AymMap *m = (AymMap*)map;
+    aym_map_adopt_keys(m, 1);
+    if (!m->int_keys) return aym_map_set(map, aym_to_string((long)key), value, is_string);
+    return aym_map_put(m, key, aym_int_hash(key), value, is_string);
+}
+
+intptr_t aym_imap_get(intptr_t map, intptr_t key) {
+    if (!map) {
+        aym_imap_missing_key(key);
+        return 0;
     }
-    m->len--;
-    return value;
+    AymMap *m = (AymMap*)map;
+    if (!m->int_keys && m->used) return aym_map_get(map, aym_to_string((long)key));
+    long idx = aym_imap_find(m, key);
+    if (idx < 0) {
+        aym_imap_missing_key(key);
+        return 0;
+    }
+    return m->values[idx];
+}
+
+intptr_t aym_imap_get_default(intptr_t map, intptr_t key, intptr_t default_value) {
+    if (!map) return default_value;
+    AymMap *m = (AymMap*)map;
+    if (!m->int_keys && m->used) return aym_map_get_default(map, aym_to_string((long)key), default_value);
+    long idx = aym_imap_find(m, key);
+    if (idx < 0) return default_value;
+    return m->values[idx];
+}
+
+intptr_t aym_imap_delete(intptr_t map, intptr_t key) {
+    if (!map) {
+        aym_imap_missing_key(key);
+        return 0;
+    }
+    AymMap *m = (AymMap*)map;
+    if (!m->int_keys && m->used) return aym_map_delete(map, aym_to_string((long)key));
+    size_t pos = 0;
+    long idx = m->int_keys ? aym_map_find_hashed(m, key, aym_int_hash(key), &pos) : -1;
+    if (idx < 0) {
+        aym_imap_missing_key(key);
+        return 0;
+    }
+    return aym_map_erase(m, idx, pos);
 }
 
+/* Claves en orden de insercion. `sutinaka` es una lista de textos, asi que
+ * las claves enteras se formatean aqui. */
 intptr_t aym_map_keys(intptr_t map) {
     if (!map) return 0;
     AymMap *m = (AymMap*)map;
     intptr_t arr = aym_array_new(m->len);
-    for (long i = 0; i < m->len; i++) {
-        aym_array_set(arr, i, (intptr_t)m->keys[i]);
+    long out = 0;
+    for (long i = 0; i < m->used; i++) {
+        if (!m->hashes[i]) continue;
+        intptr_t key = m->int_keys ? (intptr_t)aym_to_string((long)m->keys[i]) : m->keys[i];
+        aym_array_set(arr, out++, key);
     }
     return arr;
 }
@@ -150,23 +426,29 @@ intptr_t aym_map_values(intptr_t map) {
     if (!map) return 0;
     AymMap *m = (AymMap*)map;
     intptr_t arr = aym_array_new(m->len);
-    for (long i = 0; i < m->len; i++) {
-        aym_array_set(arr, i, (intptr_t)m->values[i]);
+    long out = 0;
+    for (long i = 0; i < m->used; i++) {
+        if (!m->hashes[i]) continue;
+        aym_array_set(arr, out++, (intptr_t)m->values[i]);
     }
     return arr;
 }
 
+/* Tambien devuelve texto para las claves enteras (qillqa las imprime asi). */
 const char *aym_map_key_at(intptr_t map, long idx) {
-    if (!map) return "";
+    if (!map) return aym_str_empty.data;
     AymMap *m = (AymMap*)map;
-    if (idx < 0 || idx >= m->len) return "";
-    return m->keys[idx] ? m->keys[idx] : "";
+    if (idx < 0 || idx >= m->len) return aym_str_empty.data;
+    aym_map_compact(m);
+    if (m->int_keys) return aym_to_string((long)m->keys[idx]);
+    return m->keys[idx] ? (const char *)m->keys[idx] : aym_str_empty.data;
 }
 
 intptr_t aym_map_value_at(intptr_t map, long idx) {
     if (!map) return 0;
     AymMap *m = (AymMap*)map;
     if (idx < 0 || idx >= m->len) return 0;
+    aym_map_compact(m);
     return m->values[idx];
 }
 
@@ -174,6 +456,7 @@ long aym_map_value_is_string(intptr_t map, long idx) {
     if (!map) return 0;
     AymMap *m = (AymMap*)map;
     if (idx < 0 || idx >= m->len) return 0;
+    aym_map_compact(m);
     return m->types[idx] ? 1 : 0;
 }
 
@@ -185,37 +468,153 @@ long aym_map_value_is_string_key(intptr_t map, const char *key) {
     return m->types[idx] ? 1 : 0;
 }
 
+long aym_imap_value_is_string_key(intptr_t map, intptr_t key) {
+    if (!map) return 0;
+    AymMap *m = (AymMap*)map;
+    if (!m->int_keys) return aym_map_value_is_string_key(map, aym_to_string((long)key));
+    long idx = aym_imap_find(m, key);
+    if (idx < 0) return 0;
+    return m->types[idx] ? 1 : 0;
+}
+
+/* Arena de textos. Todo texto que produce el runtime sale de una cadena de
+ * bloques con asignacion por desplazamiento; nunca se libera uno por uno.
+ * Cada pedido reserva la cabecera AymStrHeader delante de los caracteres.
+ * El compilador abre regiones temporales con aym_str_scratch_mark y las
+ * cierra con aym_str_scratch_release, que vuelve el puntero a la marca: los
+ * bloques siguientes quedan en la cadena para reutilizarse. Un pedido que no
+ * cabe en un bloque normal recibe un bloque propio del tamano justo. Cada
+ * hilo tiene su propia cadena, asi que los hilos del pool (runtime_pool.c)
+ * arman textos sin bloquearse. */
+#define AYM_STR_CHUNK_BYTES (64 * 1024)
+
+typedef struct AymStrChunk {
+    struct AymStrChunk *prev;
+    struct AymStrChunk *next;
+    size_t cap;
+    size_t used;
+    char data[];
+} AymStrChunk;
+
+static __thread AymStrChunk *aym_str_current = NULL;
+
+static AymStrChunk *aym_str_chunk_new(size_t cap) {
+    AymStrChunk *chunk = (AymStrChunk *)malloc(sizeof(AymStrChunk) + cap);
+    if (!chunk) return NULL;
+    chunk->prev = NULL;
+    chunk->next = NULL;
+    chunk->cap = cap;
+    chunk->used = 0;
+    aym_gc_note(cap);
+    return chunk;
+}
+
+/* Para runtime_gc.c: los bloques anteriores al actual ya no reciben textos
+ * nuevos, asi que el recolector puede soltar los que nadie apunta. El actual
+ * y los que quedaron libres detras de una marca siempre se conservan. */
+static void aym_str_gc_chunks(AymGcChunkFn fn, void *ctx) {
+    AymStrChunk *chunk = aym_str_current;
+    for (chunk = chunk ? chunk->prev : NULL; chunk; chunk = chunk->prev) {
+        fn(ctx, chunk, chunk->data, chunk->cap);
+    }
+}
+
+static size_t aym_str_gc_drop(void *block) {
+    AymStrChunk *chunk = (AymStrChunk *)block;
+    if (chunk->prev) chunk->prev->next = chunk->next;
+    if (chunk->next) chunk->next->prev = chunk->prev;
+    size_t bytes = sizeof(AymStrChunk) + chunk->cap;
+    free(chunk);
+    return bytes;
+}
+
+static char *aym_str_init(char *block, size_t need, size_t len) {
+    AymStrHeader *h = (AymStrHeader *)block;
+    h->hash = 0;
+    h->cap = need - sizeof(AymStrHeader) - 1;
+    h->len = len;
+    char *out = (char *)(h + 1);
+    out[len] = '\0';
+    return out;
+}
+
+/* Reserva un texto de `len` caracteres (mas el NUL) con la cabecera lista. */
+char *aym_str_alloc(size_t len) {
+    size_t need = (sizeof(AymStrHeader) + len + 1 + 7u) & ~(size_t)7u;
+    AymStrChunk *cur = aym_str_current;
+    if (cur && cur->cap - cur->used >= need) {
+        char *out = cur->data + cur->used;
+        cur->used += need;
+        return aym_str_init(out, need, len);
+    }
+    /* El bloque siguiente ya esta libre (quedo detras de una marca). */
+    AymStrChunk *next = cur ? cur->next : NULL;
+    if (!next || next->cap < need) {
+        size_t cap = need > AYM_STR_CHUNK_BYTES ? need : AYM_STR_CHUNK_BYTES;
+        AymStrChunk *fresh = aym_str_chunk_new(cap);
+        if (!fresh) return NULL;
+        fresh->prev = cur;
+        fresh->next = next;
+        if (next) next->prev = fresh;
+        if (cur) cur->next = fresh;
+        next = fresh;
+    }
+    next->used = need;
+    aym_str_current = next;
+    return aym_str_init(next->data, need, len);
+}
+
+intptr_t aym_str_scratch_mark(void) {
+    AymStrChunk *cur = aym_str_current;
+    return cur ? (intptr_t)(cur->data + cur->used) : 0;
+}
+
+void aym_str_scratch_release(intptr_t mark) {
+    AymStrChunk *chunk = aym_str_current;
+    if (!chunk) return;
+    if (!mark) {
+        while (chunk->prev) chunk = chunk->prev;
+        chunk->used = 0;
+        aym_str_current = chunk;
+        return;
+    }
+    char *pos = (char *)mark;
+    while (chunk && !(pos >= chunk->data && pos <= chunk->data + chunk->cap)) {
+        chunk = chunk->prev;
+    }
+    if (!chunk) return;
+    chunk->used = (size_t)(pos - chunk->data);
+    aym_str_current = chunk;
+}
+
 char *aym_str_concat(const char *left, const char *right) {
-    if (!left) left = "";
-    if (!right) right = "";
-    size_t left_len = strlen(left);
-    size_t right_len = strlen(right);
-    size_t total = left_len + right_len + 1;
-    char *out = (char *)malloc(total);
+    size_t left_len = aym_str_len(left);
+    size_t right_len = aym_str_len(right);
+    char *out = aym_str_alloc(left_len + right_len);
     if (!out) return NULL;
-    memcpy(out, left, left_len);
-    memcpy(out + left_len, right, right_len);
-    out[total - 1] = '\0';
+    if (left_len) memcpy(out, left, left_len);
+    if (right_len) memcpy(out + left_len, right, right_len);
     return out;
 }
 
 char *aym_str_trim(const char *text) {
-    if (!text) text = "";
+    if (!text) text = aym_str_empty.data;
     const char *start = text;
     while (*start && isspace((unsigned char)*start)) start++;
-    const char *end = text + strlen(text);
+    const char *end = text + aym_str_len(text);
     while (end > start && isspace((unsigned char)*(end - 1))) end--;
     size_t len = (size_t)(end - start);
     return aym_str_copy(start, len);
 }
 
 intptr_t aym_str_split(const char *text, const char *sep) {
-    if (!text) text = "";
-    if (!sep || sep[0] == '\0') {
+    if (!text) text = aym_str_empty.data;
+    size_t sep_len = aym_str_len(sep);
+    if (!sep_len) {
         aym_throw_typed("ARG", "separador vacio");
         return 0;
     }
-    size_t sep_len = strlen(sep);
+    const char *text_end = text + aym_str_len(text);
     if (*text == '\0') {
         intptr_t arr = aym_array_new(1);
         char *empty = aym_str_copy("", 0);
@@ -234,7 +633,7 @@ intptr_t aym_str_split(const char *text, const char *sep) {
     while (1) {
         const char *pos = strstr(start, sep);
         if (!pos) {
-            char *piece = aym_str_copy(start, strlen(start));
+            char *piece = aym_str_copy(start, (size_t)(text_end - start));
             if (piece) aym_array_set(arr, (long)idx, (intptr_t)piece);
             break;
         }
@@ -247,24 +646,22 @@ intptr_t aym_str_split(const char *text, const char *sep) {
 }
 
 char *aym_str_join(intptr_t arr, const char *sep) {
-    if (!sep) sep = "";
-    size_t sep_len = strlen(sep);
+    size_t sep_len = aym_str_len(sep);
     if (!arr) return aym_str_copy("", 0);
     AymArray *a = (AymArray*)arr;
     if (a->len <= 0) return aym_str_copy("", 0);
     size_t total = 0;
     for (long i = 0; i < a->len; i++) {
-        const char *part = (const char *)a->data[i];
-        if (part) total += strlen(part);
+        total += aym_str_len((const char *)a->data[i]);
         if (i + 1 < a->len) total += sep_len;
     }
-    char *out = (char *)malloc(total + 1);
+    char *out = aym_str_alloc(total);
     if (!out) return NULL;
     char *cursor = out;
     for (long i = 0; i < a->len; i++) {
         const char *part = (const char *)a->data[i];
-        if (part) {
-            size_t len = strlen(part);
+        size_t len = aym_str_len(part);
+        if (len) {
             memcpy(cursor, part, len);
             cursor += len;
         }
@@ -273,19 +670,18 @@ char *aym_str_join(intptr_t arr, const char *sep) {
             cursor += sep_len;
         }
     }
-    *cursor = '\0';
     return out;
 }
 
 char *aym_str_replace(const char *text, const char *search, const char *replacement) {
-    if (!text) text = "";
-    if (!search || search[0] == '\0') {
+    if (!text) text = aym_str_empty.data;
+    size_t search_len = aym_str_len(search);
+    if (!search_len) {
         aym_throw_typed("ARG", "busqueda vacia");
         return NULL;
     }
-    if (!replacement) replacement = "";
-    size_t search_len = strlen(search);
-    size_t replacement_len = strlen(replacement);
+    size_t text_len = aym_str_len(text);
+    size_t replacement_len = aym_str_len(replacement);
     size_t count = 0;
     const char *scan = text;
     while ((scan = strstr(scan, search)) != NULL) {
@@ -298,9 +694,9 @@ char *aym_str_replace(const char *text, const char *search, const char *replacem
             scan += 1;
         }
     }
-    if (count == 0) return aym_str_copy(text, strlen(text));
-    size_t total = strlen(text) + count * (replacement_len - search_len);
-    char *out = (char *)malloc(total + 1);
+    if (count == 0) return aym_str_copy(text, text_len);
+    size_t total = text_len + count * (replacement_len - search_len);
+    char *out = aym_str_alloc(total);
     if (!out) return NULL;
     const char *src = text;
     char *dst = out;
@@ -323,29 +719,79 @@ char *aym_str_replace(const char *text, const char *search, const char *replacem
         }
         src = scan + search_len;
     }
-    size_t tail = strlen(src);
+    size_t tail = (size_t)(text + text_len - src);
     memcpy(dst, src, tail);
-    dst += tail;
-    *dst = '\0';
     return out;
 }
 
 long aym_str_contains(const char *text, const char *sub) {
     if (!text) return 0;
     if (!sub) return 0;
-    if (sub[0] == '\0') return 1;
+    size_t sub_len = aym_str_len(sub);
+    if (!sub_len) return 1;
+    if (sub_len > aym_str_len(text)) return 0;
     return strstr(text, sub) != NULL;
 }
 
+/* Digitos decimales de un entero, con el signo. */
+static size_t aym_long_width(long value) {
+    unsigned long magnitude = value < 0 ? 0UL - (unsigned long)value : (unsigned long)value;
+    size_t width = value < 0 ? 2 : 1;
+    while (magnitude >= 10) {
+        magnitude /= 10;
+        width++;
+    }
+    return width;
+}
+
+/* Escribe `value` en exactamente aym_long_width(value) bytes desde `out`. */
+static void aym_long_write(char *out, long value, size_t width) {
+    unsigned long magnitude = value < 0 ? 0UL - (unsigned long)value : (unsigned long)value;
+    char *cursor = out + width;
+    do {
+        *--cursor = (char)('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude);
+    if (value < 0) *--cursor = '-';
+}
+
 char *aym_to_string(long value) {
-    char buffer[64];
-    int written = snprintf(buffer, sizeof(buffer), "%ld", value);
-    if (written < 0) return NULL;
-    size_t len = (size_t)written;
-    char *out = (char *)malloc(len + 1);
+    size_t width = aym_long_width(value);
+    char *out = aym_str_alloc(width);
     if (!out) return NULL;
-    memcpy(out, buffer, len);
-    out[len] = '\0';
+    aym_long_write(out, value, width);
+    return out;
+}
+
+/* Arma un texto a partir de `count` partes {tipo, valor} en una sola
+ * reserva: tipo AYM_PART_TEXT es un texto (nulo cuenta como "") y
+ * AYM_PART_LONG un entero que se formatea en su lugar. El compilador baja a
+ * esta llamada las cadenas `a + b + ...` y los textos $"...{x}...". */
+#define AYM_PART_TEXT 0
+#define AYM_PART_LONG 1
+
+char *aym_str_build(const intptr_t *parts, long count) {
+    size_t total = 0;
+    for (long i = 0; i < count; i++) {
+        intptr_t value = parts[2 * i + 1];
+        if (parts[2 * i] == AYM_PART_LONG) total += aym_long_width((long)value);
+        else total += aym_str_len((const char *)value);
+    }
+    char *out = aym_str_alloc(total);
+    if (!out) return NULL;
+    char *cursor = out;
+    for (long i = 0; i < count; i++) {
+        intptr_t value = parts[2 * i + 1];
+        if (parts[2 * i] == AYM_PART_LONG) {
+            size_t width = aym_long_width((long)value);
+            aym_long_write(cursor, (long)value, width);
+            cursor += width;
+        } else {
+            size_t len = aym_str_len((const char *)value);
+            if (len) memcpy(cursor, (const char *)value, len);
+            cursor += len;
+        }
+    }
     return out;
 }
 
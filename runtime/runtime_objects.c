@@ -0,0 +1,97 @@
+/* Objetos de clases `kasta` con layout fijo.
+ *
+ * El compilador emite un descriptor AymClass por clase (seccion .data) y
+ * resuelve cada atributo declarado a un desplazamiento constante, de modo que
+ * `aka.x` se traduce a un `mov` directo sobre AymObject.fields. Las funciones
+ * de este modulo cubren solo el acceso dinamico: atributos no declarados
+ * (guardados en el mapa `extra`), la vista como mapa para qillqa/sutinaka y la
+ * busqueda de metodos por nombre. La vtable (`methods`) se emite justo detras
+ * del descriptor; el codigo generado llama a cls->methods[slot] sin pasar por
+ * aqui. */
+typedef struct AymClass {
+    const char *name;
+    const struct AymClass *base;
+    long field_count;
+    const char *const *field_names;
+    const unsigned char *field_types;
+    long method_count;
+    const char *const *method_names;
+    const intptr_t *methods;
+} AymClass;
+
+typedef struct {
+    const AymClass *cls;
+    intptr_t extra;
+    intptr_t fields[];
+} AymObject;
+
+intptr_t aym_object_new(intptr_t cls) {
+    const AymClass *info = (const AymClass *)cls;
+    long count = info ? info->field_count : 0;
+    AymObject *obj = aym_gc_alloc(sizeof(AymObject) + sizeof(intptr_t) * (size_t)count, AYM_GC_RAW);
+    if (!obj) {
+        fprintf(stderr, "aym_object_new: allocation failed\n");
+        return 0;
+    }
+    obj->cls = info;
+    return (intptr_t)obj;
+}
+
+static long aym_object_field_index(const AymClass *cls, const char *name) {
+    if (!cls || !name) return -1;
+    for (long i = 0; i < cls->field_count; i++) {
+        if (strcmp(cls->field_names[i], name) == 0) return i;
+    }
+    return -1;
+}
+
+intptr_t aym_object_get(intptr_t obj, const char *name) {
+    AymObject *o = (AymObject *)obj;
+    if (!o) {
+        aym_map_missing_key(name);
+        return 0;
+    }
+    long idx = aym_object_field_index(o->cls, name);
+    if (idx >= 0) return o->fields[idx];
+    return aym_map_get(o->extra, name);
+}
+
+intptr_t aym_object_set(intptr_t obj, const char *name, intptr_t value, int is_string) {
+    AymObject *o = (AymObject *)obj;
+    if (!o || !name) return 0;
+    long idx = aym_object_field_index(o->cls, name);
+    if (idx >= 0) {
+        o->fields[idx] = value;
+        return value;
+    }
+    if (!o->extra) {
+        o->extra = aym_map_new(0);
+    }
+    return aym_map_set(o->extra, name, value, is_string);
+}
+
+intptr_t aym_object_method(intptr_t obj, const char *name) {
+    AymObject *o = (AymObject *)obj;
+    if (o && o->cls && name) {
+        for (long i = 0; i < o->cls->method_count; i++) {
+            if (strcmp(o->cls->method_names[i], name) == 0) return o->cls->methods[i];
+        }
+    }
+    aym_map_missing_key(name);
+    return 0;
+}
+
+intptr_t aym_object_to_map(intptr_t obj) {
+    AymObject *o = (AymObject *)obj;
+    if (!o) return aym_map_new(0);
+    long count = o->cls ? o->cls->field_count : 0;
+    intptr_t map = aym_map_new(count + aym_map_size(o->extra));
+    for (long i = 0; i < count; i++) {
+        aym_map_set(map, o->cls->field_names[i], o->fields[i], o->cls->field_types[i]);
+    }
+    for (long i = 0; i < aym_map_size(o->extra); i++) {
+        aym_map_set(map, aym_map_key_at(o->extra, i), aym_map_value_at(o->extra, i),
+                    (int)aym_map_value_is_string(o->extra, i));
+    }
+    return map;
+}
@@ -0,0 +1,59 @@
+/* Salida estandar de qillqa. Todo lo que el programa imprime pasa por un
+ * buffer propio de 64 KiB: sin formato que interpretar y sin bloquear stdio
+ * por cada valor. Con stdout en una terminal se vacia al ver un salto de
+ * linea; si no, al llenarse, al salir (atexit), antes de leer la entrada y
+ * con aym_write_flush. stdout queda sin buffer de stdio para que lo poco que
+ * el runtime escribe con printf (secuencias de terminal) salga en orden
+ * despues de vaciar este buffer. */
+#define AYM_OUT_BYTES (64 * 1024)
+
+static char aym_out_buf[AYM_OUT_BYTES];
+static size_t aym_out_used = 0;
+static int aym_out_line_mode = -1; /* -1 sin iniciar, 1 terminal, 0 bloques */
+
+void aym_write_flush(void);
+
+static void aym_out_init(void) {
+#ifdef _WIN32
+    aym_out_line_mode = _isatty(_fileno(stdout)) ? 1 : 0;
+#else
+    aym_out_line_mode = isatty(STDOUT_FILENO) ? 1 : 0;
+#endif
+    setvbuf(stdout, NULL, _IONBF, 0);
+    atexit(aym_write_flush);
+}
+
+void aym_write_flush(void) {
+    if (aym_out_line_mode < 0) aym_out_init();
+    if (aym_out_used) {
+        fwrite(aym_out_buf, 1, aym_out_used, stdout);
+        aym_out_used = 0;
+    }
+}
+
+static void aym_write_bytes(const char *data, size_t len) {
+    if (aym_out_line_mode < 0) aym_out_init();
+    if (aym_out_used + len > AYM_OUT_BYTES) {
+        aym_write_flush();
+        if (len > AYM_OUT_BYTES) {
+            fwrite(data, 1, len, stdout);
+            return;
+        }
+    }
+    memcpy(aym_out_buf + aym_out_used, data, len);
+    aym_out_used += len;
+    if (aym_out_line_mode && memchr(data, '\n', len)) aym_write_flush();
+}
+
+void aym_write_str(const char *text) {
+    size_t len = aym_str_len(text);
+    if (len) aym_write_bytes(text, len);
+}
+
+void aym_write_int(long value) {
+    if (aym_out_line_mode < 0) aym_out_init();
+    size_t width = aym_long_width(value);
+    if (aym_out_used + width > AYM_OUT_BYTES) aym_write_flush();
+    aym_long_write(aym_out_buf + aym_out_used, value, width);
+    aym_out_used += width;
+}
@@ -0,0 +1,263 @@
+/* Pool de hilos del runtime para `map_par`, `filter_par`, `reduce_par` y el
+ * ordenamiento en paralelo. Los hilos se crean la primera vez que hacen falta
+ * y quedan dormidos entre trabajos. La cantidad sale de la variable de
+ * entorno AYM_HILOS (contando el hilo que llama) o, si no esta, de los
+ * nucleos disponibles.
+ *
+ * Un trabajo es un rango de `chunks` trozos numerados. Cada hilo recibe una
+ * porcion contigua del rango y la consume desde adelante; cuando se le acaba
+ * roba trozos del final de la porcion de otro hilo. El hilo que llama tambien
+ * trabaja y espera a que terminen todos antes de volver.
+ *
+ * Una excepcion del runtime dentro de un trozo (aym_throw) no puede saltar al
+ * catch de otra pila: se guarda en el trabajo junto con el numero del trozo y
+ * el hilo que llamo la relanza al final. Si lanzan varios trozos gana el de
+ * numero menor, que es la que saldria corriendo todo en orden; por eso solo se
+ * descartan los trozos que vienen despues del que fallo. */
+
+#define AYM_POOL_MAX_THREADS 64
+
+#ifdef _WIN32
+typedef SRWLOCK AymLock;
+typedef CONDITION_VARIABLE AymCond;
+#define aym_lock_init(l) InitializeSRWLock(l)
+#define aym_lock(l) AcquireSRWLockExclusive(l)
+#define aym_unlock(l) ReleaseSRWLockExclusive(l)
+#define aym_cond_init(c) InitializeConditionVariable(c)
+#define aym_cond_wait(c, l) SleepConditionVariableSRW((c), (l), INFINITE, 0)
+#define aym_cond_broadcast(c) WakeAllConditionVariable(c)
+#else
+typedef pthread_mutex_t AymLock;
+typedef pthread_cond_t AymCond;
+#define aym_lock_init(l) pthread_mutex_init((l), NULL)
+#define aym_lock(l) pthread_mutex_lock(l)
+#define aym_unlock(l) pthread_mutex_unlock(l)
+#define aym_cond_init(c) pthread_cond_init((c), NULL)
+#define aym_cond_wait(c, l) pthread_cond_wait((c), (l))
+#define aym_cond_broadcast(c) pthread_cond_broadcast(c)
+#endif
+
+typedef void (*AymChunkFn)(void *ctx, long chunk);
+
+typedef struct {
+    AymLock lock;
+    long lo;
+    long hi;
+} AymPoolSlot;
+
+typedef struct {
+    AymChunkFn fn;
+    void *ctx;
+    long workers;
+    AymPoolSlot slots[AYM_POOL_MAX_THREADS];
+    volatile long failed; /* primer trozo que lanzo, o la cantidad de trozos */
+    intptr_t error;
+} AymPoolJob;
+
+static struct {
+    int state; /* 0 sin iniciar, 1 listo, -1 sin hilos */
+    long size;
+    AymLock lock;
+    AymCond wake;
+    AymCond done;
+    AymPoolJob *job;
+    unsigned long generation;
+    long active;
+    int busy;
+} aym_pool;
+
+/* Dentro de un trozo: donde salta aym_throw y la excepcion que dejo. */
+static __thread void **aym_pool_catch = NULL;
+static __thread intptr_t aym_pool_thrown = 0;
+static __thread int aym_pool_inside = 0;
+
+static long aym_cpu_count(void) {
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return (long)info.dwNumberOfProcessors;
+#else
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? n : 1;
+#endif
+}
+
+static long aym_pool_wanted(void) {
+    const char *env = getenv("AYM_HILOS");
+    long n = 0;
+    if (env && *env) {
+        char *end = NULL;
+        n = strtol(env, &end, 10);
+        if (end == env || *end != '\0') n = 0;
+    }
+    if (n <= 0) n = aym_cpu_count();
+    if (n > AYM_POOL_MAX_THREADS) n = AYM_POOL_MAX_THREADS;
+    return n;
+}
+
+/* Corre un trozo atrapando las excepciones del runtime. */
+static void aym_pool_run_chunk(AymPoolJob *job, long chunk) {
+    void *buf[5];
+    void **prev = aym_pool_catch;
+    aym_pool_catch = buf;
+    if (__builtin_setjmp(buf) == 0) {
+        job->fn(job->ctx, chunk);
+        aym_pool_catch = prev;
+        return;
+    }
+    aym_pool_catch = prev;
+    aym_lock(&aym_pool.lock);
+    if (chunk < job->failed) {
+        job->failed = chunk;
+        job->error = aym_pool_thrown;
+    }
+    aym_unlock(&aym_pool.lock);
+}
+
+static int aym_pool_take(AymPoolJob *job, long self, long *chunk) {
+    AymPoolSlot *own = &job->slots[self];
+    int found = 0;
+    aym_lock(&own->lock);
+    if (own->lo < own->hi) {
+        *chunk = own->lo++;
+        found = 1;
+    }
+    aym_unlock(&own->lock);
+    for (long k = 1; !found && k < job->workers; k++) {
+        AymPoolSlot *victim = &job->slots[(self + k) % job->workers];
+        aym_lock(&victim->lock);
+        if (victim->lo < victim->hi) {
+            *chunk = --victim->hi;
+            found = 1;
+        }
+        aym_unlock(&victim->lock);
+    }
+    return found;
+}
+
+static void aym_pool_work(AymPoolJob *job, long self) {
+    long chunk;
+    aym_pool_inside = 1;
+    while (aym_pool_take(job, self, &chunk)) {
+        if (chunk < job->failed) aym_pool_run_chunk(job, chunk);
+    }
+    aym_pool_inside = 0;
+}
+
+#ifdef _WIN32
+static DWORD WINAPI aym_pool_main(LPVOID arg)
+#else
+static void *aym_pool_main(void *arg)
+#endif
+{
+    long self = (long)(intptr_t)arg;
+    unsigned long seen = 0;
+    for (;;) {
+        aym_lock(&aym_pool.lock);
+        while (aym_pool.generation == seen) aym_cond_wait(&aym_pool.wake, &aym_pool.lock);
+        seen = aym_pool.generation;
+        AymPoolJob *job = aym_pool.job;
+        aym_unlock(&aym_pool.lock);
+        if (self < job->workers) aym_pool_work(job, self);
+        aym_lock(&aym_pool.lock);
+        if (--aym_pool.active == 0) aym_cond_broadcast(&aym_pool.done);
+        aym_unlock(&aym_pool.lock);
+    }
+#ifdef _WIN32
+    return 0;
+#else
+    return NULL;
+#endif
+}
+
+/* Cantidad de hilos que usa el pool, incluido el que llama. */
+static long aym_pool_threads(void) {
+    if (aym_pool.state != 0) return aym_pool.size;
+    aym_pool.size = 1;
+    aym_pool.state = -1;
+    long wanted = aym_pool_wanted();
+    if (wanted < 2) return 1;
+    aym_lock_init(&aym_pool.lock);
+    aym_cond_init(&aym_pool.wake);
+    aym_cond_init(&aym_pool.done);
+    for (long i = 1; i < wanted; i++) {
+        void *arg = (void *)(intptr_t)i;
+#ifdef _WIN32
+        HANDLE thread = CreateThread(NULL, 0, aym_pool_main, arg, 0, NULL);
+        if (!thread) break;
+        CloseHandle(thread);
+#else
+        pthread_t thread;
+        if (pthread_create(&thread, NULL, aym_pool_main, arg) != 0) break;
+        pthread_detach(thread);
+#endif
+        aym_pool.size++;
+    }
+    if (aym_pool.size > 1) aym_pool.state = 1;
+    return aym_pool.size;
+}
+
+/* Corre fn(ctx, i) para cada i en [0, chunks) repartido en el pool y vuelve
+ * cuando terminaron todos. Sin pool, o si se llama desde dentro de otro
+ * trabajo, corre todo en el hilo actual. */
+static void aym_pool_for(long chunks, AymChunkFn fn, void *ctx) {
+    if (chunks <= 0) return;
+    long size = aym_pool_threads();
+    if (size < 2 || chunks < 2 || aym_pool_inside) {
+        for (long i = 0; i < chunks; i++) fn(ctx, i);
+        return;
+    }
+    AymPoolJob job;
+    job.fn = fn;
+    job.ctx = ctx;
+    job.workers = chunks < size ? chunks : size;
+    job.failed = chunks;
+    job.error = 0;
+    for (long w = 0; w < job.workers; w++) {
+        aym_lock_init(&job.slots[w].lock);
+        job.slots[w].lo = chunks * w / job.workers;
+        job.slots[w].hi = chunks * (w + 1) / job.workers;
+    }
+    aym_lock(&aym_pool.lock);
+    if (aym_pool.busy) {
+        aym_unlock(&aym_pool.lock);
+        for (long i = 0; i < chunks; i++) fn(ctx, i);
+        return;
+    }
+    aym_pool.busy = 1;
+    aym_pool.job = &job;
+    aym_pool.active = size - 1;
+    aym_pool.generation++;
+    aym_cond_broadcast(&aym_pool.wake);
+    aym_unlock(&aym_pool.lock);
+
+    aym_pool_work(&job, 0);
+
+    aym_lock(&aym_pool.lock);
+    while (aym_pool.active > 0) aym_cond_wait(&aym_pool.done, &aym_pool.lock);
+    aym_pool.busy = 0;
+    aym_unlock(&aym_pool.lock);
+#ifndef _WIN32
+    for (long w = 0; w < job.workers; w++) pthread_mutex_destroy(&job.slots[w].lock);
+#endif
+    if (job.failed < chunks) aym_throw(job.error);
+}
+
+typedef void (*AymTaskFn)(void *task);
+
+typedef struct {
+    AymTaskFn fn;
+    char *tasks;
+    size_t task_size;
+} AymTaskList;
+
+static void aym_pool_task_chunk(void *ctx, long chunk) {
+    AymTaskList *list = (AymTaskList*)ctx;
+    list->fn(list->tasks + (size_t)chunk * list->task_size);
+}
+
+/* Corre fn sobre cada una de las `count` tareas (de `task_size` bytes). */
+static void aym_run_tasks(AymTaskFn fn, void *tasks, size_t task_size, long count) {
+    AymTaskList list = {fn, (char *)tasks, task_size};
+    aym_pool_for(count, aym_pool_task_chunk, &list);
+}
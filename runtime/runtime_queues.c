@@ -0,0 +1,290 @@
+/* Cola doble (`siqi`) sobre un buffer circular: `head` es la posicion del
+ * primer elemento y `cap` siempre es potencia de dos, asi que los indices se
+ * envuelven con una mascara. Meter y sacar por cualquiera de los dos extremos
+ * es O(1) amortizado; al crecer se copian los elementos en orden a un buffer
+ * nuevo empezando en 0. `is_string` solo sirve para imprimirla. */
+typedef struct {
+    long head;
+    long len;
+    long cap;
+    intptr_t *data;
+    long is_string;
+} AymDeque;
+
+static int aym_deque_grow(AymDeque *d) {
+    long newCap = d->cap > 0 ? d->cap * 2 : 8;
+    intptr_t *data = malloc(sizeof(intptr_t) * (size_t)newCap);
+    if (!data) {
+        fprintf(stderr, "aym_deque_push: allocation failed\n");
+        return 0;
+    }
+    for (long i = 0; i < d->len; i++) {
+        data[i] = d->data[(d->head + i) & (d->cap - 1)];
+    }
+    free(d->data);
+    aym_gc_note(sizeof(intptr_t) * (size_t)(newCap - d->cap));
+    d->data = data;
+    d->cap = newCap;
+    d->head = 0;
+    return 1;
+}
+
+intptr_t aym_deque_new(long is_string) {
+    AymDeque *d = aym_gc_alloc(sizeof(AymDeque), AYM_GC_DEQUE);
+    if (!d) {
+        fprintf(stderr, "aym_deque_new: allocation failed\n");
+        return 0;
+    }
+    d->is_string = is_string ? 1 : 0;
+    return (intptr_t)d;
+}
+
+void aym_deque_free(intptr_t deque) {
+    if (!deque) return;
+    AymDeque *d = (AymDeque*)deque;
+    free(d->data);
+    aym_gc_release(d);
+}
+
+static void aym_deque_gc_visit(void *body, AymGcVisitFn visit, void *ctx) {
+    AymDeque *d = (AymDeque*)body;
+    visit(ctx, d->data, sizeof(intptr_t) * (size_t)d->cap);
+}
+
+static size_t aym_deque_gc_free(void *body) {
+    AymDeque *d = (AymDeque*)body;
+    free(d->data);
+    return sizeof(intptr_t) * (size_t)d->cap;
+}
+
+long aym_deque_size(intptr_t deque) {
+    if (!deque) return 0;
+    return ((AymDeque*)deque)->len;
+}
+
+long aym_deque_is_string(intptr_t deque) {
+    if (!deque) return 0;
+    return ((AymDeque*)deque)->is_string;
+}
+
+long aym_deque_push_back(intptr_t deque, intptr_t value) {
+    if (!deque) return 0;
+    AymDeque *d = (AymDeque*)deque;
+    if (d->len == d->cap && !aym_deque_grow(d)) return d->len;
+    d->data[(d->head + d->len) & (d->cap - 1)] = value;
+    d->len++;
+    return d->len;
+}
+
+long aym_deque_push_front(intptr_t deque, intptr_t value) {
+    if (!deque) return 0;
+    AymDeque *d = (AymDeque*)deque;
+    if (d->len == d->cap && !aym_deque_grow(d)) return d->len;
+    d->head = (d->head - 1) & (d->cap - 1);
+    d->data[d->head] = value;
+    d->len++;
+    return d->len;
+}
+
+intptr_t aym_deque_pop_back(intptr_t deque) {
+    AymDeque *d = (AymDeque*)deque;
+    if (!d || d->len <= 0) {
+        aym_throw_typed("VACIO", "siqi vacia");
+        return 0;
+    }
+    d->len--;
+    return d->data[(d->head + d->len) & (d->cap - 1)];
+}
+
+intptr_t aym_deque_pop_front(intptr_t deque) {
+    AymDeque *d = (AymDeque*)deque;
+    if (!d || d->len <= 0) {
+        aym_throw_typed("VACIO", "siqi vacia");
+        return 0;
+    }
+    intptr_t value = d->data[d->head];
+    d->head = (d->head + 1) & (d->cap - 1);
+    d->len--;
+    return value;
+}
+
+/* Lista nueva con los elementos de adelante hacia atras. */
+intptr_t aym_deque_items(intptr_t deque) {
+    if (!deque) return aym_array_new(0);
+    AymDeque *d = (AymDeque*)deque;
+    intptr_t arr = aym_array_new(d->len);
+    if (!arr) return 0;
+    AymArray *dst = (AymArray*)arr;
+    for (long i = 0; i < d->len; i++) {
+        dst->data[i] = d->data[(d->head + i) & (d->cap - 1)];
+    }
+    return arr;
+}
+
+intptr_t aym_deque_from_array(intptr_t arr, long is_string) {
+    intptr_t deque = aym_deque_new(is_string);
+    if (!deque || !arr) return deque;
+    AymArray *a = (AymArray*)arr;
+    for (long i = 0; i < a->len; i++) {
+        aym_deque_push_back(deque, a->data[i]);
+    }
+    return deque;
+}
+
+/* Monticulo binario (`qullu`) guardado en un arreglo: los hijos de i estan en
+ * 2i+1 y 2i+2 y la cima en 0. `cmp` es una funcion del programa (`&f`) que
+ * recibe dos elementos y devuelve chiqa si el primero debe salir antes; sin
+ * ella se saca primero el menor (numeros, o textos en orden de strcmp). */
+typedef struct {
+    long len;
+    long cap;
+    intptr_t *data;
+    intptr_t cmp;
+    long is_string;
+} AymHeap;
+
+static int aym_heap_before(const AymHeap *h, intptr_t a, intptr_t b) {
+    if (h->cmp) return ((AymBinaryFn)h->cmp)(a, b) != 0;
+    if (h->is_string) return strcmp((const char *)a, (const char *)b) < 0;
+    return a < b;
+}
+
+static void aym_heap_sift_up(AymHeap *h, long i) {
+    intptr_t value = h->data[i];
+    while (i > 0) {
+        long parent = (i - 1) / 2;
+        if (!aym_heap_before(h, value, h->data[parent])) break;
+        h->data[i] = h->data[parent];
+        i = parent;
+    }
+    h->data[i] = value;
+}
+
+static void aym_heap_sift_down(AymHeap *h, long i) {
+    intptr_t value = h->data[i];
+    while (1) {
+        long child = 2 * i + 1;
+        if (child >= h->len) break;
+        if (child + 1 < h->len && aym_heap_before(h, h->data[child + 1], h->data[child])) {
+            child++;
+        }
+        if (!aym_heap_before(h, h->data[child], value)) break;
+        h->data[i] = h->data[child];
+        i = child;
+    }
+    h->data[i] = value;
+}
+
+intptr_t aym_heap_new(intptr_t cmp, long is_string) {
+    AymHeap *h = aym_gc_alloc(sizeof(AymHeap), AYM_GC_HEAP);
+    if (!h) {
+        fprintf(stderr, "aym_heap_new: allocation failed\n");
+        return 0;
+    }
+    h->cmp = cmp;
+    h->is_string = is_string ? 1 : 0;
+    return (intptr_t)h;
+}
+
+void aym_heap_free(intptr_t heap) {
+    if (!heap) return;
+    AymHeap *h = (AymHeap*)heap;
+    free(h->data);
+    aym_gc_release(h);
+}
+
+static void aym_heap_gc_visit(void *body, AymGcVisitFn visit, void *ctx) {
+    AymHeap *h = (AymHeap*)body;
+    visit(ctx, h->data, sizeof(intptr_t) * (size_t)h->cap);
+}
+
+static size_t aym_heap_gc_free(void *body) {
+    AymHeap *h = (AymHeap*)body;
+    free(h->data);
+    return sizeof(intptr_t) * (size_t)h->cap;
+}
+
+long aym_heap_size(intptr_t heap) {
+    if (!heap) return 0;
+    return ((AymHeap*)heap)->len;
+}
+
+long aym_heap_is_string(intptr_t heap) {
+    if (!heap) return 0;
+    return ((AymHeap*)heap)->is_string;
+}
+
+long aym_heap_push(intptr_t heap, intptr_t value) {
+    if (!heap) return 0;
+    AymHeap *h = (AymHeap*)heap;
+    if (h->len == h->cap) {
+        long newCap = h->cap > 0 ? h->cap * 2 : 8;
+        intptr_t *data = realloc(h->data, sizeof(intptr_t) * (size_t)newCap);
+        if (!data) {
+            fprintf(stderr, "aym_heap_push: allocation failed\n");
+            return h->len;
+        }
+        aym_gc_note(sizeof(intptr_t) * (size_t)(newCap - h->cap));
+        h->data = data;
+        h->cap = newCap;
+    }
+    h->data[h->len] = value;
+    aym_heap_sift_up(h, h->len);
+    h->len++;
+    return h->len;
+}
+
+intptr_t aym_heap_peek(intptr_t heap) {
+    AymHeap *h = (AymHeap*)heap;
+    if (!h || h->len <= 0) {
+        aym_throw_typed("VACIO", "qullu vacio");
+        return 0;
+    }
+    return h->data[0];
+}
+
+intptr_t aym_heap_pop(intptr_t heap) {
+    AymHeap *h = (AymHeap*)heap;
+    if (!h || h->len <= 0) {
+        aym_throw_typed("VACIO", "qullu vacio");
+        return 0;
+    }
+    intptr_t top = h->data[0];
+    h->len--;
+    if (h->len > 0) {
+        h->data[0] = h->data[h->len];
+        aym_heap_sift_down(h, 0);
+    }
+    return top;
+}
+
+/* Lista nueva en el orden interno del monticulo (la cima primero). */
+intptr_t aym_heap_items(intptr_t heap) {
+    if (!heap) return aym_array_new(0);
+    AymHeap *h = (AymHeap*)heap;
+    intptr_t arr = aym_array_new(h->len);
+    if (!arr) return 0;
+    AymArray *dst = (AymArray*)arr;
+    for (long i = 0; i < h->len; i++) dst->data[i] = h->data[i];
+    return arr;
+}
+
+/* Construye el monticulo de una lista en O(n) hundiendo cada padre. */
+intptr_t aym_heap_from_array(intptr_t arr, intptr_t cmp, long is_string) {
+    intptr_t heap = aym_heap_new(cmp, is_string);
+    if (!heap || !arr) return heap;
+    AymHeap *h = (AymHeap*)heap;
+    AymArray *a = (AymArray*)arr;
+    if (a->len <= 0) return heap;
+    h->data = malloc(sizeof(intptr_t) * (size_t)a->len);
+    if (!h->data) {
+        fprintf(stderr, "aym_heap_new: allocation failed\n");
+        return heap;
+    }
+    aym_gc_note(sizeof(intptr_t) * (size_t)a->len);
+    memcpy(h->data, a->data, sizeof(intptr_t) * (size_t)a->len);
+    h->len = a->len;
+    h->cap = a->len;
+    for (long i = h->len / 2 - 1; i >= 0; i--) aym_heap_sift_down(h, i);
+    return heap;
+}
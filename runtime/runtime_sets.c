@@ -0,0 +1,198 @@
+/* Conjunto (`tama`) con el mismo esquema que AymMap: los elementos viven en
+ * arreglos densos en orden de insercion y `slots` es la tabla hash (potencia
+ * de dos, sondeo lineal, marcadores AYM_MAP_EMPTY/AYM_MAP_TOMBSTONE). Un
+ * elemento es un entero o un texto segun `is_string`, que el compilador pasa
+ * en cada llamada; el conjunto recuerda el tipo del primero para imprimirse.
+ * Ningun hash vale 0, asi que hashes[i] == 0 marca el hueco de un borrado. */
+typedef struct {
+    long len;
+    long cap;
+    intptr_t *items;
+    uint64_t *hashes;
+    long used;
+    long *slots;
+    long slot_count;
+    long is_string;
+} AymSet;
+
+static uint64_t aym_set_hash(intptr_t value, long is_string) {
+    return is_string ? aym_str_hash((const char *)value) : aym_int_hash(value);
+}
+
+static long aym_set_find_hashed(AymSet *set, intptr_t value, uint64_t hash, long is_string,
+                                size_t *slot) {
+    if (!set->slots) return -1;
+    size_t mask = (size_t)set->slot_count - 1;
+    size_t pos = (size_t)hash & mask;
+    while (1) {
+        long entry = set->slots[pos];
+        if (entry == AYM_MAP_EMPTY) return -1;
+        if (entry >= 0 && set->hashes[entry] == hash &&
+            (is_string ? aym_str_eq((const char *)set->items[entry], (const char *)value)
+                       : set->items[entry] == value)) {
+            if (slot) *slot = pos;
+            return entry;
+        }
+        pos = (pos + 1) & mask;
+    }
+}
+
+/* Elimina los huecos de aym_set_remove conservando el orden y reconstruye la
+ * tabla con `slot_count` posiciones. */
+static int aym_set_rehash(AymSet *set, long slot_count) {
+    long *slots = malloc(sizeof(long) * (size_t)slot_count);
+    if (!slots) {
+        fprintf(stderr, "aym_set_add: allocation failed\n");
+        return 0;
+    }
+    for (long i = 0; i < slot_count; i++) slots[i] = AYM_MAP_EMPTY;
+    long live = 0;
+    for (long i = 0; i < set->used; i++) {
+        if (!set->hashes[i]) continue;
+        set->items[live] = set->items[i];
+        set->hashes[live] = set->hashes[i];
+        size_t pos = (size_t)set->hashes[live] & (size_t)(slot_count - 1);
+        while (slots[pos] != AYM_MAP_EMPTY) pos = (pos + 1) & (size_t)(slot_count - 1);
+        slots[pos] = live;
+        live++;
+    }
+    free(set->slots);
+    set->slots = slots;
+    set->slot_count = slot_count;
+    set->used = live;
+    return 1;
+}
+
+static int aym_set_grow(AymSet *set) {
+    long newCap = set->cap > 0 ? set->cap * 2 : 8;
+    intptr_t *newItems = realloc(set->items, sizeof(intptr_t) * (size_t)newCap);
+    if (newItems) set->items = newItems;
+    uint64_t *newHashes = realloc(set->hashes, sizeof(uint64_t) * (size_t)newCap);
+    if (newHashes) set->hashes = newHashes;
+    if (!newItems || !newHashes) {
+        fprintf(stderr, "aym_set_add: allocation failed\n");
+        return 0;
+    }
+    aym_gc_note((sizeof(intptr_t) + sizeof(uint64_t)) * (size_t)(newCap - set->cap));
+    set->cap = newCap;
+    return 1;
+}
+
+intptr_t aym_set_new(void) {
+    AymSet *set = aym_gc_alloc(sizeof(AymSet), AYM_GC_SET);
+    if (!set) {
+        fprintf(stderr, "aym_set_new: allocation failed\n");
+        return 0;
+    }
+    set->is_string = -1;
+    return (intptr_t)set;
+}
+
+void aym_set_free(intptr_t set) {
+    if (!set) return;
+    AymSet *s = (AymSet*)set;
+    aym_set_gc_free(s);
+    aym_gc_release(s);
+}
+
+static void aym_set_gc_visit(void *body, AymGcVisitFn visit, void *ctx) {
+    AymSet *set = (AymSet*)body;
+    visit(ctx, set->items, sizeof(intptr_t) * (size_t)set->cap);
+}
+
+static size_t aym_set_gc_free(void *body) {
+    AymSet *set = (AymSet*)body;
+    free(set->items);
+    free(set->hashes);
+    free(set->slots);
+    return (sizeof(intptr_t) + sizeof(uint64_t)) * (size_t)set->cap +
+           sizeof(long) * (size_t)set->slot_count;
+}
+
+long aym_set_size(intptr_t set) {
+    if (!set) return 0;
+    return ((AymSet*)set)->len;
+}
+
+long aym_set_is_string(intptr_t set) {
+    if (!set) return 0;
+    return ((AymSet*)set)->is_string > 0;
+}
+
+long aym_set_contains(intptr_t set, intptr_t value, long is_string) {
+    if (!set) return 0;
+    AymSet *s = (AymSet*)set;
+    if (!s->len) return 0;
+    return aym_set_find_hashed(s, value, aym_set_hash(value, is_string), is_string, NULL) >= 0;
+}
+
+/* Devuelve 1 si el elemento no estaba y se agrego. */
+long aym_set_add(intptr_t set, intptr_t value, long is_string) {
+    if (!set) return 0;
+    AymSet *s = (AymSet*)set;
+    uint64_t hash = aym_set_hash(value, is_string);
+    if (aym_set_find_hashed(s, value, hash, is_string, NULL) >= 0) return 0;
+    if (s->is_string < 0) s->is_string = is_string ? 1 : 0;
+    if (s->used >= s->cap) {
+        if (s->used - s->len > s->used / 2) {
+            aym_set_rehash(s, s->slot_count);
+        }
+        if (s->used >= s->cap && !aym_set_grow(s)) return 0;
+    }
+    /* Factor de carga maximo 3/4 contando lapidas, igual que los mapas. */
+    if ((s->used + 1) * 4 > s->slot_count * 3) {
+        long slots = s->slot_count > 0 ? s->slot_count : AYM_MAP_MIN_SLOTS;
+        while ((s->len + 1) * 4 > slots * 3 / 2) slots *= 2;
+        if (!aym_set_rehash(s, slots)) return 0;
+    }
+    long entry = s->used++;
+    s->items[entry] = value;
+    s->hashes[entry] = hash;
+    size_t mask = (size_t)s->slot_count - 1;
+    size_t pos = (size_t)hash & mask;
+    while (s->slots[pos] >= 0) pos = (pos + 1) & mask;
+    s->slots[pos] = entry;
+    s->len++;
+    return 1;
+}
+
+/* Devuelve 1 si el elemento estaba y se quito. */
+long aym_set_remove(intptr_t set, intptr_t value, long is_string) {
+    if (!set) return 0;
+    AymSet *s = (AymSet*)set;
+    size_t pos = 0;
+    long idx = aym_set_find_hashed(s, value, aym_set_hash(value, is_string), is_string, &pos);
+    if (idx < 0) return 0;
+    s->slots[pos] = AYM_MAP_TOMBSTONE;
+    s->hashes[idx] = 0;
+    s->len--;
+    if (s->len == 0) {
+        for (long i = 0; i < s->slot_count; i++) s->slots[i] = AYM_MAP_EMPTY;
+        s->used = 0;
+    }
+    return 1;
+}
+
+/* Lista nueva con los elementos en orden de insercion. */
+intptr_t aym_set_items(intptr_t set) {
+    if (!set) return aym_array_new(0);
+    AymSet *s = (AymSet*)set;
+    intptr_t arr = aym_array_new(s->len);
+    if (!arr) return 0;
+    AymArray *dst = (AymArray*)arr;
+    long out = 0;
+    for (long i = 0; i < s->used; i++) {
+        if (s->hashes[i]) dst->data[out++] = s->items[i];
+    }
+    return arr;
+}
+
+intptr_t aym_set_from_array(intptr_t arr, long is_string) {
+    intptr_t set = aym_set_new();
+    if (!set || !arr) return set;
+    AymArray *a = (AymArray*)arr;
+    for (long i = 0; i < a->len; i++) {
+        aym_set_add(set, a->data[i], is_string);
+    }
+    return set;
+}
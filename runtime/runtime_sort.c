@@ -0,0 +1,487 @@
+/* Ordenamiento de listas (`wakicha` y `wakicha_clave`). Los enteros usan radix
+ * LSD de 8 bits y los textos un pdqsort con la comparacion en linea, sin la
+ * llamada indirecta por comparacion de `qsort`. Las listas de al menos
+ * AYM_SORT_PARALLEL_MIN elementos se parten en trozos que se ordenan en el
+ * pool de hilos (runtime_pool.c) y luego se mezclan de a pares, tambien en el
+ * pool. */
+
+#define AYM_SORT_INSERTION 24
+#define AYM_SORT_NINTHER 128
+#define AYM_SORT_PARALLEL_MIN (1L << 20)
+#define AYM_SORT_MAX_THREADS 8
+
+static int aym_cmp_intptr(const void *left, const void *right) {
+    intptr_t a = *(const intptr_t *)left;
+    intptr_t b = *(const intptr_t *)right;
+    if (a < b) return -1;
+    if (a > b) return 1;
+    return 0;
+}
+
+static inline int aym_sort_str_less(intptr_t a, intptr_t b) {
+    const char *x = (const char *)a;
+    const char *y = (const char *)b;
+    if (!x || !y) return !x && y;
+    return strcmp(x, y) < 0;
+}
+
+static inline int aym_sort_less(intptr_t a, intptr_t b, long is_string) {
+    return is_string ? aym_sort_str_less(a, b) : a < b;
+}
+
+/* LSD de 8 bits sobre la primera palabra de cada elemento de `words` palabras
+ * (1 para enteros, 2 para pares clave/indice de wakicha_clave). Se ordena
+ * `clave - minimo` como sin signo, asi que los negativos quedan antes y solo
+ * se hacen las pasadas que cubren el rango; tambien se saltan las pasadas en
+ * que todos los elementos caen en el mismo balde. Es estable. */
+static void aym_radix_sort(intptr_t *data, intptr_t *tmp, long n, int words) {
+    intptr_t lo = data[0];
+    intptr_t hi = data[0];
+    for (long i = 1; i < n; i++) {
+        intptr_t key = data[i * words];
+        if (key < lo) lo = key;
+        if (key > hi) hi = key;
+    }
+    uint64_t range = (uint64_t)hi - (uint64_t)lo;
+    int passes = 0;
+    while (passes < 8 && (range >> (8 * passes)) != 0) passes++;
+    size_t counts[8][256];
+    memset(counts, 0, sizeof(counts));
+    for (long i = 0; i < n; i++) {
+        uint64_t key = (uint64_t)data[i * words] - (uint64_t)lo;
+        for (int b = 0; b < passes; b++) counts[b][(key >> (8 * b)) & 0xff]++;
+    }
+    intptr_t *src = data;
+    intptr_t *dst = tmp;
+    for (int b = 0; b < passes; b++) {
+        size_t *count = counts[b];
+        if (count[(((uint64_t)src[0] - (uint64_t)lo) >> (8 * b)) & 0xff] == (size_t)n) continue;
+        size_t sum = 0;
+        for (int d = 0; d < 256; d++) {
+            size_t c = count[d];
+            count[d] = sum;
+            sum += c;
+        }
+        for (long i = 0; i < n; i++) {
+            const intptr_t *item = src + i * words;
+            size_t pos = count[(((uint64_t)item[0] - (uint64_t)lo) >> (8 * b)) & 0xff]++;
+            dst[pos * words] = item[0];
+            if (words == 2) dst[pos * words + 1] = item[1];
+        }
+        intptr_t *swap = src;
+        src = dst;
+        dst = swap;
+    }
+    if (src != data) memcpy(data, src, sizeof(intptr_t) * (size_t)n * (size_t)words);
+}
+
+/* pdqsort (Orson Peters) sobre textos: quicksort con pivote mediana de tres
+ * (o ninther), particion a la izquierda para tramos de iguales, insercion
+ * parcial cuando la particion no movio nada y heapsort si se acumulan
+ * particiones desbalanceadas. */
+static void aym_pdq_swap(intptr_t *a, intptr_t *b) {
+    intptr_t t = *a;
+    *a = *b;
+    *b = t;
+}
+
+static void aym_pdq_sort2(intptr_t *a, intptr_t *b) {
+    if (aym_sort_str_less(*b, *a)) aym_pdq_swap(a, b);
+}
+
+static void aym_pdq_sort3(intptr_t *a, intptr_t *b, intptr_t *c) {
+    aym_pdq_sort2(a, b);
+    aym_pdq_sort2(b, c);
+    aym_pdq_sort2(a, b);
+}
+
+static void aym_pdq_insertion(intptr_t *begin, intptr_t *end, int guarded) {
+    if (begin == end) return;
+    for (intptr_t *cur = begin + 1; cur != end; ++cur) {
+        intptr_t *sift = cur;
+        intptr_t *sift_1 = cur - 1;
+        if (aym_sort_str_less(*sift, *sift_1)) {
+            intptr_t value = *sift;
+            do {
+                *sift-- = *sift_1;
+            } while ((!guarded || sift != begin) && aym_sort_str_less(value, *--sift_1));
+            *sift = value;
+        }
+    }
+}
+
+/* Insercion que se rinde tras mover mas de 8 elementos. */
+static int aym_pdq_partial_insertion(intptr_t *begin, intptr_t *end) {
+    if (begin == end) return 1;
+    long moved = 0;
+    for (intptr_t *cur = begin + 1; cur != end; ++cur) {
+        intptr_t *sift = cur;
+        intptr_t *sift_1 = cur - 1;
+        if (aym_sort_str_less(*sift, *sift_1)) {
+            intptr_t value = *sift;
+            do {
+                *sift-- = *sift_1;
+            } while (sift != begin && aym_sort_str_less(value, *--sift_1));
+            *sift = value;
+            moved += cur - sift;
+        }
+        if (moved > 8) return 0;
+    }
+    return 1;
+}
+
+static void aym_pdq_sift_down(intptr_t *heap, long root, long n) {
+    intptr_t value = heap[root];
+    while (1) {
+        long child = 2 * root + 1;
+        if (child >= n) break;
+        if (child + 1 < n && aym_sort_str_less(heap[child], heap[child + 1])) child++;
+        if (!aym_sort_str_less(value, heap[child])) break;
+        heap[root] = heap[child];
+        root = child;
+    }
+    heap[root] = value;
+}
+
+static void aym_pdq_heapsort(intptr_t *begin, intptr_t *end) {
+    long n = end - begin;
+    for (long i = n / 2 - 1; i >= 0; i--) aym_pdq_sift_down(begin, i, n);
+    for (long last = n - 1; last > 0; last--) {
+        aym_pdq_swap(begin, begin + last);
+        aym_pdq_sift_down(begin, 0, last);
+    }
+}
+
+/* Deja el pivote (*begin) en su lugar con los menores a la izquierda; los
+ * iguales van a la derecha. `already` indica que no hubo intercambios. */
+static intptr_t *aym_pdq_partition_right(intptr_t *begin, intptr_t *end, int *already) {
+    intptr_t pivot = *begin;
+    intptr_t *first = begin;
+    intptr_t *last = end;
+    while (aym_sort_str_less(*++first, pivot)) {}
+    if (first - 1 == begin) {
+        while (first < last && !aym_sort_str_less(*--last, pivot)) {}
+    } else {
+        while (!aym_sort_str_less(*--last, pivot)) {}
+    }
+    *already = first >= last;
+    while (first < last) {
+        aym_pdq_swap(first, last);
+        while (aym_sort_str_less(*++first, pivot)) {}
+        while (!aym_sort_str_less(*--last, pivot)) {}
+    }
+    intptr_t *pivot_pos = first - 1;
+    *begin = *pivot_pos;
+    *pivot_pos = pivot;
+    return pivot_pos;
+}
+
+/* Igual, pero los iguales al pivote van a la izquierda: se usa cuando el
+ * pivote es igual al elemento anterior al tramo, asi que todo ese lado ya
+ * queda en su lugar. */
+static intptr_t *aym_pdq_partition_left(intptr_t *begin, intptr_t *end) {
+    intptr_t pivot = *begin;
+    intptr_t *first = begin;
+    intptr_t *last = end;
+    while (aym_sort_str_less(pivot, *--last)) {}
+    if (last + 1 == end) {
+        while (first < last && !aym_sort_str_less(pivot, *++first)) {}
+    } else {
+        while (!aym_sort_str_less(pivot, *++first)) {}
+    }
+    while (first < last) {
+        aym_pdq_swap(first, last);
+        while (aym_sort_str_less(pivot, *--last)) {}
+        while (!aym_sort_str_less(pivot, *++first)) {}
+    }
+    *begin = *last;
+    *last = pivot;
+    return last;
+}
+
+static void aym_pdq_loop(intptr_t *begin, intptr_t *end, int bad_allowed, int leftmost) {
+    while (1) {
+        long size = end - begin;
+        if (size < AYM_SORT_INSERTION) {
+            aym_pdq_insertion(begin, end, leftmost);
+            return;
+        }
+        long half = size / 2;
+        if (size > AYM_SORT_NINTHER) {
+            aym_pdq_sort3(begin, begin + half, end - 1);
+            aym_pdq_sort3(begin + 1, begin + (half - 1), end - 2);
+            aym_pdq_sort3(begin + 2, begin + (half + 1), end - 3);
+            aym_pdq_sort3(begin + (half - 1), begin + half, begin + (half + 1));
+            aym_pdq_swap(begin, begin + half);
+        } else {
+            aym_pdq_sort3(begin + half, begin, end - 1);
+        }
+        if (!leftmost && !aym_sort_str_less(*(begin - 1), *begin)) {
+            begin = aym_pdq_partition_left(begin, end) + 1;
+            continue;
+        }
+        int already = 0;
+        intptr_t *pivot_pos = aym_pdq_partition_right(begin, end, &already);
+        long l_size = pivot_pos - begin;
+        long r_size = end - (pivot_pos + 1);
+        if (l_size < size / 8 || r_size < size / 8) {
+            if (--bad_allowed == 0) {
+                aym_pdq_heapsort(begin, end);
+                return;
+            }
+            /* Rompe patrones que engañan a la mediana moviendo algunos
+             * elementos de cada lado. */
+            if (l_size >= AYM_SORT_INSERTION) {
+                aym_pdq_swap(begin, begin + l_size / 4);
+                aym_pdq_swap(pivot_pos - 1, pivot_pos - l_size / 4);
+                if (l_size > AYM_SORT_NINTHER) {
+                    aym_pdq_swap(begin + 1, begin + (l_size / 4 + 1));
+                    aym_pdq_swap(begin + 2, begin + (l_size / 4 + 2));
+                    aym_pdq_swap(pivot_pos - 2, pivot_pos - (l_size / 4 + 1));
+                    aym_pdq_swap(pivot_pos - 3, pivot_pos - (l_size / 4 + 2));
+                }
+            }
+            if (r_size >= AYM_SORT_INSERTION) {
+                aym_pdq_swap(pivot_pos + 1, pivot_pos + (1 + r_size / 4));
+                aym_pdq_swap(end - 1, end - r_size / 4);
+                if (r_size > AYM_SORT_NINTHER) {
+                    aym_pdq_swap(pivot_pos + 2, pivot_pos + (2 + r_size / 4));
+                    aym_pdq_swap(pivot_pos + 3, pivot_pos + (3 + r_size / 4));
+                    aym_pdq_swap(end - 2, end - (1 + r_size / 4));
+                    aym_pdq_swap(end - 3, end - (2 + r_size / 4));
+                }
+            }
+        } else if (already && aym_pdq_partial_insertion(begin, pivot_pos) &&
+                   aym_pdq_partial_insertion(pivot_pos + 1, end)) {
+            return;
+        }
+        aym_pdq_loop(begin, pivot_pos, bad_allowed, leftmost);
+        begin = pivot_pos + 1;
+        leftmost = 0;
+    }
+}
+
+static void aym_pdqsort_str(intptr_t *data, long n) {
+    if (n < 2) return;
+    int bad_allowed = 1;
+    for (long m = n; m > 1; m >>= 1) bad_allowed++;
+    aym_pdq_loop(data, data + n, bad_allowed, 1);
+}
+
+/* Ordena `data` usando `tmp` (n palabras) como buffer auxiliar. */
+static void aym_sort_words(intptr_t *data, intptr_t *tmp, long n, long is_string) {
+    if (n < 2) return;
+    if (is_string) {
+        aym_pdqsort_str(data, n);
+    } else if (n < AYM_SORT_INSERTION) {
+        for (long i = 1; i < n; i++) {
+            intptr_t value = data[i];
+            long j = i;
+            while (j > 0 && data[j - 1] > value) {
+                data[j] = data[j - 1];
+                j--;
+            }
+            data[j] = value;
+        }
+    } else {
+        aym_radix_sort(data, tmp, n, 1);
+    }
+}
+
+static void aym_sort_merge(const intptr_t *left, long nl, const intptr_t *right, long nr,
+                           intptr_t *out, long is_string) {
+    long i = 0, j = 0, k = 0;
+    while (i < nl && j < nr) {
+        out[k++] = aym_sort_less(right[j], left[i], is_string) ? right[j++] : left[i++];
+    }
+    while (i < nl) out[k++] = left[i++];
+    while (j < nr) out[k++] = right[j++];
+}
+
+typedef struct {
+    intptr_t *data;
+    intptr_t *tmp;
+    long n;
+    long is_string;
+} AymSortTask;
+
+typedef struct {
+    const intptr_t *left;
+    long nl;
+    const intptr_t *right;
+    long nr;
+    intptr_t *out;
+    long is_string;
+} AymMergeTask;
+
+static void aym_sort_task(void *arg) {
+    AymSortTask *t = (AymSortTask*)arg;
+    aym_sort_words(t->data, t->tmp, t->n, t->is_string);
+}
+
+static void aym_merge_task(void *arg) {
+    AymMergeTask *t = (AymMergeTask*)arg;
+    aym_sort_merge(t->left, t->nl, t->right, t->nr, t->out, t->is_string);
+}
+
+/* Parte en `parts` trozos (potencia de dos), los ordena en el pool y
+ * mezcla de a pares hasta que queda uno. */
+static void aym_sort_parallel(intptr_t *data, intptr_t *tmp, long n, long is_string, long parts) {
+    long bounds[AYM_SORT_MAX_THREADS + 1];
+    for (long i = 0; i <= parts; i++) bounds[i] = n * i / parts;
+    AymSortTask sorts[AYM_SORT_MAX_THREADS];
+    for (long i = 0; i < parts; i++) {
+        sorts[i].data = data + bounds[i];
+        sorts[i].tmp = tmp + bounds[i];
+        sorts[i].n = bounds[i + 1] - bounds[i];
+        sorts[i].is_string = is_string;
+    }
+    aym_run_tasks(aym_sort_task, sorts, sizeof(AymSortTask), parts);
+    intptr_t *src = data;
+    intptr_t *dst = tmp;
+    for (long width = 1; width < parts; width *= 2) {
+        AymMergeTask merges[AYM_SORT_MAX_THREADS];
+        long count = 0;
+        for (long i = 0; i < parts; i += 2 * width) {
+            long lo = bounds[i];
+            long mid = bounds[i + width];
+            long hi = bounds[i + 2 * width];
+            merges[count].left = src + lo;
+            merges[count].nl = mid - lo;
+            merges[count].right = src + mid;
+            merges[count].nr = hi - mid;
+            merges[count].out = dst + lo;
+            merges[count].is_string = is_string;
+            count++;
+        }
+        aym_run_tasks(aym_merge_task, merges, sizeof(AymMergeTask), count);
+        intptr_t *swap = src;
+        src = dst;
+        dst = swap;
+    }
+    if (src != data) memcpy(data, src, sizeof(intptr_t) * (size_t)n);
+}
+
+static intptr_t aym_array_sorted(intptr_t arr, long is_string) {
+    if (!arr) return aym_array_new(0);
+    AymArray *a = (AymArray*)arr;
+    intptr_t out = aym_array_new(a->len);
+    if (!out) return 0;
+    AymArray *dst = (AymArray*)out;
+    long n = dst->len;
+    if (n == 0) return out;
+    memcpy(dst->data, a->data, sizeof(intptr_t) * (size_t)n);
+    if (n < 2 || (is_string && n < AYM_SORT_PARALLEL_MIN)) {
+        aym_sort_words(dst->data, NULL, n, is_string);
+        return out;
+    }
+    intptr_t *tmp = malloc(sizeof(intptr_t) * (size_t)n);
+    if (!tmp) {
+        /* Sin buffer auxiliar no hay radix ni mezcla: queda ordenar en el
+         * lugar. */
+        if (is_string) {
+            aym_pdqsort_str(dst->data, n);
+        } else {
+            qsort(dst->data, (size_t)n, sizeof(intptr_t), aym_cmp_intptr);
+        }
+        return out;
+    }
+    long parts = 1;
+    if (n >= AYM_SORT_PARALLEL_MIN) {
+        long threads = aym_pool_threads();
+        while (parts * 2 <= threads && parts * 2 <= AYM_SORT_MAX_THREADS) parts *= 2;
+    }
+    if (parts > 1) {
+        aym_sort_parallel(dst->data, tmp, n, is_string, parts);
+    } else {
+        aym_sort_words(dst->data, tmp, n, is_string);
+    }
+    free(tmp);
+    return out;
+}
+
+intptr_t aym_array_sort_int(intptr_t arr) {
+    return aym_array_sorted(arr, 0);
+}
+
+intptr_t aym_array_sort_str(intptr_t arr) {
+    return aym_array_sorted(arr, 1);
+}
+
+/* Merge sort estable de pares (clave, indice) con clave de texto. */
+static void aym_sort_pairs_str(intptr_t *pairs, intptr_t *tmp, long n) {
+    for (long lo = 0; lo < n; lo += AYM_SORT_INSERTION) {
+        long hi = lo + AYM_SORT_INSERTION < n ? lo + AYM_SORT_INSERTION : n;
+        for (long i = lo + 1; i < hi; i++) {
+            intptr_t key = pairs[2 * i];
+            intptr_t idx = pairs[2 * i + 1];
+            long j = i;
+            while (j > lo && aym_sort_str_less(key, pairs[2 * (j - 1)])) {
+                pairs[2 * j] = pairs[2 * (j - 1)];
+                pairs[2 * j + 1] = pairs[2 * (j - 1) + 1];
+                j--;
+            }
+            pairs[2 * j] = key;
+            pairs[2 * j + 1] = idx;
+        }
+    }
+    intptr_t *src = pairs;
+    intptr_t *dst = tmp;
+    for (long width = AYM_SORT_INSERTION; width < n; width *= 2) {
+        for (long lo = 0; lo < n; lo += 2 * width) {
+            long mid = lo + width < n ? lo + width : n;
+            long hi = lo + 2 * width < n ? lo + 2 * width : n;
+            long i = lo, j = mid, k = lo;
+            while (i < mid && j < hi) {
+                long from = aym_sort_str_less(src[2 * j], src[2 * i]) ? j++ : i++;
+                dst[2 * k] = src[2 * from];
+                dst[2 * k + 1] = src[2 * from + 1];
+                k++;
+            }
+            for (; i < mid; i++, k++) {
+                dst[2 * k] = src[2 * i];
+                dst[2 * k + 1] = src[2 * i + 1];
+            }
+            for (; j < hi; j++, k++) {
+                dst[2 * k] = src[2 * j];
+                dst[2 * k + 1] = src[2 * j + 1];
+            }
+        }
+        intptr_t *swap = src;
+        src = dst;
+        dst = swap;
+    }
+    if (src != pairs) memcpy(pairs, src, sizeof(intptr_t) * 2 * (size_t)n);
+}
+
+/* `wakicha_clave(lista, &clave)`: llama a la funcion una vez por elemento y
+ * ordena de forma estable por la clave (entero o texto segun `key_is_string`). */
+intptr_t aym_array_sort_by(intptr_t arr, intptr_t fn_ptr, long key_is_string) {
+    if (!arr || !fn_ptr) return aym_array_sort_int(arr);
+    AymArray *a = (AymArray*)arr;
+    long n = a->len;
+    intptr_t out = aym_array_new(n);
+    if (!out || n == 0) return out;
+    AymArray *dst = (AymArray*)out;
+    /* Las claves que devuelve `fn` pueden ser textos nuevos: el buffer va en
+     * un bloque del recolector para que las vea si recolecta entre llamadas. */
+    intptr_t *pairs = aym_gc_alloc(sizeof(intptr_t) * 4 * (size_t)n, AYM_GC_RAW);
+    if (!pairs) {
+        fprintf(stderr, "aym_array_sort_by: allocation failed\n");
+        memcpy(dst->data, a->data, sizeof(intptr_t) * (size_t)n);
+        return out;
+    }
+    AymUnaryFn fn = (AymUnaryFn)fn_ptr;
+    for (long i = 0; i < n; i++) {
+        pairs[2 * i] = fn(a->data[i]);
+        pairs[2 * i + 1] = i;
+    }
+    if (key_is_string) {
+        aym_sort_pairs_str(pairs, pairs + 2 * n, n);
+    } else {
+        aym_radix_sort(pairs, pairs + 2 * n, n, 2);
+    }
+    for (long i = 0; i < n; i++) dst->data[i] = a->data[pairs[2 * i + 1]];
+    aym_gc_release(pairs);
+    return out;
+}
@@ -0,0 +1,68 @@
+param(
+    [string]$Compiler,
+    [string]$Source = "samples/bench/par_bench.aym",
+    [string]$OutputDir = "build/bench/par",
+    [int]$MaxThreads = [Environment]::ProcessorCount
+)
+
+Set-StrictMode -Version Latest
+$ErrorActionPreference = "Stop"
+
+# Compila par_bench.aym una vez y lo corre con AYM_HILOS = 1, 2, 4, ... hasta
+# MaxThreads para ver como escalan map_par, filter_par y reduce_par.
+
+$repoRoot = (Resolve-Path (Join-Path $PSScriptRoot "..\..")).Path
+if ([string]::IsNullOrWhiteSpace($Compiler)) {
+    foreach ($entry in @("build/bin/Release/aymc.exe", "build/bin/aymc.exe", "build/bin/Release/aymc", "build/bin/aymc")) {
+        $candidate = Join-Path $repoRoot $entry
+        if (Test-Path $candidate) {
+            $Compiler = (Resolve-Path $candidate).Path
+            break
+        }
+    }
+    if ([string]::IsNullOrWhiteSpace($Compiler)) {
+        throw "No se pudo localizar aymc. Compila primero el proyecto (ej. cmake --build build --config Release)."
+    }
+}
+
+$outDir = Join-Path $repoRoot $OutputDir
+New-Item -ItemType Directory -Force -Path $outDir | Out-Null
+$binary = Join-Path $outDir "par_bench"
+Push-Location $repoRoot
+try {
+    & $Compiler (Join-Path $repoRoot $Source) -o $binary
+    if ($LASTEXITCODE -ne 0) {
+        throw "Fallo la compilacion de $Source"
+    }
+} finally {
+    Pop-Location
+}
+if ($IsWindows -or $env:OS -eq "Windows_NT") {
+    $binary = "$binary.exe"
+}
+
+$counts = @()
+for ($n = 1; $n -lt $MaxThreads; $n *= 2) {
+    $counts += $n
+}
+$counts += $MaxThreads
+
+$rows = @()
+$previous = $env:AYM_HILOS
+try {
+    foreach ($threads in $counts) {
+        $env:AYM_HILOS = "$threads"
+        $row = [ordered]@{ hilos = $threads }
+        foreach ($line in (& $binary)) {
+            if ($line -match '^(\S+) ms = (\d+)') {
+                $row[$Matches[1]] = [int64]$Matches[2]
+            }
+        }
+        $rows += [pscustomobject]$row
+    }
+} finally {
+    $env:AYM_HILOS = $previous
+}
+
+$rows | Format-Table -AutoSize
+$rows | ConvertTo-Json | Set-Content -Path (Join-Path $outDir "scaling.json") -Encoding UTF8
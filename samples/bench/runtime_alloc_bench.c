@@ -0,0 +1,92 @@
+/* Benchmark de reservas del runtime (runtime/runtime_gc.c).
+ *
+ * Repite un bucle con muchos objetos: una instancia con un campo extra (que
+ * crea su mapa), un mapa chico de claves enteras, una lista de tres elementos
+ * y una excepcion. Cuenta las llamadas a malloc/calloc/realloc que llegan a la
+ * libc envolviendolas con `-Wl,--wrap=...` (solo ld de GNU) y mide el tiempo.
+ * Las cabeceras chicas salen de los slabs del recolector y las entradas de un
+ * mapa van en un solo bloque, asi que por vuelta deberian bajar las llamadas.
+ * Ver samples/bench/README.md para compilarlo. */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+intptr_t aym_object_new(intptr_t cls);
+intptr_t aym_object_set(intptr_t obj, const char *name, intptr_t value, int is_string);
+intptr_t aym_object_get(intptr_t obj, const char *name);
+intptr_t aym_imap_set(intptr_t map, intptr_t key, intptr_t value, int is_string);
+intptr_t aym_imap_get(intptr_t map, intptr_t key);
+intptr_t aym_map_new(long size);
+intptr_t aym_array_new(long size);
+intptr_t aym_array_push(intptr_t arr, intptr_t val);
+intptr_t aym_exception_new(const char *type, const char *message);
+char *aym_str_from_c(const char *text);
+
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t count, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+
+static long allocations;
+
+void *__wrap_malloc(size_t size) {
+    allocations++;
+    return __real_malloc(size);
+}
+
+void *__wrap_calloc(size_t count, size_t size) {
+    allocations++;
+    return __real_calloc(count, size);
+}
+
+void *__wrap_realloc(void *ptr, size_t size) {
+    allocations++;
+    return __real_realloc(ptr, size);
+}
+
+/* Misma forma que AymClass en runtime_objects.c. */
+typedef struct {
+    const char *name;
+    const void *base;
+    long field_count;
+    const char *const *field_names;
+    const unsigned char *field_types;
+    long method_count;
+    const char *const *method_names;
+    const intptr_t *methods;
+} BenchClass;
+
+static const char *const point_fields[] = {"x", "y"};
+static const unsigned char point_types[] = {0, 0};
+static const BenchClass point_class = {"Punto", NULL, 2, point_fields, point_types, 0, NULL, NULL};
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+int main(int argc, char **argv) {
+    long rounds = argc > 1 ? atol(argv[1]) : 200000;
+    char *color = aym_str_from_c("color");
+    char *message = aym_str_from_c("fuera de rango");
+    intptr_t sum = 0;
+    long before = allocations;
+    double start = now_seconds();
+    for (long i = 0; i < rounds; i++) {
+        intptr_t p = aym_object_new((intptr_t)&point_class);
+        aym_object_set(p, "x", i, 0);
+        aym_object_set(p, color, i & 7, 0);
+        intptr_t m = aym_map_new(0);
+        for (long k = 0; k < 4; k++) aym_imap_set(m, k, i + k, 0);
+        intptr_t xs = aym_array_new(0);
+        for (long k = 0; k < 3; k++) aym_array_push(xs, k);
+        intptr_t e = aym_exception_new("Error", message);
+        sum += aym_object_get(p, color) + aym_imap_get(m, 3) + (e != 0);
+    }
+    double elapsed = now_seconds() - start;
+    long count = allocations - before;
+    printf("vueltas=%ld reservas=%ld (%.2f por vuelta) %8.2f ms  (checksum %ld)\n",
+           rounds, count, (double)count / (double)rounds, elapsed * 1e3, (long)sum);
+    return 0;
+}
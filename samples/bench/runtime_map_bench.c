@@ -0,0 +1,76 @@
+/* Benchmark de busqueda en AymMap (runtime/runtime_maps_strings.c).
+ *
+ * Mide el throughput de aym_map_get sobre mapas de 10, 1k y 100k claves y
+ * valida de paso que aym_map_key_at conserve el orden de insercion tras
+ * borrar claves. Las claves pasan por aym_str_from_c porque el runtime
+ * espera textos con cabecera. Ver samples/bench/README.md para compilarlo. */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+intptr_t aym_map_new(long size);
+intptr_t aym_map_set(intptr_t map, const char *key, intptr_t value, int is_string);
+intptr_t aym_map_get(intptr_t map, const char *key);
+intptr_t aym_map_delete(intptr_t map, const char *key);
+long aym_map_size(intptr_t map);
+const char *aym_map_key_at(intptr_t map, long idx);
+char *aym_str_from_c(const char *text);
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static int check_order(void) {
+    intptr_t map = aym_map_new(0);
+    char *keys[64];
+    for (int i = 0; i < 64; i++) {
+        char buf[16];
+        snprintf(buf, sizeof(buf), "k%d", i);
+        keys[i] = aym_str_from_c(buf);
+        aym_map_set(map, keys[i], i, 0);
+    }
+    for (int i = 0; i < 64; i += 3) aym_map_delete(map, keys[i]);
+    long idx = 0;
+    for (int i = 0; i < 64; i++) {
+        if (i % 3 == 0) continue;
+        if (strcmp(aym_map_key_at(map, idx), keys[i]) != 0) return 0;
+        if (aym_map_get(map, keys[i]) != i) return 0;
+        idx++;
+    }
+    return idx == aym_map_size(map);
+}
+
+static void bench(long key_count, long lookups) {
+    char **keys = malloc(sizeof(char *) * (size_t)key_count);
+    intptr_t map = aym_map_new(0);
+    for (long i = 0; i < key_count; i++) {
+        char buf[24];
+        snprintf(buf, sizeof(buf), "clave_%ld", i);
+        keys[i] = aym_str_from_c(buf);
+        aym_map_set(map, keys[i], i, 0);
+    }
+    intptr_t sum = 0;
+    double start = now_seconds();
+    for (long i = 0; i < lookups; i++) {
+        sum += aym_map_get(map, keys[(i * 7919) % key_count]);
+    }
+    double elapsed = now_seconds() - start;
+    printf("claves=%-7ld busquedas=%-9ld %8.2f ns/busqueda  %10.0f busquedas/s  (checksum %ld)\n",
+           key_count, lookups, elapsed * 1e9 / (double)lookups, (double)lookups / elapsed, (long)sum);
+}
+
+int main(int argc, char **argv) {
+    long lookups = argc > 1 ? atol(argv[1]) : 2000000;
+    if (!check_order()) {
+        fprintf(stderr, "orden de insercion no preservado\n");
+        return 1;
+    }
+    bench(10, lookups);
+    bench(1000, lookups);
+    bench(100000, lookups / 100 > 0 ? lookups / 100 : 1);
+    return 0;
+}
@@ -63,6 +63,21 @@ endfunction()
 
 file(REMOVE_RECURSE "${AYM_BACKEND_IR_ROOT}")
 file(MAKE_DIRECTORY "${AYM_BACKEND_IR_ROOT}")
+file(MAKE_DIRECTORY "${AYM_BACKEND_IR_ROOT}/runtime")
+configure_file("${CMAKE_CURRENT_LIST_DIR}/../runtime/runtime.c" "${AYM_BACKEND_IR_ROOT}/runtime/runtime.c" COPYONLY)
+configure_file("${CMAKE_CURRENT_LIST_DIR}/../runtime/math.c" "${AYM_BACKEND_IR_ROOT}/runtime/math.c" COPYONLY)
+configure_file("${CMAKE_CURRENT_LIST_DIR}/../runtime/runtime_arrays.c" "${AYM_BACKEND_IR_ROOT}/runtime/runtime_arrays.c" COPYONLY)
+configure_file("${CMAKE_CURRENT_LIST_DIR}/../runtime/runtime_pool.c" "${AYM_BACKEND_IR_ROOT}/runtime/runtime_pool.c" COPYONLY)
+configure_file("${CMAKE_CURRENT_LIST_DIR}/../runtime/runtime_gc.c" "${AYM_BACKEND_IR_ROOT}/runtime/runtime_gc.c" COPYONLY)
+configure_file("${CMAKE_CURRENT_LIST_DIR}/../runtime/runtime_sort.c" "${AYM_BACKEND_IR_ROOT}/runtime/runtime_sort.c" COPYONLY)
+configure_file("${CMAKE_CURRENT_LIST_DIR}/../runtime/runtime_hof.c" "${AYM_BACKEND_IR_ROOT}/runtime/runtime_hof.c" COPYONLY)
+configure_file("${CMAKE_CURRENT_LIST_DIR}/../runtime/runtime_maps_strings.c" "${AYM_BACKEND_IR_ROOT}/runtime/runtime_maps_strings.c" COPYONLY)
+configure_file("${CMAKE_CURRENT_LIST_DIR}/../runtime/runtime_sets.c" "${AYM_BACKEND_IR_ROOT}/runtime/runtime_sets.c" COPYONLY)
+configure_file("${CMAKE_CURRENT_LIST_DIR}/../runtime/runtime_queues.c" "${AYM_BACKEND_IR_ROOT}/runtime/runtime_queues.c" COPYONLY)
+configure_file("${CMAKE_CURRENT_LIST_DIR}/../runtime/runtime_output.c" "${AYM_BACKEND_IR_ROOT}/runtime/runtime_output.c" COPYONLY)
+configure_file("${CMAKE_CURRENT_LIST_DIR}/../runtime/runtime_objects.c" "${AYM_BACKEND_IR_ROOT}/runtime/runtime_objects.c" COPYONLY)
+configure_file("${CMAKE_CURRENT_LIST_DIR}/../runtime/runtime_exceptions.c" "${AYM_BACKEND_IR_ROOT}/runtime/runtime_exceptions.c" COPYONLY)
+configure_file("${CMAKE_CURRENT_LIST_DIR}/../runtime/runtime_gfx_linux.c" "${AYM_BACKEND_IR_ROOT}/runtime/runtime_gfx_linux.c" COPYONLY)
 
 set(source_file "${AYM_BACKEND_IR_ROOT}/ir_smoke.aym")
 file(WRITE
@@ -104,13 +119,13 @@ string(FIND "${pipeline_json_content}" "\"phase_summary\"" has_phase_summary)
 if(has_phase_summary EQUAL -1)
   message(FATAL_ERROR "Pipeline JSON backend ir sin bloque phase_summary")
 endif()
-string(FIND "${pipeline_json_content}" "\"commands_total\": 1" has_commands_total)
-if(has_commands_total EQUAL -1)
-  message(FATAL_ERROR "Pipeline JSON backend ir con commands_total inesperado")
+string(FIND "${pipeline_json_content}" "\"ir_gen\"" has_ir_gen_timing)
+if(has_ir_gen_timing EQUAL -1)
+  message(FATAL_ERROR "Pipeline JSON backend ir sin timing ir_gen")
 endif()
-string(FIND "${pipeline_json_content}" "\"reason_ok\": 1" has_reason_ok)
-if(has_reason_ok EQUAL -1)
-  message(FATAL_ERROR "Pipeline JSON backend ir con reason_ok inesperado")
+string(FIND "${pipeline_json_content}" "\"stage\": \"enlace\"" has_link_stage)
+if(has_link_stage EQUAL -1)
+  message(FATAL_ERROR "Pipeline JSON backend ir sin stage enlace")
 endif()
 string(FIND "${pipeline_json_content}" "\"stage\": \"ir-gen\"" has_ir_gen_stage)
 if(has_ir_gen_stage EQUAL -1)
@@ -129,6 +144,25 @@ if(has_stderr_field EQUAL -1)
   message(FATAL_ERROR "Pipeline JSON backend ir sin campo stderr en commands")
 endif()
 
+file(READ "${ir_path}" ir_content)
+string(FIND "${ir_content}" "func @main" has_main_function)
+if(has_main_function EQUAL -1)
+  message(FATAL_ERROR "Artefacto IR sin funcion main en SSA")
+endif()
+
+if(WIN32)
+  set(binary_path "${output_base}.exe")
+else()
+  set(binary_path "${output_base}")
+endif()
+run_capture(binary_out binary_err binary_rc "${AYM_BACKEND_IR_ROOT}" "${binary_path}")
+if(NOT binary_rc EQUAL 0 OR NOT binary_out MATCHES "ir-smoke")
+  message(FATAL_ERROR
+    "Ejecutable del backend ir con salida inesperada (rc=${binary_rc}):\n"
+    "STDOUT:\n${binary_out}\n"
+    "STDERR:\n${binary_err}\n")
+endif()
+
 expect_failure_contains(
   "${AYM_BACKEND_IR_ROOT}"
   "--link-only"
@@ -92,7 +92,15 @@ file(MAKE_DIRECTORY "${AYM_PIPELINE_ROOT}/runtime")
 configure_file("${CMAKE_CURRENT_LIST_DIR}/../runtime/runtime.c" "${AYM_PIPELINE_ROOT}/runtime/runtime.c" COPYONLY)
 configure_file("${CMAKE_CURRENT_LIST_DIR}/../runtime/math.c" "${AYM_PIPELINE_ROOT}/runtime/math.c" COPYONLY)
 configure_file("${CMAKE_CURRENT_LIST_DIR}/../runtime/runtime_arrays.c" "${AYM_PIPELINE_ROOT}/runtime/runtime_arrays.c" COPYONLY)
+configure_file("${CMAKE_CURRENT_LIST_DIR}/../runtime/runtime_pool.c" "${AYM_PIPELINE_ROOT}/runtime/runtime_pool.c" COPYONLY)
+configure_file("${CMAKE_CURRENT_LIST_DIR}/../runtime/runtime_gc.c" "${AYM_PIPELINE_ROOT}/runtime/runtime_gc.c" COPYONLY)
+configure_file("${CMAKE_CURRENT_LIST_DIR}/../runtime/runtime_sort.c" "${AYM_PIPELINE_ROOT}/runtime/runtime_sort.c" COPYONLY)
+configure_file("${CMAKE_CURRENT_LIST_DIR}/../runtime/runtime_hof.c" "${AYM_PIPELINE_ROOT}/runtime/runtime_hof.c" COPYONLY)
 configure_file("${CMAKE_CURRENT_LIST_DIR}/../runtime/runtime_maps_strings.c" "${AYM_PIPELINE_ROOT}/runtime/runtime_maps_strings.c" COPYONLY)
+configure_file("${CMAKE_CURRENT_LIST_DIR}/../runtime/runtime_sets.c" "${AYM_PIPELINE_ROOT}/runtime/runtime_sets.c" COPYONLY)
+configure_file("${CMAKE_CURRENT_LIST_DIR}/../runtime/runtime_queues.c" "${AYM_PIPELINE_ROOT}/runtime/runtime_queues.c" COPYONLY)
+configure_file("${CMAKE_CURRENT_LIST_DIR}/../runtime/runtime_output.c" "${AYM_PIPELINE_ROOT}/runtime/runtime_output.c" COPYONLY)
+configure_file("${CMAKE_CURRENT_LIST_DIR}/../runtime/runtime_objects.c" "${AYM_PIPELINE_ROOT}/runtime/runtime_objects.c" COPYONLY)
 configure_file("${CMAKE_CURRENT_LIST_DIR}/../runtime/runtime_exceptions.c" "${AYM_PIPELINE_ROOT}/runtime/runtime_exceptions.c" COPYONLY)
 configure_file("${CMAKE_CURRENT_LIST_DIR}/../runtime/runtime_gfx_linux.c" "${AYM_PIPELINE_ROOT}/runtime/runtime_gfx_linux.c" COPYONLY)
 
@@ -206,6 +214,10 @@ string(FIND "${link_json_content}" "\"runtime\"" link_has_runtime)
 if(link_has_runtime EQUAL -1)
   message(FATAL_ERROR "Metrics JSON link-only sin bloque runtime")
 endif()
+string(FIND "${link_json_content}" "\"opt\": \"O2\"" link_has_runtime_opt)
+if(link_has_runtime_opt EQUAL -1)
+  message(FATAL_ERROR "Metrics JSON link-only sin perfil de runtime O2 por defecto")
+endif()
 string(FIND "${link_json_content}" "\"commands\"" link_has_commands)
 if(link_has_commands EQUAL -1)
   message(FATAL_ERROR "Metrics JSON link-only sin bloque commands")
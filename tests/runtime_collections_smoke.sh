@@ -0,0 +1,216 @@
+#!/usr/bin/env bash
+set -euo pipefail
+
+if [ "$#" -lt 1 ]; then
+  echo "[test] uso: runtime_collections_smoke.sh <ruta-aymc>" >&2
+  exit 1
+fi
+
+compiler="$1"
+repo_root="$(cd "$(dirname "$0")/.." && pwd)"
+tmp_root="${repo_root}/build/tmp/runtime_collections_smoke"
+
+mkdir -p "$tmp_root"
+
+if [ ! -x "$compiler" ]; then
+  echo "[test] compilador no ejecutable: $compiler" >&2
+  exit 1
+fi
+
+# Compila el programa de la entrada estandar como <caso>.aym (con las
+# opciones extra de aymc del tercer argumento), lo ejecuta y compara su
+# salida con la esperada. La salida de error queda en <caso>.err.
+run_case() {
+  local name="$1"
+  local expected="$2"
+  local flags="${3:-}"
+  local sample_path="${tmp_root}/${name}.aym"
+  local binary_path="${tmp_root}/${name}"
+  cat > "$sample_path"
+  (cd "$repo_root" && "$compiler" $flags "$sample_path" -o "$binary_path" >/dev/null)
+  local output
+  output="$("$binary_path" 2>"${tmp_root}/${name}.err")"
+  if [ "$output" != "$expected" ]; then
+    echo "[test] ${name}: salida inesperada:" >&2
+    echo "$output" >&2
+    exit 1
+  fi
+}
+
+# Tabla hash de AymMap: 200 claves (varias ampliaciones sobre 3/4 de carga),
+# borrado de un tercio (lapidas), reinsercion de claves borradas y 100 claves
+# nuevas. `sutinaka` debe seguir el orden de insercion, con las reinsertadas
+# al final, y la suma pondera cada valor por su posicion.
+run_case map_delete_grow "$(printf "235 235 306770170\nk1 k199 k3 n99\nk'ari chiqa 1001")" <<'AYM'
+yatiya mapa m = {};
+kuti (yatiya jakhüwi i = 0; i < 200; i = i + 1) {
+  m["k" + aru(i)] = i;
+}
+kuti (yatiya jakhüwi i = 0; i < 200; i = i + 3) {
+  apsusuti(m, "k" + aru(i));
+}
+m["k3"] = 1003;
+m["k0"] = 1000;
+m["k1"] = 1001;
+kuti (yatiya jakhüwi i = 0; i < 100; i = i + 1) {
+  m["n" + aru(i)] = 500 + i;
+}
+yatiya t'aqa ks = sutinaka(m);
+yatiya jakhüwi suma = 0;
+kuti (yatiya jakhüwi i = 0; i < suyut(ks); i = i + 1) {
+  suma = (suma * 31 + m[ks[i]] * (i + 1)) % 1000000007;
+}
+qillqa(suyum(m), suyut(ks), suma);
+yatiya aru primero = ks[0];
+yatiya aru borrado = ks[132];
+yatiya aru vuelto = ks[133];
+yatiya aru ultimo = ks[234];
+qillqa(primero, borrado, vuelto, ultimo);
+qillqa(utjisuti(m, "k6"), utjisuti(m, "k3"), m["k1"]);
+AYM
+
+# Mapa de claves enteras que recibe claves de texto: un texto numerico se
+# busca como el entero (ida y vuelta set -> sutinaka -> get) y uno que no lo
+# es pasa el mapa a claves de texto. Vale hasta 19 cifras (los extremos de
+# intptr_t); un texto que se pasa del rango no es entero.
+run_case map_int_text_keys "$(printf "3 chiqa k'ari 55\n158 71 31\n3 56 71 71 1 [\"5\", \"7\", \"x\"]\n789 k'ari chiqa")" <<'AYM'
+yatiya mapa m = {};
+m[5] = 50;
+m[7] = 70;
+m[-3] = 30;
+m["5"] = 55;
+qillqa(suyum(m), utjisuti(m, "7"), utjisuti(m, "07"), m[5]);
+yatiya t'aqa ks = sutinaka(m);
+yatiya jakhüwi suma = 0;
+kuti (yatiya jakhüwi i = 0; i < suyut(ks); i = i + 1) {
+  yatiya aru k = ks[i];
+  m[k] = m[k] + 1;
+  suma = suma + m[k];
+}
+qillqa(suma, m[7], m[-3]);
+apsusuti(m, "-3");
+m["x"] = 1;
+qillqa(suyum(m), m[5], m["7"], m[7], m["x"], sutinaka(m));
+yatiya mapa g = {};
+g[1000000000000000000] = 7;
+g[-1000000000000000000] = 8;
+g[9223372036854775807] = 9;
+yatiya t'aqa grandes = sutinaka(g);
+yatiya jakhüwi total = 0;
+kuti (yatiya jakhüwi i = 0; i < suyut(grandes); i = i + 1) {
+  yatiya aru k = grandes[i];
+  total = total * 10 + g[k];
+}
+qillqa(total, utjisuti(g, "9223372036854775808"), utjisuti(g, "1000000000000000000"));
+AYM
+
+# Recolector con un umbral de 4 KB: cientos de recolecciones que sueltan y
+# reusan ranuras de varias clases de losa y bloques de calloc mientras dos
+# mapas crecen por varias ampliaciones de su bloque de entradas.
+AYM_GC_UMBRAL=4096 run_case gc_slabs "5000 5000 -2 0" --gc-stats <<'AYM'
+// Basura en varias clases de losa (objetos de 2, 6 y 22 campos, listas y
+// mapas chicos) mas objetos de mas de 256 bytes que van a calloc. Cada 1000
+// vueltas se encadena un sobreviviente de cada clase; al final sus campos
+// deben estar intactos y los mapas grandes deben tener todas sus entradas.
+kasta Chiqui {
+  yatiya jakhüwi v = 0;
+  yatiya Chiqui sig;
+  qallta(jakhüwi a) { aka.v = a; }
+}
+kasta Medio {
+  yatiya jakhüwi a = 0; yatiya jakhüwi b = 0; yatiya jakhüwi c = 0;
+  yatiya jakhüwi d = 0; yatiya jakhüwi v = 0;
+  yatiya Medio sig;
+  qallta(jakhüwi x) { aka.v = x; aka.d = x + 1; }
+}
+kasta Grande {
+  yatiya jakhüwi f0 = 0; yatiya jakhüwi f1 = 1; yatiya jakhüwi f2 = 2; yatiya jakhüwi f3 = 3; yatiya jakhüwi f4 = 4; yatiya jakhüwi f5 = 5; yatiya jakhüwi f6 = 6; yatiya jakhüwi f7 = 7; yatiya jakhüwi f8 = 8; yatiya jakhüwi f9 = 9; yatiya jakhüwi f10 = 10; yatiya jakhüwi f11 = 11; yatiya jakhüwi f12 = 12; yatiya jakhüwi f13 = 13; yatiya jakhüwi f14 = 14; yatiya jakhüwi f15 = 15; yatiya jakhüwi f16 = 16; yatiya jakhüwi f17 = 17; yatiya jakhüwi f18 = 18; yatiya jakhüwi f19 = 19;
+  yatiya jakhüwi v = 0;
+  yatiya Grande sig;
+  qallta(jakhüwi x) { aka.v = x; aka.f19 = x * 2; }
+}
+kasta Enorme {
+  yatiya jakhüwi g0 = 0; yatiya jakhüwi g1 = 1; yatiya jakhüwi g2 = 2; yatiya jakhüwi g3 = 3; yatiya jakhüwi g4 = 4; yatiya jakhüwi g5 = 5; yatiya jakhüwi g6 = 6; yatiya jakhüwi g7 = 7; yatiya jakhüwi g8 = 8; yatiya jakhüwi g9 = 9; yatiya jakhüwi g10 = 10; yatiya jakhüwi g11 = 11; yatiya jakhüwi g12 = 12; yatiya jakhüwi g13 = 13; yatiya jakhüwi g14 = 14; yatiya jakhüwi g15 = 15; yatiya jakhüwi g16 = 16; yatiya jakhüwi g17 = 17; yatiya jakhüwi g18 = 18; yatiya jakhüwi g19 = 19;
+  yatiya jakhüwi h0 = 0; yatiya jakhüwi h1 = 1; yatiya jakhüwi h2 = 2; yatiya jakhüwi h3 = 3; yatiya jakhüwi h4 = 4; yatiya jakhüwi h5 = 5; yatiya jakhüwi h6 = 6; yatiya jakhüwi h7 = 7; yatiya jakhüwi h8 = 8; yatiya jakhüwi h9 = 9; yatiya jakhüwi h10 = 10; yatiya jakhüwi h11 = 11; yatiya jakhüwi h12 = 12; yatiya jakhüwi h13 = 13; yatiya jakhüwi h14 = 14; yatiya jakhüwi h15 = 15; yatiya jakhüwi h16 = 16; yatiya jakhüwi h17 = 17; yatiya jakhüwi h18 = 18; yatiya jakhüwi h19 = 19;
+  yatiya jakhüwi v = 0;
+  yatiya Enorme sig;
+  qallta(jakhüwi x) { aka.v = x; aka.h19 = x * 3; }
+}
+
+yatiya Chiqui ultimo_c = machaqa Chiqui(-1);
+yatiya Medio ultimo_m = machaqa Medio(-1);
+yatiya Grande ultimo_g = machaqa Grande(-1);
+yatiya Enorme ultimo_e = machaqa Enorme(-1);
+yatiya mapa m = {};
+yatiya mapa t = {};
+kuti (yatiya jakhüwi i = 0; i < 20000; i = i + 1) {
+  yatiya Chiqui c = machaqa Chiqui(i);
+  yatiya Medio md = machaqa Medio(i);
+  yatiya Grande g = machaqa Grande(i);
+  yatiya Enorme e = machaqa Enorme(i);
+  yatiya t'aqa basura = [i, i + 1, i + 2];
+  yatiya mapa mb = {"a": i};
+  ukaxa (i % 1000 == 0) {
+    c.sig = ultimo_c; ultimo_c = c;
+    md.sig = ultimo_m; ultimo_m = md;
+    g.sig = ultimo_g; ultimo_g = g;
+    e.sig = ultimo_e; ultimo_e = e;
+  }
+  ukaxa (i % 4 == 0) {
+    m[i] = i * 7 + c.v - md.d + g.f19 - e.h19 + basura[2] - mb["a"] - 1;
+    t["t" + aru(i)] = i + 1;
+  }
+}
+yatiya jakhüwi malos = 0;
+kuti (yatiya jakhüwi i = 0; i < 20000; i = i + 4) {
+  ukaxa (m[i] != i * 6) { malos = malos + 1; }
+  ukaxa (t["t" + aru(i)] != i + 1) { malos = malos + 1; }
+}
+kuti (yatiya jakhüwi k = 19; k >= 0; k = k - 1) {
+  yatiya jakhüwi n = k * 1000;
+  ukaxa (ultimo_c.v != n || ultimo_m.v != n || ultimo_m.d != n + 1 || ultimo_m.a != 0) { malos = malos + 1; }
+  ukaxa (ultimo_g.v != n || ultimo_g.f19 != n * 2 || ultimo_g.f3 != 3) { malos = malos + 1; }
+  ukaxa (ultimo_e.v != n || ultimo_e.h19 != n * 3 || ultimo_e.g5 != 5) { malos = malos + 1; }
+  ultimo_c = ultimo_c.sig; ultimo_m = ultimo_m.sig; ultimo_g = ultimo_g.sig; ultimo_e = ultimo_e.sig;
+}
+qillqa(suyum(m), suyum(t), ultimo_c.v + ultimo_e.v, malos);
+AYM
+collections="$(sed -n 's/.*recolecciones: \([0-9]*\).*/\1/p' "${tmp_root}/gc_slabs.err")"
+if [ -z "$collections" ] || [ "$collections" -lt 50 ]; then
+  echo "[test] gc_slabs: se esperaban al menos 50 recolecciones:" >&2
+  cat "${tmp_root}/gc_slabs.err" >&2
+  exit 1
+fi
+
+# map_par con 8 hilos sobre 100000 elementos donde fallan dos, en trozos
+# distintos: la excepcion que sale siempre es la del primero (k5), como en
+# `map`, aunque el trozo de k90000 termine antes. Se repite 50 veces.
+AYM_HILOS=8 run_case map_par_first_error "50" <<'AYM'
+yatiya mapa m = {"k0": 0};
+lurawi busca(jakhüwi x): jakhüwi {
+  ukaxa (x == 5 || x == 90000) {
+    kuttaya m["k" + aru(x)];
+  }
+  kuttaya x;
+}
+yatiya t'aqa xs = [];
+kuti (yatiya jakhüwi i = 0; i < 100000; i = i + 1) {
+  ch'ullu(xs, i);
+}
+yatiya jakhüwi bien = 0;
+kuti (yatiya jakhüwi r = 0; r < 50; r = r + 1) {
+  yant'aña {
+    yatiya t'aqa ys = map_par(xs, &busca);
+    qillqa("sin excepcion", suyut(ys));
+  } katjaña("CLAVE", e) {
+    ukaxa (e.aru == "no existe: k5") {
+      bien = bien + 1;
+    } maysatxa {
+      qillqa(e.aru);
+    }
+  }
+}
+qillqa(bien);
+AYM
+
+echo "[test] runtime collections smoke test passed"
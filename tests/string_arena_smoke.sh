@@ -0,0 +1,66 @@
+#!/usr/bin/env bash
+set -euo pipefail
+
+if [ "$#" -lt 1 ]; then
+  echo "[test] uso: string_arena_smoke.sh <ruta-aymc>" >&2
+  exit 1
+fi
+
+compiler="$1"
+repo_root="$(cd "$(dirname "$0")/.." && pwd)"
+tmp_root="${repo_root}/build/tmp/string_arena_smoke"
+sample_path="${tmp_root}/string_arena.aym"
+binary_path="${tmp_root}/string_arena"
+
+mkdir -p "$tmp_root"
+
+if [ ! -x "$compiler" ]; then
+  echo "[test] compilador no ejecutable: $compiler" >&2
+  exit 1
+fi
+
+# 10M vueltas que crean dos textos cada una. Sin regiones temporales el
+# proceso pasa de 200 MB; con ellas la arena reutiliza el mismo bloque.
+# Un texto de la vuelta guardado en una variable de afuera (o devuelto desde
+# una funcion) debe conservar su valor: esos bucles no liberan por vuelta.
+cat > "$sample_path" <<'AYM'
+yatiya jakhüwi total = 0;
+kuti (yatiya jakhüwi i = 0; i < 10000000; i = i + 1) {
+  total = total + suyu("ab" + aru(i));
+}
+qillqa(total);
+yatiya jakhüwi j = 0;
+ukhakamaxa (j < 1000000) {
+  yatiya aru t = aru(j) + "-" + aru(j);
+  ukaxa (suyu(t) > 12) { pakhina; }
+  j = j + 1;
+}
+qillqa(j);
+yatiya aru ultimo = "";
+kuti (yatiya jakhüwi k = 0; k < 3; k = k + 1) {
+  yatiya aru w = "w" + aru(k);
+  ukaxa (k == 0) { ultimo = w; }
+}
+qillqa(ultimo);
+lurawi guarda(): aru {
+  yatiya aru keep = "";
+  kuti (yatiya jakhüwi k = 0; k < 3; k = k + 1) {
+    yatiya aru z = "z" + aru(k);
+    ukaxa (k == 0) { keep = z; }
+  }
+  kuttaya keep;
+}
+qillqa(guarda());
+AYM
+
+(cd "$repo_root" && "$compiler" "$sample_path" -o "$binary_path" >/dev/null)
+
+output="$(ulimit -v 65536; "$binary_path")"
+expected="$(printf '88888890\n100000\nw0\nz0')"
+if [ "$output" != "$expected" ]; then
+  echo "[test] salida inesperada:" >&2
+  echo "$output" >&2
+  exit 1
+fi
+
+echo "[test] string arena smoke test passed"
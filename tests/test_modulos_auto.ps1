@@ -186,7 +186,15 @@ $compileDeps = @(
   (Join-Path $repo "runtime\runtime.c"),
   (Join-Path $repo "runtime\math.c"),
   (Join-Path $repo "runtime\runtime_arrays.c"),
+  (Join-Path $repo "runtime\runtime_pool.c"),
+  (Join-Path $repo "runtime\runtime_gc.c"),
+  (Join-Path $repo "runtime\runtime_sort.c"),
+  (Join-Path $repo "runtime\runtime_hof.c"),
   (Join-Path $repo "runtime\runtime_maps_strings.c"),
+  (Join-Path $repo "runtime\runtime_sets.c"),
+  (Join-Path $repo "runtime\runtime_queues.c"),
+  (Join-Path $repo "runtime\runtime_output.c"),
+  (Join-Path $repo "runtime\runtime_objects.c"),
   (Join-Path $repo "runtime\runtime_exceptions.c"),
   (Join-Path $repo "runtime\runtime_gfx_linux.c")
 )
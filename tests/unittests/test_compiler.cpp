@@ -1,10 +1,13 @@
 #include <gtest/gtest.h>
 #include "compiler/lexer/lexer.h"
 #include "compiler/parser/parser.h"
+#include "compiler/ast/ast_fold.h"
+#include "compiler/ast/ast_inline.h"
 #include "compiler/ast/ast_json.h"
 #include "compiler/semantic/semantic.h"
 #include "compiler/backend/backend.h"
 #include "compiler/codegen/codegen.h"
+#include "compiler/ir/ir.h"
 #include "compiler/ast/ast.h"
 #include "compiler/utils/module_resolver.h"
 #include "compiler/utils/diagnostic.h"
@@ -467,6 +470,96 @@ TEST(DriverTest, ParseBackendOptionRejectsUnknownValue) {
     EXPECT_NE(errorMsg.find("Backend no soportado"), std::string::npos);
 }
 
+TEST(DriverTest, ParseRuntimeOptOption) {
+    char arg0[] = "aymc";
+    char arg1[] = "--runtime-opt=O3";
+    char arg2[] = "entrada.aym";
+    char *argv[] = {arg0, arg1, arg2};
+
+    CompileOptions options;
+    std::string errorMsg;
+    EXPECT_EQ(makeDefaultCompileOptions().runtimeOpt, "O2");
+    const auto result = parseCompileOptions(3, argv, options, errorMsg);
+
+    EXPECT_EQ(result, CliParseResult::Ok);
+    EXPECT_TRUE(errorMsg.empty());
+    EXPECT_EQ(options.runtimeOpt, "O3");
+}
+
+TEST(DriverTest, ParseRuntimeOptOptionRejectsUnknownLevel) {
+    char arg0[] = "aymc";
+    char arg1[] = "--runtime-opt";
+    char arg2[] = "O5";
+    char arg3[] = "entrada.aym";
+    char *argv[] = {arg0, arg1, arg2, arg3};
+
+    CompileOptions options;
+    std::string errorMsg;
+    const auto result = parseCompileOptions(4, argv, options, errorMsg);
+
+    EXPECT_EQ(result, CliParseResult::Error);
+    EXPECT_NE(errorMsg.find("--runtime-opt"), std::string::npos);
+}
+
+TEST(DriverTest, ParseInlineOptions) {
+    char arg0[] = "aymc";
+    char arg1[] = "--no-inline";
+    char arg2[] = "--inline-report";
+    char arg3[] = "entrada.aym";
+    char *argv[] = {arg0, arg1, arg2, arg3};
+
+    CompileOptions options;
+    std::string errorMsg;
+    EXPECT_FALSE(makeDefaultCompileOptions().noInline);
+    EXPECT_FALSE(makeDefaultCompileOptions().inlineReport);
+    const auto result = parseCompileOptions(4, argv, options, errorMsg);
+
+    EXPECT_EQ(result, CliParseResult::Ok);
+    EXPECT_TRUE(options.noInline);
+    EXPECT_TRUE(options.inlineReport);
+}
+
+TEST(DriverTest, ParseGcStatsOption) {
+    char arg0[] = "aymc";
+    char arg1[] = "--gc-stats";
+    char arg2[] = "entrada.aym";
+    char *argv[] = {arg0, arg1, arg2};
+
+    CompileOptions options;
+    std::string errorMsg;
+    EXPECT_FALSE(makeDefaultCompileOptions().gcStats);
+    const auto result = parseCompileOptions(3, argv, options, errorMsg);
+
+    EXPECT_EQ(result, CliParseResult::Ok);
+    EXPECT_TRUE(options.gcStats);
+
+    // main activa el reporte del recolector justo despues de guardar argv.
+    std::string src = "qallta qillqa(\"ok\"); tukuya";
+    Lexer lexer(src);
+    auto tokens = lexer.tokenize();
+    Parser parser(tokens);
+    auto nodes = parser.parse();
+    ASSERT_FALSE(parser.hasError());
+    std::filesystem::create_directory("build");
+    const fs::path asmPath = fs::path("build") / "test_gc_stats.asm";
+    CodeGenerator cg;
+    cg.setGcStats(true);
+#ifdef _WIN32
+    const bool windowsTarget = true;
+#else
+    const bool windowsTarget = false;
+#endif
+    ASSERT_TRUE(cg.generate(nodes, asmPath.string(), {}, {}, {}, {}, windowsTarget, 0, "runtime", true,
+                            CodegenPipelineMode::CompileOnly));
+    std::ifstream in(asmPath);
+    std::string contents((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    in.close();
+    std::remove(asmPath.string().c_str());
+    std::remove((fs::path("build") / "test_gc_stats.o").string().c_str());
+    std::remove((fs::path("build") / "test_gc_stats.obj").string().c_str());
+    EXPECT_NE(contents.find("call aym_set_args\n    call aym_gc_stats_enable"), std::string::npos);
+}
+
 TEST(DriverTest, ParseCompileOnlyOption) {
     char arg0[] = "aymc";
     char arg1[] = "--compile-only";
@@ -762,10 +855,10 @@ TEST(BackendDispatchTest, ParseBackendKindRecognizesNativeAndIr) {
     EXPECT_EQ(kind, BackendKind::Ir);
 }
 
-TEST(BackendDispatchTest, IrBackendGeneratesPrototypeArtifact) {
+TEST(BackendDispatchTest, IrBackendWritesSsaDump) {
     fs::create_directories(fs::path("build") / "tmp");
-    const fs::path irOutputBase = fs::path("build") / "tmp" / "backend_ir_prototype.asm";
-    const fs::path irPath = fs::path("build") / "tmp" / "backend_ir_prototype.ir";
+    const fs::path irOutputBase = fs::path("build") / "tmp" / "backend_ir_dump.asm";
+    const fs::path irPath = fs::path("build") / "tmp" / "backend_ir_dump.ir";
     std::remove(irPath.string().c_str());
 
     std::vector<std::unique_ptr<Node>> nodes;
@@ -774,6 +867,11 @@ TEST(BackendDispatchTest, IrBackendGeneratesPrototypeArtifact) {
     std::unordered_map<std::string, std::string> functionReturnTypes;
     std::unordered_map<std::string, std::string> globalTypes;
     std::string error;
+#ifdef _WIN32
+    const bool windowsTarget = true;
+#else
+    const bool windowsTarget = false;
+#endif
 
     const bool ok = runBackendCompile(BackendKind::Ir,
                                       nodes,
@@ -782,14 +880,16 @@ TEST(BackendDispatchTest, IrBackendGeneratesPrototypeArtifact) {
                                       paramTypes,
                                       functionReturnTypes,
                                       globalTypes,
-                                      true,
+                                      windowsTarget,
                                       0,
                                       "runtime",
                                       false,
-                                      CodegenPipelineMode::Full,
+                                      CodegenPipelineMode::CompileOnly,
                                       false,
                                       "",
                                       0,
+                                      "O2",
+                                      false,
                                       error);
     ASSERT_TRUE(ok) << error;
     EXPECT_TRUE(fs::exists(irPath));
@@ -799,8 +899,13 @@ TEST(BackendDispatchTest, IrBackendGeneratesPrototypeArtifact) {
     std::string contents((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
     in.close();
     EXPECT_NE(contents.find("backend = ir"), std::string::npos);
+    EXPECT_NE(contents.find("func @main() -> void {"), std::string::npos);
+    EXPECT_NE(contents.find("ast_fallback = 0"), std::string::npos);
 
     std::remove(irPath.string().c_str());
+    std::remove(irOutputBase.string().c_str());
+    std::remove((fs::path("build") / "tmp" / "backend_ir_dump.o").string().c_str());
+    std::remove((fs::path("build") / "tmp" / "backend_ir_dump.obj").string().c_str());
 }
 
 TEST(BackendDispatchTest, IrBackendRejectsLinkOnlyMode) {
@@ -826,6 +931,8 @@ TEST(BackendDispatchTest, IrBackendRejectsLinkOnlyMode) {
                                       false,
                                       "",
                                       0,
+                                      "O2",
+                                      false,
                                       error);
     EXPECT_FALSE(ok);
     EXPECT_NE(error.find("--link-only"), std::string::npos);
@@ -866,6 +973,8 @@ TEST(BackendDispatchTest, NativeBackendReportsDetailedFailureForMissingObjectInL
                                       false,
                                       "",
                                       0,
+                                      "O2",
+                                      false,
                                       error);
     EXPECT_FALSE(ok);
     EXPECT_NE(error.find("pre-link"), std::string::npos);
@@ -1613,7 +1722,7 @@ TEST(CodeGenTest, GeneratesAssembly) {
         std::string contents((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
         in.close();
         EXPECT_NE(contents.find("global main"), std::string::npos);
-        EXPECT_NE(contents.find("call printf"), std::string::npos);
+        EXPECT_NE(contents.find("call aym_write_str"), std::string::npos);
     } else {
 #ifdef _WIN32
         EXPECT_TRUE(fs::exists(fs::path("build") / "test_output.exe"));
@@ -1804,6 +1913,761 @@ TEST(CodeGenTest, LinkOnlyUsesExistingObject) {
 #endif
 }
 
+namespace {
+
+// Genera el ASM de un programa completo (con analisis semantico) y devuelve su
+// contenido. No exige ensamblador: solo inspecciona el texto emitido.
+std::string generateAsmText(const std::string &src, const std::string &stem) {
+    Lexer lexer(src);
+    auto tokens = lexer.tokenize();
+    Parser parser(tokens);
+    auto nodes = parser.parse();
+    EXPECT_FALSE(parser.hasError());
+    SemanticAnalyzer sem;
+    sem.analyze(nodes);
+    EXPECT_FALSE(sem.hasErrors());
+    std::filesystem::create_directory("build");
+
+    const fs::path asmPath = fs::path("build") / (stem + ".asm");
+    CodeGenerator cg;
+#ifdef _WIN32
+    const bool windowsTarget = true;
+#else
+    const bool windowsTarget = false;
+#endif
+    cg.generate(nodes,
+                asmPath.string(),
+                sem.getGlobals(),
+                sem.getParamTypes(),
+                sem.getFunctionReturnTypes(),
+                sem.getGlobalTypes(),
+                windowsTarget,
+                0,
+                "runtime",
+                true,
+                CodegenPipelineMode::CompileOnly);
+
+    std::ifstream in(asmPath);
+    std::string contents((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    in.close();
+    std::remove(asmPath.string().c_str());
+    std::remove((fs::path("build") / (stem + ".o")).string().c_str());
+    std::remove((fs::path("build") / (stem + ".obj")).string().c_str());
+    return contents;
+}
+
+} // namespace
+
+TEST(CodeGenTest, ObjectFieldsUseFixedOffsets) {
+    std::string src =
+        "kasta Base { yatiya jakhuwi x = 1; lurawi f(): jakhuwi { kuttaya aka.x; } }\n"
+        "kasta Hija jila Base { yatiya jakhuwi y = 2; lurawi f(): jakhuwi { kuttaya jilaaka.f() + aka.y; } }\n"
+        "yatiya Hija h = machaqa Hija();\n"
+        "h.y = 5;\n"
+        "qillqa(h.f());\n";
+    std::string contents = generateAsmText(src, "test_object_layout");
+    ASSERT_FALSE(contents.empty());
+    EXPECT_NE(contents.find("__Hija_class_info: dq"), std::string::npos);
+    EXPECT_NE(contents.find("call aym_object_new"), std::string::npos);
+    // x hereda el primer slot de Base e y ocupa el siguiente.
+    EXPECT_NE(contents.find("mov rax, [rax+16]"), std::string::npos);
+    EXPECT_NE(contents.find("mov [rax+24], rcx"), std::string::npos);
+    // jilaaka.f() se resuelve en compilacion contra la base.
+    EXPECT_NE(contents.find("call __Base_f"), std::string::npos);
+    EXPECT_EQ(contents.find("call aym_map_get\n"), std::string::npos);
+}
+
+TEST(CodeGenTest, MethodCallsDispatchThroughVtable) {
+    std::string src =
+        "kasta Animal { lurawi tipo(): aru { kuttaya \"animal\"; } lurawi patas(): jakhuwi { kuttaya 4; } }\n"
+        "kasta Perro jila Animal { lurawi tipo(): aru { kuttaya \"perro\"; } }\n"
+        "yatiya Animal a = machaqa Perro();\n"
+        "qillqa(a.tipo());\n"
+        "qillqa(a.patas());\n";
+    std::string contents = generateAsmText(src, "test_object_vtable");
+    ASSERT_FALSE(contents.empty());
+    EXPECT_NE(contents.find("__Perro_class_info_vtable: dq __Perro_tipo, __Animal_patas"), std::string::npos);
+    // tipo() se sobrescribe: slot 0 de la vtable.
+    EXPECT_NE(contents.find("call [rax+64]"), std::string::npos);
+    // patas() no se sobrescribe en ninguna subclase: llamada directa.
+    EXPECT_NE(contents.find("call __Animal_patas"), std::string::npos);
+    EXPECT_EQ(contents.find("call aym_object_method"), std::string::npos);
+}
+
+TEST(CodeGenTest, FunctionLocalsLiveInRegisters) {
+    std::string src =
+        "lurawi suma(jakhuwi a, jakhuwi b): jakhuwi {\n"
+        "  yatiya jakhuwi t = a * 2 + b;\n"
+        "  kuttaya t - 1;\n"
+        "}\n"
+        "qillqa(suma(3, 4));\n";
+    std::string contents = generateAsmText(src, "test_regalloc");
+    ASSERT_FALSE(contents.empty());
+    size_t start = contents.find("\nsuma:");
+    ASSERT_NE(start, std::string::npos);
+    std::string body = contents.substr(start, contents.find("ret", start) - start);
+    EXPECT_NE(body.find("mov r12, rdi"), std::string::npos);
+    EXPECT_NE(body.find("add rax, r13"), std::string::npos);
+    // Ni recargas desde el marco ni push/pop para los operadores.
+    EXPECT_EQ(body.find("[rbp-"), std::string::npos);
+    EXPECT_EQ(body.find("push rax"), std::string::npos);
+}
+
+TEST(CodeGenTest, ConstantOperandsUseStrengthReduction) {
+    std::string src =
+        "lurawi f(jakhuwi x): jakhuwi {\n"
+        "  kuttaya x / 8 + x % 10 + x * 16 + x ^ 3;\n"
+        "}\n"
+        "qillqa(f(3));\n";
+    std::string contents = generateAsmText(src, "test_strength");
+    ASSERT_FALSE(contents.empty());
+    size_t start = contents.find("\nf:");
+    ASSERT_NE(start, std::string::npos);
+    std::string body = contents.substr(start, contents.find("ret", start) - start);
+    EXPECT_EQ(body.find("idiv"), std::string::npos);
+    EXPECT_NE(body.find("sar rax, 3"), std::string::npos);
+    EXPECT_NE(body.find("imul rcx"), std::string::npos);
+    EXPECT_NE(body.find("shl rax, 4"), std::string::npos);
+    // x ^ 3 = x * x * x sin bucle.
+    EXPECT_EQ(body.find("pow"), std::string::npos);
+}
+
+TEST(CodeGenTest, ListIndexingInlinesFastPathAndDropsLoopBoundsChecks) {
+#ifdef _WIN32
+    GTEST_SKIP() << "El acceso en linea usa el layout System V de AymArray.";
+#endif
+    std::string src =
+        "lurawi suma(t'aqa xs): jakhüwi {\n"
+        "  yatiya jakhüwi s = 0;\n"
+        "  kuti(yatiya jakhüwi i = 0; i < largo(xs); i = i + 1) { s = s + xs[i]; xs[i] = 0; }\n"
+        "  kuttaya s;\n"
+        "}\n"
+        "lurawi vacia(t'aqa xs): jakhüwi {\n"
+        "  yatiya jakhüwi s = 0;\n"
+        "  kuti(yatiya jakhüwi i = 0; i < largo(xs); i = i + 1) { s = s + xs[i]; apsu(xs); }\n"
+        "  kuttaya s;\n"
+        "}\n"
+        "yatiya t'aqa xs = [1, 2, 3];\n"
+        "xs[1] = 7;\n"
+        "qillqa(suma(xs) + vacia(xs) + xs[2]);\n";
+    std::string contents = generateAsmText(src, "test_array_fast");
+    ASSERT_FALSE(contents.empty());
+    size_t start = contents.find("\nsuma:");
+    ASSERT_NE(start, std::string::npos);
+    std::string suma = contents.substr(start, contents.find("ret", start) - start);
+    // Indice acotado por largo(xs): ni llamadas ni chequeos dentro del bucle.
+    EXPECT_EQ(suma.find("call aym_array"), std::string::npos);
+    EXPECT_EQ(suma.find("arrget_slow"), std::string::npos);
+    EXPECT_NE(suma.find("*8]"), std::string::npos);
+
+    start = contents.find("\nvacia:");
+    ASSERT_NE(start, std::string::npos);
+    std::string vacia = contents.substr(start, contents.find("ret", start) - start);
+    // apsu puede acortar la lista: se mantiene el chequeo con camino lento.
+    EXPECT_NE(vacia.find("arrget_slow"), std::string::npos);
+
+    start = contents.find("\nmain:");
+    ASSERT_NE(start, std::string::npos);
+    std::string mainBody = contents.substr(start);
+    EXPECT_NE(mainBody.find("arrset_slow"), std::string::npos);
+    EXPECT_NE(mainBody.find("arrget_slow"), std::string::npos);
+}
+
+TEST(CodeGenTest, LoopsReleaseTemporaryStringsPerIteration) {
+    std::string src =
+        "lurawi cuenta(jakhüwi n): jakhüwi {\n"
+        "  yatiya jakhüwi total = 0;\n"
+        "  kuti(yatiya jakhüwi i = 0; i < n; i = i + 1) {\n"
+        "    yatiya aru t = \"ab\" + aru(i);\n"
+        "    total = total + suyu(t);\n"
+        "  }\n"
+        "  kuttaya total;\n"
+        "}\n"
+        "lurawi junta(jakhüwi n): aru {\n"
+        "  yatiya aru acc = \"\";\n"
+        "  kuti(yatiya jakhüwi i = 0; i < n; i = i + 1) { acc = acc + aru(i); }\n"
+        "  kuttaya acc;\n"
+        "}\n"
+        "yatiya t'aqa xs = [\"a\"];\n"
+        "kuti(yatiya jakhüwi i = 0; i < 3; i = i + 1) {\n"
+        "  qillqa(\"p\" + aru(i));\n"
+        "  push(xs, \"k\" + aru(i));\n"
+        "}\n"
+        "qillqa(cuenta(3) + suyu(junta(3)));\n";
+    std::string contents = generateAsmText(src, "test_str_scratch");
+    ASSERT_FALSE(contents.empty());
+    size_t start = contents.find("\ncuenta:");
+    ASSERT_NE(start, std::string::npos);
+    std::string cuenta = contents.substr(start, contents.find("ret", start) - start);
+    // `t` no sale de la vuelta: una marca antes del bucle y una liberacion
+    // por vuelta y otra al salir.
+    size_t mark = cuenta.find("call aym_str_scratch_mark");
+    ASSERT_NE(mark, std::string::npos);
+    EXPECT_LT(mark, cuenta.find("forloop"));
+    size_t release = cuenta.find("call aym_str_scratch_release");
+    ASSERT_NE(release, std::string::npos);
+    EXPECT_NE(cuenta.find("call aym_str_scratch_release", release + 1), std::string::npos);
+
+    start = contents.find("\njunta:");
+    ASSERT_NE(start, std::string::npos);
+    std::string junta = contents.substr(start, contents.find("ret", start) - start);
+    // `acc` vive fuera del bucle: sus textos no se pueden liberar.
+    EXPECT_EQ(junta.find("aym_str_scratch"), std::string::npos);
+
+    start = contents.find("\nmain:");
+    ASSERT_NE(start, std::string::npos);
+    std::string mainBody = contents.substr(start);
+    // push guarda el texto en la lista; solo el qillqa abre su propia region.
+    mark = mainBody.find("call aym_str_scratch_mark");
+    ASSERT_NE(mark, std::string::npos);
+    EXPECT_GT(mark, mainBody.find("forloop"));
+    EXPECT_EQ(mainBody.find("call aym_str_scratch_mark", mark + 1), std::string::npos);
+}
+
+TEST(CodeGenTest, TryBlocksLinkStackFramesWithoutRuntimeCalls) {
+    std::string src =
+        "lurawi conv(aru s): jakhüwi {\n"
+        "  yant'aña { kuttaya jakhüwi(s); } katjaña(e) { qillqa(e.suti); }\n"
+        "  kuttaya -1;\n"
+        "}\n"
+        "yant'aña { qillqa(conv(\"1\")); } katjaña(\"X\", e) { qillqa(e.suti); }\n";
+    std::string contents = generateAsmText(src, "test_try_frames");
+    ASSERT_FALSE(contents.empty());
+    EXPECT_EQ(contents.find("aym_try_push"), std::string::npos);
+    EXPECT_EQ(contents.find("setjmp"), std::string::npos);
+
+    size_t start = contents.find("\nconv:");
+    ASSERT_NE(start, std::string::npos);
+    std::string conv = contents.substr(start, contents.find("ret", start) - start);
+    // El marco vive en la pila de la funcion y se enlaza con stores.
+    EXPECT_NE(conv.find("lea rax, [rbp-"), std::string::npos);
+    EXPECT_NE(conv.find("mov [rel aym_handler_top], rax"), std::string::npos);
+    // kuttaya dentro del bloque lo desenlaza antes de salir.
+    size_t unlink = conv.find("mov [rel aym_handler_top], rcx");
+    ASSERT_NE(unlink, std::string::npos);
+    EXPECT_LT(unlink, conv.find("jmp endfunc"));
+
+    // En main el marco es un global de 96 bytes.
+    EXPECT_NE(contents.find(": times 12 dq 0"), std::string::npos);
+}
+
+TEST(CodeGenTest, StringLiteralsCarryLengthHeader) {
+    std::string src =
+        "yatiya aru s = \"hola\";\n"
+        "qillqa(suyu(s));\n"
+        "qillqa(s == \"hola\");\n";
+    std::string contents = generateAsmText(src, "test_string_header");
+    ASSERT_FALSE(contents.empty());
+    // Cabecera {hash, cap, len} justo antes del primer caracter; el hash es
+    // el mismo FNV-1a que calcula aym_str_hash.
+    EXPECT_NE(contents.find("    dq 0x8a1b92032ed6bef9, 4, 4\nstr"), std::string::npos);
+    // suyu lee el largo de la cabecera y la igualdad no usa strcmp.
+    EXPECT_NE(contents.find("mov rax, [rax-8]"), std::string::npos);
+    EXPECT_NE(contents.find("call aym_str_eq"), std::string::npos);
+    EXPECT_EQ(contents.find("call strlen"), std::string::npos);
+    EXPECT_EQ(contents.find("call strcmp"), std::string::npos);
+}
+
+TEST(CodeGenTest, InterpolationBuildsStringInOneCall) {
+    std::string src =
+        "yatiya jakhüwi x = 4;\n"
+        "yatiya aru s = $\"x={x}, doble={x * 2}\";\n"
+        "qillqa(s);\n";
+    std::string contents = generateAsmText(src, "test_interpolation_build");
+    ASSERT_FALSE(contents.empty());
+    // Cuatro partes (dos textos, dos numeros) en una sola reserva.
+    size_t build = contents.find("call aym_str_build");
+    ASSERT_NE(build, std::string::npos);
+    EXPECT_EQ(contents.find("call aym_str_build", build + 1), std::string::npos);
+    EXPECT_NE(contents.find("mov rsi, 4\n    call aym_str_build"), std::string::npos);
+    EXPECT_EQ(contents.find("call aym_to_string"), std::string::npos);
+    EXPECT_EQ(contents.find("call aym_str_concat"), std::string::npos);
+}
+
+TEST(CodeGenTest, PrintUsesBufferedWriters) {
+    std::string src =
+        "yatiya jakhüwi x = 4;\n"
+        "qillqa(\"x\", x);\n";
+    std::string contents = generateAsmText(src, "test_print_buffered");
+    ASSERT_FALSE(contents.empty());
+    // Cada valor va directo al buffer de salida, sin cadenas de formato.
+    EXPECT_NE(contents.find("call aym_write_str"), std::string::npos);
+    EXPECT_NE(contents.find("call aym_write_int"), std::string::npos);
+    EXPECT_EQ(contents.find("call printf"), std::string::npos);
+    EXPECT_EQ(contents.find("fmt_int"), std::string::npos);
+}
+
+TEST(CodeGenTest, SetBuiltinsUseHashSet) {
+    std::string src =
+        "yatiya tama vistos = tama([3, 1, 3]);\n"
+        "tama_yapa(vistos, 2);\n"
+        "qillqa(tama_utji(vistos, 2), tama_suyu(vistos));\n"
+        "tama_apsu(vistos, 1);\n"
+        "yatiya t'aqa xs = sapaki([1, 1, 2]);\n";
+    std::string contents = generateAsmText(src, "test_set_builtins");
+    ASSERT_FALSE(contents.empty());
+    EXPECT_NE(contents.find("call aym_set_from_array"), std::string::npos);
+    EXPECT_NE(contents.find("call aym_set_add"), std::string::npos);
+    EXPECT_NE(contents.find("call aym_set_contains"), std::string::npos);
+    EXPECT_NE(contents.find("call aym_set_remove"), std::string::npos);
+    EXPECT_NE(contents.find("call aym_set_size"), std::string::npos);
+    EXPECT_NE(contents.find("call aym_array_unique_int"), std::string::npos);
+}
+
+TEST(CodeGenTest, IntKeyedMapSkipsStringConversion) {
+    std::string src =
+        "yatiya mapa m = {1: 10, 2: 20};\n"
+        "yatiya jakhüwi k = 2;\n"
+        "m[k] = 30;\n"
+        "qillqa(m[k], chanim(m, 3, 0), utjisuti(m, 1));\n"
+        "apsusuti(m, 1);\n";
+    std::string contents = generateAsmText(src, "test_int_map");
+    ASSERT_FALSE(contents.empty());
+    EXPECT_NE(contents.find("call aym_imap_set"), std::string::npos);
+    EXPECT_NE(contents.find("call aym_imap_get"), std::string::npos);
+    EXPECT_NE(contents.find("call aym_imap_get_default"), std::string::npos);
+    EXPECT_NE(contents.find("call aym_imap_contains"), std::string::npos);
+    EXPECT_NE(contents.find("call aym_imap_delete"), std::string::npos);
+    EXPECT_EQ(contents.find("call aym_map_set"), std::string::npos);
+    EXPECT_EQ(contents.find("call aym_to_string"), std::string::npos);
+}
+
+TEST(CodeGenTest, DequeAndHeapBuiltinsUseRuntimeQueues) {
+    std::string src =
+        "lurawi jach_a(jakhüwi a, jakhüwi b): chiqa {\n"
+        "  kuttaya a > b;\n"
+        "}\n"
+        "yatiya siqi cola = siqi([1, 2]);\n"
+        "siqi_qhipa(cola, 3);\n"
+        "siqi_nayra(cola, 0);\n"
+        "qillqa(siqi_apsu_nayra(cola), siqi_apsu_qhipa(cola), siqi_suyu(cola));\n"
+        "yatiya qullu q = qullu(&jach_a);\n"
+        "qullu_yapa(q, 5);\n"
+        "qillqa(qullu_pata(q), qullu_apsu(q), qullu_suyu(q));\n";
+    std::string contents = generateAsmText(src, "test_queue_builtins");
+    ASSERT_FALSE(contents.empty());
+    EXPECT_NE(contents.find("call aym_deque_from_array"), std::string::npos);
+    EXPECT_NE(contents.find("call aym_deque_push_back"), std::string::npos);
+    EXPECT_NE(contents.find("call aym_deque_push_front"), std::string::npos);
+    EXPECT_NE(contents.find("call aym_deque_pop_front"), std::string::npos);
+    EXPECT_NE(contents.find("call aym_deque_pop_back"), std::string::npos);
+    EXPECT_NE(contents.find("lea rax, [rel jach_a]"), std::string::npos);
+    EXPECT_NE(contents.find("call aym_heap_new"), std::string::npos);
+    EXPECT_NE(contents.find("call aym_heap_push"), std::string::npos);
+    EXPECT_NE(contents.find("call aym_heap_peek"), std::string::npos);
+    EXPECT_NE(contents.find("call aym_heap_pop"), std::string::npos);
+    EXPECT_EQ(contents.find("call aym_array_remove_at"), std::string::npos);
+}
+
+TEST(CodeGenTest, SortByPassesKeyFunctionAndKeyKind) {
+    std::string src =
+        "lurawi clave(aru s): aru {\n"
+        "  kuttaya s + \"x\";\n"
+        "}\n"
+        "yatiya t'aqa xs = wakicha_clave([\"b\", \"a\"], &clave);\n"
+        "qillqa(xs);\n";
+    std::string contents = generateAsmText(src, "test_sort_by");
+    ASSERT_FALSE(contents.empty());
+    EXPECT_NE(contents.find("lea rax, [rel clave]"), std::string::npos);
+    EXPECT_NE(contents.find("mov rdx, 1\n    call aym_array_sort_by"), std::string::npos);
+}
+
+TEST(CodeGenTest, FusesPureMapFilterReduceChains) {
+    std::string src =
+        "lurawi doble(jakhüwi x): jakhüwi {\n"
+        "  kuttaya x * 2;\n"
+        "}\n"
+        "lurawi par(jakhüwi x): chiqa {\n"
+        "  kuttaya (x % 2) == 0;\n"
+        "}\n"
+        "lurawi suma(jakhüwi a, jakhüwi x): jakhüwi {\n"
+        "  kuttaya a + x;\n"
+        "}\n"
+        "lurawi ruidosa(jakhüwi x): jakhüwi {\n"
+        "  qillqa(x);\n"
+        "  kuttaya x;\n"
+        "}\n"
+        "yatiya t'aqa xs = [1, 2, 3];\n"
+        "yatiya jakhüwi total = reduce(map(filter(xs, &par), &doble), &suma, 0);\n"
+        "yatiya t'aqa ys = filter(map(xs, &ruidosa), &par);\n"
+        "qillqa(total, ys);\n";
+    std::string contents = generateAsmText(src, "test_hof_fusion");
+    ASSERT_FALSE(contents.empty());
+    size_t first = contents.find("call aym_hof_pipeline");
+    ASSERT_NE(first, std::string::npos);
+    EXPECT_EQ(contents.find("call aym_hof_pipeline", first + 1), std::string::npos);
+    // Con una etapa que imprime, cada llamada sigue por separado.
+    EXPECT_NE(contents.find("call aym_hof_map"), std::string::npos);
+    EXPECT_NE(contents.find("call aym_hof_filter"), std::string::npos);
+}
+
+TEST(CodeGenTest, DoesNotFuseStagesThatCanThrow) {
+    // Por etapas, `f` lanza CLAVE antes de que `g` llegue a lanzar CONVERSION;
+    // fusionadas, saldria primero la de `g`.
+    std::string src =
+        "yatiya mapa m = {\"k1\": 1, \"k2\": 2, \"k4\": 4};\n"
+        "lurawi f(jakhüwi x): jakhüwi {\n"
+        "  kuttaya m[\"k\" + aru(x)];\n"
+        "}\n"
+        "lurawi num(aru s): jakhüwi {\n"
+        "  kuttaya jakhüwi(s);\n"
+        "}\n"
+        "lurawi g(jakhüwi x): chiqa {\n"
+        "  kuttaya x != 1 || num(\"zz\") == 1;\n"
+        "}\n"
+        "lurawi doble(jakhüwi x): jakhüwi {\n"
+        "  kuttaya x * 2;\n"
+        "}\n"
+        "lurawi par(jakhüwi x): chiqa {\n"
+        "  kuttaya (x % 2) == 0;\n"
+        "}\n"
+        "yatiya t'aqa xs = [1, 2, 3, 4];\n"
+        "yatiya t'aqa ys = filter(map(xs, &f), &par);\n"
+        "yatiya t'aqa zs = filter(map(xs, &doble), &g);\n"
+        "qillqa(ys, zs);\n";
+    std::string contents = generateAsmText(src, "test_hof_fusion_throw");
+    ASSERT_FALSE(contents.empty());
+    EXPECT_EQ(contents.find("call aym_hof_pipeline"), std::string::npos);
+    EXPECT_NE(contents.find("call aym_hof_map"), std::string::npos);
+    EXPECT_NE(contents.find("call aym_hof_filter"), std::string::npos);
+}
+
+TEST(CodeGenTest, ParallelHofsNeedPureFunctions) {
+    std::string src =
+        "lurawi paso(jakhüwi x): jakhüwi {\n"
+        "  kuttaya x * 3 % 7;\n"
+        "}\n"
+        "lurawi doble(jakhüwi x): jakhüwi {\n"
+        "  kuttaya paso(x) * 2;\n"
+        "}\n"
+        "lurawi suma(jakhüwi a, jakhüwi b): jakhüwi {\n"
+        "  kuttaya a + b;\n"
+        "}\n"
+        "lurawi ruidosa(jakhüwi x): chiqa {\n"
+        "  qillqa(x);\n"
+        "  kuttaya x > 1;\n"
+        "}\n"
+        "yatiya t'aqa xs = [1, 2, 3];\n"
+        "yatiya t'aqa ys = map_par(xs, &doble);\n"
+        "yatiya jakhüwi total = reduce_par(xs, &suma, 0);\n"
+        "yatiya t'aqa zs = filter_par(xs, &ruidosa);\n"
+        "qillqa(ys, total, zs);\n";
+    std::string contents = generateAsmText(src, "test_hof_par");
+    ASSERT_FALSE(contents.empty());
+    EXPECT_NE(contents.find("call aym_hof_map_par"), std::string::npos);
+    EXPECT_NE(contents.find("call aym_hof_reduce_par"), std::string::npos);
+    // La funcion que imprime no puede correr en otro hilo.
+    EXPECT_EQ(contents.find("call aym_hof_filter_par"), std::string::npos);
+    EXPECT_NE(contents.find("call aym_hof_filter\n"), std::string::npos);
+}
+
+TEST(CodeGenTest, StackAllocatesNonEscapingLocals) {
+    std::string src =
+        "kasta Punto {\n"
+        "  yatiya jakhüwi x = 0;\n"
+        "  qallta(jakhüwi a) {\n"
+        "    aka.x = a;\n"
+        "  }\n"
+        "  lurawi doble(): jakhüwi {\n"
+        "    kuttaya aka.x * 2;\n"
+        "  }\n"
+        "}\n"
+        "lurawi local(jakhüwi n): jakhüwi {\n"
+        "  yatiya Punto p = machaqa Punto(n);\n"
+        "  yatiya t'aqa xs = [n, n + 1];\n"
+        "  yatiya mapa m = {\"a\": n};\n"
+        "  kuttaya p.doble() + xs[1] + largo(xs) + m[\"a\"];\n"
+        "}\n"
+        "lurawi sale(jakhüwi n): t'aqa {\n"
+        "  yatiya t'aqa ys = [n];\n"
+        "  kuttaya ys;\n"
+        "}\n"
+        "qillqa(local(3), sale(4));\n";
+    std::string contents = generateAsmText(src, "test_escape_stack");
+    ASSERT_FALSE(contents.empty());
+    // El objeto que no sale de la funcion vive en su marco.
+    EXPECT_EQ(contents.find("call aym_object_new"), std::string::npos);
+#ifndef _WIN32
+    EXPECT_NE(contents.find("call aym_map_init_stack"), std::string::npos);
+    EXPECT_EQ(contents.find("call aym_map_new"), std::string::npos);
+#endif
+    // La lista que se devuelve sigue en el heap.
+    EXPECT_NE(contents.find("call aym_array_new"), std::string::npos);
+}
+
+TEST(CodeGenTest, TurnsTailCallsIntoJumps) {
+    std::string src =
+        "lurawi suma(jakhuwi n, jakhuwi acc): jakhuwi {\n"
+        "  ukaxa (n == 0) { kuttaya acc; }\n"
+        "  kuttaya suma(n - 1, acc + n);\n"
+        "}\n"
+        "lurawi es_par(jakhuwi n): chiqa {\n"
+        "  ukaxa (n == 0) { kuttaya chiqa; }\n"
+        "  kuttaya es_impar(n - 1);\n"
+        "}\n"
+        "lurawi es_impar(jakhuwi n): chiqa {\n"
+        "  ukaxa (n == 0) { kuttaya k'ari; }\n"
+        "  kuttaya es_par(n - 1);\n"
+        "}\n"
+        "lurawi seguro(jakhuwi n): jakhuwi {\n"
+        "  yant'aña { kuttaya es_dos(n); } katjaña(e) { kuttaya 0; }\n"
+        "  kuttaya 1;\n"
+        "}\n"
+        "lurawi es_dos(jakhuwi n): jakhuwi {\n"
+        "  kuttaya n + es_dos(n - 1);\n"
+        "}\n"
+        "qillqa(suma(10, 0), es_par(7), seguro(2));\n";
+    std::string contents = generateAsmText(src, "test_tail_calls");
+    ASSERT_FALSE(contents.empty());
+    // La recursion propia vuelve al inicio de la funcion; la mutua salta.
+    size_t fn = contents.find("\nsuma:\n");
+    ASSERT_NE(fn, std::string::npos);
+    size_t next = contents.find("\nes_par:\n", fn);
+    std::string body = contents.substr(fn, next - fn);
+    EXPECT_EQ(body.find("call suma"), std::string::npos);
+    EXPECT_NE(body.find("jmp tail"), std::string::npos);
+    EXPECT_NE(contents.find("jmp es_impar"), std::string::npos);
+    EXPECT_NE(contents.find("jmp es_par"), std::string::npos);
+    // Dentro de yant'aña o con trabajo pendiente la llamada queda normal.
+    EXPECT_NE(contents.find("call es_dos"), std::string::npos);
+    EXPECT_EQ(contents.find("jmp es_dos"), std::string::npos);
+}
+
+TEST(CodeGenTest, IrBackendBuildsPhisForLoops) {
+    std::string src =
+        "lurawi suma(jakhuwi n): jakhuwi {\n"
+        "  yatiya jakhuwi s = 0;\n"
+        "  yatiya jakhuwi i = 0;\n"
+        "  ukhakamaxa (i < n) { s = s + i; i = i + 1; }\n"
+        "  kuttaya s;\n"
+        "}\n"
+        "qillqa(suma(10));\n";
+    Lexer lexer(src);
+    auto tokens = lexer.tokenize();
+    Parser parser(tokens);
+    auto nodes = parser.parse();
+    ASSERT_FALSE(parser.hasError());
+    SemanticAnalyzer sem;
+    sem.analyze(nodes);
+    ASSERT_FALSE(sem.hasErrors());
+    std::filesystem::create_directory("build");
+
+    const fs::path asmPath = fs::path("build") / "test_ir_loop.asm";
+    const fs::path irPath = fs::path("build") / "test_ir_loop.ir";
+    CodeGenerator cg;
+    cg.setIrDumpPath(irPath.string());
+#ifdef _WIN32
+    const bool windowsTarget = true;
+#else
+    const bool windowsTarget = false;
+#endif
+    ASSERT_TRUE(cg.generate(nodes,
+                            asmPath.string(),
+                            sem.getGlobals(),
+                            sem.getParamTypes(),
+                            sem.getFunctionReturnTypes(),
+                            sem.getGlobalTypes(),
+                            windowsTarget,
+                            0,
+                            "runtime",
+                            true,
+                            CodegenPipelineMode::CompileOnly));
+
+    std::ifstream irIn(irPath);
+    std::string ir((std::istreambuf_iterator<char>(irIn)), std::istreambuf_iterator<char>());
+    irIn.close();
+    std::ifstream asmIn(asmPath);
+    std::string asmText((std::istreambuf_iterator<char>(asmIn)), std::istreambuf_iterator<char>());
+    asmIn.close();
+    std::remove(irPath.string().c_str());
+    std::remove(asmPath.string().c_str());
+    std::remove((fs::path("build") / "test_ir_loop.o").string().c_str());
+    std::remove((fs::path("build") / "test_ir_loop.obj").string().c_str());
+
+    // s e i se redefinen en el cuerpo del bucle: la cabecera necesita dos phis.
+    size_t fn = ir.find("func @suma(i64) -> i64 {");
+    ASSERT_NE(fn, std::string::npos);
+    std::string body = ir.substr(fn, ir.find("}\n", fn) - fn);
+    size_t phi = body.find("phi i64");
+    ASSERT_NE(phi, std::string::npos);
+    EXPECT_NE(body.find("phi i64", phi + 1), std::string::npos);
+    EXPECT_EQ(ir.find("sin IR"), std::string::npos);
+    EXPECT_NE(asmText.find("_bb"), std::string::npos);
+}
+
+TEST(IrTest, SimplifyRemovesTrivialPhisAndDeadBlocks) {
+    IrFunction fn;
+    fn.name = "f";
+    fn.returnType = IrType::I64;
+    int entry = fn.addBlock();
+    int loop = fn.addBlock();
+    int dead = fn.addBlock();
+    int exit = fn.addBlock();
+    fn.blocks[loop].preds = {entry, loop};
+    fn.blocks[exit].preds = {loop, dead};
+
+    IrInstr one(IrOp::Const, IrType::I64);
+    one.imm = 1;
+    int c = fn.append(entry, one);
+    IrInstr br(IrOp::Br);
+    br.targets = {loop};
+    fn.append(entry, br);
+
+    // phi(c, phi) solo depende de c: es trivial.
+    IrInstr phi(IrOp::Phi, IrType::I64);
+    phi.targets = {entry, loop};
+    int p = fn.append(loop, phi);
+    fn.values[p].args = {c, p};
+    IrInstr cbr(IrOp::CondBr);
+    cbr.args = {p};
+    cbr.targets = {loop, exit};
+    fn.append(loop, cbr);
+
+    IrInstr toExit(IrOp::Br);
+    toExit.targets = {exit};
+    fn.append(dead, toExit);
+
+    IrInstr ret(IrOp::Ret);
+    ret.args = {p};
+    int r = fn.append(exit, ret);
+
+    simplifyIrFunction(fn);
+    EXPECT_TRUE(fn.blocks[dead].instrs.empty());
+    EXPECT_EQ(fn.blocks[exit].preds, std::vector<int>{loop});
+    EXPECT_EQ(fn.values[r].args, std::vector<int>{c});
+    EXPECT_EQ(fn.values[fn.blocks[loop].instrs.front()].op, IrOp::CondBr);
+    EXPECT_EQ(verifyIrFunction(fn), "");
+}
+
+namespace {
+
+std::vector<std::unique_ptr<Node>> parseAndAnalyze(const std::string &src) {
+    Lexer lexer(src);
+    auto tokens = lexer.tokenize();
+    Parser parser(tokens);
+    auto nodes = parser.parse();
+    EXPECT_FALSE(parser.hasError());
+    SemanticAnalyzer sem;
+    sem.analyze(nodes);
+    EXPECT_FALSE(sem.hasErrors());
+    return nodes;
+}
+
+const Expr *printedExpr(const std::vector<std::unique_ptr<Node>> &nodes, size_t index) {
+    auto *print = dynamic_cast<const PrintStmt*>(nodes[index].get());
+    return print ? print->getExprs()[0].get() : nullptr;
+}
+
+} // namespace
+
+TEST(ConstantFoldTest, FoldsLiteralsAndPropagatesConstants) {
+    auto nodes = parseAndAnalyze(
+        "yatiya jakhüwi base = 7;\n"
+        "yatiya aru nombre = \"kamisaki\";\n"
+        "qillqa(2 ^ 10 + base * 6);\n"
+        "qillqa(nombre + \" jilata\");\n"
+        "qillqa(base > 3 ? 1 : 2);\n"
+        "ukaxa (base == 7) { qillqa(1); } maysatxa { qillqa(2); }\n"
+        "ukaxa (kari) { qillqa(3); }\n"
+        "qillqa(!(1 < 2));\n");
+    FoldStats stats = foldConstants(nodes);
+    EXPECT_EQ(stats.propagated, 4);
+    EXPECT_EQ(stats.deadBranches, 2);
+
+    auto *sum = dynamic_cast<const NumberExpr*>(printedExpr(nodes, 2));
+    ASSERT_NE(sum, nullptr);
+    EXPECT_EQ(sum->getValue(), 1066);
+    auto *text = dynamic_cast<const StringExpr*>(printedExpr(nodes, 3));
+    ASSERT_NE(text, nullptr);
+    EXPECT_EQ(text->getValue(), "kamisaki jilata");
+    auto *choice = dynamic_cast<const NumberExpr*>(printedExpr(nodes, 4));
+    ASSERT_NE(choice, nullptr);
+    EXPECT_EQ(choice->getValue(), 1);
+
+    // La rama viva reemplaza al `ukaxa`; el `ukaxa (kari)` sin alternativa desaparece.
+    ASSERT_EQ(nodes.size(), 7u);
+    auto *live = dynamic_cast<const BlockStmt*>(nodes[5].get());
+    ASSERT_NE(live, nullptr);
+    auto *flag = dynamic_cast<const BoolExpr*>(printedExpr(nodes, 6));
+    ASSERT_NE(flag, nullptr);
+    EXPECT_FALSE(flag->getValue());
+}
+
+TEST(ConstantFoldTest, KeepsReassignedVariablesAndRuntimeTraps) {
+    auto nodes = parseAndAnalyze(
+        "yatiya jakhüwi x = 5;\n"
+        "x = x + 1;\n"
+        "qillqa(x * 2);\n"
+        "qillqa(1 / 0);\n"
+        "lurawi f(jakhüwi n): jakhüwi { kuttaya n + 1; }\n"
+        "yatiya jakhüwi n = 3;\n"
+        "qillqa(f(n));\n");
+    FoldStats stats = foldConstants(nodes);
+    EXPECT_EQ(stats.propagated, 0);
+    EXPECT_NE(dynamic_cast<const BinaryExpr*>(printedExpr(nodes, 2)), nullptr);
+    EXPECT_NE(dynamic_cast<const BinaryExpr*>(printedExpr(nodes, 3)), nullptr);
+}
+
+TEST(InlineTest, ReplacesSmallPureCallsWithTheirBody) {
+    auto nodes = parseAndAnalyze(
+        "lurawi cuadrado(jakhüwi x): jakhüwi { kuttaya x * x; }\n"
+        "lurawi maximo(jakhüwi a, jakhüwi b): jakhüwi {\n"
+        "  ukaxa (a > b) { kuttaya a; }\n"
+        "  kuttaya b;\n"
+        "}\n"
+        "lurawi es_par(jakhüwi n): chiqa { kuttaya n % 2 == 0; }\n"
+        "yatiya jakhüwi k = 5;\n"
+        "qillqa(cuadrado(k + 1));\n"
+        "qillqa(maximo(cuadrado(k), 7));\n"
+        "qillqa(es_par(k));\n");
+    InlineStats stats = inlineFunctions(nodes);
+    EXPECT_EQ(stats.candidates, 3);
+    ASSERT_EQ(stats.sites.size(), 4u);
+    EXPECT_EQ(stats.sites[0].callee, "cuadrado");
+    EXPECT_EQ(stats.sites[0].caller, "programa principal");
+    EXPECT_EQ(stats.sites[0].line, 8u);
+
+    // (k + 1) * (k + 1): el argumento sin division se puede repetir.
+    auto *square = dynamic_cast<const BinaryExpr*>(printedExpr(nodes, 4));
+    ASSERT_NE(square, nullptr);
+    EXPECT_EQ(square->getOp(), '*');
+    EXPECT_NE(dynamic_cast<const BinaryExpr*>(square->getLeft()), nullptr);
+    // El `ukaxa` con `kuttaya` pasa a ternario.
+    auto *max = dynamic_cast<const TernaryExpr*>(printedExpr(nodes, 5));
+    ASSERT_NE(max, nullptr);
+    EXPECT_NE(dynamic_cast<const BinaryExpr*>(max->getThen()), nullptr);
+    auto *even = dynamic_cast<const BinaryExpr*>(printedExpr(nodes, 6));
+    ASSERT_NE(even, nullptr);
+    EXPECT_EQ(even->getOp(), 's');
+}
+
+TEST(InlineTest, KeepsRecursiveImpureAndTrappingCalls) {
+    auto nodes = parseAndAnalyze(
+        "lurawi fact(jakhüwi n): jakhüwi {\n"
+        "  ukaxa (n <= 1) { kuttaya 1; }\n"
+        "  kuttaya n * fact(n - 1);\n"
+        "}\n"
+        "lurawi ruidosa(jakhüwi n): jakhüwi { qillqa(n); kuttaya n; }\n"
+        "lurawi primero(jakhüwi a, jakhüwi b): jakhüwi { kuttaya a; }\n"
+        "lurawi nombre(aru s): aru { kuttaya s; }\n"
+        "lurawi seguro(jakhüwi n): jakhüwi {\n"
+        "  yant'aña { kuttaya n; } katjaña(e) { kuttaya 0; }\n"
+        "}\n"
+        "yatiya jakhüwi k = 0;\n"
+        "qillqa(fact(5));\n"
+        "qillqa(ruidosa(k));\n"
+        "qillqa(primero(1, 10 / k));\n"
+        "qillqa(primero(ruidosa(1), 2));\n"
+        "qillqa(nombre(\"a\"));\n"
+        "qillqa(seguro(k));\n");
+    InlineStats stats = inlineFunctions(nodes);
+    EXPECT_EQ(stats.candidates, 1);
+    EXPECT_TRUE(stats.sites.empty());
+    for (size_t i = 6; i < nodes.size(); ++i) {
+        EXPECT_NE(dynamic_cast<const CallExpr*>(printedExpr(nodes, i)), nullptr);
+    }
+}
+
 TEST(ModuleResolverTest, LoadsModuleFromRelativeDirectory) {
     fs::path base = fs::current_path() / "tests" / "tmp_modules";
     fs::create_directories(base / "modules");
@@ -2137,6 +3001,43 @@ TEST(SemanticTest, RejectsWriteWithNumericArgument) {
     EXPECT_TRUE(foundTypeError);
 }
 
+TEST(SemanticTest, RejectsSetElementOfWrongType) {
+    Lexer lexer("qallta yatiya tama s = tama([1, 2]); tama_yapa(s, \"x\"); tukuya");
+    auto tokens = lexer.tokenize();
+    Parser parser(tokens);
+    auto nodes = parser.parse();
+    ASSERT_FALSE(parser.hasError());
+
+    SemanticAnalyzer sem;
+    sem.analyze(nodes);
+    EXPECT_TRUE(sem.hasErrors());
+}
+
+TEST(SemanticTest, RejectsMapWithMixedKeyTypes) {
+    Lexer lexer("qallta yatiya mapa m = {1: 2, \"a\": 3}; tukuya");
+    auto tokens = lexer.tokenize();
+    Parser parser(tokens);
+    auto nodes = parser.parse();
+    ASSERT_FALSE(parser.hasError());
+
+    SemanticAnalyzer sem;
+    sem.analyze(nodes);
+    EXPECT_TRUE(sem.hasErrors());
+}
+
+TEST(SemanticTest, RejectsHeapComparatorWithWrongArity) {
+    Lexer lexer("qallta lurawi mayor(jakhüwi a): chiqa { kuttaya a > 0; } "
+                "yatiya qullu q = qullu(&mayor); tukuya");
+    auto tokens = lexer.tokenize();
+    Parser parser(tokens);
+    auto nodes = parser.parse();
+    ASSERT_FALSE(parser.hasError());
+
+    SemanticAnalyzer sem;
+    sem.analyze(nodes);
+    EXPECT_TRUE(sem.hasErrors());
+}
+
 TEST(DiagnosticEngineTest, WritesDiagnosticsJsonFile) {
     fs::create_directories("build");
     fs::create_directories(fs::path("build") / "tmp");